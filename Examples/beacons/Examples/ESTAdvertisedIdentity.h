@@ -0,0 +1,76 @@
+//
+//  ESTAdvertisedIdentity.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+
+typedef NS_ENUM(NSInteger, ESTAdvertisedFrameType)
+{
+    ESTAdvertisedFrameTypeIBeacon,
+    ESTAdvertisedFrameTypeEddystoneUID,
+    ESTAdvertisedFrameTypeEddystoneURL
+};
+
+/*
+ * Immutable identity advertised by the device, with its advertisement payload
+ * encoded once at creation:
+ *
+ * - iBeacon: manufacturer specific data (company 0x004C, type 0x02 0x15, UUID, major, minor, power),
+ * - Eddystone: service data of 0xFEAA service (UID or URL frame).
+ *
+ * Factory methods return nil for invalid values (e.g. URL that does not fit the frame).
+ */
+@interface ESTAdvertisedIdentity : NSObject
+
+@property (nonatomic, assign, readonly) ESTAdvertisedFrameType frameType;
+
+@property (nonatomic, strong, readonly) NSUUID *proximityUUID;
+@property (nonatomic, assign, readonly) CLBeaconMajorValue major;
+@property (nonatomic, assign, readonly) CLBeaconMinorValue minor;
+
+@property (nonatomic, strong, readonly) NSString *namespaceID;
+@property (nonatomic, strong, readonly) NSString *instanceID;
+@property (nonatomic, strong, readonly) NSString *url;
+
+/*
+ * Calibrated power: RSSI at 1 m for iBeacon, at 0 m for Eddystone.
+ */
+@property (nonatomic, assign, readonly) int8_t measuredPower;
+
+/*
+ * Over-the-air bytes for radios that take raw advertisement data.
+ * CoreBluetooth builds iBeacon advertisement data itself, see ESTPeripheralAdvertiser.
+ */
+@property (nonatomic, strong, readonly) NSData *payload;
+
+/*
+ * Relative share of advertising time. Default 1.
+ */
+@property (nonatomic, assign) double share;
+
+/*
+ * Time the identity is advertised in each of its turns, 0 uses scheduler slotDuration.
+ */
+@property (nonatomic, assign) NSTimeInterval dwellTime;
+
++ (instancetype)identityWithProximityUUID:(NSUUID *)proximityUUID
+                                    major:(CLBeaconMajorValue)major
+                                    minor:(CLBeaconMinorValue)minor
+                            measuredPower:(int8_t)measuredPower;
+
+/*
+ * Namespace ID is 20 and instance ID 12 hexadecimal characters.
+ */
++ (instancetype)identityWithEddystoneNamespaceID:(NSString *)namespaceID
+                                      instanceID:(NSString *)instanceID
+                                   measuredPower:(int8_t)measuredPower;
+
++ (instancetype)identityWithEddystoneURL:(NSString *)url
+                           measuredPower:(int8_t)measuredPower;
+
+@end
@@ -0,0 +1,217 @@
+//
+//  ESTAdvertisedIdentity.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTAdvertisedIdentity.h"
+
+#define EST_EDDYSTONE_FRAME_UID       0x00
+#define EST_EDDYSTONE_FRAME_URL       0x10
+#define EST_EDDYSTONE_URL_MAX_LENGTH  17
+
+static NSString * const ESTEddystoneURLSchemes[] = { @"http://www.", @"https://www.", @"http://", @"https://" };
+
+static NSString * const ESTEddystoneURLExpansions[] = {
+    @".com/", @".org/", @".edu/", @".net/", @".info/", @".biz/", @".gov/",
+    @".com", @".org", @".edu", @".net", @".info", @".biz", @".gov"
+};
+
+@interface ESTAdvertisedIdentity ()
+
+@property (nonatomic, assign, readwrite) ESTAdvertisedFrameType frameType;
+@property (nonatomic, strong, readwrite) NSUUID *proximityUUID;
+@property (nonatomic, assign, readwrite) CLBeaconMajorValue major;
+@property (nonatomic, assign, readwrite) CLBeaconMinorValue minor;
+@property (nonatomic, strong, readwrite) NSString *namespaceID;
+@property (nonatomic, strong, readwrite) NSString *instanceID;
+@property (nonatomic, strong, readwrite) NSString *url;
+@property (nonatomic, assign, readwrite) int8_t measuredPower;
+@property (nonatomic, strong, readwrite) NSData *payload;
+
+@end
+
+@implementation ESTAdvertisedIdentity
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.share = 1;
+    }
+    return self;
+}
+
+#pragma mark - iBeacon
+
++ (instancetype)identityWithProximityUUID:(NSUUID *)proximityUUID
+                                    major:(CLBeaconMajorValue)major
+                                    minor:(CLBeaconMinorValue)minor
+                            measuredPower:(int8_t)measuredPower
+{
+    if (!proximityUUID)
+    {
+        return nil;
+    }
+
+    uint8_t bytes[25] = { 0x4C, 0x00, 0x02, 0x15 };
+    [proximityUUID getUUIDBytes:bytes + 4];
+    bytes[20] = (uint8_t)(major >> 8);
+    bytes[21] = (uint8_t)major;
+    bytes[22] = (uint8_t)(minor >> 8);
+    bytes[23] = (uint8_t)minor;
+    bytes[24] = (uint8_t)measuredPower;
+
+    ESTAdvertisedIdentity *identity = [self new];
+    identity.frameType = ESTAdvertisedFrameTypeIBeacon;
+    identity.proximityUUID = proximityUUID;
+    identity.major = major;
+    identity.minor = minor;
+    identity.measuredPower = measuredPower;
+    identity.payload = [NSData dataWithBytes:bytes length:sizeof(bytes)];
+
+    return identity;
+}
+
+#pragma mark - Eddystone
+
+static BOOL ESTParseHex(NSString *string, uint8_t *bytes, NSUInteger length)
+{
+    if (string.length != length * 2)
+    {
+        return NO;
+    }
+
+    for (NSUInteger i = 0; i < length * 2; i++)
+    {
+        unichar c = [string characterAtIndex:i];
+        uint8_t nibble;
+
+        if (c >= '0' && c <= '9')      nibble = (uint8_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') nibble = (uint8_t)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') nibble = (uint8_t)(c - 'A' + 10);
+        else return NO;
+
+        bytes[i / 2] = (i % 2) ? (uint8_t)(bytes[i / 2] | nibble) : (uint8_t)(nibble << 4);
+    }
+
+    return YES;
+}
+
++ (instancetype)identityWithEddystoneNamespaceID:(NSString *)namespaceID
+                                      instanceID:(NSString *)instanceID
+                                   measuredPower:(int8_t)measuredPower
+{
+    uint8_t bytes[20] = { EST_EDDYSTONE_FRAME_UID, (uint8_t)measuredPower };
+
+    if (!ESTParseHex(namespaceID, bytes + 2, 10) || !ESTParseHex(instanceID, bytes + 12, 6))
+    {
+        return nil;
+    }
+
+    ESTAdvertisedIdentity *identity = [self new];
+    identity.frameType = ESTAdvertisedFrameTypeEddystoneUID;
+    identity.namespaceID = [namespaceID lowercaseString];
+    identity.instanceID = [instanceID lowercaseString];
+    identity.measuredPower = measuredPower;
+    identity.payload = [NSData dataWithBytes:bytes length:sizeof(bytes)];
+
+    return identity;
+}
+
++ (instancetype)identityWithEddystoneURL:(NSString *)url measuredPower:(int8_t)measuredPower
+{
+    uint8_t bytes[3 + EST_EDDYSTONE_URL_MAX_LENGTH] = { EST_EDDYSTONE_FRAME_URL, (uint8_t)measuredPower };
+    NSUInteger length = 2;
+
+    NSUInteger position = NSNotFound;
+    NSUInteger schemeCount = sizeof(ESTEddystoneURLSchemes) / sizeof(ESTEddystoneURLSchemes[0]);
+
+    for (NSUInteger i = 0; i < schemeCount; i++)
+    {
+        if ([url hasPrefix:ESTEddystoneURLSchemes[i]])
+        {
+            bytes[length++] = (uint8_t)i;
+            position = ESTEddystoneURLSchemes[i].length;
+            break;
+        }
+    }
+
+    if (position == NSNotFound)
+    {
+        return nil;
+    }
+
+    NSUInteger expansionCount = sizeof(ESTEddystoneURLExpansions) / sizeof(ESTEddystoneURLExpansions[0]);
+
+    while (position < url.length)
+    {
+        if (length == sizeof(bytes))
+        {
+            return nil;
+        }
+
+        // Expansions with trailing slash come first, so the longest match wins.
+        BOOL expanded = NO;
+
+        for (NSUInteger i = 0; i < expansionCount; i++)
+        {
+            NSString *expansion = ESTEddystoneURLExpansions[i];
+
+            if (position + expansion.length <= url.length
+                && [url compare:expansion options:NSLiteralSearch range:NSMakeRange(position, expansion.length)] == NSOrderedSame)
+            {
+                bytes[length++] = (uint8_t)i;
+                position += expansion.length;
+                expanded = YES;
+                break;
+            }
+        }
+
+        if (!expanded)
+        {
+            unichar c = [url characterAtIndex:position++];
+
+            if (c <= 0x20 || c >= 0x7F)
+            {
+                return nil;
+            }
+
+            bytes[length++] = (uint8_t)c;
+        }
+    }
+
+    ESTAdvertisedIdentity *identity = [self new];
+    identity.frameType = ESTAdvertisedFrameTypeEddystoneURL;
+    identity.url = url;
+    identity.measuredPower = measuredPower;
+    identity.payload = [NSData dataWithBytes:bytes length:length];
+
+    return identity;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    switch (self.frameType)
+    {
+        case ESTAdvertisedFrameTypeIBeacon:
+            return [NSString stringWithFormat:@"<%@: %@ %u:%u>", NSStringFromClass([self class]),
+                    [self.proximityUUID UUIDString], self.major, self.minor];
+
+        case ESTAdvertisedFrameTypeEddystoneUID:
+            return [NSString stringWithFormat:@"<%@: %@ %@>", NSStringFromClass([self class]),
+                    self.namespaceID, self.instanceID];
+
+        case ESTAdvertisedFrameTypeEddystoneURL:
+            return [NSString stringWithFormat:@"<%@: %@>", NSStringFromClass([self class]), self.url];
+    }
+
+    return [super description];
+}
+
+@end
@@ -0,0 +1,125 @@
+//
+//  ESTAdvertisingScheduler.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "ESTAdvertisedIdentity.h"
+
+/*
+ * Radio used by ESTAdvertisingScheduler. canAdvertiseIdentity: is called once per
+ * identity when identities are set, implementations build their advertisement data
+ * there and should do no encoding work when switching.
+ */
+@protocol ESTAdvertiser <NSObject>
+
+- (BOOL)canAdvertiseIdentity:(ESTAdvertisedIdentity *)identity;
+- (void)startAdvertisingIdentity:(ESTAdvertisedIdentity *)identity;
+- (void)stopAdvertising;
+
+@end
+
+/*
+ * Advertiser backed by CBPeripheralManager. Advertisement data of an identity, with its
+ * measured power, is built once when the identity is accepted, a switch only restarts
+ * the radio. Apps on iOS can advertise iBeacon frames only, Eddystone identities are
+ * rejected and skipped by the scheduler. Advertising starts once Bluetooth is powered on.
+ */
+@interface ESTPeripheralAdvertiser : NSObject <ESTAdvertiser>
+
+@property (nonatomic, strong, readonly) CBPeripheralManager *peripheralManager;
+
+@end
+
+@class ESTAdvertisingScheduler;
+
+@protocol ESTAdvertisingSchedulerDelegate <NSObject>
+
+@optional
+
+/*
+ * lateness is the delay between planned and actual switch time.
+ */
+- (void)advertisingScheduler:(ESTAdvertisingScheduler *)scheduler
+       didStartAdvertisingIdentity:(ESTAdvertisedIdentity *)identity
+                          lateness:(NSTimeInterval)lateness;
+
+@end
+
+/*
+ * Time multiplexed advertising of several identities with a single radio.
+ *
+ * Shares are shares of airtime: identities get slots in proportion to share / dwell time,
+ * interleaved with smooth weighted round robin so that each identity is spread evenly
+ * over the cycle. The one slot every identity gets at least, and rounding to whole
+ * slots, limit how closely airtime follows small shares. The slot sequence
+ * and its time offsets are computed once in setIdentities:, each rotation only moves
+ * an index. Switch times are derived from the cycle start, so timer jitter does not
+ * accumulate over time.
+ */
+@interface ESTAdvertisingScheduler : NSObject
+
+@property (nonatomic, weak) id <ESTAdvertisingSchedulerDelegate> delegate;
+
+@property (nonatomic, strong, readonly) id <ESTAdvertiser> advertiser;
+
+/*
+ * Identities accepted by the advertiser.
+ */
+@property (nonatomic, strong, readonly) NSArray *identities;
+
+/*
+ * Default dwell time of a slot. Default 1 s, restarting advertising on iOS takes
+ * a few hundred milliseconds so shorter slots waste a large part of air time.
+ */
+@property (nonatomic, assign) NSTimeInterval slotDuration;
+
+/*
+ * Number of slots in one cycle shared between identities. Default 20, raised
+ * automatically so that each identity gets at least one slot.
+ */
+@property (nonatomic, assign) NSUInteger slotsPerCycle;
+
+@property (nonatomic, assign, readonly, getter = isRunning) BOOL running;
+@property (nonatomic, strong, readonly) ESTAdvertisedIdentity *currentIdentity;
+
+/*
+ * Maximum observed lateness of a switch.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval maximumLateness;
+
+- (instancetype)initWithAdvertiser:(id <ESTAdvertiser>)advertiser;
+
+/*
+ * Rebuilds the slot sequence, restarts the cycle when running.
+ */
+- (void)setIdentities:(NSArray *)identities;
+
+- (void)start;
+- (void)stop;
+
+/*
+ * Rotation without timers, driven by the caller's clock, e.g. a replay or a test with
+ * a recording advertiser. advanceToTime: switches to the slot planned for the time,
+ * times must not decrease.
+ */
+- (void)startAtTime:(CFAbsoluteTime)time;
+- (void)advanceToTime:(CFAbsoluteTime)time;
+
+/*
+ * Planned time of the next switch, 0 when not running.
+ */
+@property (nonatomic, assign, readonly) CFAbsoluteTime nextSwitchTime;
+
+/*
+ * Identity planned for given offset from the cycle start.
+ */
+- (ESTAdvertisedIdentity *)identityAtCycleOffset:(NSTimeInterval)offset;
+
+@property (nonatomic, assign, readonly) NSTimeInterval cycleDuration;
+
+@end
@@ -0,0 +1,436 @@
+//
+//  ESTAdvertisingScheduler.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTAdvertisingScheduler.h"
+
+#pragma mark - Peripheral advertiser
+
+@interface ESTPeripheralAdvertiser () <CBPeripheralManagerDelegate>
+
+@property (nonatomic, strong, readwrite) CBPeripheralManager *peripheralManager;
+
+@property (nonatomic, strong) NSMapTable *advertisements;
+@property (nonatomic, strong) NSDictionary *currentAdvertisement;
+
+@end
+
+@implementation ESTPeripheralAdvertiser
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.advertisements = [NSMapTable weakToStrongObjectsMapTable];
+        self.peripheralManager = [[CBPeripheralManager alloc] initWithDelegate:self queue:nil];
+    }
+    return self;
+}
+
+- (BOOL)canAdvertiseIdentity:(ESTAdvertisedIdentity *)identity
+{
+    if (identity.frameType != ESTAdvertisedFrameTypeIBeacon)
+    {
+        return NO;
+    }
+
+    if (![self.advertisements objectForKey:identity])
+    {
+        CLBeaconRegion *region = [[CLBeaconRegion alloc] initWithProximityUUID:identity.proximityUUID
+                                                                         major:identity.major
+                                                                         minor:identity.minor
+                                                                    identifier:@"ESTAdvertisingScheduler"];
+
+        [self.advertisements setObject:[region peripheralDataWithMeasuredPower:@(identity.measuredPower)] forKey:identity];
+    }
+
+    return YES;
+}
+
+- (void)startAdvertisingIdentity:(ESTAdvertisedIdentity *)identity
+{
+    if (![self.advertisements objectForKey:identity] && ![self canAdvertiseIdentity:identity])
+    {
+        return;
+    }
+
+    self.currentAdvertisement = [self.advertisements objectForKey:identity];
+
+    if (self.peripheralManager.state == CBPeripheralManagerStatePoweredOn)
+    {
+        [self.peripheralManager stopAdvertising];
+        [self.peripheralManager startAdvertising:self.currentAdvertisement];
+    }
+}
+
+- (void)stopAdvertising
+{
+    self.currentAdvertisement = nil;
+    [self.peripheralManager stopAdvertising];
+}
+
+- (void)peripheralManagerDidUpdateState:(CBPeripheralManager *)peripheral
+{
+    if (peripheral.state == CBPeripheralManagerStatePoweredOn && self.currentAdvertisement)
+    {
+        [peripheral startAdvertising:self.currentAdvertisement];
+    }
+}
+
+@end
+
+#pragma mark - Scheduler
+
+@interface ESTAdvertisingScheduler ()
+
+@property (nonatomic, strong, readwrite) id <ESTAdvertiser> advertiser;
+@property (nonatomic, strong, readwrite) NSArray *identities;
+@property (nonatomic, assign, readwrite) BOOL running;
+@property (nonatomic, strong, readwrite) ESTAdvertisedIdentity *currentIdentity;
+@property (nonatomic, assign, readwrite) NSTimeInterval maximumLateness;
+
+@property (nonatomic, strong) NSTimer *timer;
+
+@end
+
+@implementation ESTAdvertisingScheduler
+{
+    // Identity index and start offset of each slot, offsets has one extra entry with cycle duration.
+    uint32_t *_slotIdentities;
+    NSTimeInterval *_slotOffsets;
+    NSUInteger _slotCount;
+
+    NSUInteger _slot;
+    NSTimeInterval _cycleStart;
+
+    // Caller driven rotation restarts at the last time it was given.
+    BOOL _timerDriven;
+    CFAbsoluteTime _lastTime;
+}
+
+- (instancetype)initWithAdvertiser:(id <ESTAdvertiser>)advertiser
+{
+    self = [super init];
+    if (self)
+    {
+        self.advertiser = advertiser;
+        _identities = @[];
+        self.slotDuration = 1.0;
+        self.slotsPerCycle = 20;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_slotIdentities);
+    free(_slotOffsets);
+}
+
+- (NSTimeInterval)cycleDuration
+{
+    return _slotCount ? _slotOffsets[_slotCount] : 0;
+}
+
+#pragma mark - Slot sequence
+
+- (void)setIdentities:(NSArray *)identities
+{
+    BOOL wasRunning = self.running;
+    BOOL wasTimerDriven = _timerDriven;
+    [self stop];
+
+    NSMutableArray *accepted = [NSMutableArray arrayWithCapacity:identities.count];
+
+    for (ESTAdvertisedIdentity *identity in identities)
+    {
+        if (identity.share > 0 && [self.advertiser canAdvertiseIdentity:identity])
+        {
+            [accepted addObject:identity];
+        }
+    }
+
+    _identities = [accepted copy];
+    [self buildSlots];
+
+    if (wasRunning && wasTimerDriven)
+    {
+        [self start];
+    }
+    else if (wasRunning)
+    {
+        [self startAtTime:_lastTime];
+    }
+}
+
+/*
+ * Slots are distributed in proportion to share / dwell time by largest remainder,
+ * every identity gets at least one, and interleaved with smooth weighted round robin.
+ */
+- (void)buildSlots
+{
+    NSUInteger count = self.identities.count;
+    NSUInteger total = MAX(self.slotsPerCycle, count);
+
+    free(_slotIdentities);
+    free(_slotOffsets);
+    _slotIdentities = NULL;
+    _slotOffsets = NULL;
+    _slotCount = 0;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Slots per unit of airtime share, so identities with longer dwell get fewer turns.
+    double *weights = calloc(count, sizeof(double));
+    double totalWeight = 0;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        ESTAdvertisedIdentity *identity = self.identities[i];
+
+        weights[i] = identity.share / (identity.dwellTime > 0 ? identity.dwellTime : self.slotDuration);
+        totalWeight += weights[i];
+    }
+
+    NSInteger *slots = calloc(count, sizeof(NSInteger));
+    double *remainders = calloc(count, sizeof(double));
+    NSUInteger assigned = 0;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        double exact = (double)total * weights[i] / totalWeight;
+        slots[i] = MAX((NSInteger)1, (NSInteger)floor(exact));
+        remainders[i] = exact - slots[i];
+        assigned += slots[i];
+    }
+
+    while (assigned < total)
+    {
+        NSUInteger best = 0;
+        for (NSUInteger i = 1; i < count; i++)
+        {
+            if (remainders[i] > remainders[best])
+            {
+                best = i;
+            }
+        }
+
+        slots[best]++;
+        remainders[best] = -INFINITY;
+        assigned++;
+    }
+
+    // Identities raised to their one slot can take the cycle past total.
+    total = assigned;
+
+    _slotCount = total;
+    _slotIdentities = malloc(total * sizeof(uint32_t));
+    _slotOffsets = malloc((total + 1) * sizeof(NSTimeInterval));
+
+    NSInteger *current = calloc(count, sizeof(NSInteger));
+    NSTimeInterval offset = 0;
+
+    for (NSUInteger s = 0; s < total; s++)
+    {
+        NSUInteger best = 0;
+
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            current[i] += slots[i];
+
+            if (current[i] > current[best])
+            {
+                best = i;
+            }
+        }
+
+        current[best] -= (NSInteger)total;
+
+        ESTAdvertisedIdentity *identity = self.identities[best];
+
+        _slotIdentities[s] = (uint32_t)best;
+        _slotOffsets[s] = offset;
+        offset += identity.dwellTime > 0 ? identity.dwellTime : self.slotDuration;
+    }
+
+    _slotOffsets[total] = offset;
+
+    free(current);
+    free(remainders);
+    free(slots);
+    free(weights);
+}
+
+- (ESTAdvertisedIdentity *)identityAtCycleOffset:(NSTimeInterval)offset
+{
+    if (_slotCount == 0)
+    {
+        return nil;
+    }
+
+    offset = fmod(offset, self.cycleDuration);
+    if (offset < 0)
+    {
+        offset += self.cycleDuration;
+    }
+
+    // Binary search for the last slot starting at or before offset.
+    NSUInteger low = 0;
+    NSUInteger high = _slotCount;
+
+    while (high - low > 1)
+    {
+        NSUInteger mid = (low + high) / 2;
+
+        if (_slotOffsets[mid] <= offset)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return self.identities[_slotIdentities[low]];
+}
+
+#pragma mark - Rotation
+
+- (void)start
+{
+    if ([self beginAtTime:CFAbsoluteTimeGetCurrent()])
+    {
+        _timerDriven = YES;
+        [self scheduleNextSwitch];
+    }
+}
+
+- (void)startAtTime:(CFAbsoluteTime)time
+{
+    [self beginAtTime:time];
+}
+
+- (BOOL)beginAtTime:(CFAbsoluteTime)time
+{
+    if (self.running || _slotCount == 0)
+    {
+        return NO;
+    }
+
+    self.running = YES;
+    self.maximumLateness = 0;
+
+    _slot = 0;
+    _cycleStart = time;
+    _lastTime = time;
+    _timerDriven = NO;
+
+    [self advertiseSlotWithLateness:0];
+
+    return YES;
+}
+
+- (void)stop
+{
+    if (!self.running)
+    {
+        return;
+    }
+
+    [self.timer invalidate];
+    self.timer = nil;
+
+    [self.advertiser stopAdvertising];
+
+    self.currentIdentity = nil;
+    self.running = NO;
+}
+
+- (void)scheduleNextSwitch
+{
+    NSDate *fireDate = [NSDate dateWithTimeIntervalSinceReferenceDate:_cycleStart + _slotOffsets[_slot + 1]];
+
+    // Timer retains the scheduler until stop is called.
+    self.timer = [[NSTimer alloc] initWithFireDate:fireDate
+                                          interval:0
+                                            target:self
+                                          selector:@selector(switchTimerFired:)
+                                          userInfo:nil
+                                           repeats:NO];
+    self.timer.tolerance = 0;
+
+    [[NSRunLoop mainRunLoop] addTimer:self.timer forMode:NSRunLoopCommonModes];
+}
+
+- (CFAbsoluteTime)nextSwitchTime
+{
+    return self.running ? _cycleStart + _slotOffsets[_slot + 1] : 0;
+}
+
+- (void)switchTimerFired:(NSTimer *)timer
+{
+    [self advanceToTime:CFAbsoluteTimeGetCurrent()];
+    [self scheduleNextSwitch];
+}
+
+- (void)advanceToTime:(CFAbsoluteTime)now
+{
+    if (!self.running)
+    {
+        return;
+    }
+
+    _lastTime = MAX(_lastTime, now);
+
+    if (now < _cycleStart + _slotOffsets[_slot + 1])
+    {
+        return;
+    }
+
+    // Skip slots that already ended, e.g. after the app was suspended.
+    do
+    {
+        _slot++;
+
+        if (_slot == _slotCount)
+        {
+            _slot = 0;
+            _cycleStart += _slotOffsets[_slotCount];
+        }
+    }
+    while (_cycleStart + _slotOffsets[_slot + 1] <= now);
+
+    [self advertiseSlotWithLateness:now - (_cycleStart + _slotOffsets[_slot])];
+}
+
+- (void)advertiseSlotWithLateness:(NSTimeInterval)lateness
+{
+    ESTAdvertisedIdentity *identity = self.identities[_slotIdentities[_slot]];
+
+    self.maximumLateness = MAX(self.maximumLateness, lateness);
+
+    // Consecutive slots of the same identity keep the radio running.
+    if (identity == self.currentIdentity)
+    {
+        return;
+    }
+
+    self.currentIdentity = identity;
+    [self.advertiser startAdvertisingIdentity:identity];
+
+    if ([self.delegate respondsToSelector:@selector(advertisingScheduler:didStartAdvertisingIdentity:lateness:)])
+    {
+        [self.delegate advertisingScheduler:self didStartAdvertisingIdentity:identity lateness:lateness];
+    }
+}
+
+@end
@@ -8,27 +8,32 @@
 
 #import "ESTAppDelegate.h"
 #import "ESTViewController.h"
+#import "ESTLaunchCoordinator.h"
 #import <EstimoteSDK/EstimoteSDK.h>
 
 @implementation ESTAppDelegate
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions
 {
+    ESTLaunchCoordinator *launchCoordinator = [ESTLaunchCoordinator sharedCoordinator];
+    
     // App ID and App Token should be provided using method below
     // to allow beacons connection and Estimote Cloud requests possible.
     // Both values can be found in Estimote Cloud ( http://cloud.estimote.com )
     // in Account Settings tab.
     
     NSLog(@"ESTAppDelegate: APP ID and APP TOKEN are required to connect to your beacons and make Estimote API calls.");
-    [ESTCloudManager setupAppID:nil andAppToken:nil];
+    [launchCoordinator setupAppID:nil andAppToken:nil];
     
     // Estimote Analytics allows you to log activity related to monitoring mechanism.
     // At the current stage it is possible to log all enter/exit events when monitoring
     // Particular beacons (Proximity UUID, Major, Minor values needs to be provided).
     
     NSLog(@"ESTAppDelegate: Analytics are turned OFF by defaults. You can enable them changing flag");
-    [ESTCloudManager enableMonitoringAnalytics:NO];
-    [ESTCloudManager enableGPSPositioningForAnalytics:NO];
+    [launchCoordinator addTaskForStage:ESTLaunchStageAfterFirstFrame block:^{
+        [ESTCloudManager enableMonitoringAnalytics:NO];
+        [ESTCloudManager enableGPSPositioningForAnalytics:NO];
+    }];
     
     self.window = [[UIWindow alloc] initWithFrame:[[UIScreen mainScreen] bounds]];
     
@@ -60,6 +65,8 @@
         [[UIApplication sharedApplication] registerForRemoteNotificationTypes: UIRemoteNotificationTypeNone];
     }
     
+    [launchCoordinator launch];
+    
     return YES;
 }
 
@@ -0,0 +1,121 @@
+//
+//  ESTAssetLocationIndex.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+#import "ESTHDRHistogram.h"
+
+/*
+ * Sighting of an asset (nearable) by an observer (gateway, phone).
+ */
+typedef struct
+{
+    uint64_t asset;
+    uint64_t observer;
+    NSTimeInterval timestamp;
+    int8_t rssi;
+} ESTAssetObservation;
+
+@class ESTAssetLocationIndex;
+
+@protocol ESTAssetLocationIndexDelegate <NSObject>
+
+@optional
+
+/*
+ * Room 0 means the asset was unknown before, or expired.
+ */
+- (void)assetIndex:(ESTAssetLocationIndex *)index didMoveAsset:(uint64_t)asset fromRoom:(uint64_t)fromRoom toRoom:(uint64_t)toRoom;
+
+@end
+
+/*
+ * Always current "asset -> room" and "room -> assets" mapping built from nearable
+ * sightings of many observers, each assigned to a room.
+ *
+ * Every asset keeps decayed evidence for a few candidate rooms, a sighting adds
+ * evidence growing with RSSI to the room of its observer. The strongest room wins,
+ * confidence is its share of the evidence. An assigned asset moves only after another
+ * room leads by switchMargin for dwellTime, so an asset near a wall does not flap.
+ *
+ * Rooms keep dense lists of their assets and assets their position in the list, so
+ * a move is O(1) and a room query is O(result). Assets, observers and rooms are
+ * nonzero 64-bit identity hashes, room 0 means unknown.
+ */
+@interface ESTAssetLocationIndex : NSObject
+
+@property (nonatomic, weak) id <ESTAssetLocationIndexDelegate> delegate;
+
+/*
+ * Time constant of evidence decay. Default 60 s.
+ */
+@property (nonatomic, assign) NSTimeInterval timeConstant;
+
+/*
+ * Confidence lead another room needs to take the asset. Default 0.2.
+ */
+@property (nonatomic, assign) double switchMargin;
+
+/*
+ * Time the lead has to hold. Default 10 s.
+ */
+@property (nonatomic, assign) NSTimeInterval dwellTime;
+
+@property (nonatomic, assign, readonly) NSUInteger assetCount;
+@property (nonatomic, assign, readonly) NSUInteger observerCount;
+@property (nonatomic, assign, readonly) uint64_t observationCount;
+
+/*
+ * Observations from unregistered observers.
+ */
+@property (nonatomic, assign, readonly) uint64_t droppedObservationCount;
+
+/*
+ * Per observation time of addObservations:count: in ns.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *updateTime;
+
+/*
+ * Time of enumerateAssetsInRoom:usingBlock: in ns.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *queryTime;
+
+- (void)setRoom:(uint64_t)room forObserver:(uint64_t)observer;
+- (void)removeObserver:(uint64_t)observer;
+
+- (void)addObservation:(ESTAssetObservation)observation;
+- (void)addObservations:(const ESTAssetObservation *)observations count:(NSUInteger)count;
+
+/*
+ * ESTNearable objects seen by the observer, hashed by identifier.
+ */
+- (void)addNearables:(NSArray *)nearables observer:(uint64_t)observer timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * Removes assets not seen for longer than timeout, their rooms become unknown.
+ */
+- (NSUInteger)expireAssetsIdleForTimeout:(NSTimeInterval)timeout atTime:(NSTimeInterval)time;
+
+/*
+ * Resolved room or 0, confidence is optional.
+ */
+- (uint64_t)roomOfAsset:(uint64_t)asset confidence:(double *)confidence;
+
+- (NSUInteger)assetCountInRoom:(uint64_t)room;
+
+/*
+ * The index must not be modified from the block.
+ */
+- (void)enumerateAssetsInRoom:(uint64_t)room usingBlock:(void (^)(uint64_t asset, double confidence, BOOL *stop))block;
+
+/*
+ * Assets (NSNumber) in the room.
+ */
+- (NSArray *)assetsInRoom:(uint64_t)room;
+
+@end
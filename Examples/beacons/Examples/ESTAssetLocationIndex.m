@@ -0,0 +1,478 @@
+//
+//  ESTAssetLocationIndex.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTAssetLocationIndex.h"
+#import "ESTSketchHash.h"
+#import "ESTStructTable.h"
+#import <mach/mach_time.h>
+
+#define EST_ASSET_CANDIDATES    4
+#define EST_ASSET_RSSI_FLOOR    -100.0
+
+typedef struct
+{
+    uint64_t room;
+    float evidence;
+} ESTAssetCandidate;
+
+typedef struct
+{
+    uint64_t identityHash;
+    uint64_t room;
+    uint64_t leader;
+    NSTimeInterval lastSeen;
+    NSTimeInterval leadSince;
+    float confidence;
+    uint32_t slot;
+    ESTAssetCandidate candidates[EST_ASSET_CANDIDATES];
+} ESTAsset;
+
+typedef struct
+{
+    uint32_t index;
+} ESTAssetEntry;
+
+typedef struct
+{
+    uint64_t room;
+} ESTObserverEntry;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t *assets;
+} ESTAssetRoom;
+
+typedef struct
+{
+    uint64_t asset;
+    uint64_t fromRoom;
+} ESTAssetMove;
+
+/*
+ * Linear amplitude relative to the floor, a sighting 20 dB stronger counts ten times more.
+ */
+static float ESTAssetEvidence(int8_t rssi)
+{
+    return (float)pow(10.0, (MAX(rssi, EST_ASSET_RSSI_FLOOR) - EST_ASSET_RSSI_FLOOR) / 20.0);
+}
+
+@interface ESTAssetLocationIndex ()
+
+@property (nonatomic, assign, readwrite) uint64_t observationCount;
+@property (nonatomic, assign, readwrite) uint64_t droppedObservationCount;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *updateTime;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *queryTime;
+
+@property (nonatomic, strong) ESTStructTable *assetEntries;
+@property (nonatomic, strong) ESTStructTable *observers;
+@property (nonatomic, strong) ESTStructTable *rooms;
+
+@end
+
+@implementation ESTAssetLocationIndex
+{
+    ESTAsset *_assets;
+    NSUInteger _assetCount;
+    NSUInteger _assetCapacity;
+    mach_timebase_info_data_t _timebase;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.timeConstant = 60;
+        self.switchMargin = 0.2;
+        self.dwellTime = 10;
+
+        self.assetEntries = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTAssetEntry) capacity:1024];
+        self.observers = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTObserverEntry) capacity:64];
+        self.rooms = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTAssetRoom) capacity:64];
+
+        // 1 ns ... 10 s.
+        self.updateTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:10000000000ULL significantBits:7];
+        self.queryTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:10000000000ULL significantBits:7];
+
+        mach_timebase_info(&_timebase);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self.rooms enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+        free(((ESTAssetRoom *)value)->assets);
+    }];
+
+    free(_assets);
+}
+
+- (NSUInteger)assetCount
+{
+    return _assetCount;
+}
+
+- (NSUInteger)observerCount
+{
+    return self.observers.count;
+}
+
+#pragma mark - Observers
+
+- (void)setRoom:(uint64_t)room forObserver:(uint64_t)observer
+{
+    ESTObserverEntry *entry = [self.observers insertValueForKey:observer created:NULL];
+    entry->room = room;
+}
+
+- (void)removeObserver:(uint64_t)observer
+{
+    [self.observers removeValueForKey:observer];
+}
+
+#pragma mark - Rooms
+
+- (void)removeAssetAtIndex:(uint32_t)index fromRoom:(uint64_t)room
+{
+    ESTAssetRoom *list = [self.rooms valueForKey:room];
+
+    if (!list)
+    {
+        return;
+    }
+
+    uint32_t slot = _assets[index].slot;
+    uint32_t last = list->assets[--list->count];
+
+    list->assets[slot] = last;
+    _assets[last].slot = slot;
+}
+
+- (void)addAssetAtIndex:(uint32_t)index toRoom:(uint64_t)room
+{
+    ESTAssetRoom *list = [self.rooms insertValueForKey:room created:NULL];
+
+    if (list->count == list->capacity)
+    {
+        list->capacity = MAX(list->capacity * 2, (uint32_t)16);
+        list->assets = realloc(list->assets, list->capacity * sizeof(uint32_t));
+    }
+
+    _assets[index].slot = list->count;
+    list->assets[list->count++] = index;
+}
+
+- (void)moveAssetAtIndex:(uint32_t)index toRoom:(uint64_t)room
+{
+    uint64_t fromRoom = _assets[index].room;
+    uint64_t identityHash = _assets[index].identityHash;
+
+    if (fromRoom != 0)
+    {
+        [self removeAssetAtIndex:index fromRoom:fromRoom];
+    }
+
+    if (room != 0)
+    {
+        [self addAssetAtIndex:index toRoom:room];
+    }
+
+    _assets[index].room = room;
+    _assets[index].leader = 0;
+
+    if ([self.delegate respondsToSelector:@selector(assetIndex:didMoveAsset:fromRoom:toRoom:)])
+    {
+        [self.delegate assetIndex:self didMoveAsset:identityHash fromRoom:fromRoom toRoom:room];
+    }
+}
+
+#pragma mark - Observations
+
+- (uint32_t)indexOfAsset:(uint64_t)identityHash
+{
+    BOOL created;
+    ESTAssetEntry *entry = [self.assetEntries insertValueForKey:identityHash created:&created];
+
+    if (!created)
+    {
+        return entry->index;
+    }
+
+    if (_assetCount == _assetCapacity)
+    {
+        _assetCapacity = MAX(_assetCapacity * 2, (NSUInteger)1024);
+        _assets = realloc(_assets, _assetCapacity * sizeof(ESTAsset));
+    }
+
+    entry->index = (uint32_t)_assetCount;
+
+    ESTAsset *asset = &_assets[_assetCount++];
+    memset(asset, 0, sizeof(ESTAsset));
+    asset->identityHash = identityHash;
+
+    return entry->index;
+}
+
+- (void)addObservation:(ESTAssetObservation)observation
+{
+    ESTObserverEntry *observer = [self.observers valueForKey:observation.observer];
+
+    if (!observer || observer->room == 0)
+    {
+        self.droppedObservationCount++;
+        return;
+    }
+
+    self.observationCount++;
+
+    uint64_t room = observer->room;
+    uint32_t index = [self indexOfAsset:observation.asset];
+    ESTAsset *asset = &_assets[index];
+
+    NSTimeInterval elapsed = observation.timestamp - asset->lastSeen;
+    float decay = elapsed > 0 ? (float)exp(-elapsed / self.timeConstant) : 1.0f;
+
+    asset->lastSeen = MAX(asset->lastSeen, observation.timestamp);
+
+    ESTAssetCandidate *candidates = asset->candidates;
+    ESTAssetCandidate *target = NULL;
+    ESTAssetCandidate *weakest = &candidates[0];
+
+    for (int i = 0; i < EST_ASSET_CANDIDATES; i++)
+    {
+        candidates[i].evidence *= decay;
+
+        if (candidates[i].room == room)
+        {
+            target = &candidates[i];
+        }
+
+        if (candidates[i].evidence < weakest->evidence)
+        {
+            weakest = &candidates[i];
+        }
+    }
+
+    // The weakest candidate decayed the longest, recent evidence replaces it.
+    if (!target)
+    {
+        target = weakest;
+        target->room = room;
+        target->evidence = 0;
+    }
+
+    target->evidence += ESTAssetEvidence(observation.rssi);
+
+    float total = 0;
+    float current = 0;
+    const ESTAssetCandidate *best = &candidates[0];
+
+    for (int i = 0; i < EST_ASSET_CANDIDATES; i++)
+    {
+        total += candidates[i].evidence;
+
+        if (candidates[i].room == asset->room)
+        {
+            current = candidates[i].evidence;
+        }
+
+        if (candidates[i].evidence > best->evidence)
+        {
+            best = &candidates[i];
+        }
+    }
+
+    uint64_t bestRoom = best->room;
+    float bestEvidence = best->evidence;
+
+    if (asset->room == 0)
+    {
+        asset->confidence = bestEvidence / total;
+        [self moveAssetAtIndex:index toRoom:bestRoom];
+        return;
+    }
+
+    asset->confidence = current / total;
+
+    if (bestRoom == asset->room || (bestEvidence - current) / total < self.switchMargin)
+    {
+        asset->leader = 0;
+        return;
+    }
+
+    if (asset->leader != bestRoom)
+    {
+        asset->leader = bestRoom;
+        asset->leadSince = observation.timestamp;
+    }
+
+    if (observation.timestamp - asset->leadSince >= self.dwellTime)
+    {
+        asset->confidence = bestEvidence / total;
+        [self moveAssetAtIndex:index toRoom:bestRoom];
+    }
+}
+
+- (void)addObservations:(const ESTAssetObservation *)observations count:(NSUInteger)count
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    uint64_t start = mach_absolute_time();
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [self addObservation:observations[i]];
+    }
+
+    uint64_t elapsed = (mach_absolute_time() - start) * _timebase.numer / _timebase.denom;
+
+    [self.updateTime recordValue:elapsed / count count:count];
+}
+
+- (void)addNearables:(NSArray *)nearables observer:(uint64_t)observer timestamp:(NSTimeInterval)timestamp
+{
+    NSMutableData *observations = [NSMutableData dataWithCapacity:nearables.count * sizeof(ESTAssetObservation)];
+
+    for (ESTNearable *nearable in nearables)
+    {
+        if (nearable.rssi >= 0)
+        {
+            continue;
+        }
+
+        ESTAssetObservation observation = {
+            ESTSketchHashString(nearable.identifier),
+            observer,
+            timestamp,
+            (int8_t)MAX(nearable.rssi, (NSInteger)INT8_MIN)
+        };
+
+        [observations appendBytes:&observation length:sizeof(observation)];
+    }
+
+    [self addObservations:observations.bytes count:observations.length / sizeof(ESTAssetObservation)];
+}
+
+- (NSUInteger)expireAssetsIdleForTimeout:(NSTimeInterval)timeout atTime:(NSTimeInterval)time
+{
+    NSMutableData *moves = [NSMutableData data];
+    NSUInteger expired = 0;
+    NSUInteger index = 0;
+
+    while (index < _assetCount)
+    {
+        if (time - _assets[index].lastSeen <= timeout)
+        {
+            index++;
+            continue;
+        }
+
+        uint32_t removed = (uint32_t)index;
+        uint64_t identityHash = _assets[removed].identityHash;
+
+        if (_assets[removed].room != 0)
+        {
+            [self removeAssetAtIndex:removed fromRoom:_assets[removed].room];
+
+            ESTAssetMove move = { identityHash, _assets[removed].room };
+            [moves appendBytes:&move length:sizeof(move)];
+        }
+
+        // Last asset takes the freed index, its entry and room slot follow.
+        uint32_t last = (uint32_t)(_assetCount - 1);
+
+        if (removed != last)
+        {
+            _assets[removed] = _assets[last];
+
+            ESTAssetEntry *entry = [self.assetEntries valueForKey:_assets[removed].identityHash];
+            entry->index = removed;
+
+            ESTAssetRoom *list = _assets[removed].room ? [self.rooms valueForKey:_assets[removed].room] : NULL;
+
+            if (list)
+            {
+                list->assets[_assets[removed].slot] = removed;
+            }
+        }
+
+        [self.assetEntries removeValueForKey:identityHash];
+        _assetCount--;
+        expired++;
+    }
+
+    // Delegate may feed observations, so it is notified once the table is consistent.
+    const ESTAssetMove *events = moves.bytes;
+
+    for (NSUInteger i = 0; i < moves.length / sizeof(ESTAssetMove); i++)
+    {
+        if ([self.delegate respondsToSelector:@selector(assetIndex:didMoveAsset:fromRoom:toRoom:)])
+        {
+            [self.delegate assetIndex:self didMoveAsset:events[i].asset fromRoom:events[i].fromRoom toRoom:0];
+        }
+    }
+
+    return expired;
+}
+
+#pragma mark - Queries
+
+- (uint64_t)roomOfAsset:(uint64_t)identityHash confidence:(double *)confidence
+{
+    ESTAssetEntry *entry = [self.assetEntries valueForKey:identityHash];
+    const ESTAsset *asset = entry ? &_assets[entry->index] : NULL;
+
+    if (confidence)
+    {
+        *confidence = asset ? asset->confidence : 0;
+    }
+
+    return asset ? asset->room : 0;
+}
+
+- (NSUInteger)assetCountInRoom:(uint64_t)room
+{
+    ESTAssetRoom *list = [self.rooms valueForKey:room];
+
+    return list ? list->count : 0;
+}
+
+- (void)enumerateAssetsInRoom:(uint64_t)room usingBlock:(void (^)(uint64_t asset, double confidence, BOOL *stop))block
+{
+    uint64_t start = mach_absolute_time();
+
+    ESTAssetRoom *list = [self.rooms valueForKey:room];
+    BOOL stop = NO;
+
+    for (uint32_t i = 0; list && i < list->count && !stop; i++)
+    {
+        const ESTAsset *asset = &_assets[list->assets[i]];
+        block(asset->identityHash, asset->confidence, &stop);
+    }
+
+    [self.queryTime recordValue:(mach_absolute_time() - start) * _timebase.numer / _timebase.denom];
+}
+
+- (NSArray *)assetsInRoom:(uint64_t)room
+{
+    NSMutableArray *assets = [NSMutableArray arrayWithCapacity:[self assetCountInRoom:room]];
+
+    [self enumerateAssetsInRoom:room usingBlock:^(uint64_t asset, double confidence, BOOL *stop) {
+        [assets addObject:@(asset)];
+    }];
+
+    return assets;
+}
+
+@end
@@ -0,0 +1,126 @@
+//
+//  ESTBeaconAnomalyDetector.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+typedef NS_ENUM(NSInteger, ESTBeaconAnomalyKind)
+{
+    /*
+     * Same identity advertised by two radios: conflicting MAC addresses
+     * or packet rate well above the known advertising interval.
+     */
+    ESTBeaconAnomalyKindCloneSuspected,
+
+    /*
+     * Persistent shift of RSSI at the observer location
+     * or loss of usually co-visible neighbor beacons.
+     */
+    ESTBeaconAnomalyKindMoved
+};
+
+@interface ESTBeaconAnomaly : NSObject
+
+@property (nonatomic, strong, readonly) NSString *identifier;
+@property (nonatomic, assign, readonly) ESTBeaconAnomalyKind kind;
+@property (nonatomic, strong, readonly) NSString *reason;
+
+/*
+ * Strength of the evidence, e.g. RSSI shift in standard deviations.
+ */
+@property (nonatomic, assign, readonly) double score;
+@property (nonatomic, assign, readonly) NSTimeInterval timestamp;
+
+@end
+
+@class ESTBeaconAnomalyDetector;
+
+@protocol ESTBeaconAnomalyDetectorDelegate <NSObject>
+
+- (void)anomalyDetector:(ESTBeaconAnomalyDetector *)detector didDetectAnomaly:(ESTBeaconAnomaly *)anomaly;
+
+@end
+
+/*
+ * Streaming spoofing / moved beacon detector working on the scan stream.
+ *
+ * For every identity it learns the expected RSSI distribution per observer location,
+ * the set of usually co-visible neighbors, the MAC address and (when fleet data is loaded)
+ * the advertising interval. Each frame costs O(1) work on compact per-device models held
+ * in flat tables, objects are allocated only for new identities and reported anomalies.
+ *
+ * Frames seen between beginScanWindow and endScanWindow are considered co-visible.
+ * Convenience methods for discovery callbacks treat each callback as a single window.
+ */
+@interface ESTBeaconAnomalyDetector : NSObject
+
+@property (nonatomic, weak) id <ESTBeaconAnomalyDetectorDelegate> delegate;
+
+/*
+ * Frames needed before an identity / location model is trusted. Default 20.
+ */
+@property (nonatomic, assign) NSUInteger warmupFrames;
+
+/*
+ * RSSI deviation, in standard deviations, counted as outlier. Default 3.
+ */
+@property (nonatomic, assign) double rssiThreshold;
+
+/*
+ * Consecutive outliers / isolated windows needed to report. Default 5.
+ */
+@property (nonatomic, assign) NSUInteger persistenceCount;
+
+/*
+ * Observed / expected packet interval ratio below which clone is reported. Default 0.6.
+ */
+@property (nonatomic, assign) double intervalRatioThreshold;
+
+/*
+ * Time two MAC addresses have to be seen together for the identity to be reported. Default 10 s.
+ */
+@property (nonatomic, assign) NSTimeInterval macConflictWindow;
+
+/*
+ * Minimum time between two reports for the same identity. Default 60 s.
+ */
+@property (nonatomic, assign) NSTimeInterval reportCooldown;
+
+/*
+ * Loads advertising intervals of fleet beacons (`ESTBeaconVO` from `ESTCloudManager`).
+ * Interval check is done only for identities with known interval and only on the raw
+ * frame entry point, because batched discovery callbacks do not expose packet timing.
+ */
+- (void)loadFleetBeacons:(NSArray *)beacons;
+- (void)setExpectedAdvertisingInterval:(NSTimeInterval)interval forIdentityHash:(uint64_t)identityHash;
+
+- (void)beginScanWindow;
+- (void)endScanWindow;
+
+/*
+ * Raw frame entry point, one call per received packet. identityHash is an ESTBeaconIdentity
+ * hash (or ESTFrame identityHash) so frames share models with fleet data and discovery
+ * callbacks, identifier names the identity in reports. macAddress may be nil.
+ */
+- (void)processFrameWithIdentityHash:(uint64_t)identityHash
+                          identifier:(NSString *)identifier
+                          macAddress:(NSString *)macAddress
+                                rssi:(NSInteger)rssi
+                            location:(NSString *)location
+                           timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * Discovery / ranging callbacks, each call is one scan window.
+ */
+- (void)processBluetoothBeacons:(NSArray *)beacons location:(NSString *)location;
+- (void)processEddystones:(NSArray *)eddystones location:(NSString *)location;
+- (void)processBeacons:(NSArray *)beacons location:(NSString *)location;
+
+- (void)reset;
+
+@end
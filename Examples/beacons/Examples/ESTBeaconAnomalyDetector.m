@@ -0,0 +1,662 @@
+//
+//  ESTBeaconAnomalyDetector.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTBeaconAnomalyDetector.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+
+#define EST_ANOMALY_NEIGHBORS           8
+#define EST_ANOMALY_MIN_RSSI_DEVIATION  2.0
+#define EST_ANOMALY_RSSI_ALPHA          0.02
+#define EST_ANOMALY_INTERVAL_ALPHA      0.1
+#define EST_ANOMALY_NEIGHBOR_ALPHA      0.1
+#define EST_ANOMALY_NEIGHBOR_INITIAL    0.25f
+#define EST_ANOMALY_NEIGHBOR_STRONG     0.5f
+#define EST_ANOMALY_NEIGHBOR_WEAK       0.2f
+#define EST_ANOMALY_MIN_NEIGHBORS       3
+
+/*
+ * Per identity model, ~190 bytes.
+ */
+typedef struct
+{
+    uint64_t macHash;
+    uint64_t otherMacHash;
+    NSTimeInterval lastSeen;
+    NSTimeInterval lastPacket;
+    NSTimeInterval macSeen;
+    NSTimeInterval otherMacSeen;
+    NSTimeInterval otherMacFirstSeen;
+    NSTimeInterval lastReport;
+    double expectedInterval;
+    double intervalMean;
+    uint32_t frames;
+    uint32_t isolatedWindows;
+
+    // Windows in which a new neighbor was offered, rotates the offered window member.
+    uint32_t neighborOffers;
+    uint64_t neighbors[EST_ANOMALY_NEIGHBORS];
+    float neighborScores[EST_ANOMALY_NEIGHBORS];
+} ESTBeaconModel;
+
+/*
+ * Per identity and observer location RSSI model.
+ */
+typedef struct
+{
+    double mean;
+    double variance;
+    double shiftedMean;
+    uint32_t count;
+    uint32_t outlierStreak;
+} ESTRSSIModel;
+
+#pragma mark - Anomaly
+
+@interface ESTBeaconAnomaly ()
+
+@property (nonatomic, strong, readwrite) NSString *identifier;
+@property (nonatomic, assign, readwrite) ESTBeaconAnomalyKind kind;
+@property (nonatomic, strong, readwrite) NSString *reason;
+@property (nonatomic, assign, readwrite) double score;
+@property (nonatomic, assign, readwrite) NSTimeInterval timestamp;
+
+@end
+
+@implementation ESTBeaconAnomaly
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %@ %@ (%@, score %.2f)>",
+            NSStringFromClass([self class]),
+            self.identifier,
+            self.kind == ESTBeaconAnomalyKindCloneSuspected ? @"clone suspected" : @"moved",
+            self.reason,
+            self.score];
+}
+
+@end
+
+#pragma mark - Detector
+
+@interface ESTBeaconAnomalyDetector ()
+
+@property (nonatomic, strong) ESTStructTable *beaconModels;
+@property (nonatomic, strong) ESTStructTable *rssiModels;
+@property (nonatomic, strong) ESTStructTable *expectedIntervals;
+@property (nonatomic, strong) NSMutableDictionary *identifiers;
+
+@end
+
+@implementation ESTBeaconAnomalyDetector
+{
+    uint64_t *_window;
+    NSUInteger _windowCount;
+    NSUInteger _windowCapacity;
+    BOOL _windowOpen;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.warmupFrames = 20;
+        self.rssiThreshold = 3.0;
+        self.persistenceCount = 5;
+        self.intervalRatioThreshold = 0.6;
+        self.macConflictWindow = 10;
+        self.reportCooldown = 60;
+
+        self.beaconModels = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTBeaconModel) capacity:256];
+        self.rssiModels = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTRSSIModel) capacity:256];
+        self.expectedIntervals = [[ESTStructTable alloc] initWithValueSize:sizeof(double) capacity:256];
+        self.identifiers = [NSMutableDictionary dictionary];
+
+        _windowCapacity = 256;
+        _window = malloc(_windowCapacity * sizeof(uint64_t));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_window);
+}
+
+- (void)reset
+{
+    [self.beaconModels removeAllValues];
+    [self.rssiModels removeAllValues];
+    [self.identifiers removeAllObjects];
+
+    _windowCount = 0;
+    _windowOpen = NO;
+}
+
+#pragma mark - Fleet data
+
+- (void)loadFleetBeacons:(NSArray *)beacons
+{
+    for (ESTBeaconVO *beacon in beacons)
+    {
+        if (beacon.advInterval <= 0)
+        {
+            continue;
+        }
+
+        NSTimeInterval interval = beacon.advInterval / 1000.0;
+
+        [self setExpectedAdvertisingInterval:interval forIdentityHash:ESTBeaconIdentityHashBeaconVO(beacon, NO)];
+
+        if (beacon.broadcastingScheme != ESTBroadcastingSchemeEddystoneUID
+            && beacon.broadcastingScheme != ESTBroadcastingSchemeEddystoneURL)
+        {
+            [self setExpectedAdvertisingInterval:interval forIdentityHash:ESTBeaconIdentityHashBeaconVO(beacon, YES)];
+        }
+    }
+}
+
+- (void)setExpectedAdvertisingInterval:(NSTimeInterval)interval forIdentityHash:(uint64_t)identityHash
+{
+    double *expected = [self.expectedIntervals insertValueForKey:identityHash created:NULL];
+    *expected = interval;
+
+    ESTBeaconModel *model = [self.beaconModels valueForKey:identityHash];
+    if (model)
+    {
+        model->expectedInterval = interval;
+    }
+}
+
+#pragma mark - Scan windows
+
+- (void)beginScanWindow
+{
+    _windowCount = 0;
+    _windowOpen = YES;
+}
+
+- (void)appendToWindow:(uint64_t)identityHash
+{
+    if (_windowCount == _windowCapacity)
+    {
+        _windowCapacity *= 2;
+        _window = realloc(_window, _windowCapacity * sizeof(uint64_t));
+    }
+
+    _window[_windowCount++] = identityHash;
+}
+
+static int ESTCompareHashes(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static inline BOOL ESTWindowContains(const uint64_t *window, NSUInteger count, uint64_t hash)
+{
+    return bsearch(&hash, window, count, sizeof(uint64_t), ESTCompareHashes) != NULL;
+}
+
+- (void)endScanWindow
+{
+    if (!_windowOpen)
+    {
+        return;
+    }
+
+    _windowOpen = NO;
+
+    qsort(_window, _windowCount, sizeof(uint64_t), ESTCompareHashes);
+
+    // Deduplicate in place.
+    NSUInteger unique = 0;
+    for (NSUInteger i = 0; i < _windowCount; i++)
+    {
+        if (unique == 0 || _window[unique - 1] != _window[i])
+        {
+            _window[unique++] = _window[i];
+        }
+    }
+    _windowCount = unique;
+
+    for (NSUInteger i = 0; i < _windowCount; i++)
+    {
+        [self updateNeighborsOfIdentity:_window[i] windowIndex:i];
+    }
+}
+
+/*
+ * Co-visibility: scores of known neighbors decay towards "seen together" frequency.
+ * One new candidate is offered per identity and window, at an offset from it in the
+ * sorted window that advances every time, so a stable visible set offers each of its
+ * members in turn at O(1) cost per identity and window.
+ */
+- (void)updateNeighborsOfIdentity:(uint64_t)identityHash windowIndex:(NSUInteger)index
+{
+    ESTBeaconModel *model = [self.beaconModels valueForKey:identityHash];
+
+    if (!model)
+    {
+        return;
+    }
+
+    NSUInteger strong = 0;
+    NSUInteger strongPresent = 0;
+    NSInteger weakest = -1;
+    float weakestScore = 2.0f;
+
+    for (NSUInteger k = 0; k < EST_ANOMALY_NEIGHBORS; k++)
+    {
+        // Empty slots are always preferred for new candidates.
+        if (model->neighbors[k] == 0)
+        {
+            if (weakestScore >= 0)
+            {
+                weakest = (NSInteger)k;
+                weakestScore = -1.0f;
+            }
+            continue;
+        }
+
+        BOOL present = ESTWindowContains(_window, _windowCount, model->neighbors[k]);
+
+        if (model->neighborScores[k] >= EST_ANOMALY_NEIGHBOR_STRONG)
+        {
+            strong++;
+            strongPresent += present ? 1 : 0;
+        }
+
+        model->neighborScores[k] += (float)(EST_ANOMALY_NEIGHBOR_ALPHA * ((present ? 1.0 : 0.0) - model->neighborScores[k]));
+
+        if (model->neighborScores[k] < weakestScore)
+        {
+            weakest = (NSInteger)k;
+            weakestScore = model->neighborScores[k];
+        }
+    }
+
+    if (model->frames >= self.warmupFrames && strong >= EST_ANOMALY_MIN_NEIGHBORS && strongPresent == 0)
+    {
+        model->isolatedWindows++;
+    }
+    else
+    {
+        model->isolatedWindows = 0;
+    }
+
+    if (model->isolatedWindows >= self.persistenceCount)
+    {
+        model->isolatedWindows = 0;
+
+        [self reportIdentity:identityHash
+                       model:model
+                        kind:ESTBeaconAnomalyKindMoved
+                      reason:@"usual neighbors not visible"
+                       score:(double)strong
+                   timestamp:model->lastSeen];
+    }
+
+    if (_windowCount > 1 && weakest >= 0 && weakestScore < EST_ANOMALY_NEIGHBOR_WEAK)
+    {
+        NSUInteger offset = 1 + model->neighborOffers++ % (_windowCount - 1);
+        uint64_t candidate = _window[(index + offset) % _windowCount];
+        BOOL known = NO;
+
+        for (NSUInteger k = 0; k < EST_ANOMALY_NEIGHBORS; k++)
+        {
+            known = known || model->neighbors[k] == candidate;
+        }
+
+        if (!known)
+        {
+            model->neighbors[weakest] = candidate;
+            model->neighborScores[weakest] = EST_ANOMALY_NEIGHBOR_INITIAL;
+        }
+    }
+}
+
+#pragma mark - Frames
+
+/*
+ * ESTSketchHashString of the lowercase address, folded while reading the characters
+ * into a stack buffer, so no string is created per frame. 0 for nil.
+ */
+static uint64_t ESTAnomalyHashMacAddress(NSString *macAddress)
+{
+    if (!macAddress)
+    {
+        return 0;
+    }
+
+    unichar buffer[32];
+    NSUInteger length = macAddress.length;
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    for (NSUInteger offset = 0; offset < length; offset += 32)
+    {
+        NSUInteger count = MIN(length - offset, (NSUInteger)32);
+        [macAddress getCharacters:buffer range:NSMakeRange(offset, count)];
+
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            unichar c = buffer[i];
+            c = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+
+            h ^= (uint8_t)c;
+            h *= 0x100000001b3ULL;
+        }
+    }
+
+    return ESTSketchMix64(h);
+}
+
+- (void)processFrameWithIdentityHash:(uint64_t)identityHash
+                          identifier:(NSString *)identifier
+                          macAddress:(NSString *)macAddress
+                                rssi:(NSInteger)rssi
+                            location:(NSString *)location
+                           timestamp:(NSTimeInterval)timestamp
+{
+    [self processFrameWithIdentityHash:identityHash
+                            identifier:^NSString *{ return identifier; }
+                               macHash:ESTAnomalyHashMacAddress(macAddress)
+                                  rssi:rssi
+                          locationHash:ESTSketchHashString(location)
+                             timestamp:timestamp
+                             perPacket:YES];
+}
+
+- (void)processBluetoothBeacons:(NSArray *)beacons location:(NSString *)location
+{
+    uint64_t locationHash = ESTSketchHashString(location);
+
+    [self beginScanWindow];
+
+    for (ESTBluetoothBeacon *beacon in beacons)
+    {
+        NSTimeInterval timestamp = beacon.discoveryDate ? [beacon.discoveryDate timeIntervalSinceReferenceDate] : CFAbsoluteTimeGetCurrent();
+
+        [self processFrameWithIdentityHash:ESTBeaconIdentityHashBluetoothBeacon(beacon)
+                                identifier:^NSString *{ return [NSString stringWithFormat:@"%@:%@", beacon.major, beacon.minor]; }
+                                   macHash:ESTAnomalyHashMacAddress(beacon.macAddress)
+                                      rssi:beacon.rssi
+                              locationHash:locationHash
+                                 timestamp:timestamp
+                                 perPacket:NO];
+    }
+
+    [self endScanWindow];
+}
+
+- (void)processEddystones:(NSArray *)eddystones location:(NSString *)location
+{
+    uint64_t locationHash = ESTSketchHashString(location);
+
+    [self beginScanWindow];
+
+    for (ESTEddystone *eddystone in eddystones)
+    {
+        NSTimeInterval timestamp = eddystone.discoveryDate ? [eddystone.discoveryDate timeIntervalSinceReferenceDate] : CFAbsoluteTimeGetCurrent();
+
+        [self processFrameWithIdentityHash:ESTBeaconIdentityHashEddystoneDevice(eddystone)
+                                identifier:^NSString *{
+                                    return eddystone.namespaceID
+                                        ? [NSString stringWithFormat:@"%@:%@", eddystone.namespaceID, eddystone.instanceID]
+                                        : eddystone.url;
+                                }
+                                   macHash:ESTAnomalyHashMacAddress(eddystone.macAddress)
+                                      rssi:[eddystone.rssi integerValue]
+                              locationHash:locationHash
+                                 timestamp:timestamp
+                                 perPacket:NO];
+    }
+
+    [self endScanWindow];
+}
+
+- (void)processBeacons:(NSArray *)beacons location:(NSString *)location
+{
+    uint64_t locationHash = ESTSketchHashString(location);
+    NSTimeInterval timestamp = CFAbsoluteTimeGetCurrent();
+
+    [self beginScanWindow];
+
+    for (CLBeacon *beacon in beacons)
+    {
+        // CoreLocation reports 0 when beacon was not heard in the last ranging cycle.
+        if (beacon.rssi == 0)
+        {
+            continue;
+        }
+
+        [self processFrameWithIdentityHash:ESTBeaconIdentityHashCLBeacon(beacon)
+                                identifier:^NSString *{
+                                    return [NSString stringWithFormat:@"%@:%@:%@",
+                                            [beacon.proximityUUID UUIDString], beacon.major, beacon.minor];
+                                }
+                                   macHash:0
+                                      rssi:beacon.rssi
+                              locationHash:locationHash
+                                 timestamp:timestamp
+                                 perPacket:NO];
+    }
+
+    [self endScanWindow];
+}
+
+/*
+ * Identifier block is invoked only for identities seen for the first time,
+ * so steady state processing does not create strings. Only per packet frames
+ * carry inter-arrival times, batched callbacks would measure their own cadence.
+ */
+- (void)processFrameWithIdentityHash:(uint64_t)identityHash
+                          identifier:(NSString *(^)(void))identifier
+                             macHash:(uint64_t)macHash
+                                rssi:(NSInteger)rssi
+                        locationHash:(uint64_t)locationHash
+                           timestamp:(NSTimeInterval)timestamp
+                           perPacket:(BOOL)perPacket
+{
+    // Non-negative values, including 127, are RSSI reading errors.
+    if (rssi >= 0)
+    {
+        return;
+    }
+
+    BOOL created;
+    ESTBeaconModel *model = [self.beaconModels insertValueForKey:identityHash created:&created];
+
+    if (created)
+    {
+        NSString *name = identifier();
+        self.identifiers[@(identityHash)] = name ?: [NSString stringWithFormat:@"%016llx", (unsigned long long)identityHash];
+
+        double *expected = [self.expectedIntervals valueForKey:identityHash];
+        model->expectedInterval = expected ? *expected : 0;
+    }
+
+    if (_windowOpen)
+    {
+        [self appendToWindow:identityHash];
+    }
+
+    [self checkMacHash:macHash identity:identityHash model:model timestamp:timestamp];
+
+    if (perPacket)
+    {
+        [self checkIntervalOfIdentity:identityHash model:model timestamp:timestamp];
+        model->lastPacket = timestamp;
+    }
+
+    model->lastSeen = timestamp;
+    model->frames++;
+
+    // RSSI models live in a separate table, inserting there does not move the identity model.
+    [self checkRSSI:rssi identity:identityHash model:model locationHash:locationHash timestamp:timestamp];
+}
+
+- (void)checkMacHash:(uint64_t)macHash identity:(uint64_t)identityHash model:(ESTBeaconModel *)model timestamp:(NSTimeInterval)timestamp
+{
+    if (macHash == 0)
+    {
+        return;
+    }
+
+    if (model->macHash == 0 || model->macHash == macHash)
+    {
+        model->macHash = macHash;
+        model->macSeen = timestamp;
+        return;
+    }
+
+    if (model->otherMacHash != macHash)
+    {
+        model->otherMacHash = macHash;
+        model->otherMacFirstSeen = timestamp;
+    }
+    model->otherMacSeen = timestamp;
+
+    BOOL bothAlive = (timestamp - model->macSeen) < self.macConflictWindow;
+
+    if (bothAlive && (timestamp - model->otherMacFirstSeen) >= self.macConflictWindow)
+    {
+        [self reportIdentity:identityHash
+                       model:model
+                        kind:ESTBeaconAnomalyKindCloneSuspected
+                      reason:@"two MAC addresses advertise the same identity"
+                       score:timestamp - model->otherMacFirstSeen
+                   timestamp:timestamp];
+    }
+    else if (!bothAlive)
+    {
+        // Original radio is gone, new one took over the identity (e.g. replaced beacon).
+        model->macHash = macHash;
+        model->macSeen = timestamp;
+        model->otherMacHash = 0;
+    }
+}
+
+- (void)checkIntervalOfIdentity:(uint64_t)identityHash model:(ESTBeaconModel *)model timestamp:(NSTimeInterval)timestamp
+{
+    if (model->expectedInterval <= 0 || model->lastPacket <= 0)
+    {
+        return;
+    }
+
+    double interval = timestamp - model->lastPacket;
+
+    // Long gaps are packet loss or absence, not timing information.
+    if (interval <= 0 || interval > 10 * model->expectedInterval)
+    {
+        return;
+    }
+
+    model->intervalMean = model->intervalMean > 0
+        ? model->intervalMean + EST_ANOMALY_INTERVAL_ALPHA * (interval - model->intervalMean)
+        : interval;
+
+    if (model->frames >= self.warmupFrames
+        && model->intervalMean < self.intervalRatioThreshold * model->expectedInterval)
+    {
+        [self reportIdentity:identityHash
+                       model:model
+                        kind:ESTBeaconAnomalyKindCloneSuspected
+                      reason:@"packet rate above advertising interval"
+                       score:model->expectedInterval / model->intervalMean
+                   timestamp:timestamp];
+    }
+}
+
+- (void)checkRSSI:(NSInteger)rssi
+         identity:(uint64_t)identityHash
+            model:(ESTBeaconModel *)model
+     locationHash:(uint64_t)locationHash
+        timestamp:(NSTimeInterval)timestamp
+{
+    ESTRSSIModel *rssiModel = [self.rssiModels insertValueForKey:ESTSketchHashCombine(identityHash, locationHash)
+                                                         created:NULL];
+    double value = (double)rssi;
+
+    // Welford during warm-up, exponentially weighted afterwards to follow slow drift.
+    if (rssiModel->count < self.warmupFrames)
+    {
+        rssiModel->count++;
+        double delta = value - rssiModel->mean;
+        rssiModel->mean += delta / rssiModel->count;
+        rssiModel->variance += (delta * (value - rssiModel->mean) - rssiModel->variance) / rssiModel->count;
+        return;
+    }
+
+    double deviation = MAX(sqrt(rssiModel->variance), EST_ANOMALY_MIN_RSSI_DEVIATION);
+    double z = (value - rssiModel->mean) / deviation;
+
+    if (fabs(z) < self.rssiThreshold)
+    {
+        double delta = value - rssiModel->mean;
+        rssiModel->mean += EST_ANOMALY_RSSI_ALPHA * delta;
+        rssiModel->variance = (1.0 - EST_ANOMALY_RSSI_ALPHA) * (rssiModel->variance + EST_ANOMALY_RSSI_ALPHA * delta * delta);
+        rssiModel->outlierStreak = 0;
+        return;
+    }
+
+    rssiModel->shiftedMean = rssiModel->outlierStreak == 0
+        ? value
+        : rssiModel->shiftedMean + 0.3 * (value - rssiModel->shiftedMean);
+    rssiModel->outlierStreak++;
+
+    if (rssiModel->outlierStreak >= self.persistenceCount)
+    {
+        double score = fabs(rssiModel->shiftedMean - rssiModel->mean) / deviation;
+
+        // Rebase on the new level, so the same move is not reported again.
+        rssiModel->mean = rssiModel->shiftedMean;
+        rssiModel->outlierStreak = 0;
+
+        [self reportIdentity:identityHash
+                       model:model
+                        kind:ESTBeaconAnomalyKindMoved
+                      reason:@"persistent RSSI shift at observer location"
+                       score:score
+                   timestamp:timestamp];
+    }
+}
+
+#pragma mark - Reporting
+
+- (void)reportIdentity:(uint64_t)identityHash
+                 model:(ESTBeaconModel *)model
+                  kind:(ESTBeaconAnomalyKind)kind
+                reason:(NSString *)reason
+                 score:(double)score
+             timestamp:(NSTimeInterval)timestamp
+{
+    if (model->lastReport > 0 && timestamp - model->lastReport < self.reportCooldown)
+    {
+        return;
+    }
+
+    model->lastReport = timestamp;
+
+    ESTBeaconAnomaly *anomaly = [ESTBeaconAnomaly new];
+    anomaly.identifier = self.identifiers[@(identityHash)];
+    anomaly.kind = kind;
+    anomaly.reason = reason;
+    anomaly.score = score;
+    anomaly.timestamp = timestamp;
+
+    if ([self.delegate respondsToSelector:@selector(anomalyDetector:didDetectAnomaly:)])
+    {
+        [self.delegate anomalyDetector:self didDetectAnomaly:anomaly];
+    }
+}
+
+@end
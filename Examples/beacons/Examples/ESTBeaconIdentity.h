@@ -0,0 +1,92 @@
+//
+//  ESTBeaconIdentity.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+#import "ESTSketchHash.h"
+
+/*
+ * 64-bit identity hashes for advertised identities.
+ *
+ * iBeacon identity is hashed from raw UUID bytes and big endian major / minor,
+ * so ranging callbacks can be matched against fleet data without creating strings.
+ * `ESTBluetoothBeacon` does not carry Proximity UUID, use nil UUID for it and for
+ * fleet entries that should be matched by major / minor only.
+ */
+
+static inline uint64_t ESTBeaconIdentityHashIBeacon(NSUUID *proximityUUID, uint16_t major, uint16_t minor)
+{
+    uint8_t bytes[20] = { 0 };
+
+    if (proximityUUID)
+    {
+        [proximityUUID getUUIDBytes:bytes];
+    }
+
+    bytes[16] = (uint8_t)(major >> 8);
+    bytes[17] = (uint8_t)(major & 0xff);
+    bytes[18] = (uint8_t)(minor >> 8);
+    bytes[19] = (uint8_t)(minor & 0xff);
+
+    return ESTSketchHashBytes(bytes, sizeof(bytes));
+}
+
+static inline uint64_t ESTBeaconIdentityHashEddystone(NSString *namespaceID, NSString *instanceID)
+{
+    return ESTSketchHashCombine(ESTSketchHashString([namespaceID uppercaseString]),
+                                ESTSketchHashString([instanceID uppercaseString]));
+}
+
+static inline uint64_t ESTBeaconIdentityHashCLBeacon(CLBeacon *beacon)
+{
+    return ESTBeaconIdentityHashIBeacon(beacon.proximityUUID,
+                                        [beacon.major unsignedShortValue],
+                                        [beacon.minor unsignedShortValue]);
+}
+
+static inline uint64_t ESTBeaconIdentityHashBluetoothBeacon(ESTBluetoothBeacon *beacon)
+{
+    return ESTBeaconIdentityHashIBeacon(nil, [beacon.major unsignedShortValue], [beacon.minor unsignedShortValue]);
+}
+
+static inline uint64_t ESTBeaconIdentityHashEddystoneDevice(ESTEddystone *eddystone)
+{
+    if (eddystone.namespaceID)
+    {
+        return ESTBeaconIdentityHashEddystone(eddystone.namespaceID, eddystone.instanceID);
+    }
+
+    return ESTSketchHashString(eddystone.url);
+}
+
+/*
+ * Identity a fleet beacon is expected to advertise, according to its broadcasting scheme.
+ * Set matchMajorMinorOnly to match against `ESTBluetoothBeacon` discovery results.
+ */
+static inline uint64_t ESTBeaconIdentityHashBeaconVO(ESTBeaconVO *beacon, BOOL matchMajorMinorOnly)
+{
+    switch (beacon.broadcastingScheme)
+    {
+        case ESTBroadcastingSchemeEddystoneUID:
+            return ESTBeaconIdentityHashEddystone(beacon.eddystoneNamespaceID, beacon.eddystoneInstanceID);
+
+        case ESTBroadcastingSchemeEddystoneURL:
+            return ESTSketchHashString(beacon.eddystoneURL);
+
+        default:
+        {
+            NSUUID *uuid = nil;
+            if (!matchMajorMinorOnly && beacon.proximityUUID)
+            {
+                uuid = [[NSUUID alloc] initWithUUIDString:beacon.proximityUUID];
+            }
+
+            return ESTBeaconIdentityHashIBeacon(uuid, [beacon.major unsignedShortValue], [beacon.minor unsignedShortValue]);
+        }
+    }
+}
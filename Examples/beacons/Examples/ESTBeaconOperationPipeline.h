@@ -0,0 +1,156 @@
+//
+//  ESTBeaconOperationPipeline.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+#import "ESTFuture.h"
+#import "ESTHDRHistogram.h"
+
+/*
+ * Beacon settings reachable through the pipeline. Values are NSString for UUID,
+ * name and Eddystone fields, NSNumber otherwise (BOOL for the modes).
+ */
+typedef NS_ENUM(NSInteger, ESTBeaconSetting)
+{
+    ESTBeaconSettingProximityUUID,
+    ESTBeaconSettingMajor,
+    ESTBeaconSettingMinor,
+    ESTBeaconSettingAdvInterval,
+    ESTBeaconSettingPower,
+    ESTBeaconSettingName,
+    ESTBeaconSettingEddystoneNamespace,
+    ESTBeaconSettingEddystoneInstance,
+    ESTBeaconSettingEddystoneURL,
+    ESTBeaconSettingBasicPowerMode,
+    ESTBeaconSettingSmartPowerMode,
+    ESTBeaconSettingSecureUUID,
+    ESTBeaconSettingMotionDetection,
+
+    /*
+     * Read only.
+     */
+    ESTBeaconSettingTemperature
+};
+
+/*
+ * Executes single reads and writes, completions on the main queue.
+ */
+@protocol ESTBeaconOperationBackend <NSObject>
+
+- (void)readSetting:(ESTBeaconSetting)setting completion:(ESTObjectCompletionBlock)completion;
+- (void)writeSetting:(ESTBeaconSetting)setting value:(id)value completion:(ESTObjectCompletionBlock)completion;
+
+@end
+
+/*
+ * Backend of a connected ESTBeaconConnection. Reads other than temperature come
+ * from the values the connection read when it connected.
+ */
+@interface ESTBeaconConnectionBackend : NSObject <ESTBeaconOperationBackend>
+
+@property (nonatomic, strong, readonly) ESTBeaconConnection *connection;
+
+- (instancetype)initWithConnection:(ESTBeaconConnection *)connection;
+
+@end
+
+/*
+ * In-memory GATT link for measuring recipes without hardware. Requests leave one
+ * per transmitTime, each response arrives latency later, so pipelined requests
+ * overlap their round trips while serialized ones pay each in full.
+ */
+@interface ESTMockBeaconBackend : NSObject <ESTBeaconOperationBackend>
+
+/*
+ * Default 7.5 ms, the minimal BLE connection interval.
+ */
+@property (nonatomic, assign) NSTimeInterval transmitTime;
+
+/*
+ * Default 100 ms.
+ */
+@property (nonatomic, assign) NSTimeInterval latency;
+
+/*
+ * Probability an operation fails. Default 0.
+ */
+@property (nonatomic, assign) double failureRate;
+
+/*
+ * Current setting values (NSNumber of ESTBeaconSetting -> value).
+ */
+@property (nonatomic, strong, readonly) NSMutableDictionary *settings;
+
+@end
+
+/*
+ * Operation graph over a beacon connection. Reads and writes return futures and are
+ * issued as soon as their dependencies are fulfilled, up to maxInFlight back-to-back
+ * on the link, instead of nesting every completion in the previous one:
+ *
+ *   ESTFuture *uuid = [pipeline writeSetting:ESTBeaconSettingProximityUUID value:uuidString];
+ *   [pipeline writeSetting:ESTBeaconSettingMajor value:@(1) after:@[ uuid ]];
+ *   [pipeline writeSetting:ESTBeaconSettingMinor value:@(2) after:@[ uuid ]];
+ *   [[pipeline completion] whenComplete:^(id value, NSError *error) { ... }];
+ *
+ * An operation whose dependency fails is rejected with ESTFutureErrorDependencyFailed
+ * without running. Operations time out with ESTFutureErrorTimeout, cancelling a
+ * future drops the operation if it has not started yet.
+ */
+@interface ESTBeaconOperationPipeline : NSObject
+
+@property (nonatomic, strong, readonly) id <ESTBeaconOperationBackend> backend;
+
+/*
+ * Operations issued without waiting for each other. Default 4, 1 serializes.
+ * A slot is held until the backend completes, even after a timeout or cancel.
+ */
+@property (nonatomic, assign) NSUInteger maxInFlight;
+
+/*
+ * Default 10 s.
+ */
+@property (nonatomic, assign) NSTimeInterval defaultTimeout;
+
+@property (nonatomic, assign, readonly) NSUInteger pendingCount;
+@property (nonatomic, assign, readonly) NSUInteger inFlightCount;
+
+/*
+ * Time from issue to completion in ms.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *operationTime;
+
+- (instancetype)initWithBackend:(id <ESTBeaconOperationBackend>)backend;
+- (instancetype)initWithConnection:(ESTBeaconConnection *)connection;
+
+- (ESTFuture *)readSetting:(ESTBeaconSetting)setting;
+- (ESTFuture *)readSetting:(ESTBeaconSetting)setting after:(NSArray *)dependencies;
+
+- (ESTFuture *)writeSetting:(ESTBeaconSetting)setting value:(id)value;
+- (ESTFuture *)writeSetting:(ESTBeaconSetting)setting value:(id)value after:(NSArray *)dependencies;
+
+/*
+ * Dependencies are ESTFuture objects, from this pipeline or elsewhere.
+ */
+- (ESTFuture *)writeSetting:(ESTBeaconSetting)setting
+                      value:(id)value
+                      after:(NSArray *)dependencies
+                    timeout:(NSTimeInterval)timeout;
+
+/*
+ * Fulfilled once every operation added so far is, rejected with the first error.
+ */
+- (ESTFuture *)completion;
+
+/*
+ * Cancels every unfinished operation. Started operations keep their slot until
+ * the backend completes them.
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,530 @@
+//
+//  ESTBeaconOperationPipeline.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTBeaconOperationPipeline.h"
+
+static NSError *ESTBeaconOperationError(ESTFutureError code, NSError *underlyingError)
+{
+    NSDictionary *userInfo = underlyingError ? @{ NSUnderlyingErrorKey : underlyingError } : nil;
+
+    return [NSError errorWithDomain:ESTFutureErrorDomain code:code userInfo:userInfo];
+}
+
+#pragma mark - ESTBeaconConnectionBackend
+
+@interface ESTBeaconConnectionBackend ()
+
+@property (nonatomic, strong, readwrite) ESTBeaconConnection *connection;
+
+@end
+
+@implementation ESTBeaconConnectionBackend
+
+- (instancetype)initWithConnection:(ESTBeaconConnection *)connection
+{
+    self = [super init];
+    if (self)
+    {
+        self.connection = connection;
+    }
+    return self;
+}
+
+- (void)readSetting:(ESTBeaconSetting)setting completion:(ESTObjectCompletionBlock)completion
+{
+    ESTBeaconConnection *connection = self.connection;
+    id value = nil;
+
+    switch (setting)
+    {
+        case ESTBeaconSettingTemperature:
+            [connection readTemperatureWithCompletion:^(NSNumber *temperature, NSError *error) {
+                completion(temperature, error);
+            }];
+            return;
+
+        case ESTBeaconSettingProximityUUID:
+            value = connection.proximityUUID.UUIDString;
+            break;
+
+        case ESTBeaconSettingMajor:
+            value = connection.major;
+            break;
+
+        case ESTBeaconSettingMinor:
+            value = connection.minor;
+            break;
+
+        case ESTBeaconSettingAdvInterval:
+            value = connection.advInterval;
+            break;
+
+        case ESTBeaconSettingPower:
+            value = connection.power;
+            break;
+
+        case ESTBeaconSettingName:
+            value = connection.name;
+            break;
+
+        case ESTBeaconSettingEddystoneNamespace:
+            value = connection.eddystoneNamespace;
+            break;
+
+        case ESTBeaconSettingEddystoneInstance:
+            value = connection.eddystoneInstance;
+            break;
+
+        case ESTBeaconSettingEddystoneURL:
+            value = connection.eddystoneURL;
+            break;
+
+        case ESTBeaconSettingBasicPowerMode:
+            value = @(connection.basicPowerMode == ESTBeaconPowerSavingModeOn);
+            break;
+
+        case ESTBeaconSettingSmartPowerMode:
+            value = @(connection.smartPowerMode == ESTBeaconPowerSavingModeOn);
+            break;
+
+        case ESTBeaconSettingSecureUUID:
+            value = @(connection.estimoteSecureUUIDState == ESTBeaconEstimoteSecureUUIDOn);
+            break;
+
+        case ESTBeaconSettingMotionDetection:
+            value = @(connection.motionDetectionState == ESTBeaconMotionDetectionOn);
+            break;
+    }
+
+    // Cached values complete asynchronously as well, like every other operation.
+    dispatch_async(dispatch_get_main_queue(), ^{
+        completion(value, nil);
+    });
+}
+
+- (void)writeSetting:(ESTBeaconSetting)setting value:(id)value completion:(ESTObjectCompletionBlock)completion
+{
+    ESTBeaconConnection *connection = self.connection;
+
+    ESTStringCompletionBlock stringCompletion = ^(NSString *written, NSError *error) {
+        completion(written, error);
+    };
+
+    ESTUnsignedShortCompletionBlock shortCompletion = ^(unsigned short written, NSError *error) {
+        completion(error ? nil : @(written), error);
+    };
+
+    ESTBoolCompletionBlock boolCompletion = ^(BOOL written, NSError *error) {
+        completion(error ? nil : @(written), error);
+    };
+
+    switch (setting)
+    {
+        case ESTBeaconSettingProximityUUID:
+            [connection writeProximityUUID:value completion:stringCompletion];
+            break;
+
+        case ESTBeaconSettingMajor:
+            [connection writeMajor:[value unsignedShortValue] completion:shortCompletion];
+            break;
+
+        case ESTBeaconSettingMinor:
+            [connection writeMinor:[value unsignedShortValue] completion:shortCompletion];
+            break;
+
+        case ESTBeaconSettingAdvInterval:
+            [connection writeAdvInterval:[value unsignedShortValue] completion:shortCompletion];
+            break;
+
+        case ESTBeaconSettingPower:
+            [connection writePower:(ESTBeaconPower)[value charValue] completion:^(ESTBeaconPower power, NSError *error) {
+                completion(error ? nil : @(power), error);
+            }];
+            break;
+
+        case ESTBeaconSettingName:
+            [connection writeName:value completion:stringCompletion];
+            break;
+
+        case ESTBeaconSettingEddystoneNamespace:
+            [connection writeEddystoneHexNamespace:value completion:stringCompletion];
+            break;
+
+        case ESTBeaconSettingEddystoneInstance:
+            [connection writeEddystoneInstance:value completion:stringCompletion];
+            break;
+
+        case ESTBeaconSettingEddystoneURL:
+            [connection writeEddystoneURL:value completion:stringCompletion];
+            break;
+
+        case ESTBeaconSettingBasicPowerMode:
+            [connection writeBasicPowerModeEnabled:[value boolValue] completion:boolCompletion];
+            break;
+
+        case ESTBeaconSettingSmartPowerMode:
+            [connection writeSmartPowerModeEnabled:[value boolValue] completion:boolCompletion];
+            break;
+
+        case ESTBeaconSettingSecureUUID:
+            [connection writeEstimoteSecureUUIDEnabled:[value boolValue] completion:boolCompletion];
+            break;
+
+        case ESTBeaconSettingMotionDetection:
+            [connection writeMotionDetectionEnabled:[value boolValue] completion:boolCompletion];
+            break;
+
+        case ESTBeaconSettingTemperature:
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(nil, [NSError errorWithDomain:NSCocoaErrorDomain code:NSFeatureUnsupportedError userInfo:nil]);
+            });
+            break;
+    }
+}
+
+@end
+
+#pragma mark - ESTMockBeaconBackend
+
+@interface ESTMockBeaconBackend ()
+
+@property (nonatomic, strong, readwrite) NSMutableDictionary *settings;
+
+@end
+
+@implementation ESTMockBeaconBackend
+{
+    NSTimeInterval _linkFreeTime;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.transmitTime = 0.0075;
+        self.latency = 0.1;
+        self.settings = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)completeWithValue:(id)value setting:(ESTBeaconSetting)setting write:(BOOL)write completion:(ESTObjectCompletionBlock)completion
+{
+    NSTimeInterval now = CFAbsoluteTimeGetCurrent();
+
+    // Requests queue on the link, responses overlap.
+    _linkFreeTime = MAX(now, _linkFreeTime) + self.transmitTime;
+    NSTimeInterval delay = _linkFreeTime + self.latency - now;
+
+    BOOL fails = arc4random_uniform(1000000) < self.failureRate * 1000000;
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+
+        if (fails)
+        {
+            completion(nil, [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteUnknownError userInfo:nil]);
+            return;
+        }
+
+        if (write)
+        {
+            self.settings[@(setting)] = value;
+        }
+
+        completion(write ? value : self.settings[@(setting)], nil);
+    });
+}
+
+- (void)readSetting:(ESTBeaconSetting)setting completion:(ESTObjectCompletionBlock)completion
+{
+    [self completeWithValue:nil setting:setting write:NO completion:completion];
+}
+
+- (void)writeSetting:(ESTBeaconSetting)setting value:(id)value completion:(ESTObjectCompletionBlock)completion
+{
+    [self completeWithValue:value setting:setting write:YES completion:completion];
+}
+
+@end
+
+#pragma mark - ESTBeaconOperationPipeline
+
+@interface ESTBeaconOperation : NSObject
+
+@property (nonatomic, assign) ESTBeaconSetting setting;
+@property (nonatomic, strong) id value;
+@property (nonatomic, assign) BOOL write;
+@property (nonatomic, strong) NSArray *dependencies;
+@property (nonatomic, assign) NSTimeInterval timeout;
+@property (nonatomic, strong) ESTFuture *future;
+@property (nonatomic, assign) NSTimeInterval startTime;
+@property (nonatomic, assign) BOOL finished;
+
+@end
+
+@implementation ESTBeaconOperation
+
+@end
+
+@interface ESTBeaconOperationPipeline ()
+
+@property (nonatomic, strong, readwrite) id <ESTBeaconOperationBackend> backend;
+@property (nonatomic, assign, readwrite) NSUInteger inFlightCount;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *operationTime;
+
+@property (nonatomic, strong) NSMutableArray *pending;
+@property (nonatomic, strong) NSMutableArray *futures;
+
+@end
+
+@implementation ESTBeaconOperationPipeline
+{
+    BOOL _pumping;
+    BOOL _pumpAgain;
+}
+
+- (instancetype)initWithConnection:(ESTBeaconConnection *)connection
+{
+    return [self initWithBackend:[[ESTBeaconConnectionBackend alloc] initWithConnection:connection]];
+}
+
+- (instancetype)initWithBackend:(id <ESTBeaconOperationBackend>)backend
+{
+    self = [super init];
+    if (self)
+    {
+        self.backend = backend;
+        self.maxInFlight = 4;
+        self.defaultTimeout = 10;
+
+        self.pending = [NSMutableArray array];
+        self.futures = [NSMutableArray array];
+
+        // 1 ms ... 1 hour.
+        self.operationTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:3600000 significantBits:7];
+    }
+    return self;
+}
+
+- (NSUInteger)pendingCount
+{
+    return self.pending.count;
+}
+
+#pragma mark - Operations
+
+- (ESTFuture *)readSetting:(ESTBeaconSetting)setting
+{
+    return [self readSetting:setting after:nil];
+}
+
+- (ESTFuture *)readSetting:(ESTBeaconSetting)setting after:(NSArray *)dependencies
+{
+    ESTBeaconOperation *operation = [ESTBeaconOperation new];
+    operation.setting = setting;
+    operation.dependencies = dependencies;
+    operation.timeout = self.defaultTimeout;
+
+    return [self addOperation:operation];
+}
+
+- (ESTFuture *)writeSetting:(ESTBeaconSetting)setting value:(id)value
+{
+    return [self writeSetting:setting value:value after:nil timeout:self.defaultTimeout];
+}
+
+- (ESTFuture *)writeSetting:(ESTBeaconSetting)setting value:(id)value after:(NSArray *)dependencies
+{
+    return [self writeSetting:setting value:value after:dependencies timeout:self.defaultTimeout];
+}
+
+- (ESTFuture *)writeSetting:(ESTBeaconSetting)setting
+                      value:(id)value
+                      after:(NSArray *)dependencies
+                    timeout:(NSTimeInterval)timeout
+{
+    ESTBeaconOperation *operation = [ESTBeaconOperation new];
+    operation.setting = setting;
+    operation.value = value;
+    operation.write = YES;
+    operation.dependencies = dependencies;
+    operation.timeout = timeout;
+
+    return [self addOperation:operation];
+}
+
+- (ESTFuture *)addOperation:(ESTBeaconOperation *)operation
+{
+    operation.future = [ESTFuture new];
+
+    [self.pending addObject:operation];
+    [self.futures addObject:operation.future];
+
+    __weak typeof(self) selfRef = self;
+
+    for (ESTFuture *dependency in operation.dependencies)
+    {
+        [dependency whenComplete:^(id value, NSError *error) {
+            [selfRef pump];
+        }];
+    }
+
+    // Cancelled before it started, or finished and freed a slot.
+    [operation.future whenComplete:^(id value, NSError *error) {
+        [selfRef pump];
+    }];
+
+    [self pump];
+
+    return operation.future;
+}
+
+- (ESTFuture *)completion
+{
+    return [ESTFuture all:[self.futures copy]];
+}
+
+- (void)cancel
+{
+    for (ESTFuture *future in [self.futures copy])
+    {
+        [future cancel];
+    }
+}
+
+#pragma mark - Scheduling
+
+/*
+ * Starts every pending operation whose dependencies are fulfilled while slots are
+ * free. Resolving futures calls back in, those calls only request another pass.
+ */
+- (void)pump
+{
+    if (_pumping)
+    {
+        _pumpAgain = YES;
+        return;
+    }
+
+    _pumping = YES;
+
+    do
+    {
+        _pumpAgain = NO;
+
+        for (ESTBeaconOperation *operation in [self.pending copy])
+        {
+            if (operation.future.resolved)
+            {
+                [self.pending removeObject:operation];
+                continue;
+            }
+
+            NSError *failure = nil;
+            BOOL waiting = NO;
+
+            for (ESTFuture *dependency in operation.dependencies)
+            {
+                waiting = waiting || !dependency.resolved;
+                failure = failure ?: dependency.error;
+            }
+
+            if (failure)
+            {
+                [self.pending removeObject:operation];
+                [operation.future rejectWithError:ESTBeaconOperationError(ESTFutureErrorDependencyFailed, failure)];
+                continue;
+            }
+
+            if (waiting || self.inFlightCount >= MAX(self.maxInFlight, (NSUInteger)1))
+            {
+                continue;
+            }
+
+            [self.pending removeObject:operation];
+            [self startOperation:operation];
+        }
+    }
+    while (_pumpAgain);
+
+    _pumping = NO;
+}
+
+- (void)startOperation:(ESTBeaconOperation *)operation
+{
+    self.inFlightCount++;
+    operation.startTime = CFAbsoluteTimeGetCurrent();
+
+    __weak typeof(self) selfRef = self;
+
+    ESTObjectCompletionBlock completion = ^(id value, NSError *error) {
+        [selfRef finishOperation:operation value:value error:error];
+    };
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(operation.timeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [selfRef timeOutOperation:operation];
+    });
+
+    if (operation.write)
+    {
+        [self.backend writeSetting:operation.setting value:operation.value completion:completion];
+    }
+    else
+    {
+        [self.backend readSetting:operation.setting completion:completion];
+    }
+}
+
+/*
+ * Rejects the future only. The request is still outstanding on the link, so the
+ * slot is kept until the backend completes, same as for a cancelled operation.
+ */
+- (void)timeOutOperation:(ESTBeaconOperation *)operation
+{
+    if (operation.finished)
+    {
+        return;
+    }
+
+    if ([operation.future rejectWithError:ESTBeaconOperationError(ESTFutureErrorTimeout, nil)])
+    {
+        // Dependents of the timed out operation fail now, not when the link frees up.
+        [self pump];
+    }
+}
+
+/*
+ * Backend completion, releases the slot. The result is dropped when the future
+ * already timed out or was cancelled.
+ */
+- (void)finishOperation:(ESTBeaconOperation *)operation value:(id)value error:(NSError *)error
+{
+    if (operation.finished)
+    {
+        return;
+    }
+
+    operation.finished = YES;
+    self.inFlightCount--;
+
+    [self.operationTime recordValue:(uint64_t)llround((CFAbsoluteTimeGetCurrent() - operation.startTime) * 1000)];
+
+    if (error)
+    {
+        [operation.future rejectWithError:error];
+    }
+    else
+    {
+        [operation.future fulfillWithValue:value];
+    }
+
+    [self pump];
+}
+
+@end
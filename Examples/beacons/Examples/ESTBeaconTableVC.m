@@ -8,6 +8,7 @@
 
 #import "ESTBeaconTableVC.h"
 #import "ESTViewController.h"
+#import "ESTLaunchCoordinator.h"
 
 @interface ESTBeaconTableVC () <ESTBeaconManagerDelegate, ESTUtilityManagerDelegate>
 
@@ -18,6 +19,7 @@
 @property (nonatomic, strong) ESTUtilityManager *utilityManager;
 @property (nonatomic, strong) CLBeaconRegion *region;
 @property (nonatomic, strong) NSArray *beaconsArray;
+@property (nonatomic, assign) BOOL rangedRegionsPersisted;
 
 @end
 
@@ -57,8 +59,7 @@
     self.title = @"Select beacon";
     [self.tableView registerClass:[ESTTableViewCell class] forCellReuseIdentifier:@"CellIdentifier"];
     
-    self.beaconManager = [[ESTBeaconManager alloc] init];
-    self.beaconManager.delegate = self;
+    self.beaconManager = [ESTLaunchCoordinator sharedCoordinator].beaconManager;
     
     self.utilityManager = [[ESTUtilityManager alloc] init];
     self.utilityManager.delegate = self;
@@ -68,6 +69,11 @@
 {
     [super viewDidAppear:animated];
     
+    /*
+     * Beacon manager is shared, screens pushed from here take over its delegate.
+     */
+    self.beaconManager.delegate = self;
+    self.rangedRegionsPersisted = NO;
     
     /* 
      * Creates sample region object (you can additionaly pass major / minor values).
@@ -167,6 +173,23 @@
 
 - (void)beaconManager:(id)manager didRangeBeacons:(NSArray *)beacons inRegion:(CLBeaconRegion *)region
 {
+    ESTLaunchCoordinator *launchCoordinator = [ESTLaunchCoordinator sharedCoordinator];
+    [launchCoordinator markFirstRangingCallback];
+    
+    /*
+     * Ranged regions are cached once per appearance, next launch restarts ranging from the cache.
+     */
+    if (!self.rangedRegionsPersisted)
+    {
+        [launchCoordinator persistRangedRegions:self.beaconManager.rangedRegions];
+        self.rangedRegionsPersisted = YES;
+    }
+    
+    if (![region.identifier isEqualToString:self.region.identifier])
+    {
+        return;
+    }
+    
     self.beaconsArray = beacons;
     
     [self.tableView reloadData];
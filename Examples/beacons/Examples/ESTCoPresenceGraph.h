@@ -0,0 +1,86 @@
+//
+//  ESTCoPresenceGraph.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+@interface ESTCoPresenceNeighbor : NSObject
+
+@property (nonatomic, assign, readonly) uint64_t identityHash;
+
+/*
+ * Decayed number of shared scan windows.
+ */
+@property (nonatomic, assign, readonly) double weight;
+
+@end
+
+/*
+ * Streaming co-presence of nearables and beacons: how often two devices are seen in
+ * the same scan window, with exponential time decay. Devices travelling together
+ * (a bag and a bike) or mounted together end up as strong neighbors, a beacon
+ * whose neighbors change is likely misplaced.
+ *
+ * The co-presence matrix is stored as sparse rows of sorted (neighbor, weight) arrays.
+ * A scan window merges its sorted device list into the row of every visible device,
+ * rows are independent so the merges run in parallel. Decay is global: weights are
+ * stored scaled by exp(t / tau) and rescaled rarely, when weak entries are dropped.
+ *
+ * Rows longer than 2 * maxNeighbors are pruned to the maxNeighbors strongest, each on
+ * its own, so the stored matrix is not symmetric: a busy device may drop a pair its
+ * neighbor still keeps, or keep it with a weight restarted after an earlier drop.
+ * Both rows receive the same increments while they hold the pair, so pair queries
+ * read both and take the larger weight. Top neighbor lists come from one row.
+ */
+@interface ESTCoPresenceGraph : NSObject
+
+@property (nonatomic, assign, readonly) NSTimeInterval halfLife;
+
+/*
+ * Neighbors kept per device. Default 256.
+ */
+@property (nonatomic, assign) NSUInteger maxNeighbors;
+
+/*
+ * Decayed weights below this are dropped on rescaling. Default 0.01.
+ */
+@property (nonatomic, assign) double minimumWeight;
+
+@property (nonatomic, assign, readonly) NSUInteger deviceCount;
+@property (nonatomic, assign, readonly) NSUInteger entryCount;
+
+/*
+ * Default half life is one day.
+ */
+- (instancetype)initWithHalfLife:(NSTimeInterval)halfLife;
+
+/*
+ * Devices seen together in one scan window, duplicates are ignored. Windows have
+ * to come in time order.
+ */
+- (void)addScanWindowWithIdentityHashes:(const uint64_t *)identityHashes
+                                  count:(NSUInteger)count
+                              timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * ESTNearable objects hashed by identifier and CLBeacon objects hashed with ESTBeaconIdentity.
+ */
+- (void)addScanWindowWithNearables:(NSArray *)nearables beacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * Weights decayed to the last window, the larger of the two rows.
+ */
+- (double)weightBetweenIdentityHash:(uint64_t)identityHash andIdentityHash:(uint64_t)otherIdentityHash;
+
+/*
+ * ESTCoPresenceNeighbor objects, strongest first. Sorts in a buffer owned by the graph,
+ * so it must not run concurrently with updates or other calls of this method.
+ */
+- (NSArray *)topNeighborsOfIdentityHash:(uint64_t)identityHash count:(NSUInteger)count;
+
+@end
@@ -0,0 +1,579 @@
+//
+//  ESTCoPresenceGraph.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTCoPresenceGraph.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+
+// Stored weights grow by exp(exponent), rescale before float precision suffers.
+#define EST_COPRESENCE_RESCALE_EXPONENT 16.0
+#define EST_COPRESENCE_PARALLEL_MINIMUM 64
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t *neighbors;
+    float *weights;
+} ESTCoPresenceRow;
+
+typedef struct
+{
+    uint32_t index;
+} ESTCoPresenceDevice;
+
+typedef struct
+{
+    uint32_t neighbor;
+    float weight;
+} ESTCoPresenceEntry;
+
+static int ESTCompareUInt32(const void *a, const void *b)
+{
+    uint32_t left = *(const uint32_t *)a;
+    uint32_t right = *(const uint32_t *)b;
+
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+static int ESTCompareEntriesByWeight(const void *a, const void *b)
+{
+    float left = ((const ESTCoPresenceEntry *)a)->weight;
+    float right = ((const ESTCoPresenceEntry *)b)->weight;
+
+    return left > right ? -1 : (left < right ? 1 : 0);
+}
+
+/*
+ * k-th largest value (k >= 1), reorders values.
+ */
+static float ESTCoPresenceSelect(float *values, uint32_t count, uint32_t k)
+{
+    uint32_t low = 0;
+    uint32_t high = count - 1;
+    uint32_t target = k - 1;
+
+    while (low < high)
+    {
+        float pivot = values[low + (high - low) / 2];
+        uint32_t i = low;
+        uint32_t j = high;
+
+        while (i <= j)
+        {
+            while (values[i] > pivot) i++;
+            while (values[j] < pivot) j--;
+
+            if (i <= j)
+            {
+                float swap = values[i];
+                values[i] = values[j];
+                values[j] = swap;
+                i++;
+
+                if (j == 0)
+                {
+                    break;
+                }
+
+                j--;
+            }
+        }
+
+        if (target <= j)
+        {
+            high = j;
+        }
+        else if (target >= i)
+        {
+            low = i;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return values[target];
+}
+
+static void ESTCoPresenceRowReserve(ESTCoPresenceRow *row, uint32_t capacity)
+{
+    if (capacity <= row->capacity)
+    {
+        return;
+    }
+
+    row->capacity = MAX(capacity, MAX(row->capacity * 2, (uint32_t)8));
+    row->neighbors = realloc(row->neighbors, row->capacity * sizeof(uint32_t));
+    row->weights = realloc(row->weights, row->capacity * sizeof(float));
+}
+
+/*
+ * Keeps the `keep` strongest entries, neighbor order is preserved.
+ * Scratch holds at least row->count floats.
+ */
+static void ESTCoPresenceRowPrune(ESTCoPresenceRow *row, uint32_t keep, float *scratch)
+{
+    memcpy(scratch, row->weights, row->count * sizeof(float));
+
+    float threshold = ESTCoPresenceSelect(scratch, row->count, keep);
+
+    uint32_t above = 0;
+
+    for (uint32_t i = 0; i < row->count; i++)
+    {
+        above += row->weights[i] > threshold ? 1 : 0;
+    }
+
+    uint32_t ties = keep - MIN(above, keep);
+    uint32_t written = 0;
+
+    for (uint32_t i = 0; i < row->count; i++)
+    {
+        BOOL tie = row->weights[i] == threshold && ties > 0;
+
+        if (row->weights[i] > threshold || tie)
+        {
+            ties -= tie ? 1 : 0;
+            row->neighbors[written] = row->neighbors[i];
+            row->weights[written] = row->weights[i];
+            written++;
+        }
+    }
+
+    row->count = written;
+}
+
+/*
+ * Adds increment to the row of owner for every other window device. Both lists are sorted,
+ * new neighbors are counted first so the merge runs backwards in place.
+ */
+static void ESTCoPresenceRowMerge(ESTCoPresenceRow *row, const uint32_t *window, uint32_t windowCount, uint32_t owner, float increment)
+{
+    uint32_t added = 0;
+    uint32_t i = 0;
+
+    for (uint32_t j = 0; j < windowCount; j++)
+    {
+        if (window[j] == owner)
+        {
+            continue;
+        }
+
+        while (i < row->count && row->neighbors[i] < window[j])
+        {
+            i++;
+        }
+
+        if (i < row->count && row->neighbors[i] == window[j])
+        {
+            i++;
+        }
+        else
+        {
+            added++;
+        }
+    }
+
+    ESTCoPresenceRowReserve(row, row->count + added);
+
+    int64_t a = (int64_t)row->count - 1;
+    int64_t b = (int64_t)windowCount - 1;
+    int64_t out = (int64_t)(row->count + added) - 1;
+
+    while (b >= 0)
+    {
+        if (window[b] == owner)
+        {
+            b--;
+        }
+        else if (a >= 0 && row->neighbors[a] > window[b])
+        {
+            row->neighbors[out] = row->neighbors[a];
+            row->weights[out--] = row->weights[a--];
+        }
+        else if (a >= 0 && row->neighbors[a] == window[b])
+        {
+            row->neighbors[out] = row->neighbors[a];
+            row->weights[out--] = row->weights[a--] + increment;
+            b--;
+        }
+        else
+        {
+            row->neighbors[out] = window[b--];
+            row->weights[out--] = increment;
+        }
+    }
+
+    row->count += added;
+}
+
+/*
+ * Stored weight of neighbor in the row, 0 when pruned or never seen.
+ */
+static float ESTCoPresenceRowWeight(const ESTCoPresenceRow *row, uint32_t neighbor)
+{
+    const uint32_t *found = bsearch(&neighbor, row->neighbors, row->count, sizeof(uint32_t), ESTCompareUInt32);
+
+    return found ? row->weights[found - row->neighbors] : 0;
+}
+
+#pragma mark - Neighbor
+
+@interface ESTCoPresenceNeighbor ()
+
+@property (nonatomic, assign, readwrite) uint64_t identityHash;
+@property (nonatomic, assign, readwrite) double weight;
+
+@end
+
+@implementation ESTCoPresenceNeighbor
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%016llx %.2f", self.identityHash, self.weight];
+}
+
+@end
+
+#pragma mark - Graph
+
+@interface ESTCoPresenceGraph ()
+
+@property (nonatomic, assign, readwrite) NSTimeInterval halfLife;
+
+@property (nonatomic, strong) ESTStructTable *devices;
+
+@end
+
+@implementation ESTCoPresenceGraph
+{
+    double _decayRate;
+    NSTimeInterval _scaleOrigin;
+    NSTimeInterval _lastTimestamp;
+
+    ESTCoPresenceRow *_rows;
+    uint64_t *_hashes;
+    NSUInteger _rowCapacity;
+
+    uint32_t *_window;
+    NSUInteger _windowCapacity;
+
+    // Merges run in slices, each slice prunes in its own part of the scratch.
+    NSUInteger _sliceCount;
+    float *_pruneScratch;
+    NSUInteger _pruneScratchCapacity;
+    uint32_t _longestRow;
+
+    ESTCoPresenceEntry *_entries;
+    NSUInteger _entryCapacity;
+}
+
+- (instancetype)init
+{
+    return [self initWithHalfLife:24 * 3600];
+}
+
+- (instancetype)initWithHalfLife:(NSTimeInterval)halfLife
+{
+    self = [super init];
+    if (self)
+    {
+        self.halfLife = MAX(halfLife, 1.0);
+        self.maxNeighbors = 256;
+        self.minimumWeight = 0.01;
+        self.devices = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTCoPresenceDevice) capacity:1024];
+
+        _decayRate = M_LN2 / self.halfLife;
+        _scaleOrigin = NAN;
+
+        // A few slices per core, so slices holding busy rows do not hold up the rest.
+        _sliceCount = 4 * MAX([NSProcessInfo processInfo].activeProcessorCount, (NSUInteger)1);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    for (NSUInteger i = 0; i < self.devices.count; i++)
+    {
+        free(_rows[i].neighbors);
+        free(_rows[i].weights);
+    }
+
+    free(_rows);
+    free(_hashes);
+    free(_window);
+    free(_pruneScratch);
+    free(_entries);
+}
+
+- (NSUInteger)deviceCount
+{
+    return self.devices.count;
+}
+
+- (NSUInteger)entryCount
+{
+    NSUInteger count = 0;
+
+    for (NSUInteger i = 0; i < self.devices.count; i++)
+    {
+        count += _rows[i].count;
+    }
+
+    return count;
+}
+
+#pragma mark - Updates
+
+- (uint32_t)indexForIdentityHash:(uint64_t)identityHash
+{
+    BOOL created;
+    ESTCoPresenceDevice *device = [self.devices insertValueForKey:identityHash created:&created];
+
+    if (created)
+    {
+        NSUInteger index = self.devices.count - 1;
+
+        if (index == _rowCapacity)
+        {
+            _rowCapacity = MAX(_rowCapacity * 2, (NSUInteger)1024);
+            _rows = realloc(_rows, _rowCapacity * sizeof(ESTCoPresenceRow));
+            _hashes = realloc(_hashes, _rowCapacity * sizeof(uint64_t));
+        }
+
+        memset(&_rows[index], 0, sizeof(ESTCoPresenceRow));
+        _hashes[index] = identityHash;
+        device->index = (uint32_t)index;
+    }
+
+    return device->index;
+}
+
+- (void)addScanWindowWithIdentityHashes:(const uint64_t *)identityHashes
+                                  count:(NSUInteger)count
+                              timestamp:(NSTimeInterval)timestamp
+{
+    if (isnan(_scaleOrigin))
+    {
+        _scaleOrigin = timestamp;
+    }
+
+    _lastTimestamp = MAX(_lastTimestamp, timestamp);
+
+    if (_decayRate * (timestamp - _scaleOrigin) > EST_COPRESENCE_RESCALE_EXPONENT)
+    {
+        [self rescaleToTime:timestamp];
+    }
+
+    if (count > _windowCapacity)
+    {
+        _windowCapacity = MAX(count, 2 * _windowCapacity);
+        _window = realloc(_window, _windowCapacity * sizeof(uint32_t));
+    }
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        _window[i] = [self indexForIdentityHash:identityHashes[i]];
+    }
+
+    qsort(_window, count, sizeof(uint32_t), ESTCompareUInt32);
+
+    uint32_t unique = 0;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        if (unique == 0 || _window[unique - 1] != _window[i])
+        {
+            _window[unique++] = _window[i];
+        }
+    }
+
+    if (unique < 2)
+    {
+        return;
+    }
+
+    // No row is longer than _longestRow before the merge, nor gains more than unique - 1 entries.
+    NSUInteger stride = _longestRow + unique;
+
+    if (_sliceCount * stride > _pruneScratchCapacity)
+    {
+        _pruneScratchCapacity = MAX(_sliceCount * stride, 2 * _pruneScratchCapacity);
+        _pruneScratch = realloc(_pruneScratch, _pruneScratchCapacity * sizeof(float));
+    }
+
+    ESTCoPresenceRow *rows = _rows;
+    const uint32_t *window = _window;
+    float *pruneScratch = _pruneScratch;
+    float increment = (float)exp(_decayRate * (timestamp - _scaleOrigin));
+    uint32_t maxNeighbors = (uint32_t)MAX(self.maxNeighbors, (NSUInteger)1);
+
+    // Every visible device owns its row, so merges never touch shared state.
+    void (^merge)(uint32_t, float *) = ^(uint32_t j, float *scratch) {
+
+        ESTCoPresenceRow *row = &rows[window[j]];
+        ESTCoPresenceRowMerge(row, window, unique, window[j], increment);
+
+        if (row->count > 2 * maxNeighbors)
+        {
+            ESTCoPresenceRowPrune(row, maxNeighbors, scratch);
+        }
+    };
+
+    if (unique >= EST_COPRESENCE_PARALLEL_MINIMUM)
+    {
+        NSUInteger chunk = (unique + _sliceCount - 1) / _sliceCount;
+
+        dispatch_apply((unique + chunk - 1) / chunk, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t c) {
+
+            for (NSUInteger j = c * chunk; j < MIN((c + 1) * chunk, (NSUInteger)unique); j++)
+            {
+                merge((uint32_t)j, pruneScratch + c * stride);
+            }
+        });
+    }
+    else
+    {
+        for (uint32_t j = 0; j < unique; j++)
+        {
+            merge(j, pruneScratch);
+        }
+    }
+
+    for (uint32_t j = 0; j < unique; j++)
+    {
+        _longestRow = MAX(_longestRow, rows[window[j]].count);
+    }
+}
+
+- (void)addScanWindowWithNearables:(NSArray *)nearables beacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp
+{
+    NSMutableData *hashes = [NSMutableData dataWithCapacity:(nearables.count + beacons.count) * sizeof(uint64_t)];
+
+    for (ESTNearable *nearable in nearables)
+    {
+        uint64_t hash = ESTSketchHashString(nearable.identifier);
+        [hashes appendBytes:&hash length:sizeof(hash)];
+    }
+
+    for (CLBeacon *beacon in beacons)
+    {
+        uint64_t hash = ESTBeaconIdentityHashCLBeacon(beacon);
+        [hashes appendBytes:&hash length:sizeof(hash)];
+    }
+
+    [self addScanWindowWithIdentityHashes:hashes.bytes count:hashes.length / sizeof(uint64_t) timestamp:timestamp];
+}
+
+/*
+ * Moves the scale origin to time and drops entries that decayed below minimumWeight.
+ */
+- (void)rescaleToTime:(NSTimeInterval)time
+{
+    float factor = (float)exp(-_decayRate * (time - _scaleOrigin));
+    float minimum = (float)self.minimumWeight;
+    ESTCoPresenceRow *rows = _rows;
+    NSUInteger rowCount = self.devices.count;
+    NSUInteger chunk = 1024;
+
+    dispatch_apply((rowCount + chunk - 1) / chunk, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t c) {
+
+        for (NSUInteger r = c * chunk; r < MIN((c + 1) * chunk, rowCount); r++)
+        {
+            ESTCoPresenceRow *row = &rows[r];
+            uint32_t written = 0;
+
+            for (uint32_t i = 0; i < row->count; i++)
+            {
+                float weight = row->weights[i] * factor;
+
+                if (weight >= minimum)
+                {
+                    row->neighbors[written] = row->neighbors[i];
+                    row->weights[written++] = weight;
+                }
+            }
+
+            row->count = written;
+        }
+    });
+
+    _scaleOrigin = time;
+}
+
+#pragma mark - Queries
+
+- (double)decayFactor
+{
+    return isnan(_scaleOrigin) ? 1.0 : exp(-_decayRate * (_lastTimestamp - _scaleOrigin));
+}
+
+- (double)weightBetweenIdentityHash:(uint64_t)identityHash andIdentityHash:(uint64_t)otherIdentityHash
+{
+    ESTCoPresenceDevice *device = [self.devices valueForKey:identityHash];
+    ESTCoPresenceDevice *other = [self.devices valueForKey:otherIdentityHash];
+
+    if (!device || !other)
+    {
+        return 0;
+    }
+
+    // Rows are pruned independently, the row that kept the pair longer holds the larger weight.
+    float weight = MAX(ESTCoPresenceRowWeight(&_rows[device->index], other->index),
+                       ESTCoPresenceRowWeight(&_rows[other->index], device->index));
+
+    return weight * [self decayFactor];
+}
+
+- (NSArray *)topNeighborsOfIdentityHash:(uint64_t)identityHash count:(NSUInteger)count
+{
+    ESTCoPresenceDevice *device = [self.devices valueForKey:identityHash];
+
+    if (!device || count == 0)
+    {
+        return @[];
+    }
+
+    const ESTCoPresenceRow *row = &_rows[device->index];
+    double factor = [self decayFactor];
+
+    // Rows are short (at most 2 * maxNeighbors), sorting a copy is cheaper than keeping a heap.
+    if (row->count > _entryCapacity)
+    {
+        _entryCapacity = MAX((NSUInteger)row->count, 2 * _entryCapacity);
+        _entries = realloc(_entries, _entryCapacity * sizeof(ESTCoPresenceEntry));
+    }
+
+    ESTCoPresenceEntry *entries = _entries;
+
+    for (uint32_t i = 0; i < row->count; i++)
+    {
+        entries[i].neighbor = row->neighbors[i];
+        entries[i].weight = row->weights[i];
+    }
+
+    qsort(entries, row->count, sizeof(ESTCoPresenceEntry), ESTCompareEntriesByWeight);
+
+    NSUInteger resultCount = MIN(count, (NSUInteger)row->count);
+    NSMutableArray *neighbors = [NSMutableArray arrayWithCapacity:resultCount];
+
+    for (NSUInteger k = 0; k < resultCount; k++)
+    {
+        ESTCoPresenceNeighbor *neighbor = [[ESTCoPresenceNeighbor alloc] init];
+        neighbor.identityHash = _hashes[entries[k].neighbor];
+        neighbor.weight = entries[k].weight * factor;
+        [neighbors addObject:neighbor];
+    }
+
+    return neighbors;
+}
+
+@end
@@ -0,0 +1,89 @@
+//
+//  ESTColumnarExporter.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+#import "ESTHDRHistogram.h"
+
+/*
+ * Exports ranging, nearable, Eddystone telemetry and trigger history into Parquet
+ * files for analytics tools, one file per table in the directory:
+ * ranging.parquet, nearables.parquet, telemetry.parquet and triggers.parquet.
+ *
+ * Rows are buffered per table and handed over as row groups of rowGroupSize to a
+ * background writer queue, which encodes and compresses them. At most
+ * maxPendingBatches row groups wait for the writer, further full batches are dropped
+ * and counted, so memory stays bounded when storage cannot keep up.
+ *
+ * Record and read the counters from the main thread. Missing numbers are written
+ * as NAN (doubles) or -1 (integers). Files are complete once closed.
+ */
+@interface ESTColumnarExporter : NSObject
+
+@property (nonatomic, strong, readonly) NSString *directory;
+@property (nonatomic, assign, readonly) NSUInteger rowGroupSize;
+@property (nonatomic, assign, readonly) NSUInteger maxPendingBatches;
+
+/*
+ * Rows written by the writer queue.
+ */
+@property (nonatomic, assign, readonly) uint64_t rowCount;
+@property (nonatomic, assign, readonly) uint64_t droppedRowCount;
+@property (nonatomic, assign, readonly) uint64_t bytesWritten;
+
+/*
+ * Encoding and writing time per row in ns, rows per second is 1e9 / mean.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *writeTime;
+
+/*
+ * First write error, later batches of the failed table are dropped.
+ */
+@property (nonatomic, strong, readonly) NSError *error;
+
+/*
+ * Default row group of 16384 rows, 4 pending batches.
+ */
+- (instancetype)initWithDirectory:(NSString *)directory;
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                     rowGroupSize:(NSUInteger)rowGroupSize
+                maxPendingBatches:(NSUInteger)maxPendingBatches;
+
+/*
+ * CLBeacon objects from ranging.
+ */
+- (void)recordRangedBeacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * ESTNearable objects with their sensor readings.
+ */
+- (void)recordNearables:(NSArray *)nearables timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * ESTEddystone objects, only those carrying telemetry are recorded.
+ */
+- (void)recordEddystones:(NSArray *)eddystones timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * State transition reported by ESTTriggerManager.
+ */
+- (void)recordTrigger:(ESTTrigger *)trigger timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * Hands partially filled batches to the writer.
+ */
+- (void)flush;
+
+/*
+ * Flushes, writes the footers and closes the files. Completion runs on the main
+ * queue, also for repeated calls, with the first error. Records made afterwards are ignored.
+ */
+- (void)closeWithCompletion:(void (^)(NSError *error))completion;
+
+@end
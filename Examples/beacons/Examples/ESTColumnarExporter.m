@@ -0,0 +1,476 @@
+//
+//  ESTColumnarExporter.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTColumnarExporter.h"
+#import "ESTParquetWriter.h"
+#import <mach/mach_time.h>
+
+typedef NS_ENUM(NSUInteger, ESTExportTable)
+{
+    ESTExportTableRanging,
+    ESTExportTableNearables,
+    ESTExportTableTelemetry,
+    ESTExportTableTriggers,
+    ESTExportTableCount
+};
+
+static const ESTParquetType ESTExportRangingTypes[] = {
+    ESTParquetTypeTimestamp, ESTParquetTypeString, ESTParquetTypeInt32, ESTParquetTypeInt32,
+    ESTParquetTypeInt32, ESTParquetTypeDouble, ESTParquetTypeInt32
+};
+
+static const ESTParquetType ESTExportNearableTypes[] = {
+    ESTParquetTypeTimestamp, ESTParquetTypeString, ESTParquetTypeInt32, ESTParquetTypeInt32,
+    ESTParquetTypeInt32, ESTParquetTypeDouble, ESTParquetTypeInt32, ESTParquetTypeInt32,
+    ESTParquetTypeInt32, ESTParquetTypeInt32, ESTParquetTypeInt32, ESTParquetTypeDouble
+};
+
+static const ESTParquetType ESTExportTelemetryTypes[] = {
+    ESTParquetTypeTimestamp, ESTParquetTypeString, ESTParquetTypeString, ESTParquetTypeString,
+    ESTParquetTypeInt32, ESTParquetTypeDouble, ESTParquetTypeDouble, ESTParquetTypeInt64, ESTParquetTypeInt64
+};
+
+static const ESTParquetType ESTExportTriggerTypes[] = {
+    ESTParquetTypeTimestamp, ESTParquetTypeString, ESTParquetTypeInt32
+};
+
+static const ESTParquetType *ESTExportTableTypes(ESTExportTable table)
+{
+    switch (table)
+    {
+        case ESTExportTableRanging:
+            return ESTExportRangingTypes;
+
+        case ESTExportTableNearables:
+            return ESTExportNearableTypes;
+
+        case ESTExportTableTelemetry:
+            return ESTExportTelemetryTypes;
+
+        default:
+            return ESTExportTriggerTypes;
+    }
+}
+
+static double ESTExportDouble(NSNumber *number)
+{
+    return number ? number.doubleValue : NAN;
+}
+
+static int64_t ESTExportInt64(NSNumber *number)
+{
+    return number ? number.longLongValue : -1;
+}
+
+@interface ESTColumnarExporter ()
+
+@property (nonatomic, strong, readwrite) NSString *directory;
+@property (nonatomic, assign, readwrite) NSUInteger rowGroupSize;
+@property (nonatomic, assign, readwrite) NSUInteger maxPendingBatches;
+@property (nonatomic, assign, readwrite) uint64_t rowCount;
+@property (nonatomic, assign, readwrite) uint64_t droppedRowCount;
+@property (nonatomic, assign, readwrite) uint64_t bytesWritten;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *writeTime;
+@property (nonatomic, strong, readwrite) NSError *error;
+
+/*
+ * Producer side, one batch per table.
+ */
+@property (nonatomic, strong) NSMutableArray *batches;
+
+/*
+ * Writer queue side, ESTParquetWriter or NSNull per table.
+ */
+@property (nonatomic, strong) NSMutableArray *writers;
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_semaphore_t pending;
+@property (nonatomic, assign) BOOL closed;
+
+@end
+
+@implementation ESTColumnarExporter
+{
+    mach_timebase_info_data_t _timebase;
+
+    // Writer queue side.
+    BOOL _failed[ESTExportTableCount];
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory
+{
+    return [self initWithDirectory:directory rowGroupSize:16384 maxPendingBatches:4];
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                     rowGroupSize:(NSUInteger)rowGroupSize
+                maxPendingBatches:(NSUInteger)maxPendingBatches
+{
+    self = [super init];
+    if (self)
+    {
+        self.directory = directory;
+        self.rowGroupSize = MAX(rowGroupSize, (NSUInteger)1);
+        self.maxPendingBatches = MAX(maxPendingBatches, (NSUInteger)1);
+
+        self.batches = [NSMutableArray arrayWithCapacity:ESTExportTableCount];
+        self.writers = [NSMutableArray arrayWithCapacity:ESTExportTableCount];
+
+        for (NSUInteger table = 0; table < ESTExportTableCount; table++)
+        {
+            [self.batches addObject:[self emptyBatchForTable:table]];
+            [self.writers addObject:[NSNull null]];
+        }
+
+        self.queue = dispatch_queue_create("com.estimote.examples.columnar-export", DISPATCH_QUEUE_SERIAL);
+        self.pending = dispatch_semaphore_create((long)self.maxPendingBatches);
+
+        // 1 ns ... 10 s.
+        self.writeTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:10000000000ULL significantBits:7];
+
+        mach_timebase_info(&_timebase);
+    }
+    return self;
+}
+
+#pragma mark - Tables
+
++ (NSArray *)columnNamesForTable:(ESTExportTable)table
+{
+    switch (table)
+    {
+        case ESTExportTableRanging:
+            return @[ @"timestamp", @"proximity_uuid", @"major", @"minor", @"rssi", @"accuracy", @"proximity" ];
+
+        case ESTExportTableNearables:
+            return @[ @"timestamp", @"identifier", @"type", @"rssi", @"zone", @"temperature", @"is_moving",
+                      @"orientation", @"x_acceleration", @"y_acceleration", @"z_acceleration", @"idle_battery_voltage" ];
+
+        case ESTExportTableTelemetry:
+            return @[ @"timestamp", @"namespace_id", @"instance_id", @"url", @"rssi",
+                      @"battery_voltage", @"temperature", @"packet_count", @"uptime_ms" ];
+
+        default:
+            return @[ @"timestamp", @"identifier", @"state" ];
+    }
+}
+
++ (NSString *)fileNameForTable:(ESTExportTable)table
+{
+    NSArray *names = @[ @"ranging.parquet", @"nearables.parquet", @"telemetry.parquet", @"triggers.parquet" ];
+
+    return names[table];
+}
+
+- (ESTParquetBatch *)emptyBatchForTable:(ESTExportTable)table
+{
+    NSUInteger count = [[self class] columnNamesForTable:table].count;
+
+    return [[ESTParquetBatch alloc] initWithTypes:ESTExportTableTypes(table) count:count];
+}
+
+#pragma mark - Recording
+
+- (void)recordRangedBeacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp
+{
+    if (self.closed)
+    {
+        return;
+    }
+
+    ESTParquetBatch *batch = self.batches[ESTExportTableRanging];
+
+    for (CLBeacon *beacon in beacons)
+    {
+        [batch appendTimestamp:timestamp column:0];
+        [batch appendString:beacon.proximityUUID.UUIDString column:1];
+        [batch appendInt32:beacon.major.intValue column:2];
+        [batch appendInt32:beacon.minor.intValue column:3];
+        [batch appendInt32:(int32_t)beacon.rssi column:4];
+        [batch appendDouble:beacon.accuracy column:5];
+        [batch appendInt32:(int32_t)beacon.proximity column:6];
+        [batch endRow];
+    }
+
+    [self submitTableIfFull:ESTExportTableRanging];
+}
+
+- (void)recordNearables:(NSArray *)nearables timestamp:(NSTimeInterval)timestamp
+{
+    if (self.closed)
+    {
+        return;
+    }
+
+    ESTParquetBatch *batch = self.batches[ESTExportTableNearables];
+
+    for (ESTNearable *nearable in nearables)
+    {
+        [batch appendTimestamp:timestamp column:0];
+        [batch appendString:nearable.identifier column:1];
+        [batch appendInt32:(int32_t)nearable.type column:2];
+        [batch appendInt32:(int32_t)nearable.rssi column:3];
+        [batch appendInt32:(int32_t)nearable.zone column:4];
+        [batch appendDouble:nearable.temperature column:5];
+        [batch appendInt32:nearable.isMoving ? 1 : 0 column:6];
+        [batch appendInt32:(int32_t)nearable.orientation column:7];
+        [batch appendInt32:(int32_t)nearable.xAcceleration column:8];
+        [batch appendInt32:(int32_t)nearable.yAcceleration column:9];
+        [batch appendInt32:(int32_t)nearable.zAcceleration column:10];
+        [batch appendDouble:ESTExportDouble(nearable.idleBatteryVoltage) column:11];
+        [batch endRow];
+    }
+
+    [self submitTableIfFull:ESTExportTableNearables];
+}
+
+- (void)recordEddystones:(NSArray *)eddystones timestamp:(NSTimeInterval)timestamp
+{
+    if (self.closed)
+    {
+        return;
+    }
+
+    ESTParquetBatch *batch = self.batches[ESTExportTableTelemetry];
+
+    for (ESTEddystone *eddystone in eddystones)
+    {
+        ESTEddystoneTelemetry *telemetry = eddystone.telemetry;
+
+        if (!telemetry)
+        {
+            continue;
+        }
+
+        [batch appendTimestamp:timestamp column:0];
+        [batch appendString:eddystone.namespaceID column:1];
+        [batch appendString:eddystone.instanceID column:2];
+        [batch appendString:eddystone.url column:3];
+        [batch appendInt32:(int32_t)ESTExportInt64(eddystone.rssi) column:4];
+        [batch appendDouble:ESTExportDouble(telemetry.batteryVoltage) column:5];
+        [batch appendDouble:ESTExportDouble(telemetry.temperature) column:6];
+        [batch appendInt64:ESTExportInt64(telemetry.packetCount) column:7];
+        [batch appendInt64:ESTExportInt64(telemetry.uptimeMillis) column:8];
+        [batch endRow];
+    }
+
+    [self submitTableIfFull:ESTExportTableTelemetry];
+}
+
+- (void)recordTrigger:(ESTTrigger *)trigger timestamp:(NSTimeInterval)timestamp
+{
+    if (self.closed)
+    {
+        return;
+    }
+
+    ESTParquetBatch *batch = self.batches[ESTExportTableTriggers];
+
+    [batch appendTimestamp:timestamp column:0];
+    [batch appendString:trigger.identifier column:1];
+    [batch appendInt32:trigger.state ? 1 : 0 column:2];
+    [batch endRow];
+
+    [self submitTableIfFull:ESTExportTableTriggers];
+}
+
+#pragma mark - Writing
+
+- (void)submitTableIfFull:(ESTExportTable)table
+{
+    if ([self.batches[table] rowCount] >= self.rowGroupSize)
+    {
+        [self submitTable:table waiting:NO];
+    }
+}
+
+- (void)submitTable:(ESTExportTable)table waiting:(BOOL)waiting
+{
+    ESTParquetBatch *batch = self.batches[table];
+
+    if (batch.rowCount == 0 || self.closed)
+    {
+        return;
+    }
+
+    self.batches[table] = [self emptyBatchForTable:table];
+
+    // Recording never blocks, a full writer costs the batch instead.
+    if (dispatch_semaphore_wait(self.pending, waiting ? DISPATCH_TIME_FOREVER : DISPATCH_TIME_NOW) != 0)
+    {
+        self.droppedRowCount += batch.rowCount;
+        return;
+    }
+
+    mach_timebase_info_data_t timebase = _timebase;
+
+    dispatch_async(self.queue, ^{
+
+        uint64_t start = mach_absolute_time();
+        NSError *error = nil;
+        ESTParquetWriter *writer = [self writerForTable:table error:&error];
+        uint64_t bytes = writer.bytesWritten;
+        BOOL written = writer && [writer writeBatch:batch error:&error];
+
+        if (!written && writer)
+        {
+            // Row groups after a failed one would point at garbage, give up on the table.
+            [self failTable:table];
+        }
+
+        uint64_t elapsed = (mach_absolute_time() - start) * timebase.numer / timebase.denom;
+        bytes = writer.bytesWritten - bytes;
+
+        dispatch_semaphore_signal(self.pending);
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self finishBatch:batch written:written elapsed:elapsed bytes:bytes error:error];
+        });
+    });
+}
+
+/*
+ * Called on the writer queue.
+ */
+- (ESTParquetWriter *)writerForTable:(ESTExportTable)table error:(NSError **)error
+{
+    id writer = self.writers[table];
+
+    if (writer != [NSNull null] || _failed[table])
+    {
+        return writer == [NSNull null] ? nil : writer;
+    }
+
+    NSString *path = [self.directory stringByAppendingPathComponent:[[self class] fileNameForTable:table]];
+
+    if ([[NSFileManager defaultManager] createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:error])
+    {
+        writer = [[ESTParquetWriter alloc] initWithPath:path
+                                            columnNames:[[self class] columnNamesForTable:table]
+                                                  types:ESTExportTableTypes(table)
+                                                  error:error];
+    }
+
+    if (!writer)
+    {
+        [self failTable:table];
+        return nil;
+    }
+
+    self.writers[table] = writer;
+
+    return writer;
+}
+
+/*
+ * Called on the writer queue.
+ */
+- (void)failTable:(ESTExportTable)table
+{
+    id writer = self.writers[table];
+
+    // Footer covers the row groups written before the failure, the file stays readable.
+    if (writer != [NSNull null])
+    {
+        [writer closeWithError:NULL];
+    }
+
+    _failed[table] = YES;
+    self.writers[table] = [NSNull null];
+}
+
+- (void)finishBatch:(ESTParquetBatch *)batch written:(BOOL)written elapsed:(uint64_t)elapsed bytes:(uint64_t)bytes error:(NSError *)error
+{
+    if (error && !self.error)
+    {
+        self.error = error;
+    }
+
+    if (!written)
+    {
+        self.droppedRowCount += batch.rowCount;
+        return;
+    }
+
+    self.rowCount += batch.rowCount;
+    self.bytesWritten += bytes;
+    [self.writeTime recordValue:elapsed / batch.rowCount count:batch.rowCount];
+}
+
+- (void)flush
+{
+    for (NSUInteger table = 0; table < ESTExportTableCount; table++)
+    {
+        [self submitTable:table waiting:NO];
+    }
+}
+
+- (void)closeWithCompletion:(void (^)(NSError *error))completion
+{
+    if (self.closed)
+    {
+        // Queued behind the first close, so the stored error is final by then.
+        dispatch_async(self.queue, ^{
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (completion)
+                {
+                    completion(self.error);
+                }
+            });
+        });
+        return;
+    }
+
+    // Waiting on close keeps the tail of the data, the writer drains in order.
+    for (NSUInteger table = 0; table < ESTExportTableCount; table++)
+    {
+        [self submitTable:table waiting:YES];
+    }
+
+    self.closed = YES;
+
+    dispatch_async(self.queue, ^{
+
+        NSError *closeError = nil;
+        uint64_t bytes = 0;
+
+        for (id writer in self.writers)
+        {
+            if (writer == [NSNull null])
+            {
+                continue;
+            }
+
+            uint64_t before = [writer bytesWritten];
+
+            if (![writer closeWithError:closeError ? NULL : &closeError])
+            {
+                continue;
+            }
+
+            bytes += [writer bytesWritten] - before;
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+
+            self.bytesWritten += bytes;
+
+            if (closeError && !self.error)
+            {
+                self.error = closeError;
+            }
+
+            if (completion)
+            {
+                completion(self.error);
+            }
+        });
+    });
+}
+
+@end
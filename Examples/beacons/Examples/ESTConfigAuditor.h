@@ -0,0 +1,115 @@
+//
+//  ESTConfigAuditor.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+typedef NS_OPTIONS(NSUInteger, ESTConfigField)
+{
+    ESTConfigFieldNone               = 0,
+    ESTConfigFieldBroadcastingScheme = 1 << 0,
+    ESTConfigFieldMajorMinor         = 1 << 1,
+    ESTConfigFieldEddystoneUID       = 1 << 2,
+    ESTConfigFieldEddystoneURL       = 1 << 3,
+    ESTConfigFieldAdvInterval        = 1 << 4,
+    ESTConfigFieldPower              = 1 << 5,
+
+    /*
+     * Drifted when the beacon advertises from its bootloader.
+     */
+    ESTConfigFieldFirmwareState      = 1 << 6
+};
+
+/*
+ * Passive audit result of a single fleet beacon. Fields that the desired scheme
+ * does not use, or that packets seen so far could not confirm, are unverified.
+ */
+@interface ESTConfigAuditReport : NSObject
+
+@property (nonatomic, strong, readonly) ESTBeaconVO *beacon;
+@property (nonatomic, assign, readonly, getter = isSeen) BOOL seen;
+
+@property (nonatomic, assign, readonly) ESTConfigField verifiedFields;
+@property (nonatomic, assign, readonly) ESTConfigField driftedFields;
+@property (nonatomic, assign, readonly) ESTConfigField unverifiedFields;
+
+/*
+ * Advertising interval in ms estimated from inter-arrival times, 0 if unknown.
+ */
+@property (nonatomic, assign, readonly) double estimatedAdvInterval;
+
+/*
+ * Seen with drift in at least one field.
+ */
+@property (nonatomic, assign, readonly) BOOL needsConnection;
+
+@end
+
+/*
+ * Connectionless check of fleet configuration (`ESTBeaconVO` from ESTCloudManager)
+ * against what beacons advertise, so only beacons that actually drifted get a
+ * connection.
+ *
+ * Packets from ESTUtilityManager and ESTEddystoneManager discovery are matched to
+ * the fleet by MAC address. They verify the broadcasting scheme, major / minor,
+ * Eddystone UID and URL and the firmware state, power through measured power when
+ * a calibration is set, and advertising interval from the smallest inter-arrival
+ * times of packets of the desired scheme. The interval needs discovery that reports
+ * every packet (duplicates allowed). Proximity UUID, firmware version and the power
+ * modes are not advertised and stay unverified.
+ */
+@interface ESTConfigAuditor : NSObject
+
+@property (nonatomic, strong, readonly) NSArray *fleet;
+
+/*
+ * Inter-arrival samples needed for an interval estimate. Default 8.
+ */
+@property (nonatomic, assign) NSUInteger minimumIntervalSamples;
+
+/*
+ * Relative interval tolerance, at least 10 ms of advertising jitter. Default 0.1.
+ */
+@property (nonatomic, assign) double advIntervalTolerance;
+
+/*
+ * Default 3 dB.
+ */
+@property (nonatomic, assign) NSInteger measuredPowerTolerance;
+
+@property (nonatomic, assign, readonly) NSUInteger seenCount;
+
+/*
+ * Seen beacons with nothing drifted.
+ */
+@property (nonatomic, assign, readonly) NSUInteger connectionsAvoided;
+
+- (instancetype)initWithFleet:(NSArray *)fleet;
+
+/*
+ * Measured power at 1 m the hardware advertises for a power level, Eddystone
+ * packets are compared 41 dB higher (0 m reference).
+ */
+- (void)setExpectedMeasuredPower:(NSInteger)measuredPower forPower:(ESTBeaconPower)power;
+
+- (void)processBluetoothBeacons:(NSArray *)beacons;
+- (void)processEddystones:(NSArray *)eddystones;
+
+- (ESTConfigAuditReport *)reportForBeacon:(ESTBeaconVO *)beacon;
+
+/*
+ * Reports of all fleet beacons, in fleet order.
+ */
+- (NSArray *)reports;
+
+/*
+ * ESTBeaconVO objects of beacons that need a connection.
+ */
+- (NSArray *)beaconsNeedingConnection;
+
+@end
@@ -0,0 +1,452 @@
+//
+//  ESTConfigAuditor.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTConfigAuditor.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+
+#define EST_AUDIT_GAPS                  8
+#define EST_AUDIT_MIN_GAP               0.02
+#define EST_AUDIT_JITTER                10.0
+#define EST_AUDIT_EDDYSTONE_POWER_SHIFT 41
+
+/*
+ * Advertising kinds, also bits of seenKinds.
+ */
+typedef NS_ENUM(uint8_t, ESTAuditKind)
+{
+    ESTAuditKindBluetooth,
+    ESTAuditKindEddystoneUID,
+    ESTAuditKindEddystoneURL,
+    ESTAuditKindCount
+};
+
+typedef struct
+{
+    // Desired configuration.
+    uint8_t kind;
+    int8_t power;
+    uint16_t major;
+    uint16_t minor;
+    double advInterval;
+    uint64_t uidHash;
+    uint64_t urlHash;
+
+    // Observations.
+    uint8_t seenKinds;
+    uint16_t verified;
+    uint16_t drifted;
+    NSTimeInterval lastSeen[ESTAuditKindCount];
+
+    /*
+     * Smallest inter-arrival times per kind, ascending.
+     */
+    float gaps[ESTAuditKindCount][EST_AUDIT_GAPS];
+    uint32_t gapCount[ESTAuditKindCount];
+} ESTAuditEntry;
+
+@interface ESTConfigAuditReport ()
+
+@property (nonatomic, strong, readwrite) ESTBeaconVO *beacon;
+@property (nonatomic, assign, readwrite, getter = isSeen) BOOL seen;
+@property (nonatomic, assign, readwrite) ESTConfigField verifiedFields;
+@property (nonatomic, assign, readwrite) ESTConfigField driftedFields;
+@property (nonatomic, assign, readwrite) ESTConfigField unverifiedFields;
+@property (nonatomic, assign, readwrite) double estimatedAdvInterval;
+
+@end
+
+@implementation ESTConfigAuditReport
+
+- (BOOL)needsConnection
+{
+    return self.seen && self.driftedFields != ESTConfigFieldNone;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %@ drifted 0x%lx unverified 0x%lx>",
+            NSStringFromClass([self class]),
+            self.beacon.macAddress ?: self.beacon.name,
+            (unsigned long)self.driftedFields,
+            (unsigned long)self.unverifiedFields];
+}
+
+@end
+
+#pragma mark - Auditor
+
+@interface ESTConfigAuditor ()
+
+@property (nonatomic, strong, readwrite) NSArray *fleet;
+@property (nonatomic, strong) ESTStructTable *macIndex;
+@property (nonatomic, strong) NSMutableDictionary *measuredPowers;
+
+@end
+
+@implementation ESTConfigAuditor
+{
+    ESTAuditEntry *_entries;
+}
+
+- (instancetype)init
+{
+    return [self initWithFleet:@[]];
+}
+
+- (instancetype)initWithFleet:(NSArray *)fleet
+{
+    self = [super init];
+    if (self)
+    {
+        self.minimumIntervalSamples = 8;
+        self.advIntervalTolerance = 0.1;
+        self.measuredPowerTolerance = 3;
+
+        self.fleet = [fleet copy];
+        self.macIndex = [[ESTStructTable alloc] initWithValueSize:sizeof(uint32_t) capacity:self.fleet.count];
+        self.measuredPowers = [NSMutableDictionary dictionary];
+
+        _entries = calloc(MAX(self.fleet.count, (NSUInteger)1), sizeof(ESTAuditEntry));
+
+        [self.fleet enumerateObjectsUsingBlock:^(ESTBeaconVO *beacon, NSUInteger idx, BOOL *stop) {
+
+            if (beacon.macAddress)
+            {
+                uint32_t *index = [self.macIndex insertValueForKey:ESTSketchHashString([beacon.macAddress lowercaseString])
+                                                           created:NULL];
+                *index = (uint32_t)idx;
+            }
+
+            ESTAuditEntry *entry = &_entries[idx];
+
+            switch (beacon.broadcastingScheme)
+            {
+                case ESTBroadcastingSchemeEddystoneUID:
+                    entry->kind = ESTAuditKindEddystoneUID;
+                    break;
+
+                case ESTBroadcastingSchemeEddystoneURL:
+                    entry->kind = ESTAuditKindEddystoneURL;
+                    break;
+
+                default:
+                    entry->kind = ESTAuditKindBluetooth;
+                    break;
+            }
+
+            entry->power = beacon.power;
+            entry->major = [beacon.major unsignedShortValue];
+            entry->minor = [beacon.minor unsignedShortValue];
+            entry->advInterval = beacon.advInterval;
+            entry->uidHash = ESTBeaconIdentityHashEddystone(beacon.eddystoneNamespaceID, beacon.eddystoneInstanceID);
+            entry->urlHash = ESTSketchHashString(beacon.eddystoneURL);
+        }];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_entries);
+}
+
+- (void)setExpectedMeasuredPower:(NSInteger)measuredPower forPower:(ESTBeaconPower)power
+{
+    self.measuredPowers[@(power)] = @(measuredPower);
+}
+
+#pragma mark - Observations
+
+- (ESTAuditEntry *)entryForMacAddress:(NSString *)macAddress
+{
+    uint32_t *index = macAddress ? [self.macIndex valueForKey:ESTSketchHashString([macAddress lowercaseString])] : NULL;
+
+    return index ? &_entries[*index] : NULL;
+}
+
+static inline void ESTAuditSetField(ESTAuditEntry *entry, ESTConfigField field, BOOL matches)
+{
+    // Drift is sticky, a single mismatching packet is enough to ask for a connection.
+    if (matches)
+    {
+        entry->verified |= field;
+    }
+    else
+    {
+        entry->drifted |= field;
+    }
+}
+
+static void ESTAuditRecordGap(ESTAuditEntry *entry, ESTAuditKind kind, NSTimeInterval timestamp)
+{
+    NSTimeInterval gap = timestamp - entry->lastSeen[kind];
+    BOOL first = entry->lastSeen[kind] == 0;
+
+    entry->lastSeen[kind] = MAX(entry->lastSeen[kind], timestamp);
+
+    // Duplicate deliveries of one packet are closer than any advertising interval.
+    if (first || gap < EST_AUDIT_MIN_GAP)
+    {
+        return;
+    }
+
+    float *gaps = entry->gaps[kind];
+    uint32_t count = MIN(entry->gapCount[kind], (uint32_t)EST_AUDIT_GAPS);
+
+    if (count == EST_AUDIT_GAPS && gap >= gaps[count - 1])
+    {
+        entry->gapCount[kind]++;
+        return;
+    }
+
+    // Insertion into the sorted array of smallest gaps.
+    NSInteger i = MIN(count, (uint32_t)EST_AUDIT_GAPS - 1);
+
+    while (i > 0 && gaps[i - 1] > gap)
+    {
+        gaps[i] = gaps[i - 1];
+        i--;
+    }
+
+    gaps[i] = (float)gap;
+    entry->gapCount[kind]++;
+}
+
+- (void)recordMeasuredPower:(NSNumber *)measuredPower shift:(NSInteger)shift entry:(ESTAuditEntry *)entry
+{
+    NSNumber *expected = self.measuredPowers[@(entry->power)];
+
+    if (!measuredPower || !expected)
+    {
+        return;
+    }
+
+    NSInteger difference = [measuredPower integerValue] - ([expected integerValue] + shift);
+
+    ESTAuditSetField(entry, ESTConfigFieldPower, labs(difference) <= self.measuredPowerTolerance);
+}
+
+- (void)processBluetoothBeacons:(NSArray *)beacons
+{
+    for (ESTBluetoothBeacon *beacon in beacons)
+    {
+        ESTAuditEntry *entry = [self entryForMacAddress:beacon.macAddress];
+
+        if (!entry)
+        {
+            continue;
+        }
+
+        entry->seenKinds |= 1 << ESTAuditKindBluetooth;
+
+        ESTAuditSetField(entry, ESTConfigFieldFirmwareState, beacon.firmwareState == ESTBeaconFirmwareStateApp);
+
+        // Bootloader packets carry no configuration.
+        if (beacon.firmwareState != ESTBeaconFirmwareStateApp || entry->kind != ESTAuditKindBluetooth)
+        {
+            continue;
+        }
+
+        ESTAuditSetField(entry, ESTConfigFieldMajorMinor,
+                         [beacon.major unsignedShortValue] == entry->major && [beacon.minor unsignedShortValue] == entry->minor);
+
+        [self recordMeasuredPower:beacon.measuredPower shift:0 entry:entry];
+
+        NSTimeInterval timestamp = beacon.discoveryDate ? [beacon.discoveryDate timeIntervalSinceReferenceDate] : CFAbsoluteTimeGetCurrent();
+        ESTAuditRecordGap(entry, ESTAuditKindBluetooth, timestamp);
+    }
+}
+
+- (void)processEddystones:(NSArray *)eddystones
+{
+    for (ESTEddystone *eddystone in eddystones)
+    {
+        ESTAuditEntry *entry = [self entryForMacAddress:eddystone.macAddress];
+
+        // Telemetry only discoveries carry neither identity.
+        if (!entry || (!eddystone.namespaceID && !eddystone.url))
+        {
+            continue;
+        }
+
+        ESTAuditKind kind = eddystone.namespaceID ? ESTAuditKindEddystoneUID : ESTAuditKindEddystoneURL;
+        entry->seenKinds |= 1 << kind;
+
+        if (kind != entry->kind)
+        {
+            continue;
+        }
+
+        if (kind == ESTAuditKindEddystoneUID)
+        {
+            ESTAuditSetField(entry, ESTConfigFieldEddystoneUID,
+                             ESTBeaconIdentityHashEddystone(eddystone.namespaceID, eddystone.instanceID) == entry->uidHash);
+        }
+        else
+        {
+            ESTAuditSetField(entry, ESTConfigFieldEddystoneURL, ESTSketchHashString(eddystone.url) == entry->urlHash);
+        }
+
+        [self recordMeasuredPower:eddystone.measuredPower shift:EST_AUDIT_EDDYSTONE_POWER_SHIFT entry:entry];
+
+        NSTimeInterval timestamp = eddystone.discoveryDate ? [eddystone.discoveryDate timeIntervalSinceReferenceDate] : CFAbsoluteTimeGetCurrent();
+        ESTAuditRecordGap(entry, kind, timestamp);
+    }
+}
+
+#pragma mark - Reports
+
+/*
+ * Mean of the smallest gaps within 1.5x of the smallest one, so missed packets
+ * (gaps of 2x, 3x the interval) do not bias the estimate. In ms, 0 if unknown.
+ */
+- (double)estimatedAdvIntervalForEntry:(const ESTAuditEntry *)entry
+{
+    uint32_t count = MIN(entry->gapCount[entry->kind], (uint32_t)EST_AUDIT_GAPS);
+
+    if (count == 0 || entry->gapCount[entry->kind] < self.minimumIntervalSamples)
+    {
+        return 0;
+    }
+
+    const float *gaps = entry->gaps[entry->kind];
+    double sum = 0;
+    uint32_t used = 0;
+
+    for (uint32_t i = 0; i < count && gaps[i] <= gaps[0] * 1.5f; i++)
+    {
+        sum += gaps[i];
+        used++;
+    }
+
+    return sum / used * 1000;
+}
+
+- (ESTConfigAuditReport *)reportForIndex:(uint32_t)index
+{
+    const ESTAuditEntry *entry = &_entries[index];
+
+    ESTConfigAuditReport *report = [ESTConfigAuditReport new];
+    report.beacon = self.fleet[index];
+    report.seen = entry->seenKinds != 0;
+
+    ESTConfigField verified = entry->verified;
+    ESTConfigField drifted = entry->drifted;
+
+    // Other kinds next to the desired one may be extra packets, only their exclusive presence is drift.
+    if (entry->seenKinds & (1 << entry->kind))
+    {
+        verified |= ESTConfigFieldBroadcastingScheme;
+    }
+    else if (entry->seenKinds)
+    {
+        drifted |= ESTConfigFieldBroadcastingScheme;
+    }
+
+    report.estimatedAdvInterval = [self estimatedAdvIntervalForEntry:entry];
+
+    if (report.estimatedAdvInterval > 0 && entry->advInterval > 0)
+    {
+        double tolerance = MAX(entry->advInterval * self.advIntervalTolerance, EST_AUDIT_JITTER);
+        BOOL matches = fabs(report.estimatedAdvInterval - entry->advInterval) <= tolerance;
+
+        if (matches)
+        {
+            verified |= ESTConfigFieldAdvInterval;
+        }
+        else
+        {
+            drifted |= ESTConfigFieldAdvInterval;
+        }
+    }
+
+    ESTConfigField relevant = ESTConfigFieldBroadcastingScheme | ESTConfigFieldAdvInterval
+                            | ESTConfigFieldPower | ESTConfigFieldFirmwareState;
+
+    switch (entry->kind)
+    {
+        case ESTAuditKindEddystoneUID:
+            relevant |= ESTConfigFieldEddystoneUID;
+            break;
+
+        case ESTAuditKindEddystoneURL:
+            relevant |= ESTConfigFieldEddystoneURL;
+            break;
+
+        default:
+            relevant |= ESTConfigFieldMajorMinor;
+            break;
+    }
+
+    report.driftedFields = drifted;
+    report.verifiedFields = verified & ~drifted;
+    report.unverifiedFields = relevant & ~(verified | drifted);
+
+    return report;
+}
+
+- (ESTConfigAuditReport *)reportForBeacon:(ESTBeaconVO *)beacon
+{
+    NSUInteger index = [self.fleet indexOfObjectIdenticalTo:beacon];
+
+    return index == NSNotFound ? nil : [self reportForIndex:(uint32_t)index];
+}
+
+- (NSArray *)reports
+{
+    NSMutableArray *reports = [NSMutableArray arrayWithCapacity:self.fleet.count];
+
+    for (uint32_t index = 0; index < self.fleet.count; index++)
+    {
+        [reports addObject:[self reportForIndex:index]];
+    }
+
+    return reports;
+}
+
+- (NSArray *)beaconsNeedingConnection
+{
+    NSMutableArray *beacons = [NSMutableArray array];
+
+    for (ESTConfigAuditReport *report in [self reports])
+    {
+        if (report.needsConnection)
+        {
+            [beacons addObject:report.beacon];
+        }
+    }
+
+    return beacons;
+}
+
+- (NSUInteger)seenCount
+{
+    NSUInteger count = 0;
+
+    for (NSUInteger index = 0; index < self.fleet.count; index++)
+    {
+        count += _entries[index].seenKinds ? 1 : 0;
+    }
+
+    return count;
+}
+
+- (NSUInteger)connectionsAvoided
+{
+    NSUInteger count = 0;
+
+    for (ESTConfigAuditReport *report in [self reports])
+    {
+        count += report.seen && !report.needsConnection ? 1 : 0;
+    }
+
+    return count;
+}
+
+@end
@@ -0,0 +1,44 @@
+//
+//  ESTCountMinSketch.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * Count-Min frequency sketch. Estimates never undercount; overcount is bounded
+ * by epsilon * totalCount with probability 1 - delta.
+ *
+ * Memory is width * depth 32-bit counters regardless of the number of keys.
+ * Sketches with the same dimensions can be merged.
+ */
+@interface ESTCountMinSketch : NSObject <NSCoding, NSCopying>
+
+@property (nonatomic, assign, readonly) NSUInteger width;
+@property (nonatomic, assign, readonly) NSUInteger depth;
+@property (nonatomic, assign, readonly) uint64_t totalCount;
+
+- (instancetype)initWithWidth:(NSUInteger)width depth:(NSUInteger)depth;
+
+/*
+ * Sizes sketch so that error is at most epsilon * totalCount with confidence 1 - delta.
+ */
+- (instancetype)initWithErrorRate:(double)epsilon confidence:(double)delta;
+
+- (void)addHash:(uint64_t)hash count:(uint32_t)count;
+- (uint64_t)estimateForHash:(uint64_t)hash;
+
+- (void)addString:(NSString *)string count:(uint32_t)count;
+- (uint64_t)estimateForString:(NSString *)string;
+
+/*
+ * Returns NO when sketches have different dimensions.
+ */
+- (BOOL)mergeWith:(ESTCountMinSketch *)other;
+
+- (void)reset;
+
+@end
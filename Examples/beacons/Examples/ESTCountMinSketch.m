@@ -0,0 +1,198 @@
+//
+//  ESTCountMinSketch.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTCountMinSketch.h"
+#import "ESTSketchHash.h"
+
+@interface ESTCountMinSketch ()
+
+@property (nonatomic, assign, readwrite) NSUInteger width;
+@property (nonatomic, assign, readwrite) NSUInteger depth;
+@property (nonatomic, assign, readwrite) uint64_t totalCount;
+
+@end
+
+@implementation ESTCountMinSketch
+{
+    uint32_t *_counters;
+}
+
+- (instancetype)init
+{
+    return [self initWithWidth:2048 depth:4];
+}
+
+- (instancetype)initWithWidth:(NSUInteger)width depth:(NSUInteger)depth
+{
+    self = [super init];
+    if (self)
+    {
+        self.width = MAX((NSUInteger)1, width);
+        self.depth = MAX((NSUInteger)1, MIN((NSUInteger)16, depth));
+
+        _counters = calloc(self.width * self.depth, sizeof(uint32_t));
+    }
+    return self;
+}
+
+- (instancetype)initWithErrorRate:(double)epsilon confidence:(double)delta
+{
+    epsilon = MAX(epsilon, 1e-6);
+    delta = MIN(MAX(delta, 1e-9), 0.5);
+
+    NSUInteger width = (NSUInteger)ceil(M_E / epsilon);
+    NSUInteger depth = (NSUInteger)ceil(log(1.0 / delta));
+
+    return [self initWithWidth:width depth:depth];
+}
+
+- (void)dealloc
+{
+    free(_counters);
+}
+
+#pragma mark - Indexing
+
+/*
+ * Row hashes are derived from a single 64-bit hash (Kirsch-Mitzenmacher),
+ * so a key is hashed once per update no matter how deep the sketch is.
+ */
+static inline NSUInteger ESTCountMinColumn(uint64_t hash, NSUInteger row, NSUInteger width)
+{
+    uint64_t h1 = hash & 0xffffffffULL;
+    uint64_t h2 = (hash >> 32) | 1ULL;
+
+    return (NSUInteger)((h1 + row * h2) % width);
+}
+
+#pragma mark - Updates
+
+- (void)addHash:(uint64_t)hash count:(uint32_t)count
+{
+    NSUInteger width = self.width;
+
+    for (NSUInteger row = 0; row < self.depth; row++)
+    {
+        uint32_t *cell = &_counters[row * width + ESTCountMinColumn(hash, row, width)];
+        uint32_t value = *cell + count;
+
+        // Saturate instead of wrapping around.
+        *cell = (value < *cell) ? UINT32_MAX : value;
+    }
+
+    self.totalCount += count;
+}
+
+- (uint64_t)estimateForHash:(uint64_t)hash
+{
+    NSUInteger width = self.width;
+    uint32_t estimate = UINT32_MAX;
+
+    for (NSUInteger row = 0; row < self.depth; row++)
+    {
+        estimate = MIN(estimate, _counters[row * width + ESTCountMinColumn(hash, row, width)]);
+    }
+
+    return estimate;
+}
+
+- (void)addString:(NSString *)string count:(uint32_t)count
+{
+    [self addHash:ESTSketchHashString(string) count:count];
+}
+
+- (uint64_t)estimateForString:(NSString *)string
+{
+    return [self estimateForHash:ESTSketchHashString(string)];
+}
+
+- (void)reset
+{
+    memset(_counters, 0, self.width * self.depth * sizeof(uint32_t));
+    self.totalCount = 0;
+}
+
+#pragma mark - Merging
+
+- (BOOL)mergeWith:(ESTCountMinSketch *)other
+{
+    if (!other || other.width != self.width || other.depth != self.depth)
+    {
+        return NO;
+    }
+
+    NSUInteger cells = self.width * self.depth;
+
+    for (NSUInteger i = 0; i < cells; i++)
+    {
+        uint32_t value = _counters[i] + other->_counters[i];
+        _counters[i] = (value < _counters[i]) ? UINT32_MAX : value;
+    }
+
+    self.totalCount += other.totalCount;
+
+    return YES;
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    ESTCountMinSketch *copy = [[[self class] allocWithZone:zone] initWithWidth:self.width depth:self.depth];
+    memcpy(copy->_counters, _counters, self.width * self.depth * sizeof(uint32_t));
+    copy.totalCount = self.totalCount;
+
+    return copy;
+}
+
+#pragma mark - NSCoding
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+    NSUInteger cells = self.width * self.depth;
+
+    // Counters are stored little-endian so snapshots are portable between gateways.
+    NSMutableData *data = [NSMutableData dataWithLength:cells * sizeof(uint32_t)];
+    uint32_t *out = data.mutableBytes;
+    for (NSUInteger i = 0; i < cells; i++)
+    {
+        out[i] = CFSwapInt32HostToLittle(_counters[i]);
+    }
+
+    [coder encodeInteger:(NSInteger)self.width forKey:@"width"];
+    [coder encodeInteger:(NSInteger)self.depth forKey:@"depth"];
+    [coder encodeInt64:(int64_t)self.totalCount forKey:@"totalCount"];
+    [coder encodeObject:data forKey:@"counters"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    self = [self initWithWidth:(NSUInteger)[decoder decodeIntegerForKey:@"width"]
+                         depth:(NSUInteger)[decoder decodeIntegerForKey:@"depth"]];
+    if (self)
+    {
+        NSData *data = [decoder decodeObjectForKey:@"counters"];
+        NSUInteger cells = self.width * self.depth;
+
+        if (data.length != cells * sizeof(uint32_t))
+        {
+            return nil;
+        }
+
+        const uint32_t *in = data.bytes;
+        for (NSUInteger i = 0; i < cells; i++)
+        {
+            _counters[i] = CFSwapInt32LittleToHost(in[i]);
+        }
+
+        self.totalCount = (uint64_t)[decoder decodeInt64ForKey:@"totalCount"];
+    }
+    return self;
+}
+
+@end
@@ -0,0 +1,159 @@
+//
+//  ESTDeadReckoningFilter.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreMotion/CoreMotion.h>
+#import "ESTHDRHistogram.h"
+
+/*
+ * Single IMU reading. Vertical acceleration is gravity free in g (up is positive),
+ * heading is in radians clockwise from north.
+ */
+typedef struct
+{
+    NSTimeInterval timestamp;
+    float verticalAcceleration;
+    float heading;
+} ESTMotionSample;
+
+/*
+ * Position in venue meters (x east, y north). Uncertainty is the horizontal
+ * standard deviation in meters.
+ */
+typedef struct
+{
+    NSTimeInterval timestamp;
+    double x;
+    double y;
+    double heading;
+    double uncertainty;
+} ESTFusedPosition;
+
+@class ESTDeadReckoningFilter;
+
+@protocol ESTDeadReckoningFilterDelegate <NSObject>
+
+- (void)deadReckoningFilter:(ESTDeadReckoningFilter *)filter didUpdatePosition:(ESTFusedPosition)position;
+
+@optional
+
+- (void)deadReckoningFilter:(ESTDeadReckoningFilter *)filter didDetectStepWithLength:(double)length;
+
+@end
+
+/*
+ * Pedestrian dead reckoning fused with beacon ranging.
+ *
+ * Steps are detected as peaks of low-pass filtered vertical acceleration, step length
+ * follows the Weinberg model K * (max - min)^(1/4). A three state extended Kalman filter
+ * (x, y, heading bias) moves by every step and is corrected by ranges to beacons with
+ * known positions or by position fixes (e.g. from ESTFingerprintLocator). Corrections
+ * failing the innovation gate are dropped.
+ *
+ * Positions are reported at outputRate from the motion stream, between steps extrapolated
+ * with the current cadence up to the expected next step and decayed back when it does
+ * not come, so the position moves smoothly at 20 Hz while ranging arrives at 1 Hz.
+ * Corrections apply to the latest state.
+ *
+ * processMotionSample: does no allocation, all state is kept in plain C fields.
+ * Feeding recorded samples gives the same output as live updates, processingTime
+ * and error histograms measure latency and accuracy of a replay.
+ */
+@interface ESTDeadReckoningFilter : NSObject
+
+@property (nonatomic, weak) id <ESTDeadReckoningFilterDelegate> delegate;
+
+/*
+ * Position updates per second. Default 20.
+ */
+@property (nonatomic, assign) double outputRate;
+
+/*
+ * Weinberg constant, default 0.48. Minimum peak of filtered vertical acceleration
+ * in g (default 0.12) and minimum time between steps (default 0.3 s).
+ */
+@property (nonatomic, assign) double stepLengthConstant;
+@property (nonatomic, assign) double stepThreshold;
+@property (nonatomic, assign) NSTimeInterval minimumStepInterval;
+
+/*
+ * Process noise: step length in m (default 0.1), heading in rad (default 0.1)
+ * and heading bias drift per step (default 0.01 rad).
+ */
+@property (nonatomic, assign) double stepLengthNoise;
+@property (nonatomic, assign) double headingNoise;
+@property (nonatomic, assign) double headingBiasDrift;
+
+/*
+ * Ranges are derived from RSSI with the log-distance model, path loss exponent
+ * defaults to 2. Range noise is rangeNoiseFactor * range + 0.5 m (default factor 0.3).
+ */
+@property (nonatomic, assign) double pathLossExponent;
+@property (nonatomic, assign) double rangeNoiseFactor;
+
+/*
+ * Squared Mahalanobis distance above which corrections are rejected. Default 9.
+ */
+@property (nonatomic, assign) double innovationGate;
+
+@property (nonatomic, assign, readonly, getter = isInitialized) BOOL initialized;
+@property (nonatomic, assign, readonly) ESTFusedPosition position;
+
+@property (nonatomic, assign, readonly) NSUInteger stepCount;
+@property (nonatomic, assign, readonly) NSUInteger acceptedCorrections;
+@property (nonatomic, assign, readonly) NSUInteger rejectedCorrections;
+
+/*
+ * Time spent in processMotionSample: in ns.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *processingTime;
+
+/*
+ * Errors against ground truth in cm, see recordErrorWithTrueX:y:.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *positionError;
+
+/*
+ * Sample for the XMagneticNorthZVertical reference frame, device held roughly flat.
+ * Constant holding offsets are absorbed by the heading bias.
+ */
++ (ESTMotionSample)motionSampleWithDeviceMotion:(CMDeviceMotion *)motion;
+
+- (void)resetToX:(double)x y:(double)y uncertainty:(double)uncertainty;
+
+/*
+ * Beacon position and RSSI at 1 m, identity hash from ESTBeaconIdentity.
+ */
+- (void)addBeaconWithIdentityHash:(uint64_t)identityHash x:(double)x y:(double)y measuredPower:(NSInteger)measuredPower;
+
+- (void)processMotionSample:(ESTMotionSample)sample;
+
+/*
+ * CLBeacon objects from ranging, beacons without known position are ignored.
+ * An uninitialized filter starts at the nearest beacon.
+ */
+- (void)processRangedBeacons:(NSArray *)beacons;
+
+/*
+ * Returns NO if the correction was rejected.
+ */
+- (BOOL)processRange:(double)range toBeaconWithIdentityHash:(uint64_t)identityHash;
+- (BOOL)processPositionFixWithX:(double)x y:(double)y accuracy:(double)accuracy;
+
+/*
+ * Live updates from CMMotionManager at 50 Hz on the main queue.
+ */
+- (void)startDeviceMotionUpdates;
+- (void)stopDeviceMotionUpdates;
+
+/*
+ * Records distance between last reported position and ground truth, returns it in m.
+ */
+- (double)recordErrorWithTrueX:(double)x y:(double)y;
+
+@end
@@ -0,0 +1,518 @@
+//
+//  ESTDeadReckoningFilter.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTDeadReckoningFilter.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+#import <mach/mach_time.h>
+
+#define EST_PDR_GRAVITY             9.80665
+#define EST_PDR_LOW_PASS_CUTOFF     3.0
+#define EST_PDR_MAX_STEP_INTERVAL   2.0
+#define EST_PDR_INITIAL_BIAS_SIGMA  0.5
+#define EST_PDR_MIN_RANGE           0.1
+
+typedef struct
+{
+    double x;
+    double y;
+    double measuredPower;
+} ESTPDRBeacon;
+
+static double ESTPDRNormalizeAngle(double angle)
+{
+    angle = fmod(angle + M_PI, 2 * M_PI);
+
+    return angle < 0 ? angle + M_PI : angle - M_PI;
+}
+
+@interface ESTDeadReckoningFilter ()
+
+@property (nonatomic, assign, readwrite) BOOL initialized;
+@property (nonatomic, assign, readwrite) ESTFusedPosition position;
+@property (nonatomic, assign, readwrite) NSUInteger stepCount;
+@property (nonatomic, assign, readwrite) NSUInteger acceptedCorrections;
+@property (nonatomic, assign, readwrite) NSUInteger rejectedCorrections;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *processingTime;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *positionError;
+
+@property (nonatomic, strong) ESTStructTable *beacons;
+@property (nonatomic, strong) CMMotionManager *motionManager;
+
+@end
+
+@implementation ESTDeadReckoningFilter
+{
+    // State (x, y, heading bias) and its covariance.
+    double _state[3];
+    double _covariance[3][3];
+
+    // Step detector.
+    double _filtered[3];
+    NSUInteger _filteredCount;
+    NSTimeInterval _previousTimestamp;
+    double _valley;
+    NSTimeInterval _lastStepTime;
+    double _lastStepLength;
+    double _stepInterval;
+
+    NSTimeInterval _nextOutputTime;
+    mach_timebase_info_data_t _timebase;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.outputRate = 20;
+        self.stepLengthConstant = 0.48;
+        self.stepThreshold = 0.12;
+        self.minimumStepInterval = 0.3;
+        self.stepLengthNoise = 0.1;
+        self.headingNoise = 0.1;
+        self.headingBiasDrift = 0.01;
+        self.pathLossExponent = 2;
+        self.rangeNoiseFactor = 0.3;
+        self.innovationGate = 9;
+
+        self.beacons = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTPDRBeacon) capacity:64];
+
+        // 1 ns ... 10 s and 1 mm ... 1 km.
+        self.processingTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:10000000000ULL significantBits:7];
+        self.positionError = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:100000 significantBits:7];
+
+        _valley = INFINITY;
+        _stepInterval = 0.5;
+        mach_timebase_info(&_timebase);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self.motionManager stopDeviceMotionUpdates];
+}
+
+#pragma mark - Setup
+
++ (ESTMotionSample)motionSampleWithDeviceMotion:(CMDeviceMotion *)motion
+{
+    CMAcceleration gravity = motion.gravity;
+    CMAcceleration user = motion.userAcceleration;
+
+    double gravityNorm = sqrt(gravity.x * gravity.x + gravity.y * gravity.y + gravity.z * gravity.z);
+    double vertical = 0;
+
+    if (gravityNorm > 0)
+    {
+        // Gravity points down, projection on it gives downward acceleration.
+        vertical = -(user.x * gravity.x + user.y * gravity.y + user.z * gravity.z) / gravityNorm;
+    }
+
+    // Reference X points north and yaw is counterclockwise, top of the device is its Y axis.
+    double heading = fmod(-M_PI_2 - motion.attitude.yaw + 4 * M_PI, 2 * M_PI);
+
+    ESTMotionSample sample = { motion.timestamp, (float)vertical, (float)heading };
+
+    return sample;
+}
+
+- (void)resetToX:(double)x y:(double)y uncertainty:(double)uncertainty
+{
+    double bias = self.initialized ? _state[2] : 0;
+    double biasVariance = self.initialized ? _covariance[2][2] : EST_PDR_INITIAL_BIAS_SIGMA * EST_PDR_INITIAL_BIAS_SIGMA;
+
+    memset(_covariance, 0, sizeof(_covariance));
+
+    _state[0] = x;
+    _state[1] = y;
+    _state[2] = bias;
+    _covariance[0][0] = uncertainty * uncertainty;
+    _covariance[1][1] = uncertainty * uncertainty;
+    _covariance[2][2] = biasVariance;
+
+    self.initialized = YES;
+
+    ESTFusedPosition position = self.position;
+    position.x = x;
+    position.y = y;
+    position.uncertainty = uncertainty * M_SQRT2;
+    self.position = position;
+}
+
+- (void)addBeaconWithIdentityHash:(uint64_t)identityHash x:(double)x y:(double)y measuredPower:(NSInteger)measuredPower
+{
+    ESTPDRBeacon *beacon = [self.beacons insertValueForKey:identityHash created:NULL];
+    beacon->x = x;
+    beacon->y = y;
+    beacon->measuredPower = measuredPower;
+}
+
+#pragma mark - Motion
+
+- (void)processMotionSample:(ESTMotionSample)sample
+{
+    uint64_t start = mach_absolute_time();
+
+    double dt = _filteredCount > 0 ? sample.timestamp - _previousTimestamp : 0;
+
+    if (_filteredCount > 0 && dt <= 0)
+    {
+        return;
+    }
+
+    double rc = 1.0 / (2 * M_PI * EST_PDR_LOW_PASS_CUTOFF);
+    double alpha = _filteredCount > 0 ? dt / (rc + dt) : 1;
+
+    _filtered[0] = _filtered[1];
+    _filtered[1] = _filtered[2];
+    _filtered[2] = _filtered[2] + alpha * (sample.verticalAcceleration - _filtered[2]);
+    _filteredCount++;
+
+    _valley = MIN(_valley, _filtered[2]);
+
+    // Local maximum of the previous sample.
+    if (_filteredCount >= 3 && _filtered[1] > _filtered[0] && _filtered[1] >= _filtered[2] &&
+        _filtered[1] > self.stepThreshold && _previousTimestamp - _lastStepTime >= self.minimumStepInterval)
+    {
+        [self stepAtTime:_previousTimestamp amplitude:_filtered[1] - MIN(_valley, 0) heading:sample.heading];
+    }
+
+    _previousTimestamp = sample.timestamp;
+
+    if (self.initialized && sample.timestamp >= _nextOutputTime)
+    {
+        [self outputAtTime:sample.timestamp heading:sample.heading];
+
+        double period = 1.0 / MAX(self.outputRate, 0.1);
+        _nextOutputTime = MAX(_nextOutputTime + period, sample.timestamp);
+    }
+
+    uint64_t elapsed = mach_absolute_time() - start;
+    [self.processingTime recordValue:elapsed * _timebase.numer / _timebase.denom];
+}
+
+- (void)stepAtTime:(NSTimeInterval)timestamp amplitude:(double)amplitude heading:(double)heading
+{
+    double length = self.stepLengthConstant * pow(amplitude * EST_PDR_GRAVITY, 0.25);
+    double interval = timestamp - _lastStepTime;
+
+    if (interval < EST_PDR_MAX_STEP_INTERVAL)
+    {
+        _stepInterval = 0.7 * _stepInterval + 0.3 * interval;
+    }
+
+    _lastStepTime = timestamp;
+    _lastStepLength = length;
+    _valley = INFINITY;
+    self.stepCount++;
+
+    if (self.initialized)
+    {
+        [self predictStepWithLength:length heading:heading];
+    }
+
+    if ([self.delegate respondsToSelector:@selector(deadReckoningFilter:didDetectStepWithLength:)])
+    {
+        [self.delegate deadReckoningFilter:self didDetectStepWithLength:length];
+    }
+}
+
+- (void)outputAtTime:(NSTimeInterval)timestamp heading:(double)heading
+{
+    double course = heading + _state[2];
+    double phase = (timestamp - _lastStepTime) / _stepInterval;
+    double advance = 0;
+
+    // Walking: move along the current course with the step cadence up to the expected time
+    // of the next step. Without a step the advance decays back to zero over one interval,
+    // so stopping does not leave the position a step ahead and then snap back.
+    if (self.stepCount > 0)
+    {
+        advance = _lastStepLength * (phase <= 1 ? MAX(phase, 0.0) : MAX(2 - phase, 0.0));
+    }
+
+    ESTFusedPosition position;
+    position.timestamp = timestamp;
+    position.x = _state[0] + advance * sin(course);
+    position.y = _state[1] + advance * cos(course);
+    position.heading = fmod(course + 4 * M_PI, 2 * M_PI);
+    position.uncertainty = sqrt(_covariance[0][0] + _covariance[1][1]);
+
+    self.position = position;
+
+    [self.delegate deadReckoningFilter:self didUpdatePosition:position];
+}
+
+#pragma mark - Kalman filter
+
+- (void)predictStepWithLength:(double)length heading:(double)heading
+{
+    double course = heading + _state[2];
+    double s = sin(course);
+    double c = cos(course);
+
+    _state[0] += length * s;
+    _state[1] += length * c;
+
+    // P = F P F^T + Q, F is identity with d(x, y)/d(bias) in the last column.
+    double f0 = length * c;
+    double f1 = -length * s;
+    double p[3][3];
+
+    memcpy(p, _covariance, sizeof(p));
+
+    _covariance[0][0] = p[0][0] + 2 * f0 * p[0][2] + f0 * f0 * p[2][2];
+    _covariance[0][1] = p[0][1] + f0 * p[1][2] + f1 * p[0][2] + f0 * f1 * p[2][2];
+    _covariance[1][1] = p[1][1] + 2 * f1 * p[1][2] + f1 * f1 * p[2][2];
+    _covariance[0][2] = p[0][2] + f0 * p[2][2];
+    _covariance[1][2] = p[1][2] + f1 * p[2][2];
+
+    double lengthVariance = self.stepLengthNoise * self.stepLengthNoise;
+    double headingVariance = self.headingNoise * self.headingNoise * length * length;
+
+    _covariance[0][0] += s * s * lengthVariance + c * c * headingVariance;
+    _covariance[0][1] += s * c * (lengthVariance - headingVariance);
+    _covariance[1][1] += c * c * lengthVariance + s * s * headingVariance;
+    _covariance[2][2] += self.headingBiasDrift * self.headingBiasDrift;
+
+    _covariance[1][0] = _covariance[0][1];
+    _covariance[2][0] = _covariance[0][2];
+    _covariance[2][1] = _covariance[1][2];
+}
+
+- (void)updateWithGain:(const double *)gain innovation:(double)innovation covarianceRow:(const double *)row
+{
+    for (NSUInteger i = 0; i < 3; i++)
+    {
+        _state[i] += gain[i] * innovation;
+
+        for (NSUInteger j = 0; j < 3; j++)
+        {
+            _covariance[i][j] -= gain[i] * row[j];
+        }
+    }
+}
+
+- (void)symmetrizeCovariance
+{
+    for (NSUInteger i = 0; i < 3; i++)
+    {
+        for (NSUInteger j = i + 1; j < 3; j++)
+        {
+            double mean = 0.5 * (_covariance[i][j] + _covariance[j][i]);
+            _covariance[i][j] = mean;
+            _covariance[j][i] = mean;
+        }
+    }
+
+    _state[2] = ESTPDRNormalizeAngle(_state[2]);
+}
+
+#pragma mark - Corrections
+
+- (double)rangeForRSSI:(NSInteger)rssi measuredPower:(double)measuredPower
+{
+    return pow(10.0, (measuredPower - rssi) / (10.0 * self.pathLossExponent));
+}
+
+- (void)processRangedBeacons:(NSArray *)beacons
+{
+    if (!self.initialized)
+    {
+        ESTPDRBeacon *nearest = NULL;
+        double nearestRange = INFINITY;
+
+        for (CLBeacon *beacon in beacons)
+        {
+            ESTPDRBeacon *known = [self.beacons valueForKey:ESTBeaconIdentityHashCLBeacon(beacon)];
+
+            if (!known || beacon.rssi >= 0)
+            {
+                continue;
+            }
+
+            double range = [self rangeForRSSI:beacon.rssi measuredPower:known->measuredPower];
+
+            if (range < nearestRange)
+            {
+                nearest = known;
+                nearestRange = range;
+            }
+        }
+
+        if (!nearest)
+        {
+            return;
+        }
+
+        [self resetToX:nearest->x y:nearest->y uncertainty:MAX(nearestRange, 1.0)];
+    }
+
+    for (CLBeacon *beacon in beacons)
+    {
+        uint64_t identityHash = ESTBeaconIdentityHashCLBeacon(beacon);
+        ESTPDRBeacon *known = [self.beacons valueForKey:identityHash];
+
+        if (known && beacon.rssi < 0)
+        {
+            [self processRange:[self rangeForRSSI:beacon.rssi measuredPower:known->measuredPower]
+      toBeaconWithIdentityHash:identityHash];
+        }
+    }
+}
+
+- (BOOL)processRange:(double)range toBeaconWithIdentityHash:(uint64_t)identityHash
+{
+    ESTPDRBeacon *beacon = [self.beacons valueForKey:identityHash];
+
+    if (!beacon || !self.initialized)
+    {
+        return NO;
+    }
+
+    double dx = _state[0] - beacon->x;
+    double dy = _state[1] - beacon->y;
+    double predicted = MAX(sqrt(dx * dx + dy * dy), EST_PDR_MIN_RANGE);
+
+    // H = [dx / r, dy / r, 0], HP is the first two rows weighted by H.
+    double h0 = dx / predicted;
+    double h1 = dy / predicted;
+    double row[3];
+
+    for (NSUInteger j = 0; j < 3; j++)
+    {
+        row[j] = h0 * _covariance[0][j] + h1 * _covariance[1][j];
+    }
+
+    double noise = self.rangeNoiseFactor * range + 0.5;
+    double innovationVariance = h0 * row[0] + h1 * row[1] + noise * noise;
+    double innovation = range - predicted;
+
+    if (innovation * innovation > self.innovationGate * innovationVariance)
+    {
+        self.rejectedCorrections++;
+        return NO;
+    }
+
+    double gain[3] = { row[0] / innovationVariance, row[1] / innovationVariance, row[2] / innovationVariance };
+
+    [self updateWithGain:gain innovation:innovation covarianceRow:row];
+    [self symmetrizeCovariance];
+
+    self.acceptedCorrections++;
+
+    return YES;
+}
+
+- (BOOL)processPositionFixWithX:(double)x y:(double)y accuracy:(double)accuracy
+{
+    if (!self.initialized)
+    {
+        [self resetToX:x y:y uncertainty:accuracy];
+        return YES;
+    }
+
+    double noise = accuracy * accuracy;
+    double s00 = _covariance[0][0] + noise;
+    double s01 = _covariance[0][1];
+    double s11 = _covariance[1][1] + noise;
+    double determinant = s00 * s11 - s01 * s01;
+
+    if (determinant <= 0)
+    {
+        return NO;
+    }
+
+    double i00 = s11 / determinant;
+    double i01 = -s01 / determinant;
+    double i11 = s00 / determinant;
+
+    double nx = x - _state[0];
+    double ny = y - _state[1];
+
+    if (nx * (i00 * nx + i01 * ny) + ny * (i01 * nx + i11 * ny) > self.innovationGate)
+    {
+        self.rejectedCorrections++;
+        return NO;
+    }
+
+    // K = P[:, 0..1] S^-1, so K H P is the sum of two rank one terms built from the prior rows.
+    double rowX[3];
+    double rowY[3];
+    double gainX[3];
+    double gainY[3];
+
+    for (NSUInteger i = 0; i < 3; i++)
+    {
+        rowX[i] = _covariance[0][i];
+        rowY[i] = _covariance[1][i];
+        gainX[i] = _covariance[i][0] * i00 + _covariance[i][1] * i01;
+        gainY[i] = _covariance[i][0] * i01 + _covariance[i][1] * i11;
+    }
+
+    [self updateWithGain:gainX innovation:nx covarianceRow:rowX];
+    [self updateWithGain:gainY innovation:ny covarianceRow:rowY];
+    [self symmetrizeCovariance];
+
+    self.acceptedCorrections++;
+
+    return YES;
+}
+
+#pragma mark - Live updates
+
+- (void)startDeviceMotionUpdates
+{
+    if (!self.motionManager)
+    {
+        self.motionManager = [[CMMotionManager alloc] init];
+        self.motionManager.deviceMotionUpdateInterval = 1.0 / 50;
+    }
+
+    CMAttitudeReferenceFrame frame = CMAttitudeReferenceFrameXMagneticNorthZVertical;
+
+    if (!([CMMotionManager availableAttitudeReferenceFrames] & frame))
+    {
+        // Arbitrary yaw is a constant heading offset, the bias state takes it up.
+        frame = CMAttitudeReferenceFrameXArbitraryCorrectedZVertical;
+    }
+
+    __weak ESTDeadReckoningFilter *weakSelf = self;
+
+    [self.motionManager startDeviceMotionUpdatesUsingReferenceFrame:frame
+                                                            toQueue:[NSOperationQueue mainQueue]
+                                                        withHandler:^(CMDeviceMotion *motion, NSError *error) {
+
+        if (motion)
+        {
+            [weakSelf processMotionSample:[ESTDeadReckoningFilter motionSampleWithDeviceMotion:motion]];
+        }
+    }];
+}
+
+- (void)stopDeviceMotionUpdates
+{
+    [self.motionManager stopDeviceMotionUpdates];
+}
+
+#pragma mark - Metrics
+
+- (double)recordErrorWithTrueX:(double)x y:(double)y
+{
+    double dx = self.position.x - x;
+    double dy = self.position.y - y;
+    double error = sqrt(dx * dx + dy * dy);
+
+    [self.positionError recordValue:(uint64_t)llround(error * 100)];
+
+    return error;
+}
+
+@end
@@ -0,0 +1,164 @@
+//
+//  ESTDeviceTable.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+/*
+ * Queryable device fields, all stored as 64-bit integers.
+ */
+typedef NS_ENUM(NSUInteger, ESTDeviceField)
+{
+    /*
+     * ESTColor.
+     */
+    ESTDeviceFieldColor,
+
+    /*
+     * ESTNearableType.
+     */
+    ESTDeviceFieldNearableType,
+
+    /*
+     * ESTSketchHashString of the version string.
+     */
+    ESTDeviceFieldFirmwareVersion,
+
+    /*
+     * Millivolts.
+     */
+    ESTDeviceFieldBatteryVoltage,
+
+    /*
+     * CLProximity or ESTNearableZone, both number Unknown, Immediate, Near, Far alike.
+     */
+    ESTDeviceFieldProximity,
+
+    /*
+     * ESTSketchHashString of the region identifier.
+     */
+    ESTDeviceFieldRegion,
+
+    ESTDeviceFieldRSSI,
+
+    ESTDeviceFieldCount
+};
+
+/*
+ * Value of fields never reported for a device.
+ */
+#define ESTDeviceValueUnknown INT64_MIN
+
+typedef NS_ENUM(NSInteger, ESTDeviceIndexKind)
+{
+    ESTDeviceIndexKindNone,
+
+    /*
+     * Value -> devices, answers equality.
+     */
+    ESTDeviceIndexKindHash,
+
+    /*
+     * Hash index plus sorted distinct values, answers ranges too.
+     */
+    ESTDeviceIndexKindSorted
+};
+
+/*
+ * Conjunction of field ranges, equality is a range of one value. Immutable, every
+ * refinement returns a new query.
+ */
+@interface ESTDeviceQuery : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger termCount;
+
++ (instancetype)queryWithField:(ESTDeviceField)field equalTo:(int64_t)value;
++ (instancetype)queryWithField:(ESTDeviceField)field from:(int64_t)minimum to:(int64_t)maximum;
+
+- (instancetype)queryAndField:(ESTDeviceField)field equalTo:(int64_t)value;
+- (instancetype)queryAndField:(ESTDeviceField)field from:(int64_t)minimum to:(int64_t)maximum;
+
+@end
+
+/*
+ * Standing query registration, handler receives identity hashes (NSNumber) that
+ * started or stopped matching. Initial matches are delivered on subscription.
+ */
+@interface ESTDeviceSubscription : NSObject
+
+@property (nonatomic, strong, readonly) ESTDeviceQuery *query;
+
+@end
+
+typedef void (^ESTDeviceSubscriptionHandler)(NSArray *added, NSArray *removed);
+
+/*
+ * Live table of ranged devices with secondary indexes, replacing NSPredicate
+ * filtering of NSArrays in every callback.
+ *
+ * Rows are dense C records keyed by identity hash. Indexed fields map values to
+ * posting lists of rows, rows remember their position in each list, so an update
+ * moves a row between lists in O(1), plus O(log n) in sorted indexes when the value
+ * was not seen before. A query takes the term with the smallest index estimate as
+ * the driver and checks the other terms on the rows it yields.
+ *
+ * Subscriptions are evaluated on every change against old and new values, their
+ * deltas are collected and delivered when the update (or processing batch) ends.
+ */
+@interface ESTDeviceTable : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger deviceCount;
+
+/*
+ * Hash indexes on color, type, firmware, proximity and region, sorted on battery and RSSI.
+ */
+- (instancetype)init;
+
+/*
+ * Rebuilds the index of the field.
+ */
+- (void)setIndexKind:(ESTDeviceIndexKind)kind forField:(ESTDeviceField)field;
+- (ESTDeviceIndexKind)indexKindForField:(ESTDeviceField)field;
+
+/*
+ * Values has ESTDeviceFieldCount entries, ESTDeviceValueUnknown keeps the stored value.
+ */
+- (void)updateDevice:(uint64_t)identityHash values:(const int64_t *)values timestamp:(NSTimeInterval)timestamp;
+
+- (void)updateDevice:(uint64_t)identityHash field:(ESTDeviceField)field value:(int64_t)value timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * ESTNearable objects hashed by identifier.
+ */
+- (void)processNearables:(NSArray *)nearables timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * CLBeacon objects hashed with ESTBeaconIdentity.
+ */
+- (void)processRangedBeacons:(NSArray *)beacons inRegion:(CLBeaconRegion *)region timestamp:(NSTimeInterval)timestamp;
+
+- (void)removeDevice:(uint64_t)identityHash;
+- (NSUInteger)removeDevicesIdleForTimeout:(NSTimeInterval)timeout atTime:(NSTimeInterval)time;
+
+- (int64_t)valueOfField:(ESTDeviceField)field forDevice:(uint64_t)identityHash;
+
+/*
+ * The table must not be modified from the block.
+ */
+- (void)enumerateDevicesMatchingQuery:(ESTDeviceQuery *)query usingBlock:(void (^)(uint64_t identityHash, BOOL *stop))block;
+
+/*
+ * Identity hashes (NSNumber).
+ */
+- (NSArray *)devicesMatchingQuery:(ESTDeviceQuery *)query;
+- (NSUInteger)countOfDevicesMatchingQuery:(ESTDeviceQuery *)query;
+
+- (ESTDeviceSubscription *)subscribeToQuery:(ESTDeviceQuery *)query handler:(ESTDeviceSubscriptionHandler)handler;
+- (void)unsubscribe:(ESTDeviceSubscription *)subscription;
+
+@end
@@ -0,0 +1,822 @@
+//
+//  ESTDeviceTable.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTDeviceTable.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTSketchHash.h"
+#import "ESTStructTable.h"
+
+#define EST_DEVICE_NO_ROW       UINT32_MAX
+#define EST_DEVICE_RSSI_ERROR   127
+
+typedef struct
+{
+    ESTDeviceField field;
+    int64_t minimum;
+    int64_t maximum;
+} ESTDeviceTerm;
+
+typedef struct
+{
+    uint64_t identityHash;
+    NSTimeInterval lastSeen;
+    int64_t values[ESTDeviceFieldCount];
+    uint32_t slots[ESTDeviceFieldCount];
+} ESTDeviceRow;
+
+typedef struct
+{
+    uint32_t index;
+} ESTDeviceRowEntry;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t *rows;
+} ESTDevicePosting;
+
+/*
+ * Net change of a device in a subscription since the last delivery.
+ */
+typedef struct
+{
+    int32_t delta;
+} ESTDevicePendingChange;
+
+static BOOL ESTDeviceRowMatches(const ESTDeviceRow *row, const ESTDeviceTerm *terms, NSUInteger count)
+{
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        int64_t value = row->values[terms[i].field];
+
+        if (value < terms[i].minimum || value > terms[i].maximum)
+        {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+#pragma mark - ESTDeviceQuery
+
+@interface ESTDeviceQuery ()
+
+@property (nonatomic, strong) NSData *terms;
+
+@end
+
+@implementation ESTDeviceQuery
+
++ (instancetype)queryWithField:(ESTDeviceField)field equalTo:(int64_t)value
+{
+    return [self queryWithField:field from:value to:value];
+}
+
++ (instancetype)queryWithField:(ESTDeviceField)field from:(int64_t)minimum to:(int64_t)maximum
+{
+    ESTDeviceQuery *query = [self new];
+    query.terms = [NSData data];
+
+    return [query queryAndField:field from:minimum to:maximum];
+}
+
+- (instancetype)queryAndField:(ESTDeviceField)field equalTo:(int64_t)value
+{
+    return [self queryAndField:field from:value to:value];
+}
+
+- (instancetype)queryAndField:(ESTDeviceField)field from:(int64_t)minimum to:(int64_t)maximum
+{
+    NSAssert(field < ESTDeviceFieldCount, @"Unknown device field");
+
+    ESTDeviceTerm term = { field, minimum, maximum };
+    NSMutableData *terms = [self.terms mutableCopy];
+    [terms appendBytes:&term length:sizeof(term)];
+
+    ESTDeviceQuery *query = [[self class] new];
+    query.terms = terms;
+
+    return query;
+}
+
+- (NSUInteger)termCount
+{
+    return self.terms.length / sizeof(ESTDeviceTerm);
+}
+
+@end
+
+#pragma mark - ESTDeviceSubscription
+
+@interface ESTDeviceSubscription ()
+
+@property (nonatomic, strong, readwrite) ESTDeviceQuery *query;
+@property (nonatomic, copy) ESTDeviceSubscriptionHandler handler;
+@property (nonatomic, strong) ESTStructTable *pending;
+
+@end
+
+@implementation ESTDeviceSubscription
+
+- (void)recordDevice:(uint64_t)identityHash delta:(int32_t)delta
+{
+    ESTDevicePendingChange *change = [self.pending insertValueForKey:identityHash created:NULL];
+    change->delta += delta;
+
+    // Added and removed again within one delivery is no change.
+    if (change->delta == 0)
+    {
+        [self.pending removeValueForKey:identityHash];
+    }
+}
+
+@end
+
+#pragma mark - ESTDeviceIndex
+
+@interface ESTDeviceIndex : NSObject
+
+@property (nonatomic, assign) ESTDeviceIndexKind kind;
+
+/*
+ * Value -> ESTDevicePosting. Lists emptied by updates are kept for reuse.
+ */
+@property (nonatomic, strong) ESTStructTable *postings;
+
+@end
+
+@implementation ESTDeviceIndex
+{
+    int64_t *_keys;
+    NSUInteger _keyCount;
+    NSUInteger _keyCapacity;
+}
+
+- (instancetype)initWithKind:(ESTDeviceIndexKind)kind
+{
+    self = [super init];
+    if (self)
+    {
+        self.kind = kind;
+        self.postings = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTDevicePosting) capacity:64];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self.postings enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+        free(((ESTDevicePosting *)value)->rows);
+    }];
+
+    free(_keys);
+}
+
+/*
+ * First sorted key not below value.
+ */
+- (NSUInteger)lowerBound:(int64_t)value
+{
+    NSUInteger low = 0;
+    NSUInteger high = _keyCount;
+
+    while (low < high)
+    {
+        NSUInteger middle = low + (high - low) / 2;
+
+        if (_keys[middle] < value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+- (void)insertKey:(int64_t)value
+{
+    if (_keyCount == _keyCapacity)
+    {
+        _keyCapacity = MAX(_keyCapacity * 2, (NSUInteger)64);
+        _keys = realloc(_keys, _keyCapacity * sizeof(int64_t));
+    }
+
+    NSUInteger position = [self lowerBound:value];
+
+    memmove(&_keys[position + 1], &_keys[position], (_keyCount - position) * sizeof(int64_t));
+    _keys[position] = value;
+    _keyCount++;
+}
+
+/*
+ * Returns the slot of the row in the list of value.
+ */
+- (uint32_t)addRow:(uint32_t)row value:(int64_t)value
+{
+    BOOL created;
+    ESTDevicePosting *posting = [self.postings insertValueForKey:(uint64_t)value created:&created];
+
+    if (created && self.kind == ESTDeviceIndexKindSorted)
+    {
+        [self insertKey:value];
+    }
+
+    if (posting->count == posting->capacity)
+    {
+        posting->capacity = MAX(posting->capacity * 2, (uint32_t)4);
+        posting->rows = realloc(posting->rows, posting->capacity * sizeof(uint32_t));
+    }
+
+    posting->rows[posting->count] = row;
+
+    return posting->count++;
+}
+
+/*
+ * Swap-removes the slot, returns the row moved into it or EST_DEVICE_NO_ROW.
+ */
+- (uint32_t)removeSlot:(uint32_t)slot value:(int64_t)value
+{
+    ESTDevicePosting *posting = [self.postings valueForKey:(uint64_t)value];
+    uint32_t last = --posting->count;
+
+    if (slot == last)
+    {
+        return EST_DEVICE_NO_ROW;
+    }
+
+    posting->rows[slot] = posting->rows[last];
+
+    return posting->rows[slot];
+}
+
+- (void)setRow:(uint32_t)row atSlot:(uint32_t)slot value:(int64_t)value
+{
+    ESTDevicePosting *posting = [self.postings valueForKey:(uint64_t)value];
+    posting->rows[slot] = row;
+}
+
+- (BOOL)answersTerm:(const ESTDeviceTerm *)term
+{
+    return term->minimum == term->maximum || self.kind == ESTDeviceIndexKindSorted;
+}
+
+/*
+ * Rows in [minimum, maximum], counting stops above limit.
+ */
+- (NSUInteger)countFrom:(int64_t)minimum to:(int64_t)maximum limit:(NSUInteger)limit
+{
+    if (minimum == maximum)
+    {
+        ESTDevicePosting *posting = [self.postings valueForKey:(uint64_t)minimum];
+        return posting ? posting->count : 0;
+    }
+
+    NSUInteger count = 0;
+
+    for (NSUInteger i = [self lowerBound:minimum]; i < _keyCount && _keys[i] <= maximum && count <= limit; i++)
+    {
+        count += ((ESTDevicePosting *)[self.postings valueForKey:(uint64_t)_keys[i]])->count;
+    }
+
+    return count;
+}
+
+- (void)enumerateRowsFrom:(int64_t)minimum to:(int64_t)maximum usingBlock:(void (^)(uint32_t row, BOOL *stop))block
+{
+    BOOL stop = NO;
+
+    if (minimum == maximum)
+    {
+        ESTDevicePosting *posting = [self.postings valueForKey:(uint64_t)minimum];
+
+        for (uint32_t i = 0; posting && i < posting->count && !stop; i++)
+        {
+            block(posting->rows[i], &stop);
+        }
+
+        return;
+    }
+
+    for (NSUInteger k = [self lowerBound:minimum]; k < _keyCount && _keys[k] <= maximum && !stop; k++)
+    {
+        ESTDevicePosting *posting = [self.postings valueForKey:(uint64_t)_keys[k]];
+
+        for (uint32_t i = 0; i < posting->count && !stop; i++)
+        {
+            block(posting->rows[i], &stop);
+        }
+    }
+}
+
+@end
+
+#pragma mark - ESTDeviceTable
+
+@interface ESTDeviceTable ()
+
+@property (nonatomic, strong) ESTStructTable *rowEntries;
+
+/*
+ * ESTDeviceIndex or NSNull per field.
+ */
+@property (nonatomic, strong) NSMutableArray *indexes;
+
+@property (nonatomic, strong) NSMutableArray *subscriptions;
+
+@end
+
+@implementation ESTDeviceTable
+{
+    ESTDeviceRow *_rows;
+    NSUInteger _rowCount;
+    NSUInteger _rowCapacity;
+    NSUInteger _updateDepth;
+
+    // Owned by indexes, nil for unindexed fields.
+    __unsafe_unretained ESTDeviceIndex *_index[ESTDeviceFieldCount];
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.rowEntries = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTDeviceRowEntry) capacity:1024];
+        self.subscriptions = [NSMutableArray array];
+        self.indexes = [NSMutableArray arrayWithCapacity:ESTDeviceFieldCount];
+
+        for (NSUInteger field = 0; field < ESTDeviceFieldCount; field++)
+        {
+            [self.indexes addObject:[NSNull null]];
+        }
+
+        [self setIndexKind:ESTDeviceIndexKindHash forField:ESTDeviceFieldColor];
+        [self setIndexKind:ESTDeviceIndexKindHash forField:ESTDeviceFieldNearableType];
+        [self setIndexKind:ESTDeviceIndexKindHash forField:ESTDeviceFieldFirmwareVersion];
+        [self setIndexKind:ESTDeviceIndexKindHash forField:ESTDeviceFieldProximity];
+        [self setIndexKind:ESTDeviceIndexKindHash forField:ESTDeviceFieldRegion];
+        [self setIndexKind:ESTDeviceIndexKindSorted forField:ESTDeviceFieldBatteryVoltage];
+        [self setIndexKind:ESTDeviceIndexKindSorted forField:ESTDeviceFieldRSSI];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_rows);
+}
+
+- (NSUInteger)deviceCount
+{
+    return _rowCount;
+}
+
+#pragma mark - Indexes
+
+- (void)setIndexKind:(ESTDeviceIndexKind)kind forField:(ESTDeviceField)field
+{
+    NSAssert(field < ESTDeviceFieldCount, @"Unknown device field");
+
+    if (kind == ESTDeviceIndexKindNone)
+    {
+        self.indexes[field] = [NSNull null];
+        _index[field] = nil;
+        return;
+    }
+
+    ESTDeviceIndex *index = [[ESTDeviceIndex alloc] initWithKind:kind];
+
+    for (uint32_t row = 0; row < _rowCount; row++)
+    {
+        _rows[row].slots[field] = [index addRow:row value:_rows[row].values[field]];
+    }
+
+    self.indexes[field] = index;
+    _index[field] = index;
+}
+
+- (ESTDeviceIndexKind)indexKindForField:(ESTDeviceField)field
+{
+    return _index[field] ? _index[field].kind : ESTDeviceIndexKindNone;
+}
+
+#pragma mark - Updates
+
+- (uint32_t)insertRowForDevice:(uint64_t)identityHash
+{
+    if (_rowCount == _rowCapacity)
+    {
+        _rowCapacity = MAX(_rowCapacity * 2, (NSUInteger)1024);
+        _rows = realloc(_rows, _rowCapacity * sizeof(ESTDeviceRow));
+    }
+
+    uint32_t index = (uint32_t)_rowCount++;
+    ESTDeviceRow *row = &_rows[index];
+
+    row->identityHash = identityHash;
+    row->lastSeen = 0;
+
+    for (NSUInteger field = 0; field < ESTDeviceFieldCount; field++)
+    {
+        row->values[field] = ESTDeviceValueUnknown;
+        row->slots[field] = _index[field] ? [_index[field] addRow:index value:ESTDeviceValueUnknown] : 0;
+    }
+
+    return index;
+}
+
+- (void)applyValues:(const int64_t *)values toDevice:(uint64_t)identityHash timestamp:(NSTimeInterval)timestamp
+{
+    BOOL created;
+    ESTDeviceRowEntry *entry = [self.rowEntries insertValueForKey:identityHash created:&created];
+
+    if (created)
+    {
+        entry->index = [self insertRowForDevice:identityHash];
+    }
+
+    uint32_t index = entry->index;
+    ESTDeviceRow *row = &_rows[index];
+    ESTDeviceRow old = *row;
+    BOOL changed = created;
+
+    row->lastSeen = MAX(row->lastSeen, timestamp);
+
+    for (NSUInteger field = 0; field < ESTDeviceFieldCount; field++)
+    {
+        int64_t value = values[field];
+
+        if (value == ESTDeviceValueUnknown || value == row->values[field])
+        {
+            continue;
+        }
+
+        ESTDeviceIndex *fieldIndex = _index[field];
+
+        if (fieldIndex)
+        {
+            uint32_t moved = [fieldIndex removeSlot:row->slots[field] value:row->values[field]];
+
+            if (moved != EST_DEVICE_NO_ROW)
+            {
+                _rows[moved].slots[field] = row->slots[field];
+            }
+
+            row->slots[field] = [fieldIndex addRow:index value:value];
+        }
+
+        row->values[field] = value;
+        changed = YES;
+    }
+
+    if (!changed)
+    {
+        return;
+    }
+
+    for (ESTDeviceSubscription *subscription in self.subscriptions)
+    {
+        const ESTDeviceTerm *terms = subscription.query.terms.bytes;
+        NSUInteger termCount = subscription.query.termCount;
+
+        BOOL before = !created && ESTDeviceRowMatches(&old, terms, termCount);
+        BOOL after = ESTDeviceRowMatches(row, terms, termCount);
+
+        if (before != after)
+        {
+            [subscription recordDevice:identityHash delta:after ? 1 : -1];
+        }
+    }
+}
+
+- (void)beginUpdates
+{
+    _updateDepth++;
+}
+
+- (void)endUpdates
+{
+    if (--_updateDepth > 0)
+    {
+        return;
+    }
+
+    NSMutableArray *deliveries = [NSMutableArray array];
+
+    for (ESTDeviceSubscription *subscription in self.subscriptions)
+    {
+        if (subscription.pending.count == 0)
+        {
+            continue;
+        }
+
+        NSMutableArray *added = [NSMutableArray array];
+        NSMutableArray *removed = [NSMutableArray array];
+
+        [subscription.pending enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+            if (((ESTDevicePendingChange *)value)->delta > 0)
+            {
+                [added addObject:@(key)];
+            }
+            else
+            {
+                [removed addObject:@(key)];
+            }
+        }];
+
+        [subscription.pending removeAllValues];
+        [deliveries addObject:@[ subscription, added, removed ]];
+    }
+
+    // Handlers may update the table, so they run once all deltas were taken.
+    for (NSArray *delivery in deliveries)
+    {
+        ESTDeviceSubscription *subscription = delivery[0];
+        subscription.handler(delivery[1], delivery[2]);
+    }
+}
+
+- (void)updateDevice:(uint64_t)identityHash values:(const int64_t *)values timestamp:(NSTimeInterval)timestamp
+{
+    [self beginUpdates];
+    [self applyValues:values toDevice:identityHash timestamp:timestamp];
+    [self endUpdates];
+}
+
+- (void)updateDevice:(uint64_t)identityHash field:(ESTDeviceField)field value:(int64_t)value timestamp:(NSTimeInterval)timestamp
+{
+    int64_t values[ESTDeviceFieldCount];
+
+    for (NSUInteger i = 0; i < ESTDeviceFieldCount; i++)
+    {
+        values[i] = ESTDeviceValueUnknown;
+    }
+
+    values[field] = value;
+
+    [self updateDevice:identityHash values:values timestamp:timestamp];
+}
+
+- (void)processNearables:(NSArray *)nearables timestamp:(NSTimeInterval)timestamp
+{
+    [self beginUpdates];
+
+    for (ESTNearable *nearable in nearables)
+    {
+        int64_t values[ESTDeviceFieldCount];
+
+        values[ESTDeviceFieldColor] = nearable.color;
+        values[ESTDeviceFieldNearableType] = nearable.type;
+        values[ESTDeviceFieldFirmwareVersion] = nearable.firmwareVersion ? (int64_t)ESTSketchHashString(nearable.firmwareVersion) : ESTDeviceValueUnknown;
+        values[ESTDeviceFieldBatteryVoltage] = nearable.idleBatteryVoltage ? llround(nearable.idleBatteryVoltage.doubleValue * 1000) : ESTDeviceValueUnknown;
+        values[ESTDeviceFieldProximity] = nearable.zone;
+        values[ESTDeviceFieldRegion] = ESTDeviceValueUnknown;
+        values[ESTDeviceFieldRSSI] = nearable.rssi == EST_DEVICE_RSSI_ERROR ? ESTDeviceValueUnknown : nearable.rssi;
+
+        [self applyValues:values toDevice:ESTSketchHashString(nearable.identifier) timestamp:timestamp];
+    }
+
+    [self endUpdates];
+}
+
+- (void)processRangedBeacons:(NSArray *)beacons inRegion:(CLBeaconRegion *)region timestamp:(NSTimeInterval)timestamp
+{
+    int64_t regionHash = region.identifier ? (int64_t)ESTSketchHashString(region.identifier) : ESTDeviceValueUnknown;
+
+    [self beginUpdates];
+
+    for (CLBeacon *beacon in beacons)
+    {
+        int64_t values[ESTDeviceFieldCount];
+
+        for (NSUInteger i = 0; i < ESTDeviceFieldCount; i++)
+        {
+            values[i] = ESTDeviceValueUnknown;
+        }
+
+        values[ESTDeviceFieldProximity] = beacon.proximity;
+        values[ESTDeviceFieldRegion] = regionHash;
+
+        // Zero RSSI means the beacon was not heard in the last ranging interval.
+        if (beacon.rssi < 0)
+        {
+            values[ESTDeviceFieldRSSI] = beacon.rssi;
+        }
+
+        [self applyValues:values toDevice:ESTBeaconIdentityHashCLBeacon(beacon) timestamp:timestamp];
+    }
+
+    [self endUpdates];
+}
+
+#pragma mark - Removal
+
+- (void)removeRowAtIndex:(uint32_t)index
+{
+    ESTDeviceRow *row = &_rows[index];
+
+    for (ESTDeviceSubscription *subscription in self.subscriptions)
+    {
+        if (ESTDeviceRowMatches(row, subscription.query.terms.bytes, subscription.query.termCount))
+        {
+            [subscription recordDevice:row->identityHash delta:-1];
+        }
+    }
+
+    for (NSUInteger field = 0; field < ESTDeviceFieldCount; field++)
+    {
+        uint32_t moved = _index[field] ? [_index[field] removeSlot:row->slots[field] value:row->values[field]] : EST_DEVICE_NO_ROW;
+
+        if (moved != EST_DEVICE_NO_ROW)
+        {
+            _rows[moved].slots[field] = row->slots[field];
+        }
+    }
+
+    [self.rowEntries removeValueForKey:row->identityHash];
+
+    // Last row takes the freed index, its entry and posting slots follow.
+    uint32_t last = (uint32_t)(_rowCount - 1);
+
+    if (index != last)
+    {
+        _rows[index] = _rows[last];
+
+        ESTDeviceRowEntry *entry = [self.rowEntries valueForKey:_rows[index].identityHash];
+        entry->index = index;
+
+        for (NSUInteger field = 0; field < ESTDeviceFieldCount; field++)
+        {
+            [_index[field] setRow:index atSlot:_rows[index].slots[field] value:_rows[index].values[field]];
+        }
+    }
+
+    _rowCount--;
+}
+
+- (void)removeDevice:(uint64_t)identityHash
+{
+    ESTDeviceRowEntry *entry = [self.rowEntries valueForKey:identityHash];
+
+    if (!entry)
+    {
+        return;
+    }
+
+    [self beginUpdates];
+    [self removeRowAtIndex:entry->index];
+    [self endUpdates];
+}
+
+- (NSUInteger)removeDevicesIdleForTimeout:(NSTimeInterval)timeout atTime:(NSTimeInterval)time
+{
+    NSUInteger removed = 0;
+    uint32_t index = 0;
+
+    [self beginUpdates];
+
+    while (index < _rowCount)
+    {
+        if (time - _rows[index].lastSeen > timeout)
+        {
+            [self removeRowAtIndex:index];
+            removed++;
+        }
+        else
+        {
+            index++;
+        }
+    }
+
+    [self endUpdates];
+
+    return removed;
+}
+
+#pragma mark - Queries
+
+- (int64_t)valueOfField:(ESTDeviceField)field forDevice:(uint64_t)identityHash
+{
+    ESTDeviceRowEntry *entry = [self.rowEntries valueForKey:identityHash];
+
+    return entry ? _rows[entry->index].values[field] : ESTDeviceValueUnknown;
+}
+
+- (void)enumerateDevicesMatchingQuery:(ESTDeviceQuery *)query usingBlock:(void (^)(uint64_t identityHash, BOOL *stop))block
+{
+    const ESTDeviceTerm *terms = query.terms.bytes;
+    NSUInteger termCount = query.termCount;
+
+    // Cheapest indexed term drives, the rest is checked per row.
+    const ESTDeviceTerm *driver = NULL;
+    NSUInteger estimate = _rowCount;
+
+    for (NSUInteger i = 0; i < termCount; i++)
+    {
+        if (terms[i].minimum > terms[i].maximum)
+        {
+            return;
+        }
+
+        ESTDeviceIndex *index = _index[terms[i].field];
+
+        if (!index || ![index answersTerm:&terms[i]])
+        {
+            continue;
+        }
+
+        NSUInteger count = [index countFrom:terms[i].minimum to:terms[i].maximum limit:estimate];
+
+        if (count <= estimate)
+        {
+            driver = &terms[i];
+            estimate = count;
+        }
+    }
+
+    ESTDeviceRow *rows = _rows;
+
+    if (!driver)
+    {
+        BOOL stop = NO;
+
+        for (NSUInteger row = 0; row < _rowCount && !stop; row++)
+        {
+            if (ESTDeviceRowMatches(&rows[row], terms, termCount))
+            {
+                block(rows[row].identityHash, &stop);
+            }
+        }
+
+        return;
+    }
+
+    [_index[driver->field] enumerateRowsFrom:driver->minimum to:driver->maximum usingBlock:^(uint32_t row, BOOL *stop) {
+        if (ESTDeviceRowMatches(&rows[row], terms, termCount))
+        {
+            block(rows[row].identityHash, stop);
+        }
+    }];
+}
+
+- (NSArray *)devicesMatchingQuery:(ESTDeviceQuery *)query
+{
+    NSMutableArray *devices = [NSMutableArray array];
+
+    [self enumerateDevicesMatchingQuery:query usingBlock:^(uint64_t identityHash, BOOL *stop) {
+        [devices addObject:@(identityHash)];
+    }];
+
+    return devices;
+}
+
+- (NSUInteger)countOfDevicesMatchingQuery:(ESTDeviceQuery *)query
+{
+    __block NSUInteger count = 0;
+
+    [self enumerateDevicesMatchingQuery:query usingBlock:^(uint64_t identityHash, BOOL *stop) {
+        count++;
+    }];
+
+    return count;
+}
+
+#pragma mark - Subscriptions
+
+- (ESTDeviceSubscription *)subscribeToQuery:(ESTDeviceQuery *)query handler:(ESTDeviceSubscriptionHandler)handler
+{
+    ESTDeviceSubscription *subscription = [ESTDeviceSubscription new];
+    subscription.query = query;
+    subscription.handler = handler;
+    subscription.pending = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTDevicePendingChange) capacity:64];
+
+    [self.subscriptions addObject:subscription];
+
+    NSArray *initial = [self devicesMatchingQuery:query];
+
+    if (initial.count > 0)
+    {
+        handler(initial, @[]);
+    }
+
+    return subscription;
+}
+
+- (void)unsubscribe:(ESTDeviceSubscription *)subscription
+{
+    [self.subscriptions removeObject:subscription];
+}
+
+@end
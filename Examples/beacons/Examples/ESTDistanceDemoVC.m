@@ -8,6 +8,7 @@
 
 #import "ESTDistanceDemoVC.h"
 #import <EstimoteSDK/ESTBeaconManager.h>
+#import "ESTLaunchCoordinator.h"
 
 /*
  * Maximum distance (in meters) from beacon for which, the dot will be visible on screen.
@@ -66,7 +67,7 @@
     /*
      * BeaconManager setup.
      */
-    self.beaconManager = [[ESTBeaconManager alloc] init];
+    self.beaconManager = [ESTLaunchCoordinator sharedCoordinator].beaconManager;
     self.beaconManager.delegate = self;
     
     self.beaconRegion = [[CLBeaconRegion alloc] initWithProximityUUID:self.beacon.proximityUUID
@@ -88,6 +89,12 @@
 
 - (void)beaconManager:(id)manager didRangeBeacons:(NSArray *)beacons inRegion:(CLBeaconRegion *)region
 {
+    // The manager is shared, other regions (e.g. restored at launch) report here too.
+    if (![region.identifier isEqualToString:self.beaconRegion.identifier])
+    {
+        return;
+    }
+    
     CLBeacon *firstBeacon = [beacons firstObject];
     
     [self updateDotPositionForDistance:firstBeacon.accuracy];
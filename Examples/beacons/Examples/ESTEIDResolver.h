@@ -0,0 +1,93 @@
+//
+//  ESTEIDResolver.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTFrameDecoder.h"
+#import "ESTHDRHistogram.h"
+
+/*
+ * Frame type of Eddystone-EID frames decoded through a registered resolver,
+ * the 8-byte EID is in the first extension bytes.
+ */
+#define EST_FRAME_TYPE_EDDYSTONE_EID    ESTFrameTypeExtension
+
+#define EST_EID_MAX_WINDOW              2
+
+/*
+ * Resolver of rotating Eddystone-EID identifiers of owned beacons.
+ *
+ * Instead of trying every owned key on every packet, the resolver keeps the EIDs
+ * every beacon advertises in the current rotation epoch (and epochWindow epochs
+ * around it, for beacon clock drift) in a hash table, so resolving a packet is a
+ * lookup. EIDs are recomputed in one pass over all beacons whose epoch rolled over,
+ * the epochs of one beacon share a single multi-block AES call and temporary keys
+ * are cached for their 2^16 s lifetime. AES runs through CommonCrypto, on the
+ * hardware AES engine of the device.
+ *
+ * Identity hashes are caller defined, e.g. ESTBeaconIdentity hashes of the beacons'
+ * other identities. Not thread safe.
+ */
+@interface ESTEIDResolver : NSObject
+
+/*
+ * Epochs before and after the current one that resolve as well. Default 1, at most
+ * EST_EID_MAX_WINDOW, set before adding beacons.
+ */
+@property (nonatomic, assign) NSUInteger epochWindow;
+
+@property (nonatomic, assign, readonly) NSUInteger beaconCount;
+
+@property (nonatomic, assign, readonly) uint64_t resolvedCount;
+@property (nonatomic, assign, readonly) uint64_t unresolvedCount;
+
+/*
+ * AES blocks computed so far, to compare with the number of packets resolved.
+ */
+@property (nonatomic, assign, readonly) uint64_t blockCount;
+
+/*
+ * Duration of refresh passes in us.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *refreshTime;
+
+/*
+ * Identity key is 16 bytes, beacon time is seconds since timeBase and EIDs rotate
+ * every 2^rotationExponent seconds (exponent at most 15). Replaces a beacon with the
+ * same identity hash.
+ */
+- (BOOL)addBeaconWithIdentityKey:(NSData *)identityKey
+                rotationExponent:(uint8_t)rotationExponent
+                        timeBase:(CFAbsoluteTime)timeBase
+                    identityHash:(uint64_t)identityHash;
+
+- (void)removeBeaconWithIdentityHash:(uint64_t)identityHash;
+
+/*
+ * Recomputes EIDs of beacons whose epoch rolled over. Resolution calls it, an idle
+ * moment is a better place when many beacons share the rotation schedule.
+ */
+- (void)refreshAtTime:(CFAbsoluteTime)time;
+
+/*
+ * 0 when the EID belongs to no owned beacon.
+ */
+- (uint64_t)identityHashForEID:(const uint8_t *)eid atTime:(CFAbsoluteTime)time;
+
+/*
+ * Sets identity hashes of EID frames at their receipt time, returns the number resolved.
+ */
+- (NSUInteger)resolveFrames:(ESTFrame *)frames count:(NSUInteger)count;
+
+/*
+ * Decodes Eddystone-EID frames (service data frame type 0x30) as
+ * EST_FRAME_TYPE_EDDYSTONE_EID, resolved on decoding. The decoder does not retain
+ * the resolver.
+ */
+- (BOOL)registerWithDecoder:(ESTFrameDecoder *)decoder;
+
+@end
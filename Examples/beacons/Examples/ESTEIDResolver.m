@@ -0,0 +1,360 @@
+//
+//  ESTEIDResolver.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTEIDResolver.h"
+#import "ESTStructTable.h"
+#import <CommonCrypto/CommonCryptor.h>
+
+#define EST_EID_FRAME_TYPE      0x30
+#define EST_EID_FRAME_LENGTH    10
+#define EST_EID_BLOCKS          (2 * EST_EID_MAX_WINDOW + 1)
+
+typedef struct
+{
+    uint64_t identityHash;
+    uint8_t identityKey[16];
+    uint8_t exponent;
+    CFAbsoluteTime timeBase;
+
+    /*
+     * Temporary key of beacon time >> 16, UINT32_MAX when none.
+     */
+    uint32_t keyWindow;
+    uint8_t temporaryKey[16];
+
+    CFAbsoluteTime refreshTime;
+    uint64_t eids[EST_EID_BLOCKS];
+    uint8_t eidCount;
+} ESTEIDBeacon;
+
+static inline uint64_t ESTEIDKey(const uint8_t *eid)
+{
+    uint64_t key = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        key = key << 8 | eid[i];
+    }
+
+    return key;
+}
+
+static inline void ESTEIDEncrypt(const uint8_t *key, const uint8_t *input, uint8_t *output, size_t blocks)
+{
+    size_t moved = 0;
+
+    CCCrypt(kCCEncrypt, kCCAlgorithmAES128, kCCOptionECBMode, key, kCCKeySizeAES128, NULL,
+            input, blocks * kCCBlockSizeAES128, output, blocks * kCCBlockSizeAES128, &moved);
+}
+
+@interface ESTEIDResolver ()
+
+@property (nonatomic, assign, readwrite) uint64_t resolvedCount;
+@property (nonatomic, assign, readwrite) uint64_t unresolvedCount;
+@property (nonatomic, assign, readwrite) uint64_t blockCount;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *refreshTime;
+
+@property (nonatomic, strong) NSMutableData *beacons;
+@property (nonatomic, strong) ESTStructTable *beaconIndex;
+@property (nonatomic, strong) ESTStructTable *eids;
+
+@end
+
+@implementation ESTEIDResolver
+{
+    CFAbsoluteTime _nextRefreshTime;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.epochWindow = 1;
+
+        self.beacons = [NSMutableData data];
+        self.beaconIndex = [[ESTStructTable alloc] initWithValueSize:sizeof(uint32_t) capacity:64];
+        self.eids = [[ESTStructTable alloc] initWithValueSize:sizeof(uint64_t) capacity:64 * 3];
+
+        // 1 us ... 1 minute.
+        self.refreshTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:60000000 significantBits:7];
+
+        _nextRefreshTime = -INFINITY;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    // Keys do not outlive the resolver in freed memory.
+    memset(self.beacons.mutableBytes, 0, self.beacons.length);
+}
+
+- (NSUInteger)beaconCount
+{
+    return self.beacons.length / sizeof(ESTEIDBeacon);
+}
+
+#pragma mark - Beacons
+
+- (BOOL)addBeaconWithIdentityKey:(NSData *)identityKey
+                rotationExponent:(uint8_t)rotationExponent
+                        timeBase:(CFAbsoluteTime)timeBase
+                    identityHash:(uint64_t)identityHash
+{
+    if (identityKey.length != kCCKeySizeAES128 || rotationExponent > 15)
+    {
+        return NO;
+    }
+
+    [self removeBeaconWithIdentityHash:identityHash];
+
+    ESTEIDBeacon beacon;
+    memset(&beacon, 0, sizeof(beacon));
+
+    beacon.identityHash = identityHash;
+    memcpy(beacon.identityKey, identityKey.bytes, sizeof(beacon.identityKey));
+    beacon.exponent = rotationExponent;
+    beacon.timeBase = timeBase;
+    beacon.keyWindow = UINT32_MAX;
+    beacon.refreshTime = -INFINITY;
+
+    uint32_t *index = [self.beaconIndex insertValueForKey:identityHash created:NULL];
+    *index = (uint32_t)self.beaconCount;
+
+    [self.beacons appendBytes:&beacon length:sizeof(beacon)];
+    memset(&beacon, 0, sizeof(beacon));
+
+    _nextRefreshTime = -INFINITY;
+
+    return YES;
+}
+
+- (void)removeEIDsOfBeacon:(ESTEIDBeacon *)beacon
+{
+    for (uint8_t i = 0; i < beacon->eidCount; i++)
+    {
+        uint64_t *owner = [self.eids valueForKey:beacon->eids[i]];
+
+        if (owner && *owner == beacon->identityHash)
+        {
+            [self.eids removeValueForKey:beacon->eids[i]];
+        }
+    }
+
+    beacon->eidCount = 0;
+}
+
+- (void)removeBeaconWithIdentityHash:(uint64_t)identityHash
+{
+    uint32_t *index = [self.beaconIndex valueForKey:identityHash];
+
+    if (!index)
+    {
+        return;
+    }
+
+    uint32_t removed = *index;
+    [self.beaconIndex removeValueForKey:identityHash];
+
+    ESTEIDBeacon *beacons = self.beacons.mutableBytes;
+    uint32_t last = (uint32_t)self.beaconCount - 1;
+
+    [self removeEIDsOfBeacon:&beacons[removed]];
+
+    if (removed != last)
+    {
+        beacons[removed] = beacons[last];
+
+        uint32_t *moved = [self.beaconIndex valueForKey:beacons[removed].identityHash];
+        *moved = removed;
+    }
+
+    memset(&beacons[last], 0, sizeof(ESTEIDBeacon));
+    self.beacons.length -= sizeof(ESTEIDBeacon);
+}
+
+#pragma mark - EIDs
+
+/*
+ * Eddystone-EID: the temporary key is AES(identity key, 11 x 0x00, 0xFF, 0x00, 0x00,
+ * time bits 31..16), the EID is the first 8 bytes of AES(temporary key, 11 x 0x00,
+ * exponent, time with the low exponent bits cleared).
+ */
+- (void)computeBeacon:(ESTEIDBeacon *)beacon atTime:(CFAbsoluteTime)time
+{
+    double elapsed = time - beacon->timeBase;
+    uint32_t counter = elapsed <= 0 ? 0 : (uint32_t)MIN(elapsed, (double)UINT32_MAX);
+    uint32_t period = 1U << beacon->exponent;
+    uint32_t epoch = counter & ~(period - 1);
+    int64_t window = (int64_t)MIN(self.epochWindow, (NSUInteger)EST_EID_MAX_WINDOW);
+
+    uint8_t input[EST_EID_BLOCKS][16];
+    uint8_t output[EST_EID_BLOCKS][16];
+    size_t pending = 0;
+    size_t encrypted = 0;
+
+    memset(input, 0, sizeof(input));
+
+    for (int64_t offset = -window; offset <= window; offset++)
+    {
+        int64_t start = (int64_t)epoch + offset * period;
+
+        if (start < 0 || start > UINT32_MAX)
+        {
+            continue;
+        }
+
+        uint32_t keyWindow = (uint32_t)(start >> 16);
+
+        if (keyWindow != beacon->keyWindow)
+        {
+            // Blocks so far belong to the previous temporary key.
+            if (pending > encrypted)
+            {
+                ESTEIDEncrypt(beacon->temporaryKey, input[encrypted], output[encrypted], pending - encrypted);
+                encrypted = pending;
+            }
+
+            uint8_t keyInput[16] = { 0 };
+            keyInput[11] = 0xFF;
+            keyInput[14] = (uint8_t)(start >> 24);
+            keyInput[15] = (uint8_t)(start >> 16);
+
+            ESTEIDEncrypt(beacon->identityKey, keyInput, beacon->temporaryKey, 1);
+            beacon->keyWindow = keyWindow;
+            self.blockCount++;
+        }
+
+        uint8_t *block = input[pending++];
+        block[11] = beacon->exponent;
+        block[12] = (uint8_t)(start >> 24);
+        block[13] = (uint8_t)(start >> 16);
+        block[14] = (uint8_t)(start >> 8);
+        block[15] = (uint8_t)start;
+    }
+
+    if (pending > encrypted)
+    {
+        ESTEIDEncrypt(beacon->temporaryKey, input[encrypted], output[encrypted], pending - encrypted);
+    }
+
+    self.blockCount += pending;
+
+    [self removeEIDsOfBeacon:beacon];
+
+    for (size_t i = 0; i < pending; i++)
+    {
+        uint64_t key = ESTEIDKey(output[i]);
+        uint64_t *owner = [self.eids insertValueForKey:key created:NULL];
+        *owner = beacon->identityHash;
+
+        beacon->eids[beacon->eidCount++] = key;
+    }
+
+    beacon->refreshTime = beacon->timeBase + (double)epoch + period;
+}
+
+- (void)refreshAtTime:(CFAbsoluteTime)time
+{
+    if (time < _nextRefreshTime)
+    {
+        return;
+    }
+
+    ESTMonotonicTime start = ESTMonotonicNow();
+
+    ESTEIDBeacon *beacons = self.beacons.mutableBytes;
+    NSUInteger count = self.beaconCount;
+    CFAbsoluteTime next = INFINITY;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        if (time >= beacons[i].refreshTime)
+        {
+            [self computeBeacon:&beacons[i] atTime:time];
+        }
+
+        next = MIN(next, beacons[i].refreshTime);
+    }
+
+    _nextRefreshTime = next;
+
+    [self.refreshTime recordValue:ESTMonotonicElapsed(start) / 1000];
+}
+
+#pragma mark - Resolution
+
+- (uint64_t)identityHashForEID:(const uint8_t *)eid atTime:(CFAbsoluteTime)time
+{
+    [self refreshAtTime:time];
+
+    uint64_t *owner = [self.eids valueForKey:ESTEIDKey(eid)];
+
+    if (!owner)
+    {
+        self.unresolvedCount++;
+        return 0;
+    }
+
+    self.resolvedCount++;
+
+    return *owner;
+}
+
+- (NSUInteger)resolveFrames:(ESTFrame *)frames count:(NSUInteger)count
+{
+    NSUInteger resolved = 0;
+
+    // Receipt times of the batch are recent, one anchor sampled now converts them all.
+    ESTMonotonicAnchor anchor = ESTMonotonicAnchorNow();
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        ESTFrame *frame = &frames[i];
+
+        if (frame->type != EST_FRAME_TYPE_EDDYSTONE_EID)
+        {
+            continue;
+        }
+
+        frame->identityHash = [self identityHashForEID:frame->extension
+                                                atTime:ESTMonotonicToAbsoluteTimeWithAnchor(frame->receiptTime, anchor)];
+        resolved += frame->identityHash ? 1 : 0;
+    }
+
+    return resolved;
+}
+
+static BOOL ESTEIDDecodeFrame(const uint8_t *bytes, size_t length, ESTFrame *frame, void *context)
+{
+    if (length < EST_EID_FRAME_LENGTH)
+    {
+        return NO;
+    }
+
+    ESTEIDResolver *resolver = (__bridge ESTEIDResolver *)context;
+
+    memcpy(frame->extension, bytes + 2, 8);
+    frame->measuredPower = (int8_t)bytes[1];
+    frame->identityHash = [resolver identityHashForEID:bytes + 2 atTime:CFAbsoluteTimeGetCurrent()];
+
+    return YES;
+}
+
+- (BOOL)registerWithDecoder:(ESTFrameDecoder *)decoder
+{
+    return [decoder registerDecoder:ESTEIDDecodeFrame
+                            context:(__bridge void *)self
+                            forType:EST_FRAME_TYPE_EDDYSTONE_EID
+                             source:ESTFrameSourceServiceData
+                         identifier:EST_FRAME_SERVICE_EDDYSTONE
+                         headerByte:EST_EID_FRAME_TYPE];
+}
+
+@end
@@ -1,6 +1,7 @@
 #import "ESTEddystoneTableVC.h"
 #import "ESTViewController.h"
 #import <EstimoteSDK/EstimoteSDK.h>
+#import "ESTLaunchCoordinator.h"
 
 @interface ESTEddystoneTableVC () <ESTEddystoneManagerDelegate>
 
@@ -52,7 +53,7 @@
     self.title = @"Eddystone devices";
     [self.tableView registerClass:[ESTGTableViewCell class] forCellReuseIdentifier:@"CellIdentifier"];
     
-    self.eddystoneManager = [[ESTEddystoneManager alloc] init];
+    self.eddystoneManager = [ESTLaunchCoordinator sharedCoordinator].eddystoneManager;
     self.eddystoneManager.delegate = self;
 }
 
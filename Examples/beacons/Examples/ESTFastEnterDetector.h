@@ -0,0 +1,127 @@
+//
+//  ESTFastEnterDetector.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+#import "ESTHDRHistogram.h"
+#import "ESTFrameDecoder.h"
+
+@class ESTFastEnterDetector;
+
+@protocol ESTFastEnterDetectorDelegate <NSObject>
+
+/*
+ * First strong packet of a watched identity, identity is the value returned by watch methods.
+ */
+- (void)fastEnterDetector:(ESTFastEnterDetector *)detector didProvisionallyEnter:(uint64_t)identity rssi:(NSInteger)rssi;
+
+@optional
+
+- (void)fastEnterDetector:(ESTFastEnterDetector *)detector didConfirmEnter:(uint64_t)identity;
+- (void)fastEnterDetector:(ESTFastEnterDetector *)detector didRetractEnter:(uint64_t)identity;
+- (void)fastEnterDetector:(ESTFastEnterDetector *)detector didExit:(uint64_t)identity;
+
+@end
+
+/*
+ * Sub-second enter detection from the raw scan stream (ESTUtilityManager and
+ * ESTEddystoneManager discovery), in front of region monitoring and 1 Hz ranging.
+ *
+ * The first packet of a watched identity at or above enterRSSI fires a provisional enter.
+ * It is confirmed by ranging or by confirmationPacketCount packets at or above confirmRSSI,
+ * otherwise retracted after confirmationWindow. Inside identities exit after exitInterval
+ * without packets or ranging.
+ *
+ * All timestamps share one time base, timeIntervalSinceReferenceDate for live use or
+ * recorded times for trace replay. Decoded frame receipt times are converted into it
+ * when the frames are processed. Confirmation and exit deadlines live on a timing
+ * wheel advanced whenever input is processed, ranging callbacks provide the regular tick.
+ */
+@interface ESTFastEnterDetector : NSObject
+
+@property (nonatomic, weak) id <ESTFastEnterDetectorDelegate> delegate;
+
+/*
+ * Defaults: confirmRSSI 6 dB below enterRSSI, 3 confirming packets,
+ * 1.5 s confirmation window (one ranging cycle and margin), 10 s exit interval.
+ */
+@property (nonatomic, assign) NSInteger confirmRSSIMargin;
+@property (nonatomic, assign) NSUInteger confirmationPacketCount;
+@property (nonatomic, assign) NSTimeInterval confirmationWindow;
+@property (nonatomic, assign) NSTimeInterval exitInterval;
+
+@property (nonatomic, assign, readonly) NSUInteger provisionalCount;
+@property (nonatomic, assign, readonly) NSUInteger confirmedCount;
+@property (nonatomic, assign, readonly) NSUInteger retractedCount;
+
+/*
+ * Retracted share of provisional enters.
+ */
+@property (nonatomic, assign, readonly) double falseEnterRate;
+
+/*
+ * Time between provisional and confirmed enter in ms, i.e. how much earlier
+ * the fast path fired than the confirming source.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *leadTime;
+
+/*
+ * Time from packet receipt to the provisional enter callback in us, for packets
+ * with a receipt time (decoded frames and SDK discovery results with a discovery date).
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *enterLatency;
+
+/*
+ * iBeacon identity, keyed by all three of UUID, major and minor. Discovery packets carry
+ * no UUID and are matched by major / minor only while a single watched UUID uses them.
+ */
+- (uint64_t)watchBeaconWithProximityUUID:(NSUUID *)proximityUUID
+                                   major:(uint16_t)major
+                                   minor:(uint16_t)minor
+                               enterRSSI:(NSInteger)enterRSSI;
+
+/*
+ * Eddystone-UID identity, confirmed by further packets only.
+ */
+- (uint64_t)watchEddystoneWithNamespaceID:(NSString *)namespaceID
+                               instanceID:(NSString *)instanceID
+                                enterRSSI:(NSInteger)enterRSSI;
+
+- (void)unwatch:(uint64_t)identity;
+
+- (BOOL)isInside:(uint64_t)identity;
+
+/*
+ * Raw packet for trace replay, identity hash as produced by ESTBeaconIdentity.
+ */
+- (void)processPacketWithIdentityHash:(uint64_t)identityHash rssi:(NSInteger)rssi timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * ESTBluetoothBeacon objects, timestamps from discoveryDate.
+ */
+- (void)processBluetoothBeacons:(NSArray *)beacons;
+
+/*
+ * ESTEddystone objects, timestamps from discoveryDate.
+ */
+- (void)processEddystones:(NSArray *)eddystones;
+
+/*
+ * Decoded frames, timestamps from their receipt time. iBeacon frames match by
+ * all three of UUID, major and minor.
+ */
+- (void)processFrames:(const ESTFrame *)frames count:(NSUInteger)count;
+
+/*
+ * CLBeacon objects from ranging.
+ */
+- (void)processRangedBeacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp;
+
+- (void)advanceToTime:(NSTimeInterval)timestamp;
+
+@end
@@ -0,0 +1,475 @@
+//
+//  ESTFastEnterDetector.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTFastEnterDetector.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+#import "ESTTimingWheel.h"
+
+#define EST_FAST_ENTER_WHEEL_RESOLUTION   0.05
+
+typedef NS_ENUM(uint8_t, ESTFastEnterState)
+{
+    ESTFastEnterStateOutside = 0,
+    ESTFastEnterStateProvisional,
+    ESTFastEnterStateInside
+};
+
+typedef struct
+{
+    int16_t enterRSSI;
+    uint8_t state;
+    uint8_t confirmingPackets;
+
+    // Set with retractedTime, timestamps may start at 0 so the time can not be the flag.
+    uint8_t retracted;
+    NSTimeInterval provisionalTime;
+    NSTimeInterval retractedTime;
+    NSTimeInterval lastSeen;
+
+    // Major / minor hash for iBeacons, 0 for Eddystone.
+    uint64_t discoveryHash;
+} ESTFastEnterIdentity;
+
+/*
+ * Discovery packets carry major / minor only. An alias shared by several watched
+ * proximity UUIDs is ambiguous and such packets are ignored.
+ */
+typedef struct
+{
+    uint64_t identity;
+    uint32_t count;
+} ESTFastEnterAlias;
+
+typedef struct
+{
+    uint64_t identity;
+    ESTFastEnterState previousState;
+} ESTFastEnterExpiration;
+
+@interface ESTFastEnterDetector ()
+
+@property (nonatomic, assign, readwrite) NSUInteger provisionalCount;
+@property (nonatomic, assign, readwrite) NSUInteger confirmedCount;
+@property (nonatomic, assign, readwrite) NSUInteger retractedCount;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *leadTime;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *enterLatency;
+
+@property (nonatomic, strong) ESTStructTable *identities;
+@property (nonatomic, strong) ESTStructTable *discoveryAliases;
+@property (nonatomic, strong) NSMutableData *expirations;
+
+/*
+ * Confirmation and exit deadlines keyed by identity, created with the first timestamp.
+ */
+@property (nonatomic, strong) ESTTimingWheel *wheel;
+
+@end
+
+@implementation ESTFastEnterDetector
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.confirmRSSIMargin = 6;
+        self.confirmationPacketCount = 3;
+        self.confirmationWindow = 1.5;
+        self.exitInterval = 10;
+
+        self.identities = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTFastEnterIdentity) capacity:32];
+        self.discoveryAliases = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTFastEnterAlias) capacity:32];
+        self.expirations = [NSMutableData data];
+
+        // 1 ms ... 1 hour.
+        self.leadTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:3600000 significantBits:7];
+
+        // 1 us ... 1 minute.
+        self.enterLatency = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:60000000 significantBits:7];
+    }
+    return self;
+}
+
+- (double)falseEnterRate
+{
+    return self.provisionalCount ? (double)self.retractedCount / self.provisionalCount : 0;
+}
+
+#pragma mark - Watching
+
+- (uint64_t)watchIdentityHash:(uint64_t)identityHash discoveryHash:(uint64_t)discoveryHash enterRSSI:(NSInteger)enterRSSI
+{
+    BOOL created;
+    ESTFastEnterIdentity *identity = [self.identities insertValueForKey:identityHash created:&created];
+    identity->enterRSSI = (int16_t)enterRSSI;
+
+    if (created && discoveryHash)
+    {
+        identity->discoveryHash = discoveryHash;
+
+        BOOL aliasCreated;
+        ESTFastEnterAlias *alias = [self.discoveryAliases insertValueForKey:discoveryHash created:&aliasCreated];
+
+        if (aliasCreated)
+        {
+            alias->identity = identityHash;
+        }
+
+        alias->count++;
+    }
+
+    return identityHash;
+}
+
+- (uint64_t)watchBeaconWithProximityUUID:(NSUUID *)proximityUUID
+                                   major:(uint16_t)major
+                                   minor:(uint16_t)minor
+                               enterRSSI:(NSInteger)enterRSSI
+{
+    return [self watchIdentityHash:ESTBeaconIdentityHashIBeacon(proximityUUID, major, minor)
+                     discoveryHash:ESTBeaconIdentityHashIBeacon(nil, major, minor)
+                         enterRSSI:enterRSSI];
+}
+
+- (uint64_t)watchEddystoneWithNamespaceID:(NSString *)namespaceID
+                               instanceID:(NSString *)instanceID
+                                enterRSSI:(NSInteger)enterRSSI
+{
+    return [self watchIdentityHash:ESTBeaconIdentityHashEddystone(namespaceID, instanceID) discoveryHash:0 enterRSSI:enterRSSI];
+}
+
+- (void)unwatch:(uint64_t)identity
+{
+    ESTFastEnterIdentity *value = [self.identities valueForKey:identity];
+
+    if (!value)
+    {
+        return;
+    }
+
+    uint64_t discoveryHash = value->discoveryHash;
+
+    [self.identities removeValueForKey:identity];
+    [self.wheel cancelKey:identity];
+
+    ESTFastEnterAlias *alias = discoveryHash ? [self.discoveryAliases valueForKey:discoveryHash] : NULL;
+
+    if (!alias)
+    {
+        return;
+    }
+
+    if (--alias->count == 0)
+    {
+        [self.discoveryAliases removeValueForKey:discoveryHash];
+    }
+    else if (alias->count == 1)
+    {
+        // Alias is unambiguous again, a linear pass to find the remaining identity is fine for this rare call.
+        __block uint64_t remaining = 0;
+
+        [self.identities enumerateValuesUsingBlock:^(uint64_t key, void *identityValue, BOOL *stop) {
+            if (((ESTFastEnterIdentity *)identityValue)->discoveryHash == discoveryHash)
+            {
+                remaining = key;
+                *stop = YES;
+            }
+        }];
+
+        alias->identity = remaining;
+    }
+}
+
+- (BOOL)isInside:(uint64_t)identity
+{
+    ESTFastEnterIdentity *value = [self.identities valueForKey:identity];
+
+    return value && value->state == ESTFastEnterStateInside;
+}
+
+/*
+ * Watched identity for a packet hash, either the full identity or an unambiguous discovery alias.
+ */
+- (uint64_t)identityForPacketHash:(uint64_t)identityHash
+{
+    if ([self.identities valueForKey:identityHash])
+    {
+        return identityHash;
+    }
+
+    ESTFastEnterAlias *alias = [self.discoveryAliases valueForKey:identityHash];
+
+    return (alias && alias->count == 1) ? alias->identity : identityHash;
+}
+
+- (void)scheduleIdentity:(uint64_t)identityHash atTime:(NSTimeInterval)time
+{
+    if (!self.wheel)
+    {
+        self.wheel = [[ESTTimingWheel alloc] initWithResolution:EST_FAST_ENTER_WHEEL_RESOLUTION
+                                                      startTime:time - EST_FAST_ENTER_WHEEL_RESOLUTION];
+    }
+
+    [self.wheel scheduleKey:identityHash atTime:time];
+}
+
+#pragma mark - Transitions
+
+- (void)confirmIdentity:(uint64_t)identityHash value:(ESTFastEnterIdentity *)identity timestamp:(NSTimeInterval)timestamp
+{
+    if (identity->state == ESTFastEnterStateProvisional)
+    {
+        [self.leadTime recordValue:(uint64_t)llround(MAX(timestamp - identity->provisionalTime, 0.0) * 1000)];
+    }
+
+    identity->state = ESTFastEnterStateInside;
+    self.confirmedCount++;
+
+    // Replaces the confirmation deadline, later packets only move lastSeen and the
+    // deadline is re-armed from it when it expires.
+    [self scheduleIdentity:identityHash atTime:identity->lastSeen + self.exitInterval];
+
+    if ([self.delegate respondsToSelector:@selector(fastEnterDetector:didConfirmEnter:)])
+    {
+        [self.delegate fastEnterDetector:self didConfirmEnter:identityHash];
+    }
+}
+
+- (void)processPacketWithIdentityHash:(uint64_t)identityHash rssi:(NSInteger)rssi timestamp:(NSTimeInterval)timestamp
+{
+    [self processPacketWithIdentityHash:identityHash rssi:rssi timestamp:timestamp receiptTime:0];
+}
+
+/*
+ * Receipt time 0 is unknown, e.g. for trace replay.
+ */
+- (void)processPacketWithIdentityHash:(uint64_t)identityHash
+                                 rssi:(NSInteger)rssi
+                            timestamp:(NSTimeInterval)timestamp
+                          receiptTime:(ESTMonotonicTime)receiptTime
+{
+    [self advanceToTime:timestamp];
+
+    identityHash = [self identityForPacketHash:identityHash];
+    ESTFastEnterIdentity *identity = [self.identities valueForKey:identityHash];
+
+    if (!identity || rssi >= 0)
+    {
+        return;
+    }
+
+    identity->lastSeen = MAX(identity->lastSeen, timestamp);
+
+    switch (identity->state)
+    {
+        case ESTFastEnterStateOutside:
+        {
+            // A retracted identity needs a quiet window before it can fire again.
+            BOOL cooling = identity->retracted && timestamp - identity->retractedTime < self.confirmationWindow;
+
+            if (rssi >= identity->enterRSSI && !cooling)
+            {
+                identity->state = ESTFastEnterStateProvisional;
+                identity->provisionalTime = timestamp;
+                identity->confirmingPackets = 0;
+
+                [self scheduleIdentity:identityHash atTime:timestamp + self.confirmationWindow];
+                self.provisionalCount++;
+
+                if (receiptTime)
+                {
+                    [self.enterLatency recordValue:ESTMonotonicElapsed(receiptTime) / 1000];
+                }
+
+                [self.delegate fastEnterDetector:self didProvisionallyEnter:identityHash rssi:rssi];
+            }
+            break;
+        }
+
+        case ESTFastEnterStateProvisional:
+        {
+            if (rssi >= identity->enterRSSI - self.confirmRSSIMargin &&
+                ++identity->confirmingPackets >= self.confirmationPacketCount)
+            {
+                [self confirmIdentity:identityHash value:identity timestamp:timestamp];
+            }
+            break;
+        }
+
+        case ESTFastEnterStateInside:
+            break;
+    }
+}
+
+/*
+ * Discovery results carry wall clock dates, the receipt time is derived from the same
+ * date against one anchor per batch, so timestamp and latency agree. Without a date
+ * the packet is taken as received now and its latency is unknown.
+ */
+- (void)processPacketWithIdentityHash:(uint64_t)identityHash
+                                 rssi:(NSInteger)rssi
+                        discoveryDate:(NSDate *)discoveryDate
+                               anchor:(ESTMonotonicAnchor)anchor
+{
+    if (!discoveryDate)
+    {
+        [self processPacketWithIdentityHash:identityHash rssi:rssi timestamp:anchor.absolute receiptTime:0];
+        return;
+    }
+
+    NSTimeInterval timestamp = [discoveryDate timeIntervalSinceReferenceDate];
+
+    [self processPacketWithIdentityHash:identityHash
+                                   rssi:rssi
+                              timestamp:timestamp
+                            receiptTime:ESTMonotonicFromAbsoluteTimeWithAnchor(timestamp, anchor)];
+}
+
+- (void)processBluetoothBeacons:(NSArray *)beacons
+{
+    ESTMonotonicAnchor anchor = ESTMonotonicAnchorNow();
+
+    for (ESTBluetoothBeacon *beacon in beacons)
+    {
+        [self processPacketWithIdentityHash:ESTBeaconIdentityHashBluetoothBeacon(beacon)
+                                       rssi:beacon.rssi
+                              discoveryDate:beacon.discoveryDate
+                                     anchor:anchor];
+    }
+}
+
+- (void)processEddystones:(NSArray *)eddystones
+{
+    ESTMonotonicAnchor anchor = ESTMonotonicAnchorNow();
+
+    for (ESTEddystone *eddystone in eddystones)
+    {
+        [self processPacketWithIdentityHash:ESTBeaconIdentityHashEddystoneDevice(eddystone)
+                                       rssi:[eddystone.rssi integerValue]
+                              discoveryDate:eddystone.discoveryDate
+                                     anchor:anchor];
+    }
+}
+
+- (void)processFrames:(const ESTFrame *)frames count:(NSUInteger)count
+{
+    // Receipt times are monotonic, they enter the wall clock time base of the other inputs here.
+    ESTMonotonicAnchor anchor = ESTMonotonicAnchorNow();
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        const ESTFrame *frame = &frames[i];
+
+        [self processPacketWithIdentityHash:frame->identityHash
+                                       rssi:frame->rssi
+                                  timestamp:ESTMonotonicToAbsoluteTimeWithAnchor(frame->receiptTime, anchor)
+                                receiptTime:frame->receiptTime];
+    }
+}
+
+- (void)processRangedBeacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp
+{
+    [self advanceToTime:timestamp];
+
+    for (CLBeacon *beacon in beacons)
+    {
+        uint64_t identityHash = ESTBeaconIdentityHashCLBeacon(beacon);
+        ESTFastEnterIdentity *identity = [self.identities valueForKey:identityHash];
+
+        if (!identity || beacon.rssi >= 0)
+        {
+            continue;
+        }
+
+        identity->lastSeen = MAX(identity->lastSeen, timestamp);
+
+        // Ranging is the normal path, it confirms a provisional enter and enters on its own
+        // when the fast path missed the identity.
+        if ((identity->state == ESTFastEnterStateProvisional && beacon.rssi >= identity->enterRSSI - self.confirmRSSIMargin)
+            || (identity->state == ESTFastEnterStateOutside && beacon.rssi >= identity->enterRSSI))
+        {
+            [self confirmIdentity:identityHash value:identity timestamp:timestamp];
+        }
+    }
+}
+
+- (void)advanceToTime:(NSTimeInterval)timestamp
+{
+    if (!self.wheel || timestamp <= self.wheel.currentTime)
+    {
+        return;
+    }
+
+    NSTimeInterval exitInterval = self.exitInterval;
+    NSMutableData *expirations = self.expirations;
+
+    [expirations setLength:0];
+
+    [self.wheel advanceToTime:timestamp expired:^(uint64_t key, NSTimeInterval deadline) {
+
+        ESTFastEnterIdentity *identity = [self.identities valueForKey:key];
+
+        if (!identity || identity->state == ESTFastEnterStateOutside)
+        {
+            return;
+        }
+
+        ESTFastEnterExpiration expiration = { key, identity->state };
+
+        if (identity->state == ESTFastEnterStateInside)
+        {
+            NSTimeInterval exitTime = identity->lastSeen + exitInterval;
+
+            // Seen since the deadline was set, re-arm relative to the last packet.
+            if (exitTime > timestamp)
+            {
+                [self.wheel scheduleKey:key atTime:exitTime];
+                return;
+            }
+        }
+        else
+        {
+            identity->retracted = YES;
+            identity->retractedTime = timestamp;
+        }
+
+        identity->state = ESTFastEnterStateOutside;
+        [expirations appendBytes:&expiration length:sizeof(expiration)];
+    }];
+
+    NSUInteger count = expirations.length / sizeof(ESTFastEnterExpiration);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Delegate may watch, unwatch or feed packets, so it is notified after the scan from a copy.
+    NSData *copy = [expirations copy];
+    const ESTFastEnterExpiration *expired = copy.bytes;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        if (expired[i].previousState == ESTFastEnterStateProvisional)
+        {
+            self.retractedCount++;
+
+            if ([self.delegate respondsToSelector:@selector(fastEnterDetector:didRetractEnter:)])
+            {
+                [self.delegate fastEnterDetector:self didRetractEnter:expired[i].identity];
+            }
+        }
+        else if ([self.delegate respondsToSelector:@selector(fastEnterDetector:didExit:)])
+        {
+            [self.delegate fastEnterDetector:self didExit:expired[i].identity];
+        }
+    }
+}
+
+@end
@@ -0,0 +1,61 @@
+//
+//  ESTFingerprintLocator.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTRadioMap.h"
+
+@interface ESTFingerprintEstimate : NSObject
+
+@property (nonatomic, assign, readonly) double x;
+@property (nonatomic, assign, readonly) double y;
+@property (nonatomic, assign, readonly) NSInteger floor;
+
+/*
+ * Mean RSSI distance of used neighbors in dBm, lower is better.
+ */
+@property (nonatomic, assign, readonly) double distance;
+
+/*
+ * ESTRadioMapNeighbor objects the estimate was computed from.
+ */
+@property (nonatomic, strong, readonly) NSArray *neighbors;
+
+@end
+
+/*
+ * Indoor positioning by RSSI fingerprinting, a replacement for trilateration from
+ * CLBeacon accuracy which breaks down with multipath.
+ *
+ * Live ranging results are turned into a vector over the radio map beacons (not heard
+ * beacons are missing) and matched with weighted k nearest neighbors. Floor is chosen
+ * by weighted vote and position is averaged over neighbors on that floor.
+ */
+@interface ESTFingerprintLocator : NSObject
+
+@property (nonatomic, strong, readonly) ESTRadioMap *radioMap;
+
+/*
+ * Number of neighbors. Default 4.
+ */
+@property (nonatomic, assign) NSUInteger neighborCount;
+
+/*
+ * Fewer known beacons in the live vector give no estimate. Default 3.
+ */
+@property (nonatomic, assign) NSUInteger minimumBeaconCount;
+
+- (instancetype)initWithRadioMap:(ESTRadioMap *)radioMap;
+
+/*
+ * Accepts CLBeacon objects from ranging and ESTBluetoothBeacon objects from discovery.
+ */
+- (ESTFingerprintEstimate *)estimateWithBeacons:(NSArray *)beacons;
+
+- (ESTFingerprintEstimate *)estimateWithRSSI:(const float *)rssi;
+
+@end
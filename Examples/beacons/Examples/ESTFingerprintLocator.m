@@ -0,0 +1,177 @@
+//
+//  ESTFingerprintLocator.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTFingerprintLocator.h"
+#import "ESTBeaconIdentity.h"
+
+@interface ESTFingerprintEstimate ()
+
+@property (nonatomic, assign, readwrite) double x;
+@property (nonatomic, assign, readwrite) double y;
+@property (nonatomic, assign, readwrite) NSInteger floor;
+@property (nonatomic, assign, readwrite) double distance;
+@property (nonatomic, strong, readwrite) NSArray *neighbors;
+
+@end
+
+@implementation ESTFingerprintEstimate
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: (%.2f, %.2f) floor %ld distance %.2f>",
+            NSStringFromClass([self class]), self.x, self.y, (long)self.floor, self.distance];
+}
+
+@end
+
+@interface ESTFingerprintLocator ()
+
+@property (nonatomic, strong, readwrite) ESTRadioMap *radioMap;
+
+@end
+
+@implementation ESTFingerprintLocator
+{
+    float *_vector;
+}
+
+- (instancetype)initWithRadioMap:(ESTRadioMap *)radioMap
+{
+    self = [super init];
+    if (self)
+    {
+        self.radioMap = radioMap;
+        self.neighborCount = 4;
+        self.minimumBeaconCount = 3;
+
+        _vector = malloc(MAX(radioMap.dimension, (NSUInteger)1) * sizeof(float));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_vector);
+}
+
+- (ESTFingerprintEstimate *)estimateWithBeacons:(NSArray *)beacons
+{
+    ESTRadioMap *map = self.radioMap;
+    NSUInteger known = 0;
+
+    for (NSUInteger d = 0; d < map.dimension; d++)
+    {
+        _vector[d] = map.missingRSSI;
+    }
+
+    for (id beacon in beacons)
+    {
+        uint64_t hash;
+        NSInteger rssi;
+
+        if ([beacon isKindOfClass:[CLBeacon class]])
+        {
+            hash = ESTBeaconIdentityHashCLBeacon(beacon);
+            rssi = [(CLBeacon *)beacon rssi];
+        }
+        else if ([beacon isKindOfClass:[ESTBluetoothBeacon class]])
+        {
+            hash = ESTBeaconIdentityHashBluetoothBeacon(beacon);
+            rssi = [(ESTBluetoothBeacon *)beacon rssi];
+        }
+        else
+        {
+            continue;
+        }
+
+        NSUInteger dimension = [map dimensionForIdentityHash:hash];
+
+        // Ranging reports 0 for beacons without a recent packet.
+        if (dimension == NSNotFound || rssi >= 0)
+        {
+            continue;
+        }
+
+        _vector[dimension] = (float)rssi;
+        known++;
+    }
+
+    if (known < self.minimumBeaconCount)
+    {
+        return nil;
+    }
+
+    return [self estimateWithRSSI:_vector];
+}
+
+- (ESTFingerprintEstimate *)estimateWithRSSI:(const float *)rssi
+{
+    NSArray *neighbors = [self.radioMap nearestNeighborsOfRSSI:rssi count:self.neighborCount];
+
+    if (neighbors.count == 0)
+    {
+        return nil;
+    }
+
+    // Weighted floor vote, neighbors are few so a linear scan is enough.
+    NSInteger floor = 0;
+    double bestVote = -1;
+
+    for (ESTRadioMapNeighbor *candidate in neighbors)
+    {
+        double vote = 0;
+
+        for (ESTRadioMapNeighbor *neighbor in neighbors)
+        {
+            if (neighbor.floor == candidate.floor)
+            {
+                vote += 1.0 / (neighbor.distance + 1.0);
+            }
+        }
+
+        if (vote > bestVote)
+        {
+            bestVote = vote;
+            floor = candidate.floor;
+        }
+    }
+
+    double weightSum = 0;
+    double x = 0;
+    double y = 0;
+    double distance = 0;
+    NSMutableArray *used = [NSMutableArray arrayWithCapacity:neighbors.count];
+
+    for (ESTRadioMapNeighbor *neighbor in neighbors)
+    {
+        if (neighbor.floor != floor)
+        {
+            continue;
+        }
+
+        double weight = 1.0 / (neighbor.distance + 1.0);
+
+        x += weight * neighbor.x;
+        y += weight * neighbor.y;
+        weightSum += weight;
+        distance += neighbor.distance;
+
+        [used addObject:neighbor];
+    }
+
+    ESTFingerprintEstimate *estimate = [ESTFingerprintEstimate new];
+    estimate.x = x / weightSum;
+    estimate.y = y / weightSum;
+    estimate.floor = floor;
+    estimate.distance = distance / used.count;
+    estimate.neighbors = used;
+
+    return estimate;
+}
+
+@end
@@ -0,0 +1,141 @@
+//
+//  ESTFleetHealthMonitor.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+typedef NS_OPTIONS(NSUInteger, ESTBeaconHealthIssue)
+{
+    ESTBeaconHealthIssueNone             = 0,
+    ESTBeaconHealthIssueNeverSeen        = 1 << 0,
+    ESTBeaconHealthIssueSilent           = 1 << 1,
+    ESTBeaconHealthIssueLowBattery       = 1 << 2,
+    ESTBeaconHealthIssueBatteryDeclining = 1 << 3,
+    ESTBeaconHealthIssueFrequentReboots  = 1 << 4
+};
+
+/*
+ * Health snapshot of a single fleet beacon.
+ */
+@interface ESTBeaconHealthReport : NSObject
+
+@property (nonatomic, strong, readonly) ESTBeaconVO *beacon;
+@property (nonatomic, assign, readonly) ESTBeaconHealthIssue issues;
+
+/*
+ * Higher value means the beacon should be visited sooner.
+ */
+@property (nonatomic, assign, readonly) double priority;
+
+/*
+ * 0 if beacon was never seen.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval lastSeen;
+
+/*
+ * Last battery voltage from Eddystone telemetry in mV, nil if unknown.
+ */
+@property (nonatomic, strong, readonly) NSNumber *batteryVoltage;
+
+/*
+ * Days until battery reaches lowBatteryVoltage based on voltage trend, nil if unknown.
+ */
+@property (nonatomic, strong, readonly) NSNumber *estimatedDaysLeft;
+
+@property (nonatomic, assign, readonly) NSUInteger recentReboots;
+
+@end
+
+@class ESTFleetHealthMonitor;
+
+@protocol ESTFleetHealthMonitorDelegate <NSObject>
+
+@optional
+
+- (void)fleetHealthMonitor:(ESTFleetHealthMonitor *)monitor beaconDidGoSilent:(ESTBeaconHealthReport *)report;
+- (void)fleetHealthMonitor:(ESTFleetHealthMonitor *)monitor beaconDidRecover:(ESTBeaconHealthReport *)report;
+
+@end
+
+/*
+ * Fleet health engine deriving dead / degraded beacons from absence and telemetry.
+ *
+ * Expected fleet comes from `ESTCloudManager` (`ESTBeaconVO` objects). Sightings from
+ * `ESTUtilityManager` discovery, `ESTEddystoneManager` discovery (with TLM) and ranging
+ * only store the last seen time. Silence deadlines live in a hierarchical timing wheel
+ * and are re-armed lazily when they expire, so between events a fleet of any size costs
+ * nothing and each expired deadline costs O(1).
+ *
+ * A beacon is silent after max(silenceMultiple * advInterval, minimumSilence) without sightings.
+ * Battery trend is a least squares fit of TLM voltage over time, reboots are detected
+ * from TLM uptime going backwards.
+ */
+@interface ESTFleetHealthMonitor : NSObject
+
+@property (nonatomic, weak) id <ESTFleetHealthMonitorDelegate> delegate;
+
+@property (nonatomic, strong, readonly) NSArray *fleet;
+
+/*
+ * Default 100 advertising intervals.
+ */
+@property (nonatomic, assign) double silenceMultiple;
+
+/*
+ * Default 300 s, protects beacons with short advertising interval from false alarms.
+ */
+@property (nonatomic, assign) NSTimeInterval minimumSilence;
+
+/*
+ * Default 2800 mV and 20 %.
+ */
+@property (nonatomic, assign) double lowBatteryVoltage;
+@property (nonatomic, assign) double lowBatteryLevel;
+
+/*
+ * Battery trend projecting less days than this is reported as declining. Default 30.
+ */
+@property (nonatomic, assign) double minimumDaysLeft;
+
+/*
+ * Number of reboots within rebootWindow reported as frequent. Default 3 within 24 h.
+ */
+@property (nonatomic, assign) NSUInteger rebootThreshold;
+@property (nonatomic, assign) NSTimeInterval rebootWindow;
+
+- (instancetype)initWithFleet:(NSArray *)fleet startTime:(NSTimeInterval)startTime;
+
+#pragma mark - Sightings
+
+/*
+ * Discovery callbacks. Each call advances monitor time to the newest sighting.
+ */
+- (void)processBluetoothBeacons:(NSArray *)beacons;
+- (void)processEddystones:(NSArray *)eddystones;
+- (void)processBeacons:(NSArray *)beacons;
+
+- (void)recordSightingOfIdentityHash:(uint64_t)identityHash timestamp:(NSTimeInterval)timestamp;
+- (void)recordTelemetry:(ESTEddystoneTelemetry *)telemetry
+        forIdentityHash:(uint64_t)identityHash
+              timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * Fires silence deadlines up to given time. Call it periodically when no sightings arrive.
+ */
+- (void)advanceToTime:(NSTimeInterval)time;
+
+#pragma mark - Reports
+
+/*
+ * Reports of beacons with at least one issue, sorted by priority (highest first).
+ */
+- (NSArray *)maintenanceList;
+
+- (ESTBeaconHealthReport *)reportForBeacon:(ESTBeaconVO *)beacon;
+
+@end
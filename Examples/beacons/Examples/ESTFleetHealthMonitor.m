@@ -0,0 +1,488 @@
+//
+//  ESTFleetHealthMonitor.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTFleetHealthMonitor.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+#import "ESTTimingWheel.h"
+
+#define EST_HEALTH_REBOOT_HISTORY     4
+#define EST_HEALTH_TREND_TIME_CONST   14.0
+#define EST_HEALTH_SAMPLE_SPACING     3600.0
+#define EST_HEALTH_SECONDS_PER_DAY    86400.0
+
+typedef struct
+{
+    NSTimeInterval lastSeen;
+    NSTimeInterval timeout;
+    BOOL armed;
+    BOOL silent;
+
+    // Exponentially weighted least squares of voltage (mV) over time (days since first sample).
+    NSTimeInterval firstSampleAt;
+    NSTimeInterval lastSampleAt;
+    double w, wt, wv, wtt, wtv;
+    uint32_t samples;
+    double lastVoltage;
+
+    double lastUptime;
+    NSTimeInterval reboots[EST_HEALTH_REBOOT_HISTORY];
+    uint32_t rebootCount;
+} ESTBeaconHealth;
+
+#pragma mark - Report
+
+@interface ESTBeaconHealthReport ()
+
+@property (nonatomic, strong, readwrite) ESTBeaconVO *beacon;
+@property (nonatomic, assign, readwrite) ESTBeaconHealthIssue issues;
+@property (nonatomic, assign, readwrite) double priority;
+@property (nonatomic, assign, readwrite) NSTimeInterval lastSeen;
+@property (nonatomic, strong, readwrite) NSNumber *batteryVoltage;
+@property (nonatomic, strong, readwrite) NSNumber *estimatedDaysLeft;
+@property (nonatomic, assign, readwrite) NSUInteger recentReboots;
+
+@end
+
+@implementation ESTBeaconHealthReport
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %@ issues 0x%lx priority %.1f>",
+            NSStringFromClass([self class]),
+            self.beacon.macAddress ?: self.beacon.name,
+            (unsigned long)self.issues,
+            self.priority];
+}
+
+@end
+
+#pragma mark - Monitor
+
+@interface ESTFleetHealthMonitor ()
+
+@property (nonatomic, strong, readwrite) NSArray *fleet;
+@property (nonatomic, strong) ESTStructTable *aliases;
+@property (nonatomic, strong) ESTTimingWheel *wheel;
+@property (nonatomic, assign) NSTimeInterval currentTime;
+
+@end
+
+@implementation ESTFleetHealthMonitor
+{
+    ESTBeaconHealth *_health;
+}
+
+- (instancetype)init
+{
+    return [self initWithFleet:@[] startTime:CFAbsoluteTimeGetCurrent()];
+}
+
+- (instancetype)initWithFleet:(NSArray *)fleet startTime:(NSTimeInterval)startTime
+{
+    self = [super init];
+    if (self)
+    {
+        self.silenceMultiple = 100;
+        self.minimumSilence = 300;
+        self.lowBatteryVoltage = 2800;
+        self.lowBatteryLevel = 20;
+        self.minimumDaysLeft = 30;
+        self.rebootThreshold = 3;
+        self.rebootWindow = EST_HEALTH_SECONDS_PER_DAY;
+
+        self.fleet = [fleet copy];
+        self.currentTime = startTime;
+        self.wheel = [[ESTTimingWheel alloc] initWithResolution:1.0 startTime:startTime];
+        self.aliases = [[ESTStructTable alloc] initWithValueSize:sizeof(uint32_t) capacity:self.fleet.count * 4];
+
+        _health = calloc(MAX(self.fleet.count, (NSUInteger)1), sizeof(ESTBeaconHealth));
+
+        [self.fleet enumerateObjectsUsingBlock:^(ESTBeaconVO *beacon, NSUInteger idx, BOOL *stop) {
+
+            [self addAlias:ESTBeaconIdentityHashBeaconVO(beacon, NO) forIndex:(uint32_t)idx];
+            [self addAlias:ESTBeaconIdentityHashBeaconVO(beacon, YES) forIndex:(uint32_t)idx];
+
+            if (beacon.macAddress)
+            {
+                [self addAlias:ESTSketchHashString([beacon.macAddress lowercaseString]) forIndex:(uint32_t)idx];
+            }
+
+            if (beacon.eddystoneNamespaceID && beacon.eddystoneInstanceID)
+            {
+                [self addAlias:ESTBeaconIdentityHashEddystone(beacon.eddystoneNamespaceID, beacon.eddystoneInstanceID)
+                      forIndex:(uint32_t)idx];
+            }
+
+            // Never seen beacons are reported after the first timeout as well.
+            _health[idx].lastSeen = 0;
+            _health[idx].armed = YES;
+            [self.wheel scheduleKey:idx atTime:startTime + [self timeoutForBeacon:beacon]];
+        }];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_health);
+}
+
+- (void)addAlias:(uint64_t)hash forIndex:(uint32_t)index
+{
+    uint32_t *value = [self.aliases insertValueForKey:hash created:NULL];
+    *value = index;
+}
+
+- (NSTimeInterval)timeoutForBeacon:(ESTBeaconVO *)beacon
+{
+    return MAX(self.silenceMultiple * beacon.advInterval / 1000.0, self.minimumSilence);
+}
+
+#pragma mark - Sightings
+
+- (void)processBluetoothBeacons:(NSArray *)beacons
+{
+    NSTimeInterval newest = self.currentTime;
+
+    for (ESTBluetoothBeacon *beacon in beacons)
+    {
+        NSTimeInterval timestamp = beacon.discoveryDate ? [beacon.discoveryDate timeIntervalSinceReferenceDate] : CFAbsoluteTimeGetCurrent();
+
+        // Fleet entries without a known MAC address are matched by major / minor.
+        uint32_t index = beacon.macAddress
+            ? [self indexForHash:ESTSketchHashString([beacon.macAddress lowercaseString])]
+            : UINT32_MAX;
+
+        if (index == UINT32_MAX)
+        {
+            index = [self indexForHash:ESTBeaconIdentityHashBluetoothBeacon(beacon)];
+        }
+
+        [self sightIndex:index timestamp:timestamp];
+        newest = MAX(newest, timestamp);
+    }
+
+    [self advanceToTime:newest];
+}
+
+- (void)processEddystones:(NSArray *)eddystones
+{
+    NSTimeInterval newest = self.currentTime;
+
+    for (ESTEddystone *eddystone in eddystones)
+    {
+        NSTimeInterval timestamp = eddystone.discoveryDate ? [eddystone.discoveryDate timeIntervalSinceReferenceDate] : CFAbsoluteTimeGetCurrent();
+
+        // Telemetry only devices are identified by MAC address.
+        uint32_t index = eddystone.macAddress
+            ? [self indexForHash:ESTSketchHashString([eddystone.macAddress lowercaseString])]
+            : UINT32_MAX;
+
+        if (index == UINT32_MAX)
+        {
+            index = [self indexForHash:ESTBeaconIdentityHashEddystoneDevice(eddystone)];
+        }
+
+        [self sightIndex:index timestamp:timestamp];
+
+        if (eddystone.telemetry)
+        {
+            [self recordTelemetry:eddystone.telemetry forIndex:index timestamp:timestamp];
+        }
+
+        newest = MAX(newest, timestamp);
+    }
+
+    [self advanceToTime:newest];
+}
+
+- (void)processBeacons:(NSArray *)beacons
+{
+    NSTimeInterval timestamp = CFAbsoluteTimeGetCurrent();
+
+    for (CLBeacon *beacon in beacons)
+    {
+        uint32_t index = [self indexForHash:ESTBeaconIdentityHashCLBeacon(beacon)];
+
+        if (index == UINT32_MAX)
+        {
+            index = [self indexForHash:ESTBeaconIdentityHashIBeacon(nil, [beacon.major unsignedShortValue], [beacon.minor unsignedShortValue])];
+        }
+
+        [self sightIndex:index timestamp:timestamp];
+    }
+
+    [self advanceToTime:timestamp];
+}
+
+- (void)recordSightingOfIdentityHash:(uint64_t)identityHash timestamp:(NSTimeInterval)timestamp
+{
+    [self sightIndex:[self indexForHash:identityHash] timestamp:timestamp];
+}
+
+- (void)recordTelemetry:(ESTEddystoneTelemetry *)telemetry
+        forIdentityHash:(uint64_t)identityHash
+              timestamp:(NSTimeInterval)timestamp
+{
+    [self recordTelemetry:telemetry forIndex:[self indexForHash:identityHash] timestamp:timestamp];
+}
+
+- (uint32_t)indexForHash:(uint64_t)hash
+{
+    uint32_t *index = [self.aliases valueForKey:hash];
+    return index ? *index : UINT32_MAX;
+}
+
+/*
+ * Hot path: only the last seen time is stored, deadline is re-armed lazily on expiry.
+ */
+- (void)sightIndex:(uint32_t)index timestamp:(NSTimeInterval)timestamp
+{
+    if (index == UINT32_MAX)
+    {
+        return;
+    }
+
+    ESTBeaconHealth *health = &_health[index];
+    health->lastSeen = MAX(health->lastSeen, timestamp);
+
+    if (!health->armed)
+    {
+        health->armed = YES;
+        [self.wheel scheduleKey:index atTime:health->lastSeen + [self timeoutForBeacon:self.fleet[index]]];
+    }
+
+    if (health->silent)
+    {
+        health->silent = NO;
+
+        if ([self.delegate respondsToSelector:@selector(fleetHealthMonitor:beaconDidRecover:)])
+        {
+            [self.delegate fleetHealthMonitor:self beaconDidRecover:[self reportForIndex:index]];
+        }
+    }
+}
+
+- (void)recordTelemetry:(ESTEddystoneTelemetry *)telemetry forIndex:(uint32_t)index timestamp:(NSTimeInterval)timestamp
+{
+    if (index == UINT32_MAX)
+    {
+        return;
+    }
+
+    ESTBeaconHealth *health = &_health[index];
+
+    if (telemetry.uptimeMillis)
+    {
+        double uptime = [telemetry.uptimeMillis doubleValue] / 1000.0;
+
+        if (health->lastUptime > 0 && uptime + 1.0 < health->lastUptime)
+        {
+            health->reboots[health->rebootCount % EST_HEALTH_REBOOT_HISTORY] = timestamp;
+            health->rebootCount++;
+        }
+
+        health->lastUptime = uptime;
+    }
+
+    double voltage = [telemetry.batteryVoltage doubleValue];
+
+    // Discovery repeats the same telemetry frame, sample the trend at most once per spacing.
+    if (voltage > 0 && (health->samples == 0 || timestamp - health->lastSampleAt >= EST_HEALTH_SAMPLE_SPACING))
+    {
+        if (health->samples == 0)
+        {
+            health->firstSampleAt = timestamp;
+        }
+        else
+        {
+            double decay = exp(-(timestamp - health->lastSampleAt) / EST_HEALTH_SECONDS_PER_DAY / EST_HEALTH_TREND_TIME_CONST);
+            health->w *= decay;
+            health->wt *= decay;
+            health->wv *= decay;
+            health->wtt *= decay;
+            health->wtv *= decay;
+        }
+
+        double t = (timestamp - health->firstSampleAt) / EST_HEALTH_SECONDS_PER_DAY;
+
+        health->w += 1;
+        health->wt += t;
+        health->wv += voltage;
+        health->wtt += t * t;
+        health->wtv += t * voltage;
+        health->samples++;
+        health->lastSampleAt = timestamp;
+    }
+
+    if (voltage > 0)
+    {
+        health->lastVoltage = voltage;
+    }
+}
+
+#pragma mark - Time
+
+- (void)advanceToTime:(NSTimeInterval)time
+{
+    if (time <= self.currentTime)
+    {
+        return;
+    }
+
+    self.currentTime = time;
+
+    NSMutableArray *silenced = [NSMutableArray array];
+
+    [self.wheel advanceToTime:time expired:^(uint64_t key, NSTimeInterval deadline) {
+
+        ESTBeaconHealth *health = &_health[key];
+        NSTimeInterval timeout = [self timeoutForBeacon:self.fleet[(NSUInteger)key]];
+
+        // Seen since the deadline was set, re-arm relative to the last sighting.
+        if (health->lastSeen > 0 && health->lastSeen + timeout > time)
+        {
+            [self.wheel scheduleKey:key atTime:health->lastSeen + timeout];
+            return;
+        }
+
+        health->armed = NO;
+        health->silent = YES;
+
+        [silenced addObject:@(key)];
+    }];
+
+    if ([self.delegate respondsToSelector:@selector(fleetHealthMonitor:beaconDidGoSilent:)])
+    {
+        for (NSNumber *index in silenced)
+        {
+            [self.delegate fleetHealthMonitor:self beaconDidGoSilent:[self reportForIndex:[index unsignedIntValue]]];
+        }
+    }
+}
+
+#pragma mark - Reports
+
+- (double)trendSlopeForHealth:(const ESTBeaconHealth *)health
+{
+    double denominator = health->w * health->wtt - health->wt * health->wt;
+
+    if (health->samples < 3 || denominator <= 1e-9)
+    {
+        return 0;
+    }
+
+    return (health->w * health->wtv - health->wt * health->wv) / denominator;
+}
+
+- (ESTBeaconHealthReport *)reportForIndex:(uint32_t)index
+{
+    ESTBeaconHealth *health = &_health[index];
+    ESTBeaconVO *beacon = self.fleet[index];
+
+    ESTBeaconHealthReport *report = [ESTBeaconHealthReport new];
+    report.beacon = beacon;
+    report.lastSeen = health->lastSeen;
+
+    ESTBeaconHealthIssue issues = ESTBeaconHealthIssueNone;
+    double priority = 0;
+
+    if (health->silent)
+    {
+        if (health->lastSeen > 0)
+        {
+            issues |= ESTBeaconHealthIssueSilent;
+            priority += 1000 + MIN((self.currentTime - health->lastSeen) / 3600.0, 24 * 30);
+        }
+        else
+        {
+            issues |= ESTBeaconHealthIssueNeverSeen;
+            priority += 500;
+        }
+    }
+
+    if (health->lastVoltage > 0)
+    {
+        report.batteryVoltage = @(health->lastVoltage);
+
+        if (health->lastVoltage < self.lowBatteryVoltage)
+        {
+            issues |= ESTBeaconHealthIssueLowBattery;
+            priority += 300 + (self.lowBatteryVoltage - health->lastVoltage) / 10.0;
+        }
+
+        double slope = [self trendSlopeForHealth:health];
+        if (slope < 0)
+        {
+            double daysLeft = MAX(health->lastVoltage - self.lowBatteryVoltage, 0) / -slope;
+            report.estimatedDaysLeft = @(daysLeft);
+
+            if (daysLeft < self.minimumDaysLeft)
+            {
+                issues |= ESTBeaconHealthIssueBatteryDeclining;
+                priority += 200 + (self.minimumDaysLeft - daysLeft);
+            }
+        }
+    }
+    else if (beacon.batteryLevel && [beacon.batteryLevel doubleValue] < self.lowBatteryLevel)
+    {
+        issues |= ESTBeaconHealthIssueLowBattery;
+        priority += 300 + (self.lowBatteryLevel - [beacon.batteryLevel doubleValue]);
+    }
+
+    NSUInteger recentReboots = 0;
+    for (NSUInteger i = 0; i < MIN(health->rebootCount, (uint32_t)EST_HEALTH_REBOOT_HISTORY); i++)
+    {
+        if (self.currentTime - health->reboots[i] <= self.rebootWindow)
+        {
+            recentReboots++;
+        }
+    }
+
+    report.recentReboots = recentReboots;
+
+    if (recentReboots >= self.rebootThreshold)
+    {
+        issues |= ESTBeaconHealthIssueFrequentReboots;
+        priority += 100 + 10 * recentReboots;
+    }
+
+    report.issues = issues;
+    report.priority = priority;
+
+    return report;
+}
+
+- (ESTBeaconHealthReport *)reportForBeacon:(ESTBeaconVO *)beacon
+{
+    NSUInteger index = [self.fleet indexOfObjectIdenticalTo:beacon];
+
+    return index == NSNotFound ? nil : [self reportForIndex:(uint32_t)index];
+}
+
+- (NSArray *)maintenanceList
+{
+    NSMutableArray *list = [NSMutableArray array];
+
+    for (uint32_t index = 0; index < self.fleet.count; index++)
+    {
+        ESTBeaconHealthReport *report = [self reportForIndex:index];
+
+        if (report.issues != ESTBeaconHealthIssueNone)
+        {
+            [list addObject:report];
+        }
+    }
+
+    [list sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"priority" ascending:NO]]];
+
+    return list;
+}
+
+@end
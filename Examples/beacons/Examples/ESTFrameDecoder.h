@@ -0,0 +1,240 @@
+//
+//  ESTFrameDecoder.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTMonotonicClock.h"
+
+/*
+ * Built-in frame types compiled into the decoder, define to 0 in the prefix header
+ * or build settings to leave a decoder out of the binary.
+ */
+#ifndef EST_FRAME_DECODER_IBEACON
+#define EST_FRAME_DECODER_IBEACON       1
+#endif
+
+#ifndef EST_FRAME_DECODER_EDDYSTONE_UID
+#define EST_FRAME_DECODER_EDDYSTONE_UID 1
+#endif
+
+#ifndef EST_FRAME_DECODER_EDDYSTONE_URL
+#define EST_FRAME_DECODER_EDDYSTONE_URL 1
+#endif
+
+#ifndef EST_FRAME_DECODER_EDDYSTONE_TLM
+#define EST_FRAME_DECODER_EDDYSTONE_TLM 1
+#endif
+
+#ifndef EST_FRAME_DECODER_NEARABLE
+#define EST_FRAME_DECODER_NEARABLE      1
+#endif
+
+#define EST_FRAME_URL_CAPACITY          128
+#define EST_FRAME_EXTENSION_SIZE        64
+#define EST_FRAME_TYPE_LIMIT            32
+
+#define EST_FRAME_COMPANY_APPLE         0x004C
+#define EST_FRAME_COMPANY_ESTIMOTE      0x015D
+#define EST_FRAME_SERVICE_EDDYSTONE     0xFEAA
+
+typedef NS_ENUM(NSUInteger, ESTFrameType)
+{
+    /*
+     * Also Estimote scheme packets, which use the iBeacon layout.
+     */
+    ESTFrameTypeIBeacon,
+
+    ESTFrameTypeEddystoneUID,
+    ESTFrameTypeEddystoneURL,
+    ESTFrameTypeEddystoneTLM,
+    ESTFrameTypeNearable,
+
+    /*
+     * First type free for registered decoders, up to EST_FRAME_TYPE_LIMIT - 1.
+     */
+    ESTFrameTypeExtension = 16
+};
+
+typedef NS_ENUM(NSUInteger, ESTFrameSource)
+{
+    /*
+     * Bytes start with the little endian company ID.
+     */
+    ESTFrameSourceManufacturerData,
+
+    /*
+     * Bytes of a 16-bit service UUID's data, without the UUID.
+     */
+    ESTFrameSourceServiceData
+};
+
+/*
+ * Decoded frame. identityHash matches ESTBeaconIdentity for iBeacon and Eddystone
+ * frames and ESTSketchHashString of the identifier for nearables, it is 0 for TLM,
+ * which carries no identity. Extension decoders own the extension bytes.
+ */
+typedef struct
+{
+    ESTFrameType type;
+    uint64_t identityHash;
+    int8_t measuredPower;
+    int8_t rssi;
+
+    /*
+     * Taken at packet receipt, carried along with the observation.
+     */
+    ESTMonotonicTime receiptTime;
+
+    union
+    {
+        struct
+        {
+            uint8_t proximityUUID[16];
+            uint16_t major;
+            uint16_t minor;
+        } iBeacon;
+
+        struct
+        {
+            uint8_t namespaceID[10];
+            uint8_t instanceID[6];
+        } eddystoneUID;
+
+        struct
+        {
+            /*
+             * Expanded and NUL terminated.
+             */
+            char url[EST_FRAME_URL_CAPACITY];
+            uint8_t length;
+        } eddystoneURL;
+
+        struct
+        {
+            uint16_t batteryVoltage;
+
+            /*
+             * Celsius, NAN when not supported.
+             */
+            double temperature;
+
+            uint32_t advertisingCount;
+
+            /*
+             * Tenths of a second since power on.
+             */
+            uint32_t uptime;
+        } eddystoneTLM;
+
+        struct
+        {
+            uint8_t identifier[8];
+            uint8_t hardwareVersion;
+            uint8_t firmwareVersion;
+            double temperature;
+            BOOL moving;
+
+            /*
+             * Units of 15.625 mg.
+             */
+            int8_t acceleration[3];
+        } nearable;
+
+        uint8_t extension[EST_FRAME_EXTENSION_SIZE];
+    };
+} ESTFrame;
+
+/*
+ * Bytes of one frame as received, pointing into caller owned memory.
+ * serviceUUID is ignored for manufacturer data, receiptTime 0 is stamped
+ * when the frame is decoded.
+ */
+typedef struct
+{
+    ESTFrameSource source;
+    uint16_t serviceUUID;
+    const uint8_t *bytes;
+    size_t length;
+    int8_t rssi;
+    ESTMonotonicTime receiptTime;
+} ESTRawFrame;
+
+/*
+ * Decodes one frame whose header already matched. Fills everything but type, RSSI
+ * and receipt time, returns NO for malformed frames.
+ */
+typedef BOOL (*ESTFrameDecodeFunction)(const uint8_t *bytes, size_t length, ESTFrame *frame, void *context);
+
+/*
+ * Advertisement frame decoder, replacing branching over broadcasting schemes for
+ * every packet.
+ *
+ * Each frame type has its own decoder reading fixed offsets of its layout. Decoders
+ * sit in a jump table keyed by the header bytes: the company ID or service UUID
+ * picks a channel, the frame type byte (byte 2 of manufacturer data, byte 0 of
+ * service data) picks the decoder, so a packet costs two table lookups before its
+ * decoder runs.
+ *
+ * Registered decoders are per instance, register before decoding starts. Decoding
+ * is not synchronized, use one decoder per thread.
+ */
+@interface ESTFrameDecoder : NSObject
+
+/*
+ * Frames whose header matched no decoder.
+ */
+@property (nonatomic, assign, readonly) uint64_t unknownCount;
+
+/*
+ * Frames rejected by their decoder, e.g. truncated.
+ */
+@property (nonatomic, assign, readonly) uint64_t rejectedCount;
+
+/*
+ * Decoders of the built-in types enabled at compile time.
+ */
+- (instancetype)init;
+
+/*
+ * Adds a decoder for frames of the company (manufacturer data) or service UUID (service
+ * data) with the frame type byte. Returns NO when the slot is taken, the type is out of
+ * range or the channel table is full.
+ */
+- (BOOL)registerDecoder:(ESTFrameDecodeFunction)decoder
+                context:(void *)context
+                forType:(ESTFrameType)type
+                 source:(ESTFrameSource)source
+             identifier:(uint16_t)identifier
+             headerByte:(uint8_t)headerByte;
+
+- (BOOL)decodeRawFrame:(const ESTRawFrame *)raw into:(ESTFrame *)frame;
+
+/*
+ * Decoded frames are packed at the front of frames, returns their count.
+ */
+- (NSUInteger)decodeRawFrames:(const ESTRawFrame *)raw count:(NSUInteger)count into:(ESTFrame *)frames;
+
+/*
+ * Manufacturer data and 16-bit service data of a CoreBluetooth advertisement,
+ * call from the discovery callback so the receipt time is taken there.
+ */
+- (NSUInteger)decodeAdvertisementData:(NSDictionary *)advertisementData
+                                 rssi:(NSNumber *)rssi
+                                 into:(ESTFrame *)frames
+                             capacity:(NSUInteger)capacity;
+
+- (uint64_t)decodedCountForType:(ESTFrameType)type;
+
+- (void)resetCounts;
+
+/*
+ * Frames decoded per second over repeated passes through raw, for homogeneous
+ * streams of one type or mixed ones. Counts include the passes.
+ */
+- (double)throughputDecodingRawFrames:(const ESTRawFrame *)raw count:(NSUInteger)count iterations:(NSUInteger)iterations;
+
+@end
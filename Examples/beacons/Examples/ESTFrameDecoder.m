@@ -0,0 +1,515 @@
+//
+//  ESTFrameDecoder.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTFrameDecoder.h"
+#import "ESTSketchHash.h"
+#import <CoreBluetooth/CoreBluetooth.h>
+
+#define EST_FRAME_CHANNEL_LIMIT 8
+
+/*
+ * Frame layouts, offsets from the first byte handed to the decoder.
+ */
+enum
+{
+    ESTIBeaconOffsetType            = 2,
+    ESTIBeaconOffsetDataLength      = 3,
+    ESTIBeaconOffsetUUID            = 4,
+    ESTIBeaconOffsetMajor           = 20,
+    ESTIBeaconOffsetMinor           = 22,
+    ESTIBeaconOffsetPower           = 24,
+    ESTIBeaconLength                = 25,
+    ESTIBeaconType                  = 0x02,
+    ESTIBeaconDataLength            = 0x15
+};
+
+enum
+{
+    ESTEddystoneOffsetType          = 0,
+    ESTEddystoneOffsetPower         = 1,
+    ESTEddystoneTypeUID             = 0x00,
+    ESTEddystoneTypeURL             = 0x10,
+    ESTEddystoneTypeTLM             = 0x20,
+
+    ESTEddystoneUIDOffsetNamespace  = 2,
+    ESTEddystoneUIDOffsetInstance   = 12,
+    ESTEddystoneUIDLength           = 18,
+
+    ESTEddystoneURLOffsetScheme     = 2,
+    ESTEddystoneURLOffsetURL        = 3,
+    ESTEddystoneURLMaxLength        = 20,
+
+    ESTEddystoneTLMOffsetVersion    = 1,
+    ESTEddystoneTLMOffsetBattery    = 2,
+    ESTEddystoneTLMOffsetTemp       = 4,
+    ESTEddystoneTLMOffsetAdvCount   = 6,
+    ESTEddystoneTLMOffsetUptime     = 10,
+    ESTEddystoneTLMLength           = 14
+};
+
+enum
+{
+    ESTNearableOffsetType           = 2,
+    ESTNearableOffsetIdentifier     = 3,
+    ESTNearableOffsetHardware       = 11,
+    ESTNearableOffsetFirmware       = 12,
+    ESTNearableOffsetTemp           = 13,
+    ESTNearableOffsetFlags          = 15,
+    ESTNearableOffsetAcceleration   = 16,
+    ESTNearableLength               = 19,
+    ESTNearableType                 = 0x01,
+    ESTNearableFlagMoving           = 0x40
+};
+
+typedef struct
+{
+    ESTFrameDecodeFunction decode;
+    void *context;
+    ESTFrameType type;
+} ESTFrameDecoderEntry;
+
+typedef struct
+{
+    uint16_t identifier;
+    ESTFrameSource source;
+    ESTFrameDecoderEntry entries[256];
+} ESTFrameChannel;
+
+static inline uint16_t ESTFrameReadUInt16(const uint8_t *bytes)
+{
+    return (uint16_t)(bytes[0] << 8 | bytes[1]);
+}
+
+static inline uint32_t ESTFrameReadUInt32(const uint8_t *bytes)
+{
+    return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | bytes[3];
+}
+
+static inline uint64_t ESTFrameHashHex(const uint8_t *bytes, size_t length, const char *digits)
+{
+    char hex[32];
+
+    for (size_t i = 0; i < length; i++)
+    {
+        hex[2 * i] = digits[bytes[i] >> 4];
+        hex[2 * i + 1] = digits[bytes[i] & 0x0F];
+    }
+
+    return ESTSketchHashBytes(hex, 2 * length);
+}
+
+#pragma mark - Built-in decoders
+
+#if EST_FRAME_DECODER_IBEACON
+
+static BOOL ESTFrameDecodeIBeacon(const uint8_t *bytes, size_t length, ESTFrame *frame, void *context)
+{
+    if (length < ESTIBeaconLength || bytes[ESTIBeaconOffsetDataLength] != ESTIBeaconDataLength)
+    {
+        return NO;
+    }
+
+    memcpy(frame->iBeacon.proximityUUID, bytes + ESTIBeaconOffsetUUID, 16);
+    frame->iBeacon.major = ESTFrameReadUInt16(bytes + ESTIBeaconOffsetMajor);
+    frame->iBeacon.minor = ESTFrameReadUInt16(bytes + ESTIBeaconOffsetMinor);
+    frame->measuredPower = (int8_t)bytes[ESTIBeaconOffsetPower];
+
+    // UUID, major and minor are laid out as ESTBeaconIdentityHashIBeacon hashes them.
+    frame->identityHash = ESTSketchHashBytes(bytes + ESTIBeaconOffsetUUID, 20);
+
+    return YES;
+}
+
+#endif
+
+#if EST_FRAME_DECODER_EDDYSTONE_UID
+
+static BOOL ESTFrameDecodeEddystoneUID(const uint8_t *bytes, size_t length, ESTFrame *frame, void *context)
+{
+    if (length < ESTEddystoneUIDLength)
+    {
+        return NO;
+    }
+
+    memcpy(frame->eddystoneUID.namespaceID, bytes + ESTEddystoneUIDOffsetNamespace, 10);
+    memcpy(frame->eddystoneUID.instanceID, bytes + ESTEddystoneUIDOffsetInstance, 6);
+    frame->measuredPower = (int8_t)bytes[ESTEddystoneOffsetPower];
+
+    frame->identityHash = ESTSketchHashCombine(ESTFrameHashHex(bytes + ESTEddystoneUIDOffsetNamespace, 10, "0123456789ABCDEF"),
+                                               ESTFrameHashHex(bytes + ESTEddystoneUIDOffsetInstance, 6, "0123456789ABCDEF"));
+
+    return YES;
+}
+
+#endif
+
+#if EST_FRAME_DECODER_EDDYSTONE_URL
+
+static const char * const ESTFrameURLSchemes[] = { "http://www.", "https://www.", "http://", "https://" };
+
+static const char * const ESTFrameURLExpansions[] = {
+    ".com/", ".org/", ".edu/", ".net/", ".info/", ".biz/", ".gov/",
+    ".com", ".org", ".edu", ".net", ".info", ".biz", ".gov"
+};
+
+static BOOL ESTFrameDecodeEddystoneURL(const uint8_t *bytes, size_t length, ESTFrame *frame, void *context)
+{
+    if (length <= ESTEddystoneURLOffsetScheme || length > ESTEddystoneURLMaxLength
+        || bytes[ESTEddystoneURLOffsetScheme] >= sizeof(ESTFrameURLSchemes) / sizeof(ESTFrameURLSchemes[0]))
+    {
+        return NO;
+    }
+
+    // Longest expansion is 6 characters, 17 of them fit the capacity.
+    char *url = frame->eddystoneURL.url;
+    size_t position = strlen(strcpy(url, ESTFrameURLSchemes[bytes[ESTEddystoneURLOffsetScheme]]));
+
+    for (size_t i = ESTEddystoneURLOffsetURL; i < length; i++)
+    {
+        uint8_t c = bytes[i];
+
+        if (c < sizeof(ESTFrameURLExpansions) / sizeof(ESTFrameURLExpansions[0]))
+        {
+            position += strlen(strcpy(url + position, ESTFrameURLExpansions[c]));
+        }
+        else if (c > 0x20 && c < 0x7F)
+        {
+            url[position++] = (char)c;
+        }
+        else
+        {
+            return NO;
+        }
+    }
+
+    url[position] = '\0';
+    frame->eddystoneURL.length = (uint8_t)position;
+    frame->measuredPower = (int8_t)bytes[ESTEddystoneOffsetPower];
+    frame->identityHash = ESTSketchHashBytes(url, position);
+
+    return YES;
+}
+
+#endif
+
+#if EST_FRAME_DECODER_EDDYSTONE_TLM
+
+static BOOL ESTFrameDecodeEddystoneTLM(const uint8_t *bytes, size_t length, ESTFrame *frame, void *context)
+{
+    // Version 1 is the encrypted frame.
+    if (length < ESTEddystoneTLMLength || bytes[ESTEddystoneTLMOffsetVersion] != 0x00)
+    {
+        return NO;
+    }
+
+    uint16_t temperature = ESTFrameReadUInt16(bytes + ESTEddystoneTLMOffsetTemp);
+
+    frame->eddystoneTLM.batteryVoltage = ESTFrameReadUInt16(bytes + ESTEddystoneTLMOffsetBattery);
+    frame->eddystoneTLM.temperature = temperature == 0x8000 ? NAN : (int16_t)temperature / 256.0;
+    frame->eddystoneTLM.advertisingCount = ESTFrameReadUInt32(bytes + ESTEddystoneTLMOffsetAdvCount);
+    frame->eddystoneTLM.uptime = ESTFrameReadUInt32(bytes + ESTEddystoneTLMOffsetUptime);
+    frame->measuredPower = 0;
+    frame->identityHash = 0;
+
+    return YES;
+}
+
+#endif
+
+#if EST_FRAME_DECODER_NEARABLE
+
+static BOOL ESTFrameDecodeNearable(const uint8_t *bytes, size_t length, ESTFrame *frame, void *context)
+{
+    if (length < ESTNearableLength)
+    {
+        return NO;
+    }
+
+    // 12-bit two's complement in 1/16 degree, low byte first.
+    int temperature = (bytes[ESTNearableOffsetTemp + 1] & 0x0F) << 8 | bytes[ESTNearableOffsetTemp];
+    if (temperature > 2047)
+    {
+        temperature -= 4096;
+    }
+
+    memcpy(frame->nearable.identifier, bytes + ESTNearableOffsetIdentifier, 8);
+    frame->nearable.hardwareVersion = bytes[ESTNearableOffsetHardware];
+    frame->nearable.firmwareVersion = bytes[ESTNearableOffsetFirmware];
+    frame->nearable.temperature = temperature / 16.0;
+    frame->nearable.moving = (bytes[ESTNearableOffsetFlags] & ESTNearableFlagMoving) != 0;
+    memcpy(frame->nearable.acceleration, bytes + ESTNearableOffsetAcceleration, 3);
+    frame->measuredPower = 0;
+
+    // ESTNearable identifier is the lowercase hex of these bytes.
+    frame->identityHash = ESTFrameHashHex(bytes + ESTNearableOffsetIdentifier, 8, "0123456789abcdef");
+
+    return YES;
+}
+
+#endif
+
+#pragma mark - ESTFrameDecoder
+
+@interface ESTFrameDecoder ()
+
+@property (nonatomic, assign, readwrite) uint64_t unknownCount;
+@property (nonatomic, assign, readwrite) uint64_t rejectedCount;
+
+@end
+
+@implementation ESTFrameDecoder
+{
+    ESTFrameChannel *_channels;
+    NSUInteger _channelCount;
+
+    /*
+     * Channel index + 1 by source and low byte of the company ID / service UUID, 0 for none.
+     */
+    uint8_t _channelSlots[2][256];
+
+    uint64_t _decodedCounts[EST_FRAME_TYPE_LIMIT];
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        _channels = calloc(EST_FRAME_CHANNEL_LIMIT, sizeof(ESTFrameChannel));
+
+#if EST_FRAME_DECODER_IBEACON
+        [self registerDecoder:ESTFrameDecodeIBeacon context:NULL forType:ESTFrameTypeIBeacon
+                       source:ESTFrameSourceManufacturerData identifier:EST_FRAME_COMPANY_APPLE headerByte:ESTIBeaconType];
+#endif
+
+#if EST_FRAME_DECODER_EDDYSTONE_UID
+        [self registerDecoder:ESTFrameDecodeEddystoneUID context:NULL forType:ESTFrameTypeEddystoneUID
+                       source:ESTFrameSourceServiceData identifier:EST_FRAME_SERVICE_EDDYSTONE headerByte:ESTEddystoneTypeUID];
+#endif
+
+#if EST_FRAME_DECODER_EDDYSTONE_URL
+        [self registerDecoder:ESTFrameDecodeEddystoneURL context:NULL forType:ESTFrameTypeEddystoneURL
+                       source:ESTFrameSourceServiceData identifier:EST_FRAME_SERVICE_EDDYSTONE headerByte:ESTEddystoneTypeURL];
+#endif
+
+#if EST_FRAME_DECODER_EDDYSTONE_TLM
+        [self registerDecoder:ESTFrameDecodeEddystoneTLM context:NULL forType:ESTFrameTypeEddystoneTLM
+                       source:ESTFrameSourceServiceData identifier:EST_FRAME_SERVICE_EDDYSTONE headerByte:ESTEddystoneTypeTLM];
+#endif
+
+#if EST_FRAME_DECODER_NEARABLE
+        [self registerDecoder:ESTFrameDecodeNearable context:NULL forType:ESTFrameTypeNearable
+                       source:ESTFrameSourceManufacturerData identifier:EST_FRAME_COMPANY_ESTIMOTE headerByte:ESTNearableType];
+#endif
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_channels);
+}
+
+#pragma mark - Registration
+
+- (BOOL)registerDecoder:(ESTFrameDecodeFunction)decoder
+                context:(void *)context
+                forType:(ESTFrameType)type
+                 source:(ESTFrameSource)source
+             identifier:(uint16_t)identifier
+             headerByte:(uint8_t)headerByte
+{
+    if (!decoder || type >= EST_FRAME_TYPE_LIMIT || source > ESTFrameSourceServiceData)
+    {
+        return NO;
+    }
+
+    uint8_t slot = _channelSlots[source][identifier & 0xFF];
+
+    if (!slot)
+    {
+        if (_channelCount == EST_FRAME_CHANNEL_LIMIT)
+        {
+            return NO;
+        }
+
+        _channels[_channelCount].identifier = identifier;
+        _channels[_channelCount].source = source;
+        slot = (uint8_t)++_channelCount;
+        _channelSlots[source][identifier & 0xFF] = slot;
+    }
+
+    // Identifiers sharing the low byte would need a second level, none of the known ones do.
+    ESTFrameChannel *channel = &_channels[slot - 1];
+
+    if (channel->identifier != identifier || channel->entries[headerByte].decode)
+    {
+        return NO;
+    }
+
+    channel->entries[headerByte].decode = decoder;
+    channel->entries[headerByte].context = context;
+    channel->entries[headerByte].type = type;
+
+    return YES;
+}
+
+#pragma mark - Decoding
+
+- (BOOL)decodeRawFrame:(const ESTRawFrame *)raw into:(ESTFrame *)frame
+{
+    const uint8_t *bytes = raw->bytes;
+    size_t length = raw->length;
+    uint16_t identifier;
+    size_t headerOffset;
+
+    if (raw->source == ESTFrameSourceManufacturerData)
+    {
+        if (length < 3)
+        {
+            _unknownCount++;
+            return NO;
+        }
+
+        identifier = (uint16_t)(bytes[0] | bytes[1] << 8);
+        headerOffset = 2;
+    }
+    else
+    {
+        if (length < 1)
+        {
+            _unknownCount++;
+            return NO;
+        }
+
+        identifier = raw->serviceUUID;
+        headerOffset = 0;
+    }
+
+    uint8_t slot = _channelSlots[raw->source & 1][identifier & 0xFF];
+    ESTFrameDecoderEntry *entry = slot ? &_channels[slot - 1].entries[bytes[headerOffset]] : NULL;
+
+    if (!entry || !entry->decode || _channels[slot - 1].identifier != identifier)
+    {
+        _unknownCount++;
+        return NO;
+    }
+
+    if (!entry->decode(bytes, length, frame, entry->context))
+    {
+        _rejectedCount++;
+        return NO;
+    }
+
+    frame->type = entry->type;
+    frame->rssi = raw->rssi;
+    frame->receiptTime = raw->receiptTime ?: ESTMonotonicNow();
+    _decodedCounts[entry->type]++;
+
+    return YES;
+}
+
+- (NSUInteger)decodeRawFrames:(const ESTRawFrame *)raw count:(NSUInteger)count into:(ESTFrame *)frames
+{
+    NSUInteger decoded = 0;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        if ([self decodeRawFrame:&raw[i] into:&frames[decoded]])
+        {
+            decoded++;
+        }
+    }
+
+    return decoded;
+}
+
+- (NSUInteger)decodeAdvertisementData:(NSDictionary *)advertisementData
+                                 rssi:(NSNumber *)rssi
+                                 into:(ESTFrame *)frames
+                             capacity:(NSUInteger)capacity
+{
+    NSUInteger decoded = 0;
+    ESTRawFrame raw;
+    raw.rssi = (int8_t)[rssi intValue];
+    raw.receiptTime = ESTMonotonicNow();
+
+    NSData *manufacturerData = advertisementData[CBAdvertisementDataManufacturerDataKey];
+
+    if (manufacturerData && decoded < capacity)
+    {
+        raw.source = ESTFrameSourceManufacturerData;
+        raw.serviceUUID = 0;
+        raw.bytes = manufacturerData.bytes;
+        raw.length = manufacturerData.length;
+
+        decoded += [self decodeRawFrame:&raw into:&frames[decoded]] ? 1 : 0;
+    }
+
+    NSDictionary *serviceData = advertisementData[CBAdvertisementDataServiceDataKey];
+
+    for (CBUUID *uuid in serviceData)
+    {
+        NSData *uuidData = uuid.data;
+
+        if (decoded == capacity || uuidData.length != 2)
+        {
+            continue;
+        }
+
+        NSData *data = serviceData[uuid];
+
+        raw.source = ESTFrameSourceServiceData;
+        raw.serviceUUID = ESTFrameReadUInt16(uuidData.bytes);
+        raw.bytes = data.bytes;
+        raw.length = data.length;
+
+        decoded += [self decodeRawFrame:&raw into:&frames[decoded]] ? 1 : 0;
+    }
+
+    return decoded;
+}
+
+#pragma mark - Counts
+
+- (uint64_t)decodedCountForType:(ESTFrameType)type
+{
+    return type < EST_FRAME_TYPE_LIMIT ? _decodedCounts[type] : 0;
+}
+
+- (void)resetCounts
+{
+    memset(_decodedCounts, 0, sizeof(_decodedCounts));
+    _unknownCount = 0;
+    _rejectedCount = 0;
+}
+
+- (double)throughputDecodingRawFrames:(const ESTRawFrame *)raw count:(NSUInteger)count iterations:(NSUInteger)iterations
+{
+    if (count == 0 || iterations == 0)
+    {
+        return 0;
+    }
+
+    ESTFrame *frames = malloc(count * sizeof(ESTFrame));
+
+    ESTMonotonicTime start = ESTMonotonicNow();
+
+    for (NSUInteger i = 0; i < iterations; i++)
+    {
+        [self decodeRawFrames:raw count:count into:frames];
+    }
+
+    uint64_t elapsed = ESTMonotonicElapsed(start);
+
+    free(frames);
+
+    return elapsed ? (double)count * iterations * 1e9 / elapsed : 0;
+}
+
+@end
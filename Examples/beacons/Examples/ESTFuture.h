@@ -0,0 +1,67 @@
+//
+//  ESTFuture.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+extern NSString * const ESTFutureErrorDomain;
+
+typedef NS_ENUM(NSInteger, ESTFutureError)
+{
+    ESTFutureErrorCancelled,
+    ESTFutureErrorTimeout,
+
+    /*
+     * A future the operation waited for failed, underlying error in NSUnderlyingErrorKey.
+     */
+    ESTFutureErrorDependencyFailed
+};
+
+typedef void (^ESTFutureCompletion)(id value, NSError *error);
+
+/*
+ * Result of an asynchronous operation, resolved once with a value or an error.
+ *
+ * Completions added before resolution run when it resolves, on the resolving
+ * thread, those added later run immediately. Use from the main thread, where the
+ * SDK delivers its completion blocks.
+ */
+@interface ESTFuture : NSObject
+
+@property (nonatomic, assign, readonly, getter = isResolved) BOOL resolved;
+@property (nonatomic, strong, readonly) id value;
+@property (nonatomic, strong, readonly) NSError *error;
+
++ (instancetype)futureWithValue:(id)value;
++ (instancetype)futureWithError:(NSError *)error;
+
+/*
+ * Fulfilled with the array of values (NSNull for nil) once all futures are,
+ * rejected with the first error.
+ */
++ (instancetype)all:(NSArray *)futures;
+
+/*
+ * Return NO when the future was already resolved.
+ */
+- (BOOL)fulfillWithValue:(id)value;
+- (BOOL)rejectWithError:(NSError *)error;
+
+/*
+ * Rejects with ESTFutureErrorCancelled.
+ */
+- (BOOL)cancel;
+
+- (void)whenComplete:(ESTFutureCompletion)completion;
+
+/*
+ * Future of the block result, the block runs once this one is fulfilled. Errors
+ * pass through without running the block.
+ */
+- (ESTFuture *)then:(ESTFuture *(^)(id value))block;
+
+@end
@@ -0,0 +1,168 @@
+//
+//  ESTFuture.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTFuture.h"
+
+NSString * const ESTFutureErrorDomain = @"com.estimote.examples.future";
+
+@interface ESTFuture ()
+
+@property (nonatomic, assign, readwrite, getter = isResolved) BOOL resolved;
+@property (nonatomic, strong, readwrite) id value;
+@property (nonatomic, strong, readwrite) NSError *error;
+@property (nonatomic, strong) NSMutableArray *completions;
+
+@end
+
+@implementation ESTFuture
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.completions = [NSMutableArray array];
+    }
+    return self;
+}
+
++ (instancetype)futureWithValue:(id)value
+{
+    ESTFuture *future = [self new];
+    [future fulfillWithValue:value];
+
+    return future;
+}
+
++ (instancetype)futureWithError:(NSError *)error
+{
+    ESTFuture *future = [self new];
+    [future rejectWithError:error];
+
+    return future;
+}
+
++ (instancetype)all:(NSArray *)futures
+{
+    ESTFuture *result = [self new];
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:futures.count];
+    __block NSUInteger remaining = futures.count;
+
+    for (NSUInteger i = 0; i < futures.count; i++)
+    {
+        [values addObject:[NSNull null]];
+    }
+
+    if (remaining == 0)
+    {
+        [result fulfillWithValue:values];
+        return result;
+    }
+
+    [futures enumerateObjectsUsingBlock:^(ESTFuture *future, NSUInteger index, BOOL *stop) {
+
+        [future whenComplete:^(id value, NSError *error) {
+
+            if (error)
+            {
+                [result rejectWithError:error];
+                return;
+            }
+
+            values[index] = value ?: [NSNull null];
+
+            if (--remaining == 0)
+            {
+                [result fulfillWithValue:values];
+            }
+        }];
+    }];
+
+    return result;
+}
+
+- (BOOL)resolveWithValue:(id)value error:(NSError *)error
+{
+    if (self.resolved)
+    {
+        return NO;
+    }
+
+    self.resolved = YES;
+    self.value = value;
+    self.error = error;
+
+    // Completions may add completions, they run immediately from now on.
+    NSArray *completions = self.completions;
+    self.completions = nil;
+
+    for (ESTFutureCompletion completion in completions)
+    {
+        completion(value, error);
+    }
+
+    return YES;
+}
+
+- (BOOL)fulfillWithValue:(id)value
+{
+    return [self resolveWithValue:value error:nil];
+}
+
+- (BOOL)rejectWithError:(NSError *)error
+{
+    NSParameterAssert(error);
+
+    return [self resolveWithValue:nil error:error];
+}
+
+- (BOOL)cancel
+{
+    return [self rejectWithError:[NSError errorWithDomain:ESTFutureErrorDomain code:ESTFutureErrorCancelled userInfo:nil]];
+}
+
+- (void)whenComplete:(ESTFutureCompletion)completion
+{
+    if (self.resolved)
+    {
+        completion(self.value, self.error);
+        return;
+    }
+
+    [self.completions addObject:[completion copy]];
+}
+
+- (ESTFuture *)then:(ESTFuture *(^)(id value))block
+{
+    ESTFuture *result = [ESTFuture new];
+
+    [self whenComplete:^(id value, NSError *error) {
+
+        if (error)
+        {
+            [result rejectWithError:error];
+            return;
+        }
+
+        ESTFuture *next = block(value);
+
+        if (!next)
+        {
+            [result fulfillWithValue:nil];
+            return;
+        }
+
+        [next whenComplete:^(id nextValue, NSError *nextError) {
+            [result resolveWithValue:nextValue error:nextError];
+        }];
+    }];
+
+    return result;
+}
+
+@end
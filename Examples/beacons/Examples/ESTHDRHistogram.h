@@ -0,0 +1,51 @@
+//
+//  ESTHDRHistogram.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * High dynamic range histogram with log-linear buckets.
+ *
+ * Values below 2^(significantBits + 1) are recorded exactly, larger values with
+ * relative error below 2^-significantBits. Memory depends only on the trackable
+ * range and precision, e.g. 1 ms ... 1 week with 7 significant bits takes ~24 KB.
+ *
+ * Recording is O(1) and allocation free. Histograms with the same configuration can be merged.
+ */
+@interface ESTHDRHistogram : NSObject <NSCoding, NSCopying>
+
+@property (nonatomic, assign, readonly) uint64_t highestTrackableValue;
+@property (nonatomic, assign, readonly) NSUInteger significantBits;
+
+@property (nonatomic, assign, readonly) uint64_t totalCount;
+@property (nonatomic, assign, readonly) uint64_t minValue;
+@property (nonatomic, assign, readonly) uint64_t maxValue;
+
+/*
+ * Significant bits have to be in 1...10 range. Values above highestTrackableValue are clamped.
+ */
+- (instancetype)initWithHighestTrackableValue:(uint64_t)highestTrackableValue
+                              significantBits:(NSUInteger)significantBits;
+
+- (void)recordValue:(uint64_t)value;
+- (void)recordValue:(uint64_t)value count:(uint64_t)count;
+
+/*
+ * Percentile in 0...100 range. Returns 0 for empty histogram.
+ */
+- (uint64_t)valueAtPercentile:(double)percentile;
+- (double)mean;
+
+/*
+ * Returns NO when histograms have different configuration.
+ */
+- (BOOL)mergeWith:(ESTHDRHistogram *)other;
+
+- (void)reset;
+
+@end
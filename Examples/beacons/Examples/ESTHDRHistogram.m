@@ -0,0 +1,266 @@
+//
+//  ESTHDRHistogram.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTHDRHistogram.h"
+
+@interface ESTHDRHistogram ()
+
+@property (nonatomic, assign, readwrite) uint64_t highestTrackableValue;
+@property (nonatomic, assign, readwrite) NSUInteger significantBits;
+
+@property (nonatomic, assign, readwrite) uint64_t totalCount;
+@property (nonatomic, assign, readwrite) uint64_t minValue;
+@property (nonatomic, assign, readwrite) uint64_t maxValue;
+
+@end
+
+@implementation ESTHDRHistogram
+{
+    uint64_t *_counts;
+    NSUInteger _bucketCount;
+}
+
+/*
+ * Bucket layout: with S = 2^bits sub-buckets per power of two, values below 2S
+ * map to themselves. Larger value v with exponent e = floor(log2(v)) - bits
+ * keeps its top bits m = v >> e (S <= m < 2S) and lands in bucket e * S + m.
+ */
+static inline NSUInteger ESTHDRBucketIndex(uint64_t value, NSUInteger bits)
+{
+    uint64_t subBuckets = (uint64_t)1 << bits;
+
+    if (value < 2 * subBuckets)
+    {
+        return (NSUInteger)value;
+    }
+
+    NSUInteger exponent = (NSUInteger)(63 - __builtin_clzll(value)) - bits;
+    uint64_t mantissa = value >> exponent;
+
+    return (NSUInteger)(exponent * subBuckets + mantissa);
+}
+
+static inline uint64_t ESTHDRBucketMidValue(NSUInteger index, NSUInteger bits)
+{
+    NSUInteger subBuckets = (NSUInteger)1 << bits;
+
+    if (index < 2 * subBuckets)
+    {
+        return index;
+    }
+
+    NSUInteger exponent = index / subBuckets - 1;
+    uint64_t mantissa = index - exponent * subBuckets;
+
+    return (mantissa << exponent) + (((uint64_t)1 << exponent) >> 1);
+}
+
+- (instancetype)init
+{
+    // Milliseconds up to one week.
+    return [self initWithHighestTrackableValue:7ULL * 24 * 3600 * 1000 significantBits:7];
+}
+
+- (instancetype)initWithHighestTrackableValue:(uint64_t)highestTrackableValue
+                              significantBits:(NSUInteger)significantBits
+{
+    self = [super init];
+    if (self)
+    {
+        significantBits = MAX((NSUInteger)1, MIN((NSUInteger)10, significantBits));
+        highestTrackableValue = MAX(highestTrackableValue, (uint64_t)2 << significantBits);
+
+        self.significantBits = significantBits;
+        self.highestTrackableValue = highestTrackableValue;
+
+        _bucketCount = ESTHDRBucketIndex(highestTrackableValue, significantBits) + 1;
+        _counts = calloc(_bucketCount, sizeof(uint64_t));
+
+        self.minValue = UINT64_MAX;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_counts);
+}
+
+#pragma mark - Recording
+
+- (void)recordValue:(uint64_t)value
+{
+    [self recordValue:value count:1];
+}
+
+- (void)recordValue:(uint64_t)value count:(uint64_t)count
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    value = MIN(value, self.highestTrackableValue);
+
+    _counts[ESTHDRBucketIndex(value, self.significantBits)] += count;
+
+    self.totalCount += count;
+    self.minValue = MIN(self.minValue, value);
+    self.maxValue = MAX(self.maxValue, value);
+}
+
+- (void)reset
+{
+    memset(_counts, 0, _bucketCount * sizeof(uint64_t));
+
+    self.totalCount = 0;
+    self.minValue = UINT64_MAX;
+    self.maxValue = 0;
+}
+
+#pragma mark - Queries
+
+- (uint64_t)valueAtPercentile:(double)percentile
+{
+    if (self.totalCount == 0)
+    {
+        return 0;
+    }
+
+    percentile = MIN(MAX(percentile, 0.0), 100.0);
+
+    uint64_t target = (uint64_t)ceil(percentile / 100.0 * (double)self.totalCount);
+    target = MAX(target, (uint64_t)1);
+
+    uint64_t seen = 0;
+    for (NSUInteger i = 0; i < _bucketCount; i++)
+    {
+        seen += _counts[i];
+
+        if (seen >= target)
+        {
+            uint64_t value = ESTHDRBucketMidValue(i, self.significantBits);
+            return MIN(MAX(value, self.minValue), self.maxValue);
+        }
+    }
+
+    return self.maxValue;
+}
+
+- (double)mean
+{
+    if (self.totalCount == 0)
+    {
+        return 0;
+    }
+
+    double sum = 0;
+    for (NSUInteger i = 0; i < _bucketCount; i++)
+    {
+        if (_counts[i])
+        {
+            sum += (double)_counts[i] * (double)ESTHDRBucketMidValue(i, self.significantBits);
+        }
+    }
+
+    return sum / (double)self.totalCount;
+}
+
+#pragma mark - Merging
+
+- (BOOL)mergeWith:(ESTHDRHistogram *)other
+{
+    if (!other
+        || other.significantBits != self.significantBits
+        || other.highestTrackableValue != self.highestTrackableValue)
+    {
+        return NO;
+    }
+
+    for (NSUInteger i = 0; i < _bucketCount; i++)
+    {
+        _counts[i] += other->_counts[i];
+    }
+
+    self.totalCount += other.totalCount;
+    self.minValue = MIN(self.minValue, other.minValue);
+    self.maxValue = MAX(self.maxValue, other.maxValue);
+
+    return YES;
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    ESTHDRHistogram *copy = [[[self class] allocWithZone:zone] initWithHighestTrackableValue:self.highestTrackableValue
+                                                                             significantBits:self.significantBits];
+    [copy mergeWith:self];
+
+    return copy;
+}
+
+#pragma mark - NSCoding
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+    /*
+     * Only non-empty buckets are archived as (index, count) pairs,
+     * dwell histograms are usually very sparse.
+     */
+    NSMutableData *data = [NSMutableData data];
+    for (NSUInteger i = 0; i < _bucketCount; i++)
+    {
+        if (_counts[i])
+        {
+            uint64_t pair[2] = { CFSwapInt64HostToLittle(i), CFSwapInt64HostToLittle(_counts[i]) };
+            [data appendBytes:pair length:sizeof(pair)];
+        }
+    }
+
+    [coder encodeInt64:(int64_t)self.highestTrackableValue forKey:@"highestTrackableValue"];
+    [coder encodeInteger:(NSInteger)self.significantBits forKey:@"significantBits"];
+    [coder encodeInt64:(int64_t)self.minValue forKey:@"minValue"];
+    [coder encodeInt64:(int64_t)self.maxValue forKey:@"maxValue"];
+    [coder encodeObject:data forKey:@"buckets"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    self = [self initWithHighestTrackableValue:(uint64_t)[decoder decodeInt64ForKey:@"highestTrackableValue"]
+                               significantBits:(NSUInteger)[decoder decodeIntegerForKey:@"significantBits"]];
+    if (self)
+    {
+        NSData *data = [decoder decodeObjectForKey:@"buckets"];
+        const uint64_t *pairs = data.bytes;
+        NSUInteger pairCount = data.length / (2 * sizeof(uint64_t));
+
+        for (NSUInteger i = 0; i < pairCount; i++)
+        {
+            uint64_t index = CFSwapInt64LittleToHost(pairs[2 * i]);
+            uint64_t count = CFSwapInt64LittleToHost(pairs[2 * i + 1]);
+
+            if (index >= _bucketCount)
+            {
+                return nil;
+            }
+
+            _counts[index] += count;
+            self.totalCount += count;
+        }
+
+        if (self.totalCount)
+        {
+            self.minValue = (uint64_t)[decoder decodeInt64ForKey:@"minValue"];
+            self.maxValue = (uint64_t)[decoder decodeInt64ForKey:@"maxValue"];
+        }
+    }
+    return self;
+}
+
+@end
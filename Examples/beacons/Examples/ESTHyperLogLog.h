@@ -0,0 +1,39 @@
+//
+//  ESTHyperLogLog.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * HyperLogLog cardinality sketch used to count unique devices / visitors
+ * with fixed memory (2^precision bytes) and ~1.04 / sqrt(2^precision) relative error.
+ *
+ * Sketches with the same precision can be merged, so counts collected on several
+ * phones or gateways can be combined without double counting.
+ */
+@interface ESTHyperLogLog : NSObject <NSCoding, NSCopying>
+
+@property (nonatomic, assign, readonly) NSUInteger precision;
+
+/*
+ * Precision has to be in 4...16 range. 14 gives ~0.8% error with 16 KB of memory.
+ */
+- (instancetype)initWithPrecision:(NSUInteger)precision;
+
+- (void)addHash:(uint64_t)hash;
+- (void)addString:(NSString *)string;
+
+- (double)estimatedCardinality;
+
+/*
+ * Returns NO when sketches were created with different precision.
+ */
+- (BOOL)mergeWith:(ESTHyperLogLog *)other;
+
+- (void)reset;
+
+@end
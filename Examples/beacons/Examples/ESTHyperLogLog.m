@@ -0,0 +1,169 @@
+//
+//  ESTHyperLogLog.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTHyperLogLog.h"
+#import "ESTSketchHash.h"
+
+#define EST_HLL_MIN_PRECISION 4
+#define EST_HLL_MAX_PRECISION 16
+
+@interface ESTHyperLogLog ()
+
+@property (nonatomic, assign, readwrite) NSUInteger precision;
+
+@end
+
+@implementation ESTHyperLogLog
+{
+    uint8_t *_registers;
+    NSUInteger _registerCount;
+}
+
+- (instancetype)init
+{
+    return [self initWithPrecision:14];
+}
+
+- (instancetype)initWithPrecision:(NSUInteger)precision
+{
+    self = [super init];
+    if (self)
+    {
+        precision = MAX(EST_HLL_MIN_PRECISION, MIN(EST_HLL_MAX_PRECISION, precision));
+
+        self.precision = precision;
+        _registerCount = (NSUInteger)1 << precision;
+        _registers = calloc(_registerCount, sizeof(uint8_t));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_registers);
+}
+
+#pragma mark - Updates
+
+- (void)addHash:(uint64_t)hash
+{
+    NSUInteger index = (NSUInteger)(hash >> (64 - self.precision));
+
+    /*
+     * Sentinel bit guarantees non-zero word, so rank never exceeds 64 - precision + 1.
+     */
+    uint64_t word = (hash << self.precision) | ((uint64_t)1 << (self.precision - 1));
+    uint8_t rank = (uint8_t)(__builtin_clzll(word) + 1);
+
+    if (rank > _registers[index])
+    {
+        _registers[index] = rank;
+    }
+}
+
+- (void)addString:(NSString *)string
+{
+    [self addHash:ESTSketchHashString(string)];
+}
+
+- (void)reset
+{
+    memset(_registers, 0, _registerCount);
+}
+
+#pragma mark - Estimation
+
+- (double)estimatedCardinality
+{
+    double m = (double)_registerCount;
+    double sum = 0;
+    NSUInteger zeros = 0;
+
+    for (NSUInteger i = 0; i < _registerCount; i++)
+    {
+        sum += ldexp(1.0, -(int)_registers[i]);
+
+        if (_registers[i] == 0)
+        {
+            zeros++;
+        }
+    }
+
+    double alpha;
+    switch (_registerCount)
+    {
+        case 16:  alpha = 0.673; break;
+        case 32:  alpha = 0.697; break;
+        case 64:  alpha = 0.709; break;
+        default:  alpha = 0.7213 / (1.0 + 1.079 / m); break;
+    }
+
+    double estimate = alpha * m * m / sum;
+
+    // Small range correction (linear counting).
+    if (estimate <= 2.5 * m && zeros > 0)
+    {
+        estimate = m * log(m / (double)zeros);
+    }
+
+    return estimate;
+}
+
+#pragma mark - Merging
+
+- (BOOL)mergeWith:(ESTHyperLogLog *)other
+{
+    if (!other || other.precision != self.precision)
+    {
+        return NO;
+    }
+
+    for (NSUInteger i = 0; i < _registerCount; i++)
+    {
+        _registers[i] = MAX(_registers[i], other->_registers[i]);
+    }
+
+    return YES;
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    ESTHyperLogLog *copy = [[[self class] allocWithZone:zone] initWithPrecision:self.precision];
+    memcpy(copy->_registers, _registers, _registerCount);
+
+    return copy;
+}
+
+#pragma mark - NSCoding
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+    [coder encodeInteger:(NSInteger)self.precision forKey:@"precision"];
+    [coder encodeObject:[NSData dataWithBytes:_registers length:_registerCount] forKey:@"registers"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    self = [self initWithPrecision:(NSUInteger)[decoder decodeIntegerForKey:@"precision"]];
+    if (self)
+    {
+        NSData *registers = [decoder decodeObjectForKey:@"registers"];
+
+        if (registers.length != _registerCount)
+        {
+            return nil;
+        }
+
+        memcpy(_registers, registers.bytes, _registerCount);
+    }
+    return self;
+}
+
+@end
@@ -0,0 +1,110 @@
+//
+//  ESTLaunchCoordinator.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+#define EST_LAUNCH_FIRST_FRAME_TIMEOUT   2.0
+
+typedef NS_ENUM(NSInteger, ESTLaunchStage)
+{
+    /*
+     * Runs synchronously in launch, keep it to what the first screen needs.
+     */
+    ESTLaunchStageEssential,
+
+    /*
+     * Runs on the main thread once the first screen appeared, see markFirstFrame.
+     */
+    ESTLaunchStageAfterFirstFrame,
+
+    /*
+     * Runs concurrently on a background queue.
+     */
+    ESTLaunchStageBackground
+};
+
+/*
+ * Cold start path for apps using the SDK.
+ *
+ * - Managers are created on first access instead of in didFinishLaunching.
+ * - Cloud setup and analytics configuration run after the first frame.
+ * - Warm-up tasks registered for the background stage run in parallel off the main thread.
+ * - Ranged regions are persisted in a memory mapped record file, so ranging can be
+ *   restarted at launch without decoding archives or waiting for the cloud.
+ *
+ * Time from process start to the first frame and to the first ranging callback is measured
+ * with markFirstFrame and markFirstRangingCallback, both are logged once.
+ */
+@interface ESTLaunchCoordinator : NSObject <ESTBeaconManagerDelegate>
+
+@property (nonatomic, strong, readonly) ESTBeaconManager *beaconManager;
+@property (nonatomic, strong, readonly) ESTNearableManager *nearableManager;
+@property (nonatomic, strong, readonly) ESTEddystoneManager *eddystoneManager;
+
+/*
+ * Reference date based time of process start.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval processStartTime;
+
+/*
+ * Seconds from process start to the first markFirstFrame, negative until then.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval timeToFirstFrame;
+
+/*
+ * Seconds from process start to the first markFirstRangingCallback, negative until then.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval timeToFirstRanging;
+
++ (instancetype)sharedCoordinator;
+
+/*
+ * Same as ESTCloudManager setupAppID:andAppToken:, deferred to ESTLaunchStageAfterFirstFrame.
+ */
+- (void)setupAppID:(NSString *)appID andAppToken:(NSString *)appToken;
+
+- (void)addTaskForStage:(ESTLaunchStage)stage block:(void (^)(void))block;
+
+/*
+ * Runs essential tasks, restarts ranging of cached regions and schedules the rest.
+ * Call at the end of didFinishLaunching. Tasks added later run immediately in their stage.
+ */
+- (void)launch;
+
+/*
+ * Releases ESTLaunchStageAfterFirstFrame tasks, call from viewDidAppear: of the first
+ * view controller. Without the call they run EST_LAUNCH_FIRST_FRAME_TIMEOUT seconds
+ * after launch.
+ */
+- (void)markFirstFrame;
+
+/*
+ * Completion is called on the main thread once all deferred and background tasks finished.
+ */
+- (void)notifyWhenWarm:(void (^)(void))completion;
+
+#pragma mark - Region cache
+
+- (NSArray *)cachedRangedRegions;
+
+/*
+ * Written in the background, snapshots are written in call order.
+ */
+- (void)persistRangedRegions:(NSSet *)regions;
+
+/*
+ * Starts ranging of cached regions with beaconManager, returns number of regions.
+ * Nothing is started without location authorization. Until a view controller takes
+ * over the delegate, the coordinator receives the callbacks and only marks the first one.
+ */
+- (NSUInteger)startRangingCachedRegions;
+
+- (void)markFirstRangingCallback;
+
+@end
@@ -0,0 +1,376 @@
+//
+//  ESTLaunchCoordinator.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTLaunchCoordinator.h"
+#import "ESTMappedRecordFile.h"
+#import <sys/sysctl.h>
+
+#define EST_REGION_CACHE_TAG             0x31474552 // "REG1"
+#define EST_REGION_IDENTIFIER_CAPACITY   42
+
+#define EST_REGION_HAS_MAJOR             (1 << 0)
+#define EST_REGION_HAS_MINOR             (1 << 1)
+
+typedef struct
+{
+    uint8_t proximityUUID[16];
+    uint16_t major;
+    uint16_t minor;
+    uint8_t flags;
+    uint8_t identifierLength;
+    char identifier[EST_REGION_IDENTIFIER_CAPACITY];
+} ESTRegionCacheRecord;
+
+static NSTimeInterval ESTProcessStartTime(void)
+{
+    struct kinfo_proc info;
+    size_t size = sizeof(info);
+    int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid() };
+
+    if (sysctl(mib, 4, &info, &size, NULL, 0) != 0)
+    {
+        return CFAbsoluteTimeGetCurrent();
+    }
+
+    struct timeval start = info.kp_proc.p_starttime;
+
+    return start.tv_sec + start.tv_usec / 1e6 - kCFAbsoluteTimeIntervalSince1970;
+}
+
+@interface ESTLaunchCoordinator ()
+
+@property (nonatomic, strong, readwrite) ESTBeaconManager *beaconManager;
+@property (nonatomic, strong, readwrite) ESTNearableManager *nearableManager;
+@property (nonatomic, strong, readwrite) ESTEddystoneManager *eddystoneManager;
+@property (nonatomic, assign, readwrite) NSTimeInterval processStartTime;
+@property (nonatomic, assign, readwrite) NSTimeInterval timeToFirstFrame;
+@property (nonatomic, assign, readwrite) NSTimeInterval timeToFirstRanging;
+
+@property (nonatomic, strong) NSMutableArray *pendingTasks;
+@property (nonatomic, strong) NSMutableArray *firstFrameTasks;
+@property (nonatomic, strong) dispatch_group_t warmUpGroup;
+@property (nonatomic, strong) dispatch_queue_t backgroundQueue;
+@property (nonatomic, strong) dispatch_queue_t cacheQueue;
+@property (nonatomic, assign) BOOL launched;
+@property (nonatomic, assign) BOOL firstFrameShown;
+
+@end
+
+@implementation ESTLaunchCoordinator
+
++ (instancetype)sharedCoordinator
+{
+    static ESTLaunchCoordinator *sharedCoordinator;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        sharedCoordinator = [ESTLaunchCoordinator new];
+    });
+
+    return sharedCoordinator;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.processStartTime = ESTProcessStartTime();
+        self.timeToFirstFrame = -1;
+        self.timeToFirstRanging = -1;
+
+        self.pendingTasks = [NSMutableArray array];
+        self.firstFrameTasks = [NSMutableArray array];
+        self.warmUpGroup = dispatch_group_create();
+        self.backgroundQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0);
+
+        // Serial, so an older snapshot can not win the rename over a newer one.
+        self.cacheQueue = dispatch_queue_create("com.estimote.examples.region-cache", DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(self.cacheQueue, self.backgroundQueue);
+    }
+    return self;
+}
+
+#pragma mark - Lazy managers
+
+/*
+ * Managers are created on first access, always from the main thread.
+ */
+- (ESTBeaconManager *)beaconManager
+{
+    if (!_beaconManager)
+    {
+        _beaconManager = [ESTBeaconManager new];
+    }
+
+    return _beaconManager;
+}
+
+- (ESTNearableManager *)nearableManager
+{
+    if (!_nearableManager)
+    {
+        _nearableManager = [ESTNearableManager new];
+    }
+
+    return _nearableManager;
+}
+
+- (ESTEddystoneManager *)eddystoneManager
+{
+    if (!_eddystoneManager)
+    {
+        _eddystoneManager = [ESTEddystoneManager new];
+    }
+
+    return _eddystoneManager;
+}
+
+#pragma mark - Tasks
+
+- (void)setupAppID:(NSString *)appID andAppToken:(NSString *)appToken
+{
+    [self addTaskForStage:ESTLaunchStageAfterFirstFrame block:^{
+        [ESTCloudManager setupAppID:appID andAppToken:appToken];
+    }];
+}
+
+- (void)addTaskForStage:(ESTLaunchStage)stage block:(void (^)(void))block
+{
+    if (!self.launched)
+    {
+        [self.pendingTasks addObject:@[@(stage), [block copy]]];
+        return;
+    }
+
+    [self runTask:block stage:stage];
+}
+
+- (void)runTask:(void (^)(void))block stage:(ESTLaunchStage)stage
+{
+    switch (stage)
+    {
+        case ESTLaunchStageEssential:
+            block();
+            break;
+
+        case ESTLaunchStageAfterFirstFrame:
+            dispatch_group_enter(self.warmUpGroup);
+
+            if (!self.firstFrameShown)
+            {
+                [self.firstFrameTasks addObject:[block copy]];
+                break;
+            }
+
+            dispatch_async(dispatch_get_main_queue(), ^{
+                block();
+                dispatch_group_leave(self.warmUpGroup);
+            });
+            break;
+
+        case ESTLaunchStageBackground:
+            dispatch_group_async(self.warmUpGroup, self.backgroundQueue, block);
+            break;
+    }
+}
+
+- (void)launch
+{
+    if (self.launched)
+    {
+        return;
+    }
+
+    self.launched = YES;
+
+    NSArray *tasks = self.pendingTasks;
+    self.pendingTasks = nil;
+
+    // Background tasks first so they overlap with the main thread work.
+    for (ESTLaunchStage stage = ESTLaunchStageBackground; stage >= ESTLaunchStageEssential; stage--)
+    {
+        for (NSArray *task in tasks)
+        {
+            if ([task[0] integerValue] == stage)
+            {
+                [self runTask:task[1] stage:stage];
+            }
+        }
+    }
+
+    [self startRangingCachedRegions];
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(EST_LAUNCH_FIRST_FRAME_TIMEOUT * NSEC_PER_SEC)),
+                   dispatch_get_main_queue(), ^{
+        [self markFirstFrame];
+    });
+}
+
+- (void)markFirstFrame
+{
+    if (self.firstFrameShown)
+    {
+        return;
+    }
+
+    self.firstFrameShown = YES;
+    self.timeToFirstFrame = CFAbsoluteTimeGetCurrent() - self.processStartTime;
+
+    NSLog(@"ESTLaunchCoordinator: first frame %.0f ms after process start", self.timeToFirstFrame * 1000);
+
+    NSArray *tasks = self.firstFrameTasks;
+    self.firstFrameTasks = nil;
+
+    // Out of viewDidAppear:, so the appearance transition is not held up.
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for (void (^block)(void) in tasks)
+        {
+            block();
+            dispatch_group_leave(self.warmUpGroup);
+        }
+    });
+}
+
+- (void)notifyWhenWarm:(void (^)(void))completion
+{
+    dispatch_group_notify(self.warmUpGroup, dispatch_get_main_queue(), completion);
+}
+
+#pragma mark - Region cache
+
+- (NSString *)regionCachePath
+{
+    NSString *directory = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+
+    return [directory stringByAppendingPathComponent:@"ESTRangedRegions.cache"];
+}
+
+- (NSArray *)cachedRangedRegions
+{
+    ESTMappedRecordFile *file = [ESTMappedRecordFile fileWithPath:[self regionCachePath]
+                                                        formatTag:EST_REGION_CACHE_TAG
+                                                       recordSize:sizeof(ESTRegionCacheRecord)];
+
+    NSMutableArray *regions = [NSMutableArray arrayWithCapacity:file.recordCount];
+
+    for (NSUInteger i = 0; i < file.recordCount; i++)
+    {
+        const ESTRegionCacheRecord *record = [file recordAtIndex:i];
+
+        NSUUID *proximityUUID = [[NSUUID alloc] initWithUUIDBytes:record->proximityUUID];
+        NSString *identifier = [[NSString alloc] initWithBytes:record->identifier
+                                                        length:MIN(record->identifierLength, EST_REGION_IDENTIFIER_CAPACITY)
+                                                      encoding:NSUTF8StringEncoding];
+        CLBeaconRegion *region;
+
+        if (record->flags & EST_REGION_HAS_MINOR)
+        {
+            region = [[CLBeaconRegion alloc] initWithProximityUUID:proximityUUID
+                                                             major:CFSwapInt16LittleToHost(record->major)
+                                                             minor:CFSwapInt16LittleToHost(record->minor)
+                                                        identifier:identifier ?: @""];
+        }
+        else if (record->flags & EST_REGION_HAS_MAJOR)
+        {
+            region = [[CLBeaconRegion alloc] initWithProximityUUID:proximityUUID
+                                                             major:CFSwapInt16LittleToHost(record->major)
+                                                        identifier:identifier ?: @""];
+        }
+        else
+        {
+            region = [[CLBeaconRegion alloc] initWithProximityUUID:proximityUUID identifier:identifier ?: @""];
+        }
+
+        [regions addObject:region];
+    }
+
+    return regions;
+}
+
+- (void)persistRangedRegions:(NSSet *)regions
+{
+    NSMutableData *records = [NSMutableData dataWithLength:regions.count * sizeof(ESTRegionCacheRecord)];
+    ESTRegionCacheRecord *record = records.mutableBytes;
+    NSUInteger count = 0;
+
+    for (CLBeaconRegion *region in regions)
+    {
+        NSData *identifier = [region.identifier dataUsingEncoding:NSUTF8StringEncoding];
+
+        // Regions with longer identifiers are not cached, truncating would change their identity.
+        if (identifier.length > EST_REGION_IDENTIFIER_CAPACITY)
+        {
+            continue;
+        }
+
+        [region.proximityUUID getUUIDBytes:record->proximityUUID];
+        record->major = CFSwapInt16HostToLittle([region.major unsignedShortValue]);
+        record->minor = CFSwapInt16HostToLittle([region.minor unsignedShortValue]);
+        record->flags = (region.major ? EST_REGION_HAS_MAJOR : 0) | (region.minor ? EST_REGION_HAS_MINOR : 0);
+        record->identifierLength = (uint8_t)identifier.length;
+        memcpy(record->identifier, identifier.bytes, identifier.length);
+
+        record++;
+        count++;
+    }
+
+    NSData *snapshot = [records subdataWithRange:NSMakeRange(0, count * sizeof(ESTRegionCacheRecord))];
+    NSString *path = [self regionCachePath];
+
+    dispatch_async(self.cacheQueue, ^{
+        [ESTMappedRecordFile writeRecords:snapshot.bytes
+                                    count:count
+                               recordSize:sizeof(ESTRegionCacheRecord)
+                                formatTag:EST_REGION_CACHE_TAG
+                                 metadata:nil
+                                   toPath:path
+                                    error:NULL];
+    });
+}
+
+- (NSUInteger)startRangingCachedRegions
+{
+    if ([ESTBeaconManager authorizationStatus] != kCLAuthorizationStatusAuthorized)
+    {
+        return 0;
+    }
+
+    NSArray *regions = [self cachedRangedRegions];
+
+    if (regions.count > 0 && !self.beaconManager.delegate)
+    {
+        self.beaconManager.delegate = self;
+    }
+
+    for (CLBeaconRegion *region in regions)
+    {
+        [self.beaconManager startRangingBeaconsInRegion:region];
+    }
+
+    return regions.count;
+}
+
+- (void)markFirstRangingCallback
+{
+    if (self.timeToFirstRanging < 0)
+    {
+        self.timeToFirstRanging = CFAbsoluteTimeGetCurrent() - self.processStartTime;
+
+        NSLog(@"ESTLaunchCoordinator: first ranging callback %.0f ms after process start", self.timeToFirstRanging * 1000);
+    }
+}
+
+#pragma mark - ESTBeaconManager delegate
+
+- (void)beaconManager:(id)manager didRangeBeacons:(NSArray *)beacons inRegion:(CLBeaconRegion *)region
+{
+    [self markFirstRangingCallback];
+}
+
+@end
@@ -0,0 +1,119 @@
+//
+//  ESTLoadShedder.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTFrameDecoder.h"
+#import "ESTHDRHistogram.h"
+
+typedef NS_ENUM(NSInteger, ESTLoadShedLevel)
+{
+    ESTLoadShedLevelNone,
+
+    /*
+     * Static identities pass once per staticSampleInterval.
+     */
+    ESTLoadShedLevelSampleStatic,
+
+    /*
+     * Other identities also pass once per coalesceInterval.
+     */
+    ESTLoadShedLevelCoalesce,
+
+    /*
+     * Other identities pass once per criticalCoalesceInterval.
+     */
+    ESTLoadShedLevelCritical
+};
+
+@class ESTLoadShedder;
+
+@protocol ESTLoadShedderDelegate <NSObject>
+
+@optional
+
+- (void)loadShedder:(ESTLoadShedder *)shedder didChangeLevel:(ESTLoadShedLevel)level;
+
+@end
+
+typedef void (^ESTLoadShedderBlock)(const ESTFrame *frames, NSUInteger count);
+
+/*
+ * Overload controller in front of the scan pipeline.
+ *
+ * Every batch is filtered by the current level, the admitted frames are handed to
+ * the pipeline block and timed. Once per controlInterval the controller compares
+ * callback lag (receipt to pipeline block), the share of time spent in the block and
+ * the reported queue depth with their budgets: any over budget raises the level by
+ * one, all below half of it for recoveryIntervals in a row lower it by one. Watched
+ * identities always pass.
+ *
+ * Frames without identity (TLM) are not coalesced: they would all share one slot and
+ * one beacon's telemetry would shed everyone else's. They are rare next to identity
+ * frames. Not thread safe, use from the queue that runs the pipeline.
+ */
+@interface ESTLoadShedder : NSObject
+
+@property (nonatomic, weak) id <ESTLoadShedderDelegate> delegate;
+
+@property (nonatomic, assign, readonly) ESTLoadShedLevel level;
+
+/*
+ * Defaults: 250 ms lag, 30 % of the time in the pipeline, 256 queued batches.
+ */
+@property (nonatomic, assign) NSTimeInterval lagBudget;
+@property (nonatomic, assign) double cpuBudget;
+@property (nonatomic, assign) NSUInteger queueDepthBudget;
+
+/*
+ * Defaults: 1 s control interval, 3 intervals to recover.
+ */
+@property (nonatomic, assign) NSTimeInterval controlInterval;
+@property (nonatomic, assign) NSUInteger recoveryIntervals;
+
+/*
+ * Defaults: 5 s static sampling, 0.5 s and 2 s coalescing.
+ */
+@property (nonatomic, assign) NSTimeInterval staticSampleInterval;
+@property (nonatomic, assign) NSTimeInterval coalesceInterval;
+@property (nonatomic, assign) NSTimeInterval criticalCoalesceInterval;
+
+@property (nonatomic, assign, readonly) uint64_t admittedCount;
+@property (nonatomic, assign, readonly) uint64_t shedCount;
+
+/*
+ * Pipeline share of the last control interval.
+ */
+@property (nonatomic, assign, readonly) double utilization;
+
+/*
+ * Receipt to pipeline block in us, per admitted frame.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *callbackLag;
+
+/*
+ * Identities on full fidelity, e.g. those watched by ESTFastEnterDetector.
+ */
+- (void)watchIdentity:(uint64_t)identityHash;
+- (void)unwatchIdentity:(uint64_t)identityHash;
+
+/*
+ * Identities known not to move, e.g. fixed fleet beacons, sampled first.
+ */
+- (void)addStaticIdentity:(uint64_t)identityHash;
+- (void)removeStaticIdentity:(uint64_t)identityHash;
+
+/*
+ * Runs block with the admitted frames, returns their count. queueDepth is the
+ * number of batches waiting behind this one, 0 when unknown.
+ */
+- (NSUInteger)processFrames:(const ESTFrame *)frames
+                      count:(NSUInteger)count
+                 queueDepth:(NSUInteger)queueDepth
+                 usingBlock:(ESTLoadShedderBlock)block;
+
+@end
@@ -0,0 +1,291 @@
+//
+//  ESTLoadShedder.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTLoadShedder.h"
+#import "ESTStructTable.h"
+
+#define EST_LOAD_SHED_WATCHED   0x01
+#define EST_LOAD_SHED_STATIC    0x02
+
+typedef struct
+{
+    ESTMonotonicTime lastAdmitted;
+    uint8_t flags;
+} ESTLoadShedIdentity;
+
+@interface ESTLoadShedder ()
+
+@property (nonatomic, assign, readwrite) ESTLoadShedLevel level;
+@property (nonatomic, assign, readwrite) uint64_t admittedCount;
+@property (nonatomic, assign, readwrite) uint64_t shedCount;
+@property (nonatomic, assign, readwrite) double utilization;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *callbackLag;
+
+@property (nonatomic, strong) ESTStructTable *identities;
+@property (nonatomic, strong) NSMutableData *admitted;
+
+@end
+
+@implementation ESTLoadShedder
+{
+    ESTMonotonicTime _intervalStart;
+    uint64_t _busyTime;
+    uint64_t _maxLag;
+    NSUInteger _maxQueueDepth;
+    NSUInteger _calmIntervals;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.lagBudget = 0.25;
+        self.cpuBudget = 0.3;
+        self.queueDepthBudget = 256;
+        self.controlInterval = 1;
+        self.recoveryIntervals = 3;
+        self.staticSampleInterval = 5;
+        self.coalesceInterval = 0.5;
+        self.criticalCoalesceInterval = 2;
+
+        self.identities = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTLoadShedIdentity) capacity:256];
+        self.admitted = [NSMutableData data];
+
+        // 1 us ... 1 minute.
+        self.callbackLag = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:60000000 significantBits:7];
+    }
+    return self;
+}
+
+#pragma mark - Identities
+
+- (void)setFlag:(uint8_t)flag forIdentity:(uint64_t)identityHash
+{
+    ESTLoadShedIdentity *identity = [self.identities insertValueForKey:identityHash created:NULL];
+    identity->flags |= flag;
+}
+
+- (void)clearFlag:(uint8_t)flag forIdentity:(uint64_t)identityHash
+{
+    ESTLoadShedIdentity *identity = [self.identities valueForKey:identityHash];
+
+    if (!identity)
+    {
+        return;
+    }
+
+    identity->flags &= ~flag;
+
+    if (!identity->flags)
+    {
+        [self.identities removeValueForKey:identityHash];
+    }
+}
+
+- (void)watchIdentity:(uint64_t)identityHash
+{
+    [self setFlag:EST_LOAD_SHED_WATCHED forIdentity:identityHash];
+}
+
+- (void)unwatchIdentity:(uint64_t)identityHash
+{
+    [self clearFlag:EST_LOAD_SHED_WATCHED forIdentity:identityHash];
+}
+
+- (void)addStaticIdentity:(uint64_t)identityHash
+{
+    [self setFlag:EST_LOAD_SHED_STATIC forIdentity:identityHash];
+}
+
+- (void)removeStaticIdentity:(uint64_t)identityHash
+{
+    [self clearFlag:EST_LOAD_SHED_STATIC forIdentity:identityHash];
+}
+
+#pragma mark - Admission
+
+- (BOOL)admitFrame:(const ESTFrame *)frame level:(ESTLoadShedLevel)level
+{
+    if (level == ESTLoadShedLevelNone)
+    {
+        return YES;
+    }
+
+    ESTLoadShedIdentity *identity = [self.identities valueForKey:frame->identityHash];
+    NSTimeInterval interval;
+
+    if (identity && (identity->flags & EST_LOAD_SHED_WATCHED))
+    {
+        return YES;
+    }
+    else if (identity && (identity->flags & EST_LOAD_SHED_STATIC))
+    {
+        interval = self.staticSampleInterval;
+    }
+    else if (level >= ESTLoadShedLevelCoalesce && frame->identityHash != 0)
+    {
+        interval = level == ESTLoadShedLevelCritical ? self.criticalCoalesceInterval : self.coalesceInterval;
+        identity = identity ?: [self.identities insertValueForKey:frame->identityHash created:NULL];
+    }
+    else
+    {
+        return YES;
+    }
+
+    if (identity->lastAdmitted && frame->receiptTime < identity->lastAdmitted + (uint64_t)(interval * 1e9))
+    {
+        return NO;
+    }
+
+    identity->lastAdmitted = frame->receiptTime;
+
+    return YES;
+}
+
+- (NSUInteger)processFrames:(const ESTFrame *)frames
+                      count:(NSUInteger)count
+                 queueDepth:(NSUInteger)queueDepth
+                 usingBlock:(ESTLoadShedderBlock)block
+{
+    ESTMonotonicTime now = ESTMonotonicNow();
+
+    if (!_intervalStart)
+    {
+        _intervalStart = now;
+    }
+
+    if (self.admitted.length < count * sizeof(ESTFrame))
+    {
+        self.admitted.length = count * sizeof(ESTFrame);
+    }
+
+    ESTFrame *admitted = self.admitted.mutableBytes;
+    ESTLoadShedLevel level = self.level;
+    NSUInteger admittedCount = 0;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        if ([self admitFrame:&frames[i] level:level])
+        {
+            admitted[admittedCount++] = frames[i];
+        }
+    }
+
+    self.admittedCount += admittedCount;
+    self.shedCount += count - admittedCount;
+    _maxQueueDepth = MAX(_maxQueueDepth, queueDepth);
+
+    if (admittedCount)
+    {
+        ESTMonotonicTime start = ESTMonotonicNow();
+
+        for (NSUInteger i = 0; i < admittedCount; i++)
+        {
+            uint64_t lag = start > admitted[i].receiptTime ? start - admitted[i].receiptTime : 0;
+
+            _maxLag = MAX(_maxLag, lag);
+            [self.callbackLag recordValue:lag / 1000];
+        }
+
+        block(admitted, admittedCount);
+
+        _busyTime += ESTMonotonicElapsed(start);
+    }
+    else if (count)
+    {
+        _maxLag = MAX(_maxLag, now > frames[0].receiptTime ? now - frames[0].receiptTime : 0);
+    }
+
+    now = ESTMonotonicNow();
+
+    if (now - _intervalStart >= (uint64_t)(self.controlInterval * 1e9))
+    {
+        [self evaluateAtTime:now];
+    }
+
+    return admittedCount;
+}
+
+#pragma mark - Control
+
+- (void)evaluateAtTime:(ESTMonotonicTime)now
+{
+    double lag = _maxLag / 1e9;
+    double depth = _maxQueueDepth;
+
+    self.utilization = (double)_busyTime / MAX(now - _intervalStart, 1ULL);
+
+    BOOL over = lag > self.lagBudget || self.utilization > self.cpuBudget
+                || (self.queueDepthBudget && depth > self.queueDepthBudget);
+
+    BOOL calm = lag < self.lagBudget / 2 && self.utilization < self.cpuBudget / 2
+                && depth <= self.queueDepthBudget / 2.0;
+
+    ESTLoadShedLevel level = self.level;
+
+    if (over)
+    {
+        _calmIntervals = 0;
+        level = MIN(level + 1, ESTLoadShedLevelCritical);
+    }
+    else if (calm && ++_calmIntervals >= self.recoveryIntervals)
+    {
+        _calmIntervals = 0;
+        level = MAX(level - 1, ESTLoadShedLevelNone);
+    }
+    else if (!calm)
+    {
+        _calmIntervals = 0;
+    }
+
+    [self pruneIdentitiesAtTime:now];
+
+    _intervalStart = now;
+    _busyTime = 0;
+    _maxLag = 0;
+    _maxQueueDepth = 0;
+
+    if (level != self.level)
+    {
+        self.level = level;
+
+        if ([self.delegate respondsToSelector:@selector(loadShedder:didChangeLevel:)])
+        {
+            [self.delegate loadShedder:self didChangeLevel:level];
+        }
+    }
+}
+
+/*
+ * Coalescing entries of identities gone quiet, a linear pass once per control interval.
+ */
+- (void)pruneIdentitiesAtTime:(ESTMonotonicTime)now
+{
+    uint64_t idle = (uint64_t)(MAX(self.coalesceInterval, self.criticalCoalesceInterval) * 2e9);
+    NSMutableData *keys = [NSMutableData data];
+
+    [self.identities enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+
+        ESTLoadShedIdentity *identity = value;
+
+        if (!identity->flags && identity->lastAdmitted + idle < now)
+        {
+            [keys appendBytes:&key length:sizeof(key)];
+        }
+    }];
+
+    const uint64_t *removed = keys.bytes;
+
+    for (NSUInteger i = 0; i < keys.length / sizeof(uint64_t); i++)
+    {
+        [self.identities removeValueForKey:removed[i]];
+    }
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  ESTMappedRecordFile.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * Read only file of fixed size records, memory mapped and used in place.
+ *
+ * Layout (little endian): 24 byte header (magic, format tag, record size, record count,
+ * metadata length), metadata blob, padding to 8 bytes, records. Opening a file only
+ * validates the header, pages are loaded by the kernel on first access, so there is
+ * no decoding cost at launch.
+ */
+@interface ESTMappedRecordFile : NSObject
+
+/*
+ * Application defined tag identifying record layout, checked on open.
+ */
+@property (nonatomic, assign, readonly) uint32_t formatTag;
+@property (nonatomic, assign, readonly) NSUInteger recordSize;
+@property (nonatomic, assign, readonly) NSUInteger recordCount;
+@property (nonatomic, strong, readonly) NSData *metadata;
+
+/*
+ * Returns nil if the file does not exist, is truncated or has a different format tag / record size.
+ * Record size 0 accepts any size, e.g. when it depends on the metadata.
+ */
++ (instancetype)fileWithPath:(NSString *)path formatTag:(uint32_t)formatTag recordSize:(NSUInteger)recordSize;
+
+/*
+ * Writes atomically, records buffer holds recordCount * recordSize bytes.
+ */
++ (BOOL)writeRecords:(const void *)records
+               count:(NSUInteger)recordCount
+          recordSize:(NSUInteger)recordSize
+           formatTag:(uint32_t)formatTag
+            metadata:(NSData *)metadata
+              toPath:(NSString *)path
+               error:(NSError **)error;
+
+/*
+ * Pointer into the mapping, valid as long as the file object lives.
+ */
+- (const void *)recordAtIndex:(NSUInteger)index;
+- (const void *)records;
+
+@end
@@ -0,0 +1,129 @@
+//
+//  ESTMappedRecordFile.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTMappedRecordFile.h"
+
+#define EST_RECORD_FILE_MAGIC        0x52545345 // "ESTR"
+#define EST_RECORD_FILE_HEADER_SIZE  24
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t formatTag;
+    uint32_t recordSize;
+    uint32_t recordCount;
+    uint32_t metadataLength;
+    uint32_t reserved;
+} ESTRecordFileHeader;
+
+static NSUInteger ESTRecordFileRecordsOffset(NSUInteger metadataLength)
+{
+    return (EST_RECORD_FILE_HEADER_SIZE + metadataLength + 7) & ~(NSUInteger)7;
+}
+
+@interface ESTMappedRecordFile ()
+
+@property (nonatomic, assign, readwrite) uint32_t formatTag;
+@property (nonatomic, assign, readwrite) NSUInteger recordSize;
+@property (nonatomic, assign, readwrite) NSUInteger recordCount;
+@property (nonatomic, strong, readwrite) NSData *metadata;
+
+@property (nonatomic, strong) NSData *mapping;
+
+@end
+
+@implementation ESTMappedRecordFile
+{
+    const uint8_t *_records;
+}
+
++ (instancetype)fileWithPath:(NSString *)path formatTag:(uint32_t)formatTag recordSize:(NSUInteger)recordSize
+{
+    NSData *mapping = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:NULL];
+
+    if (mapping.length < EST_RECORD_FILE_HEADER_SIZE)
+    {
+        return nil;
+    }
+
+    ESTRecordFileHeader header;
+    [mapping getBytes:&header length:sizeof(header)];
+
+    header.magic = CFSwapInt32LittleToHost(header.magic);
+    header.formatTag = CFSwapInt32LittleToHost(header.formatTag);
+    header.recordSize = CFSwapInt32LittleToHost(header.recordSize);
+    header.recordCount = CFSwapInt32LittleToHost(header.recordCount);
+    header.metadataLength = CFSwapInt32LittleToHost(header.metadataLength);
+
+    if (header.magic != EST_RECORD_FILE_MAGIC || header.formatTag != formatTag || (recordSize && header.recordSize != recordSize))
+    {
+        return nil;
+    }
+
+    NSUInteger offset = ESTRecordFileRecordsOffset(header.metadataLength);
+
+    if (mapping.length < offset || (mapping.length - offset) / MAX(header.recordSize, (uint32_t)1) < header.recordCount)
+    {
+        return nil;
+    }
+
+    ESTMappedRecordFile *file = [self new];
+    file.formatTag = formatTag;
+    file.recordSize = header.recordSize;
+    file.recordCount = header.recordCount;
+    file.mapping = mapping;
+    file.metadata = [mapping subdataWithRange:NSMakeRange(EST_RECORD_FILE_HEADER_SIZE, header.metadataLength)];
+    file->_records = (const uint8_t *)mapping.bytes + offset;
+
+    return file;
+}
+
++ (BOOL)writeRecords:(const void *)records
+               count:(NSUInteger)recordCount
+          recordSize:(NSUInteger)recordSize
+           formatTag:(uint32_t)formatTag
+            metadata:(NSData *)metadata
+              toPath:(NSString *)path
+               error:(NSError **)error
+{
+    ESTRecordFileHeader header = {
+        CFSwapInt32HostToLittle(EST_RECORD_FILE_MAGIC),
+        CFSwapInt32HostToLittle(formatTag),
+        CFSwapInt32HostToLittle((uint32_t)recordSize),
+        CFSwapInt32HostToLittle((uint32_t)recordCount),
+        CFSwapInt32HostToLittle((uint32_t)metadata.length),
+        0
+    };
+
+    NSUInteger offset = ESTRecordFileRecordsOffset(metadata.length);
+    NSMutableData *data = [NSMutableData dataWithCapacity:offset + recordCount * recordSize];
+
+    [data appendBytes:&header length:sizeof(header)];
+    if (metadata)
+    {
+        [data appendData:metadata];
+    }
+    [data setLength:offset];
+    [data appendBytes:records length:recordCount * recordSize];
+
+    return [data writeToFile:path options:NSDataWritingAtomic error:error];
+}
+
+- (const void *)records
+{
+    return _records;
+}
+
+- (const void *)recordAtIndex:(NSUInteger)index
+{
+    NSAssert(index < self.recordCount, @"Record index out of bounds");
+
+    return _records + index * self.recordSize;
+}
+
+@end
@@ -0,0 +1,93 @@
+//
+//  ESTMonotonicClock.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <mach/mach_time.h>
+
+/*
+ * 64-bit monotonic nanosecond timestamps for observations.
+ *
+ * Taking one is a mach_absolute_time call and a multiplication, no allocation,
+ * and differences are exact regardless of wall clock changes. The clock does not
+ * advance while the device sleeps.
+ *
+ * Wall clock (CFAbsoluteTime) conversion is meant for API boundaries only. Because
+ * the monotonic clock stops in sleep, a fixed anchor pair would fall behind the wall
+ * clock by every sleep, so each conversion uses an anchor pair sampled at the time
+ * of the call and converts through the distance from now. That is exact for times
+ * since the last wake, i.e. for receipt times of observations still being processed.
+ * Batches take one anchor and convert all their times against it.
+ */
+
+typedef uint64_t ESTMonotonicTime;
+
+typedef struct
+{
+    ESTMonotonicTime monotonic;
+    CFAbsoluteTime absolute;
+} ESTMonotonicAnchor;
+
+static inline mach_timebase_info_data_t ESTMonotonicTimebase(void)
+{
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+
+    return timebase;
+}
+
+static inline ESTMonotonicTime ESTMonotonicNow(void)
+{
+    mach_timebase_info_data_t timebase = ESTMonotonicTimebase();
+
+    // 1/1 on Intel, 125/3 on arm64, both keep the product in range for years of uptime.
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+}
+
+/*
+ * Monotonic and wall clock time of the same instant, sampled now.
+ */
+extern ESTMonotonicAnchor ESTMonotonicAnchorNow(void);
+
+static inline CFAbsoluteTime ESTMonotonicToAbsoluteTimeWithAnchor(ESTMonotonicTime time, ESTMonotonicAnchor anchor)
+{
+    return anchor.absolute - ((double)anchor.monotonic - (double)time) / 1e9;
+}
+
+/*
+ * Times after the anchor clamp to it, times before boot to 0.
+ */
+static inline ESTMonotonicTime ESTMonotonicFromAbsoluteTimeWithAnchor(CFAbsoluteTime absolute, ESTMonotonicAnchor anchor)
+{
+    double time = (double)anchor.monotonic - MAX(anchor.absolute - absolute, 0.0) * 1e9;
+
+    return time > 0 ? (ESTMonotonicTime)time : 0;
+}
+
+static inline CFAbsoluteTime ESTMonotonicToAbsoluteTime(ESTMonotonicTime time)
+{
+    return ESTMonotonicToAbsoluteTimeWithAnchor(time, ESTMonotonicAnchorNow());
+}
+
+static inline ESTMonotonicTime ESTMonotonicFromAbsoluteTime(CFAbsoluteTime absolute)
+{
+    return ESTMonotonicFromAbsoluteTimeWithAnchor(absolute, ESTMonotonicAnchorNow());
+}
+
+/*
+ * Nanoseconds from time to now, 0 for times in the future.
+ */
+static inline uint64_t ESTMonotonicElapsed(ESTMonotonicTime time)
+{
+    ESTMonotonicTime now = ESTMonotonicNow();
+
+    return now > time ? now - time : 0;
+}
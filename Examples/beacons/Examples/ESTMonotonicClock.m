@@ -0,0 +1,21 @@
+//
+//  ESTMonotonicClock.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTMonotonicClock.h"
+
+ESTMonotonicAnchor ESTMonotonicAnchorNow(void)
+{
+    // Wall clock read between two monotonic reads, paired with their midpoint.
+    ESTMonotonicTime before = ESTMonotonicNow();
+    CFAbsoluteTime absolute = CFAbsoluteTimeGetCurrent();
+    ESTMonotonicTime after = ESTMonotonicNow();
+
+    ESTMonotonicAnchor anchor = { before + (after - before) / 2, absolute };
+
+    return anchor;
+}
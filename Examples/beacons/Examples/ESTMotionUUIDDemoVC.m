@@ -9,6 +9,7 @@
 #import <AudioToolbox/AudioToolbox.h>
 #import <EstimoteSDK/EstimoteSDK.h>
 #import "ESTMotionUUIDSettingsDemoVC.h"
+#import "ESTLaunchCoordinator.h"
 
 @interface ESTMotionUUIDDemoVC () <ESTBeaconManagerDelegate>
 
@@ -16,6 +17,7 @@
 
 @property (nonatomic, strong) CLBeacon *beacon;
 @property (nonatomic, strong) ESTBeaconManager *beaconManager;
+@property (nonatomic, strong) CLBeaconRegion *motionRegion;
 
 //UI properties
 @property (nonatomic, strong) IBOutlet UILabel *motionLabel;
@@ -41,18 +43,24 @@
     self.view.backgroundColor = [UIColor whiteColor];
     self.title = @"Motion UUID Demo";
     
-    self.beaconManager = [ESTBeaconManager new];
+    self.beaconManager = [ESTLaunchCoordinator sharedCoordinator].beaconManager;
     self.beaconManager.delegate = self;
     
     NSUUID *motionUUID = [ESTBeaconManager motionProximityUUIDForProximityUUID:self.beacon.proximityUUID];
     
-    CLBeaconRegion *motionRegion = [[CLBeaconRegion alloc] initWithProximityUUID:motionUUID
-                                                                           major:[self.beacon.major unsignedShortValue]
-                                                                           minor:[self.beacon.minor unsignedShortValue]
-                                                                      identifier:@"MotionBeaconRegion"];
+    self.motionRegion = [[CLBeaconRegion alloc] initWithProximityUUID:motionUUID
+                                                                major:[self.beacon.major unsignedShortValue]
+                                                                minor:[self.beacon.minor unsignedShortValue]
+                                                           identifier:@"MotionBeaconRegion"];
     
     
-    [self.beaconManager startRangingBeaconsInRegion:motionRegion];
+    [self.beaconManager startRangingBeaconsInRegion:self.motionRegion];
+}
+
+- (void)dealloc
+{
+    // The manager is shared and outlives this screen, ranging is not stopped with it.
+    [self.beaconManager stopRangingBeaconsInRegion:self.motionRegion];
 }
 
 - (void)viewDidDisappear:(BOOL)animated
@@ -104,6 +112,10 @@
       didRangeBeacons:(NSArray *)beacons
              inRegion:(CLBeaconRegion *)region
 {
+    if (![region.identifier isEqualToString:self.motionRegion.identifier])
+    {
+        return;
+    }
     
     /**
      *  You can simply verify if ranged region is the inMotion one
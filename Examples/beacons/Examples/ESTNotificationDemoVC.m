@@ -7,6 +7,7 @@
 //
 
 #import "ESTNotificationDemoVC.h"
+#import "ESTLaunchCoordinator.h"
 
 @interface ESTNotificationDemoVC () <ESTBeaconManagerDelegate>
 
@@ -56,7 +57,7 @@
      * BeaconManager setup.
      */
     
-    self.beaconManager = [[ESTBeaconManager alloc] init];
+    self.beaconManager = [ESTLaunchCoordinator sharedCoordinator].beaconManager;
     self.beaconManager.delegate = self;
     
     self.beaconRegion = [[CLBeaconRegion alloc] initWithProximityUUID:self.beacon.proximityUUID
@@ -0,0 +1,107 @@
+//
+//  ESTParquetWriter.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+typedef NS_ENUM(NSInteger, ESTParquetType)
+{
+    ESTParquetTypeInt32,
+    ESTParquetTypeInt64,
+    ESTParquetTypeDouble,
+
+    /*
+     * Milliseconds since 1970, stored as INT64 TIMESTAMP_MILLIS.
+     */
+    ESTParquetTypeTimestamp,
+
+    /*
+     * UTF-8 string, dictionary encoded.
+     */
+    ESTParquetTypeString
+};
+
+/*
+ * Rows buffered column by column, written as one row group. Strings are interned
+ * into a per batch dictionary as they are appended, so repeated identifiers cost
+ * one 32-bit index per row.
+ *
+ * Every row appends one value to each column in schema order.
+ */
+@interface ESTParquetBatch : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger rowCount;
+@property (nonatomic, assign, readonly) NSUInteger columnCount;
+
+/*
+ * Approximate memory held by the batch.
+ */
+@property (nonatomic, assign, readonly) NSUInteger byteSize;
+
+- (instancetype)initWithTypes:(const ESTParquetType *)types count:(NSUInteger)count;
+
+- (void)appendInt32:(int32_t)value column:(NSUInteger)column;
+- (void)appendInt64:(int64_t)value column:(NSUInteger)column;
+- (void)appendDouble:(double)value column:(NSUInteger)column;
+
+/*
+ * Reference date based time, converted to milliseconds since 1970.
+ */
+- (void)appendTimestamp:(NSTimeInterval)timestamp column:(NSUInteger)column;
+
+/*
+ * nil is written as an empty string.
+ */
+- (void)appendString:(NSString *)value column:(NSUInteger)column;
+
+/*
+ * Marks the end of a row, rows are counted by it.
+ */
+- (void)endRow;
+
+@end
+
+/*
+ * Minimal Apache Parquet writer for flat schemas of required columns.
+ *
+ * Every batch becomes one row group with a single data page per column, numbers PLAIN
+ * encoded, strings as a dictionary page plus RLE_DICTIONARY indices. Pages are GZIP
+ * compressed. The footer is written on close, the file is readable only after that.
+ */
+@interface ESTParquetWriter : NSObject
+
+@property (nonatomic, strong, readonly) NSString *path;
+@property (nonatomic, strong, readonly) NSArray *columnNames;
+@property (nonatomic, assign, readonly) uint64_t rowCount;
+@property (nonatomic, assign, readonly) uint64_t bytesWritten;
+
+/*
+ * zlib level of page compression. Default 6.
+ */
+@property (nonatomic, assign) int compressionLevel;
+
+/*
+ * Returns nil when the file cannot be created.
+ */
+- (instancetype)initWithPath:(NSString *)path
+                 columnNames:(NSArray *)columnNames
+                       types:(const ESTParquetType *)types
+                       error:(NSError **)error;
+
+/*
+ * Batch with the writer schema.
+ */
+- (ESTParquetBatch *)batch;
+
+- (BOOL)writeBatch:(ESTParquetBatch *)batch error:(NSError **)error;
+
+/*
+ * Writes the footer and closes the file.
+ */
+- (BOOL)closeWithError:(NSError **)error;
+
+@end
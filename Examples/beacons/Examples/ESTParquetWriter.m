@@ -0,0 +1,752 @@
+//
+//  ESTParquetWriter.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTParquetWriter.h"
+#import <zlib.h>
+
+#define EST_PARQUET_MAGIC "PAR1"
+
+// Thrift compact protocol field types.
+#define EST_THRIFT_I32      5
+#define EST_THRIFT_I64      6
+#define EST_THRIFT_BINARY   8
+#define EST_THRIFT_LIST     9
+#define EST_THRIFT_STRUCT   12
+#define EST_THRIFT_DEPTH    8
+
+// parquet.thrift enums.
+#define EST_PARQUET_INT32               1
+#define EST_PARQUET_INT64               2
+#define EST_PARQUET_DOUBLE              5
+#define EST_PARQUET_BYTE_ARRAY          6
+#define EST_PARQUET_REQUIRED            0
+#define EST_PARQUET_UTF8                0
+#define EST_PARQUET_TIMESTAMP_MILLIS    9
+#define EST_PARQUET_PLAIN               0
+#define EST_PARQUET_RLE                 3
+#define EST_PARQUET_RLE_DICTIONARY      8
+#define EST_PARQUET_GZIP                2
+#define EST_PARQUET_DATA_PAGE           0
+#define EST_PARQUET_DICTIONARY_PAGE     2
+
+#pragma mark - Buffers
+
+typedef struct
+{
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+} ESTParquetBuffer;
+
+static void ESTParquetReserve(ESTParquetBuffer *buffer, size_t extra)
+{
+    if (buffer->length + extra <= buffer->capacity)
+    {
+        return;
+    }
+
+    buffer->capacity = MAX(buffer->length + extra, MAX(buffer->capacity * 2, (size_t)4096));
+    buffer->bytes = realloc(buffer->bytes, buffer->capacity);
+}
+
+static void ESTParquetAppend(ESTParquetBuffer *buffer, const void *bytes, size_t length)
+{
+    ESTParquetReserve(buffer, length);
+    memcpy(buffer->bytes + buffer->length, bytes, length);
+    buffer->length += length;
+}
+
+static void ESTParquetAppendByte(ESTParquetBuffer *buffer, uint8_t byte)
+{
+    ESTParquetAppend(buffer, &byte, 1);
+}
+
+static void ESTParquetAppendVarint(ESTParquetBuffer *buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        ESTParquetAppendByte(buffer, (uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+
+    ESTParquetAppendByte(buffer, (uint8_t)value);
+}
+
+static void ESTParquetAppendUInt32(ESTParquetBuffer *buffer, uint32_t value)
+{
+    uint32_t little = CFSwapInt32HostToLittle(value);
+    ESTParquetAppend(buffer, &little, sizeof(little));
+}
+
+#pragma mark - Thrift compact protocol
+
+typedef struct
+{
+    ESTParquetBuffer *buffer;
+    int16_t lastField[EST_THRIFT_DEPTH];
+    int depth;
+} ESTThriftWriter;
+
+static uint64_t ESTThriftZigZag(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static void ESTThriftFieldHeader(ESTThriftWriter *writer, int16_t field, uint8_t type)
+{
+    int16_t delta = field - writer->lastField[writer->depth];
+
+    if (delta > 0 && delta <= 15)
+    {
+        ESTParquetAppendByte(writer->buffer, (uint8_t)(delta << 4 | type));
+    }
+    else
+    {
+        ESTParquetAppendByte(writer->buffer, type);
+        ESTParquetAppendVarint(writer->buffer, ESTThriftZigZag(field));
+    }
+
+    writer->lastField[writer->depth] = field;
+}
+
+static void ESTThriftI32(ESTThriftWriter *writer, int16_t field, int32_t value)
+{
+    ESTThriftFieldHeader(writer, field, EST_THRIFT_I32);
+    ESTParquetAppendVarint(writer->buffer, ESTThriftZigZag(value));
+}
+
+static void ESTThriftI64(ESTThriftWriter *writer, int16_t field, int64_t value)
+{
+    ESTThriftFieldHeader(writer, field, EST_THRIFT_I64);
+    ESTParquetAppendVarint(writer->buffer, ESTThriftZigZag(value));
+}
+
+static void ESTThriftString(ESTThriftWriter *writer, int16_t field, const char *value)
+{
+    size_t length = strlen(value);
+
+    ESTThriftFieldHeader(writer, field, EST_THRIFT_BINARY);
+    ESTParquetAppendVarint(writer->buffer, length);
+    ESTParquetAppend(writer->buffer, value, length);
+}
+
+static void ESTThriftListHeader(ESTThriftWriter *writer, int16_t field, uint8_t elementType, uint32_t count)
+{
+    ESTThriftFieldHeader(writer, field, EST_THRIFT_LIST);
+
+    if (count < 15)
+    {
+        ESTParquetAppendByte(writer->buffer, (uint8_t)(count << 4 | elementType));
+    }
+    else
+    {
+        ESTParquetAppendByte(writer->buffer, 0xF0 | elementType);
+        ESTParquetAppendVarint(writer->buffer, count);
+    }
+}
+
+/*
+ * Struct element of a list, or a struct field when field is nonzero.
+ */
+static void ESTThriftBeginStruct(ESTThriftWriter *writer, int16_t field)
+{
+    if (field)
+    {
+        ESTThriftFieldHeader(writer, field, EST_THRIFT_STRUCT);
+    }
+
+    writer->depth++;
+    writer->lastField[writer->depth] = 0;
+}
+
+static void ESTThriftEndStruct(ESTThriftWriter *writer)
+{
+    ESTParquetAppendByte(writer->buffer, 0);
+    writer->depth--;
+}
+
+#pragma mark - Encodings
+
+static int32_t ESTParquetPhysicalType(ESTParquetType type)
+{
+    switch (type)
+    {
+        case ESTParquetTypeInt32:
+            return EST_PARQUET_INT32;
+
+        case ESTParquetTypeDouble:
+            return EST_PARQUET_DOUBLE;
+
+        case ESTParquetTypeString:
+            return EST_PARQUET_BYTE_ARRAY;
+
+        case ESTParquetTypeInt64:
+        case ESTParquetTypeTimestamp:
+            return EST_PARQUET_INT64;
+    }
+
+    return EST_PARQUET_INT64;
+}
+
+static int ESTParquetBitWidth(uint32_t maximum)
+{
+    int width = 1;
+
+    while (width < 32 && (maximum >> width) != 0)
+    {
+        width++;
+    }
+
+    return width;
+}
+
+/*
+ * RLE / bit-packed hybrid encoding as a single bit-packed run, padded to groups of 8.
+ */
+static void ESTParquetAppendBitPacked(ESTParquetBuffer *buffer, const uint32_t *values, uint32_t count, int bitWidth)
+{
+    uint32_t groups = (count + 7) / 8;
+    uint64_t accumulator = 0;
+    int bits = 0;
+
+    ESTParquetAppendVarint(buffer, (uint64_t)groups << 1 | 1);
+    ESTParquetReserve(buffer, (size_t)groups * (size_t)bitWidth);
+
+    for (uint32_t i = 0; i < groups * 8; i++)
+    {
+        accumulator |= (uint64_t)(i < count ? values[i] : 0) << bits;
+        bits += bitWidth;
+
+        while (bits >= 8)
+        {
+            buffer->bytes[buffer->length++] = (uint8_t)accumulator;
+            accumulator >>= 8;
+            bits -= 8;
+        }
+    }
+}
+
+static BOOL ESTParquetCompress(const ESTParquetBuffer *input, ESTParquetBuffer *output, int level)
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+
+    // Window bits above 15 select the gzip wrapper GZIP codec readers expect.
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return NO;
+    }
+
+    uLong bound = deflateBound(&stream, (uLong)input->length);
+
+    output->length = 0;
+    ESTParquetReserve(output, bound);
+
+    stream.next_in = input->bytes;
+    stream.avail_in = (uInt)input->length;
+    stream.next_out = output->bytes;
+    stream.avail_out = (uInt)bound;
+
+    int status = deflate(&stream, Z_FINISH);
+    output->length = stream.total_out;
+    deflateEnd(&stream);
+
+    return status == Z_STREAM_END;
+}
+
+#pragma mark - ESTParquetBatch
+
+@interface ESTParquetColumnBuffer : NSObject
+
+@property (nonatomic, assign) ESTParquetType type;
+
+/*
+ * Values, or dictionary indices of a string column.
+ */
+@property (nonatomic, strong) NSMutableData *values;
+
+@property (nonatomic, strong) NSMutableDictionary *lookup;
+@property (nonatomic, strong) NSMutableArray *dictionary;
+@property (nonatomic, assign) NSUInteger dictionaryBytes;
+
+@end
+
+@implementation ESTParquetColumnBuffer
+
+@end
+
+@interface ESTParquetBatch ()
+
+@property (nonatomic, assign, readwrite) NSUInteger rowCount;
+@property (nonatomic, strong) NSArray *columns;
+
+@end
+
+@implementation ESTParquetBatch
+
+- (instancetype)initWithTypes:(const ESTParquetType *)types count:(NSUInteger)count
+{
+    self = [super init];
+    if (self)
+    {
+        NSMutableArray *columns = [NSMutableArray arrayWithCapacity:count];
+
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            ESTParquetColumnBuffer *column = [ESTParquetColumnBuffer new];
+            column.type = types[i];
+            column.values = [NSMutableData data];
+
+            if (types[i] == ESTParquetTypeString)
+            {
+                column.lookup = [NSMutableDictionary dictionary];
+                column.dictionary = [NSMutableArray array];
+            }
+
+            [columns addObject:column];
+        }
+
+        self.columns = columns;
+    }
+    return self;
+}
+
+- (NSUInteger)columnCount
+{
+    return self.columns.count;
+}
+
+- (NSUInteger)byteSize
+{
+    NSUInteger size = 0;
+
+    for (ESTParquetColumnBuffer *column in self.columns)
+    {
+        size += column.values.length + column.dictionaryBytes;
+    }
+
+    return size;
+}
+
+- (void)appendInt32:(int32_t)value column:(NSUInteger)column
+{
+    [[self.columns[column] values] appendBytes:&value length:sizeof(value)];
+}
+
+- (void)appendInt64:(int64_t)value column:(NSUInteger)column
+{
+    [[self.columns[column] values] appendBytes:&value length:sizeof(value)];
+}
+
+- (void)appendDouble:(double)value column:(NSUInteger)column
+{
+    [[self.columns[column] values] appendBytes:&value length:sizeof(value)];
+}
+
+- (void)appendTimestamp:(NSTimeInterval)timestamp column:(NSUInteger)column
+{
+    [self appendInt64:llround((timestamp + NSTimeIntervalSince1970) * 1000) column:column];
+}
+
+- (void)appendString:(NSString *)value column:(NSUInteger)column
+{
+    ESTParquetColumnBuffer *buffer = self.columns[column];
+    NSString *key = value ?: @"";
+    NSNumber *index = buffer.lookup[key];
+
+    if (!index)
+    {
+        index = @(buffer.dictionary.count);
+        buffer.lookup[key] = index;
+        [buffer.dictionary addObject:key];
+        buffer.dictionaryBytes += [key lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + sizeof(uint32_t);
+    }
+
+    uint32_t value32 = index.unsignedIntValue;
+    [buffer.values appendBytes:&value32 length:sizeof(value32)];
+}
+
+- (void)endRow
+{
+    self.rowCount++;
+}
+
+@end
+
+#pragma mark - ESTParquetWriter
+
+typedef struct
+{
+    int64_t fileOffset;
+    int64_t dictionaryPageOffset;
+    int64_t dataPageOffset;
+    int64_t uncompressedSize;
+    int64_t compressedSize;
+} ESTParquetChunk;
+
+typedef struct
+{
+    int64_t rowCount;
+    int64_t byteSize;
+} ESTParquetRowGroup;
+
+@interface ESTParquetWriter ()
+
+@property (nonatomic, strong, readwrite) NSString *path;
+@property (nonatomic, strong, readwrite) NSArray *columnNames;
+@property (nonatomic, assign, readwrite) uint64_t rowCount;
+@property (nonatomic, assign, readwrite) uint64_t bytesWritten;
+
+@property (nonatomic, strong) NSMutableData *rowGroups;
+@property (nonatomic, strong) NSMutableData *chunks;
+
+@end
+
+@implementation ESTParquetWriter
+{
+    FILE *_file;
+    ESTParquetType *_types;
+    ESTParquetBuffer _page;
+    ESTParquetBuffer _compressed;
+    ESTParquetBuffer _header;
+}
+
+- (instancetype)initWithPath:(NSString *)path
+                 columnNames:(NSArray *)columnNames
+                       types:(const ESTParquetType *)types
+                       error:(NSError **)error
+{
+    self = [super init];
+    if (self)
+    {
+        _file = fopen(path.fileSystemRepresentation, "wb");
+
+        if (!_file || fwrite(EST_PARQUET_MAGIC, 1, 4, _file) != 4)
+        {
+            if (error)
+            {
+                *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{ NSFilePathErrorKey : path }];
+            }
+            return nil;
+        }
+
+        self.path = path;
+        self.columnNames = [columnNames copy];
+        self.compressionLevel = Z_DEFAULT_COMPRESSION;
+        self.bytesWritten = 4;
+        self.rowGroups = [NSMutableData data];
+        self.chunks = [NSMutableData data];
+
+        _types = malloc(columnNames.count * sizeof(ESTParquetType));
+        memcpy(_types, types, columnNames.count * sizeof(ESTParquetType));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_file)
+    {
+        fclose(_file);
+    }
+
+    free(_types);
+    free(_page.bytes);
+    free(_compressed.bytes);
+    free(_header.bytes);
+}
+
+- (ESTParquetBatch *)batch
+{
+    return [[ESTParquetBatch alloc] initWithTypes:_types count:self.columnNames.count];
+}
+
+- (BOOL)failWithError:(NSError **)error
+{
+    if (error)
+    {
+        *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno ?: EIO userInfo:@{ NSFilePathErrorKey : self.path }];
+    }
+
+    return NO;
+}
+
+/*
+ * Compresses _page and writes it with its header, accumulating chunk sizes.
+ */
+- (BOOL)writePageOfType:(int32_t)pageType
+             valueCount:(uint32_t)valueCount
+               encoding:(int32_t)encoding
+                  chunk:(ESTParquetChunk *)chunk
+{
+    if (!ESTParquetCompress(&_page, &_compressed, self.compressionLevel))
+    {
+        errno = EIO;
+        return NO;
+    }
+
+    _header.length = 0;
+    ESTThriftWriter writer = { &_header, { 0 }, 0 };
+
+    ESTThriftI32(&writer, 1, pageType);
+    ESTThriftI32(&writer, 2, (int32_t)_page.length);
+    ESTThriftI32(&writer, 3, (int32_t)_compressed.length);
+
+    if (pageType == EST_PARQUET_DATA_PAGE)
+    {
+        ESTThriftBeginStruct(&writer, 5);
+        ESTThriftI32(&writer, 1, (int32_t)valueCount);
+        ESTThriftI32(&writer, 2, encoding);
+        ESTThriftI32(&writer, 3, EST_PARQUET_RLE);
+        ESTThriftI32(&writer, 4, EST_PARQUET_RLE);
+        ESTThriftEndStruct(&writer);
+    }
+    else
+    {
+        ESTThriftBeginStruct(&writer, 7);
+        ESTThriftI32(&writer, 1, (int32_t)valueCount);
+        ESTThriftI32(&writer, 2, encoding);
+        ESTThriftEndStruct(&writer);
+    }
+
+    ESTParquetAppendByte(&_header, 0);
+
+    if (fwrite(_header.bytes, 1, _header.length, _file) != _header.length ||
+        fwrite(_compressed.bytes, 1, _compressed.length, _file) != _compressed.length)
+    {
+        return NO;
+    }
+
+    chunk->uncompressedSize += (int64_t)(_header.length + _page.length);
+    chunk->compressedSize += (int64_t)(_header.length + _compressed.length);
+    self.bytesWritten += _header.length + _compressed.length;
+
+    return YES;
+}
+
+- (BOOL)writeColumn:(ESTParquetColumnBuffer *)column rowCount:(uint32_t)rowCount chunk:(ESTParquetChunk *)chunk
+{
+    chunk->fileOffset = (int64_t)self.bytesWritten;
+    chunk->dictionaryPageOffset = -1;
+
+    if (column.type != ESTParquetTypeString)
+    {
+        _page.length = 0;
+        ESTParquetAppend(&_page, column.values.bytes, column.values.length);
+
+        chunk->dataPageOffset = (int64_t)self.bytesWritten;
+
+        return [self writePageOfType:EST_PARQUET_DATA_PAGE valueCount:rowCount encoding:EST_PARQUET_PLAIN chunk:chunk];
+    }
+
+    // Dictionary page: PLAIN byte arrays, 4-byte length prefixed.
+    _page.length = 0;
+
+    for (NSString *value in column.dictionary)
+    {
+        const char *bytes = value.UTF8String;
+        uint32_t length = (uint32_t)strlen(bytes);
+
+        ESTParquetAppendUInt32(&_page, length);
+        ESTParquetAppend(&_page, bytes, length);
+    }
+
+    chunk->dictionaryPageOffset = (int64_t)self.bytesWritten;
+
+    if (![self writePageOfType:EST_PARQUET_DICTIONARY_PAGE
+                    valueCount:(uint32_t)column.dictionary.count
+                      encoding:EST_PARQUET_PLAIN
+                         chunk:chunk])
+    {
+        return NO;
+    }
+
+    // Data page: bit width, then the indices.
+    int bitWidth = ESTParquetBitWidth((uint32_t)MAX(column.dictionary.count, (NSUInteger)1) - 1);
+
+    _page.length = 0;
+    ESTParquetAppendByte(&_page, (uint8_t)bitWidth);
+    ESTParquetAppendBitPacked(&_page, column.values.bytes, rowCount, bitWidth);
+
+    chunk->dataPageOffset = (int64_t)self.bytesWritten;
+
+    return [self writePageOfType:EST_PARQUET_DATA_PAGE valueCount:rowCount encoding:EST_PARQUET_RLE_DICTIONARY chunk:chunk];
+}
+
+- (BOOL)writeBatch:(ESTParquetBatch *)batch error:(NSError **)error
+{
+    NSAssert(batch.columnCount == self.columnNames.count, @"Batch does not match the writer schema");
+
+    if (!_file)
+    {
+        errno = EBADF;
+        return [self failWithError:error];
+    }
+
+    if (batch.rowCount == 0)
+    {
+        return YES;
+    }
+
+    ESTParquetRowGroup rowGroup = { (int64_t)batch.rowCount, 0 };
+
+    for (ESTParquetColumnBuffer *column in batch.columns)
+    {
+        ESTParquetChunk chunk;
+        memset(&chunk, 0, sizeof(chunk));
+
+        if (![self writeColumn:column rowCount:(uint32_t)batch.rowCount chunk:&chunk])
+        {
+            return [self failWithError:error];
+        }
+
+        rowGroup.byteSize += chunk.uncompressedSize;
+        [self.chunks appendBytes:&chunk length:sizeof(chunk)];
+    }
+
+    [self.rowGroups appendBytes:&rowGroup length:sizeof(rowGroup)];
+    self.rowCount += batch.rowCount;
+
+    return YES;
+}
+
+#pragma mark - Footer
+
+- (void)appendSchemaToWriter:(ESTThriftWriter *)writer
+{
+    NSUInteger columnCount = self.columnNames.count;
+
+    ESTThriftListHeader(writer, 2, EST_THRIFT_STRUCT, (uint32_t)columnCount + 1);
+
+    ESTThriftBeginStruct(writer, 0);
+    ESTThriftString(writer, 4, "schema");
+    ESTThriftI32(writer, 5, (int32_t)columnCount);
+    ESTThriftEndStruct(writer);
+
+    for (NSUInteger i = 0; i < columnCount; i++)
+    {
+        int32_t convertedType = -1;
+
+        if (_types[i] == ESTParquetTypeTimestamp)
+        {
+            convertedType = EST_PARQUET_TIMESTAMP_MILLIS;
+        }
+        else if (_types[i] == ESTParquetTypeString)
+        {
+            convertedType = EST_PARQUET_UTF8;
+        }
+
+        ESTThriftBeginStruct(writer, 0);
+        ESTThriftI32(writer, 1, ESTParquetPhysicalType(_types[i]));
+        ESTThriftI32(writer, 3, EST_PARQUET_REQUIRED);
+        ESTThriftString(writer, 4, [self.columnNames[i] UTF8String]);
+
+        if (convertedType >= 0)
+        {
+            ESTThriftI32(writer, 6, convertedType);
+        }
+
+        ESTThriftEndStruct(writer);
+    }
+}
+
+- (void)appendRowGroupsToWriter:(ESTThriftWriter *)writer
+{
+    NSUInteger columnCount = self.columnNames.count;
+    NSUInteger rowGroupCount = self.rowGroups.length / sizeof(ESTParquetRowGroup);
+    const ESTParquetRowGroup *rowGroups = self.rowGroups.bytes;
+    const ESTParquetChunk *chunks = self.chunks.bytes;
+
+    ESTThriftListHeader(writer, 4, EST_THRIFT_STRUCT, (uint32_t)rowGroupCount);
+
+    for (NSUInteger g = 0; g < rowGroupCount; g++)
+    {
+        ESTThriftBeginStruct(writer, 0);
+        ESTThriftListHeader(writer, 1, EST_THRIFT_STRUCT, (uint32_t)columnCount);
+
+        for (NSUInteger c = 0; c < columnCount; c++)
+        {
+            const ESTParquetChunk *chunk = &chunks[g * columnCount + c];
+            BOOL dictionary = chunk->dictionaryPageOffset >= 0;
+            const char *name = [self.columnNames[c] UTF8String];
+
+            ESTThriftBeginStruct(writer, 0);
+            ESTThriftI64(writer, 2, chunk->fileOffset);
+            ESTThriftBeginStruct(writer, 3);
+
+            ESTThriftI32(writer, 1, ESTParquetPhysicalType(_types[c]));
+
+            ESTThriftListHeader(writer, 2, EST_THRIFT_I32, dictionary ? 3 : 2);
+            ESTParquetAppendVarint(writer->buffer, ESTThriftZigZag(EST_PARQUET_PLAIN));
+            ESTParquetAppendVarint(writer->buffer, ESTThriftZigZag(EST_PARQUET_RLE));
+            if (dictionary)
+            {
+                ESTParquetAppendVarint(writer->buffer, ESTThriftZigZag(EST_PARQUET_RLE_DICTIONARY));
+            }
+
+            ESTThriftListHeader(writer, 3, EST_THRIFT_BINARY, 1);
+            ESTParquetAppendVarint(writer->buffer, strlen(name));
+            ESTParquetAppend(writer->buffer, name, strlen(name));
+
+            ESTThriftI32(writer, 4, EST_PARQUET_GZIP);
+            ESTThriftI64(writer, 5, rowGroups[g].rowCount);
+            ESTThriftI64(writer, 6, chunk->uncompressedSize);
+            ESTThriftI64(writer, 7, chunk->compressedSize);
+            ESTThriftI64(writer, 9, chunk->dataPageOffset);
+
+            if (dictionary)
+            {
+                ESTThriftI64(writer, 11, chunk->dictionaryPageOffset);
+            }
+
+            ESTThriftEndStruct(writer);
+            ESTThriftEndStruct(writer);
+        }
+
+        ESTThriftI64(writer, 2, rowGroups[g].byteSize);
+        ESTThriftI64(writer, 3, rowGroups[g].rowCount);
+        ESTThriftEndStruct(writer);
+    }
+}
+
+- (BOOL)closeWithError:(NSError **)error
+{
+    if (!_file)
+    {
+        return YES;
+    }
+
+    _header.length = 0;
+    ESTThriftWriter writer = { &_header, { 0 }, 0 };
+
+    ESTThriftI32(&writer, 1, 1);
+    [self appendSchemaToWriter:&writer];
+    ESTThriftI64(&writer, 3, (int64_t)self.rowCount);
+    [self appendRowGroupsToWriter:&writer];
+    ESTThriftString(&writer, 6, "Estimote Examples");
+    ESTParquetAppendByte(&_header, 0);
+
+    ESTParquetAppendUInt32(&_header, (uint32_t)_header.length);
+    ESTParquetAppend(&_header, EST_PARQUET_MAGIC, 4);
+
+    BOOL written = fwrite(_header.bytes, 1, _header.length, _file) == _header.length;
+    BOOL closed = fclose(_file) == 0;
+
+    _file = NULL;
+
+    if (!written || !closed)
+    {
+        return [self failWithError:error];
+    }
+
+    self.bytesWritten += _header.length;
+
+    return YES;
+}
+
+@end
@@ -0,0 +1,114 @@
+//
+//  ESTPredictiveExitDetector.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+#import "ESTHDRHistogram.h"
+
+@class ESTPredictiveExitDetector;
+
+@protocol ESTPredictiveExitDetectorDelegate <NSObject>
+
+/*
+ * Absence is the time between the last sighting and the exit.
+ */
+- (void)exitDetector:(ESTPredictiveExitDetector *)detector didExit:(uint64_t)identityHash absence:(NSTimeInterval)absence;
+
+@optional
+
+- (void)exitDetector:(ESTPredictiveExitDetector *)detector didEnter:(uint64_t)identityHash;
+
+@end
+
+/*
+ * Exit detection from missed advertising slots instead of a fixed timeout.
+ *
+ * A beacon advertises every advInterval, a source reports it at most every
+ * sourceInterval (e.g. 1 s for ranging), so sightings fall into slots of the larger of
+ * the two. The probability p of receiving a slot is estimated from observed gaps
+ * (Beta prior, exponential forgetting). Missing k slots in a row while present has
+ * probability (1 - p)^k, exit is declared once it drops below falseExitProbability.
+ * Good links exit after a few slots, lossy ones wait longer, never more than
+ * baselineTimeout.
+ *
+ * Deadlines live in a timing wheel and are re-armed lazily when they expire, so
+ * sightings cost O(1) and idle beacons cost nothing.
+ */
+@interface ESTPredictiveExitDetector : NSObject
+
+@property (nonatomic, weak) id <ESTPredictiveExitDetectorDelegate> delegate;
+
+/*
+ * Target probability of declaring exit while the beacon is still present. Default 0.001.
+ */
+@property (nonatomic, assign) double falseExitProbability;
+
+/*
+ * Reporting interval of the sighting source. Default 1 s (ranging).
+ */
+@property (nonatomic, assign) NSTimeInterval sourceInterval;
+
+/*
+ * Fixed timeout of the baseline, upper bound of exit delay. Default 30 s.
+ */
+@property (nonatomic, assign) NSTimeInterval baselineTimeout;
+
+/*
+ * Forgetting factor of the reception estimate per sighting. Default 0.95.
+ */
+@property (nonatomic, assign) double forgetting;
+
+@property (nonatomic, assign, readonly) NSUInteger insideCount;
+@property (nonatomic, assign, readonly) NSUInteger exitCount;
+
+/*
+ * Exits followed by a sighting within baselineTimeout of the last one,
+ * i.e. exits the fixed timeout baseline would not have declared.
+ */
+@property (nonatomic, assign, readonly) NSUInteger falseExitCount;
+
+/*
+ * Absence at exit in ms, compare with baselineTimeout.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *exitLatency;
+
+- (instancetype)initWithStartTime:(NSTimeInterval)startTime;
+
+/*
+ * Advertising interval in seconds.
+ */
+- (void)trackIdentityHash:(uint64_t)identityHash advertisingInterval:(NSTimeInterval)interval;
+
+/*
+ * ESTBeaconVO objects from ESTCloudManager, advInterval in ms.
+ */
+- (void)trackBeacons:(NSArray *)beacons;
+
+- (void)untrackIdentityHash:(uint64_t)identityHash;
+
+/*
+ * Current reception probability estimate, NAN for unknown identities.
+ */
+- (double)receptionProbabilityForIdentityHash:(uint64_t)identityHash;
+
+- (void)processSightingOfIdentityHash:(uint64_t)identityHash timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * CLBeacon objects from ranging.
+ */
+- (void)processRangedBeacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp;
+
+- (void)advanceToTime:(NSTimeInterval)time;
+
+/*
+ * Advances to current time every interval on the main run loop.
+ */
+- (void)startClockWithInterval:(NSTimeInterval)interval;
+- (void)stopClock;
+
+@end
@@ -0,0 +1,294 @@
+//
+//  ESTPredictiveExitDetector.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTPredictiveExitDetector.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+#import "ESTTimingWheel.h"
+
+#define EST_EXIT_WHEEL_RESOLUTION   0.1
+#define EST_EXIT_MAX_RECEPTION      0.999
+#define EST_EXIT_SLOT_TOLERANCE     0.5
+
+typedef struct
+{
+    NSTimeInterval advertisingInterval;
+    NSTimeInterval lastSeen;
+    NSTimeInterval lastExit;
+    double hits;
+    double trials;
+    BOOL inside;
+    BOOL armed;
+} ESTExitTrack;
+
+typedef struct
+{
+    uint64_t identityHash;
+    NSTimeInterval absence;
+} ESTExitEvent;
+
+@interface ESTPredictiveExitDetector ()
+
+@property (nonatomic, assign, readwrite) NSUInteger insideCount;
+@property (nonatomic, assign, readwrite) NSUInteger exitCount;
+@property (nonatomic, assign, readwrite) NSUInteger falseExitCount;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *exitLatency;
+
+@property (nonatomic, strong) ESTStructTable *tracks;
+@property (nonatomic, strong) ESTTimingWheel *wheel;
+@property (nonatomic, strong) NSMutableData *exits;
+@property (nonatomic, strong) NSTimer *clock;
+
+@end
+
+@implementation ESTPredictiveExitDetector
+
+- (instancetype)init
+{
+    return [self initWithStartTime:CFAbsoluteTimeGetCurrent()];
+}
+
+- (instancetype)initWithStartTime:(NSTimeInterval)startTime
+{
+    self = [super init];
+    if (self)
+    {
+        self.falseExitProbability = 0.001;
+        self.sourceInterval = 1.0;
+        self.baselineTimeout = 30;
+        self.forgetting = 0.95;
+
+        self.tracks = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTExitTrack) capacity:64];
+        self.wheel = [[ESTTimingWheel alloc] initWithResolution:EST_EXIT_WHEEL_RESOLUTION startTime:startTime];
+        self.exits = [NSMutableData data];
+
+        // 1 ms ... 1 hour.
+        self.exitLatency = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:3600000 significantBits:7];
+    }
+    return self;
+}
+
+#pragma mark - Tracking
+
+- (void)trackIdentityHash:(uint64_t)identityHash advertisingInterval:(NSTimeInterval)interval
+{
+    ESTExitTrack *track = [self.tracks insertValueForKey:identityHash created:NULL];
+    track->advertisingInterval = MAX(interval, 0.0);
+}
+
+- (void)trackBeacons:(NSArray *)beacons
+{
+    for (ESTBeaconVO *beacon in beacons)
+    {
+        [self trackIdentityHash:ESTBeaconIdentityHashBeaconVO(beacon, NO) advertisingInterval:beacon.advInterval / 1000.0];
+    }
+}
+
+- (void)untrackIdentityHash:(uint64_t)identityHash
+{
+    ESTExitTrack *track = [self.tracks valueForKey:identityHash];
+
+    if (!track)
+    {
+        return;
+    }
+
+    if (track->inside)
+    {
+        self.insideCount--;
+    }
+
+    [self.wheel cancelKey:identityHash];
+    [self.tracks removeValueForKey:identityHash];
+}
+
+#pragma mark - Model
+
+- (NSTimeInterval)slotForTrack:(const ESTExitTrack *)track
+{
+    return MAX(MAX(track->advertisingInterval, self.sourceInterval), EST_EXIT_WHEEL_RESOLUTION);
+}
+
+/*
+ * Posterior mean with Beta(1, 1) prior.
+ */
+- (double)receptionForTrack:(const ESTExitTrack *)track
+{
+    return MIN((track->hits + 1) / (track->trials + 2), EST_EXIT_MAX_RECEPTION);
+}
+
+- (NSTimeInterval)exitDelayForTrack:(const ESTExitTrack *)track
+{
+    double reception = [self receptionForTrack:track];
+    double misses = ceil(log(self.falseExitProbability) / log(1.0 - reception));
+
+    return MIN((MAX(misses, 1.0) + EST_EXIT_SLOT_TOLERANCE) * [self slotForTrack:track], self.baselineTimeout);
+}
+
+- (double)receptionProbabilityForIdentityHash:(uint64_t)identityHash
+{
+    ESTExitTrack *track = [self.tracks valueForKey:identityHash];
+
+    return track ? [self receptionForTrack:track] : NAN;
+}
+
+#pragma mark - Sightings
+
+- (void)processSightingOfIdentityHash:(uint64_t)identityHash timestamp:(NSTimeInterval)timestamp
+{
+    [self advanceToTime:timestamp];
+
+    ESTExitTrack *track = [self.tracks valueForKey:identityHash];
+
+    if (!track || timestamp <= track->lastSeen)
+    {
+        return;
+    }
+
+    BOOL entered = NO;
+
+    if (track->inside)
+    {
+        // Gap of n slots is one received slot out of n.
+        NSTimeInterval slot = [self slotForTrack:track];
+        double slots = MAX(round((timestamp - track->lastSeen) / slot), 1.0);
+
+        track->hits = self.forgetting * track->hits + 1;
+        track->trials = self.forgetting * track->trials + slots;
+    }
+    else
+    {
+        if (track->lastExit > 0 && timestamp - track->lastSeen <= self.baselineTimeout)
+        {
+            self.falseExitCount++;
+        }
+
+        track->inside = YES;
+        self.insideCount++;
+        entered = YES;
+    }
+
+    track->lastSeen = timestamp;
+
+    // Deadline is computed when it expires, so only an unarmed track is scheduled.
+    if (!track->armed)
+    {
+        track->armed = YES;
+        [self.wheel scheduleKey:identityHash atTime:timestamp + [self exitDelayForTrack:track]];
+    }
+
+    if (entered && [self.delegate respondsToSelector:@selector(exitDetector:didEnter:)])
+    {
+        [self.delegate exitDetector:self didEnter:identityHash];
+    }
+}
+
+- (void)processRangedBeacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp
+{
+    for (CLBeacon *beacon in beacons)
+    {
+        if (beacon.rssi < 0)
+        {
+            [self processSightingOfIdentityHash:ESTBeaconIdentityHashCLBeacon(beacon) timestamp:timestamp];
+        }
+    }
+
+    [self advanceToTime:timestamp];
+}
+
+#pragma mark - Time
+
+- (void)advanceToTime:(NSTimeInterval)time
+{
+    if (time <= self.wheel.currentTime)
+    {
+        return;
+    }
+
+    NSMutableData *exits = self.exits;
+    [exits setLength:0];
+
+    [self.wheel advanceToTime:time expired:^(uint64_t key, NSTimeInterval deadline) {
+
+        ESTExitTrack *track = [self.tracks valueForKey:key];
+
+        if (!track)
+        {
+            return;
+        }
+
+        NSTimeInterval exitTime = track->lastSeen + [self exitDelayForTrack:track];
+
+        // Seen since the deadline was set, re-arm relative to the last sighting.
+        if (exitTime > time)
+        {
+            [self.wheel scheduleKey:key atTime:exitTime];
+            return;
+        }
+
+        track->armed = NO;
+
+        if (!track->inside)
+        {
+            return;
+        }
+
+        track->inside = NO;
+        track->lastExit = time;
+
+        ESTExitEvent event = { key, time - track->lastSeen };
+        [exits appendBytes:&event length:sizeof(event)];
+    }];
+
+    NSUInteger count = exits.length / sizeof(ESTExitEvent);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    self.insideCount -= count;
+    self.exitCount += count;
+
+    // Delegate may feed sightings, so it is notified after the wheel advanced, from a copy.
+    NSData *copy = [exits copy];
+    const ESTExitEvent *events = copy.bytes;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [self.exitLatency recordValue:(uint64_t)llround(events[i].absence * 1000)];
+        [self.delegate exitDetector:self didExit:events[i].identityHash absence:events[i].absence];
+    }
+}
+
+- (void)startClockWithInterval:(NSTimeInterval)interval
+{
+    [self stopClock];
+
+    // Timer retains the detector until stopClock is called.
+    self.clock = [NSTimer timerWithTimeInterval:MAX(interval, EST_EXIT_WHEEL_RESOLUTION)
+                                         target:self
+                                       selector:@selector(clockFired:)
+                                       userInfo:nil
+                                        repeats:YES];
+
+    [[NSRunLoop mainRunLoop] addTimer:self.clock forMode:NSRunLoopCommonModes];
+}
+
+- (void)stopClock
+{
+    [self.clock invalidate];
+    self.clock = nil;
+}
+
+- (void)clockFired:(NSTimer *)timer
+{
+    [self advanceToTime:CFAbsoluteTimeGetCurrent()];
+}
+
+@end
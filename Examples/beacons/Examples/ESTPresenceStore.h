@@ -0,0 +1,87 @@
+//
+//  ESTPresenceStore.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * Continuous presence of a device near an anchor (gateway, beacon, phone).
+ */
+typedef struct
+{
+    uint64_t device;
+    uint64_t anchor;
+    NSTimeInterval start;
+    NSTimeInterval end;
+    float meanRSSI;
+    int8_t minRSSI;
+    int8_t maxRSSI;
+    uint32_t observations;
+} ESTPresenceInterval;
+
+/*
+ * "Who was near what, when" store built from live observations.
+ *
+ * Observations of a (device, anchor) pair extend an open session while gaps stay
+ * within mergeTolerance, otherwise the session is closed into an interval. Closed
+ * intervals are kept in time partitions, filed in every partition they overlap, each
+ * sorted by (anchor, start) on first query after a change. A query visits only the
+ * partitions overlapping the range, binary searches the anchor and scans its intervals,
+ * open sessions are listed per anchor, so cost depends on the result size rather than
+ * on the store size. An interval spanning k partitions is stored k times.
+ *
+ * Devices and anchors are 64-bit identity hashes, e.g. from ESTBeaconIdentity.
+ */
+@interface ESTPresenceStore : NSObject
+
+/*
+ * Gaps up to this long are merged. Default 30 s.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval mergeTolerance;
+
+/*
+ * Partition length. Default 1 hour.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval partitionDuration;
+
+@property (nonatomic, assign, readonly) uint64_t observationCount;
+@property (nonatomic, assign, readonly) NSUInteger intervalCount;
+@property (nonatomic, assign, readonly) NSUInteger openSessionCount;
+
+- (instancetype)initWithMergeTolerance:(NSTimeInterval)mergeTolerance partitionDuration:(NSTimeInterval)partitionDuration;
+
+/*
+ * Observations of a pair have to come in time order.
+ */
+- (void)addObservationOfDevice:(uint64_t)device anchor:(uint64_t)anchor rssi:(NSInteger)rssi timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * Closes sessions idle for longer than mergeTolerance at time. Called automatically
+ * as observations advance, call it explicitly when the stream pauses.
+ */
+- (void)closeSessionsIdleAtTime:(NSTimeInterval)time;
+
+/*
+ * Intervals of the anchor overlapping [from, to], open sessions included.
+ * Intervals are valid only during the block.
+ */
+- (void)enumerateIntervalsNearAnchor:(uint64_t)anchor
+                                from:(NSTimeInterval)from
+                                  to:(NSTimeInterval)to
+                          usingBlock:(void (^)(const ESTPresenceInterval *interval, BOOL *stop))block;
+
+/*
+ * Distinct devices (NSNumber) near the anchor within [from, to].
+ */
+- (NSArray *)devicesNearAnchor:(uint64_t)anchor from:(NSTimeInterval)from to:(NSTimeInterval)to;
+
+/*
+ * Time the device spent near the anchor, clipped to [from, to].
+ */
+- (NSTimeInterval)durationOfDevice:(uint64_t)device nearAnchor:(uint64_t)anchor from:(NSTimeInterval)from to:(NSTimeInterval)to;
+
+@end
@@ -0,0 +1,393 @@
+//
+//  ESTPresenceStore.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTPresenceStore.h"
+#import "ESTSketchHash.h"
+#import "ESTStructTable.h"
+
+#define EST_PRESENCE_PARTITION_CAPACITY 256
+
+typedef struct
+{
+    ESTPresenceInterval interval;
+    double rssiSum;
+
+    // Position in the open session list of the anchor.
+    uint32_t anchorSlot;
+} ESTPresenceSession;
+
+/*
+ * Open session keys of one anchor, unordered.
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t capacity;
+    uint64_t *keys;
+} ESTPresenceAnchorSessions;
+
+typedef struct
+{
+    int64_t index;
+    uint32_t count;
+    uint32_t capacity;
+    BOOL sorted;
+    ESTPresenceInterval *intervals;
+} ESTPresencePartition;
+
+static int ESTComparePresenceIntervals(const void *a, const void *b)
+{
+    const ESTPresenceInterval *left = a;
+    const ESTPresenceInterval *right = b;
+
+    if (left->anchor != right->anchor)
+    {
+        return left->anchor < right->anchor ? -1 : 1;
+    }
+
+    if (left->start != right->start)
+    {
+        return left->start < right->start ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/*
+ * First interval of the anchor in a sorted partition.
+ */
+static uint32_t ESTPresenceLowerBound(const ESTPresencePartition *partition, uint64_t anchor)
+{
+    uint32_t low = 0;
+    uint32_t high = partition->count;
+
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+
+        if (partition->intervals[middle].anchor < anchor)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+static int8_t ESTPresenceClampRSSI(NSInteger rssi)
+{
+    return (int8_t)MIN(MAX(rssi, (NSInteger)INT8_MIN), (NSInteger)INT8_MAX);
+}
+
+@interface ESTPresenceStore ()
+
+@property (nonatomic, assign, readwrite) NSTimeInterval mergeTolerance;
+@property (nonatomic, assign, readwrite) NSTimeInterval partitionDuration;
+@property (nonatomic, assign, readwrite) uint64_t observationCount;
+@property (nonatomic, assign, readwrite) NSUInteger intervalCount;
+
+@property (nonatomic, strong) ESTStructTable *sessions;
+@property (nonatomic, strong) ESTStructTable *anchorSessions;
+@property (nonatomic, strong) ESTStructTable *partitions;
+@property (nonatomic, strong) NSMutableData *idleKeys;
+
+@end
+
+@implementation ESTPresenceStore
+{
+    NSTimeInterval _lastSweep;
+    int64_t _firstPartition;
+    int64_t _lastPartition;
+}
+
+- (instancetype)init
+{
+    return [self initWithMergeTolerance:30 partitionDuration:3600];
+}
+
+- (instancetype)initWithMergeTolerance:(NSTimeInterval)mergeTolerance partitionDuration:(NSTimeInterval)partitionDuration
+{
+    self = [super init];
+    if (self)
+    {
+        self.mergeTolerance = MAX(mergeTolerance, 0.0);
+        self.partitionDuration = MAX(partitionDuration, 1.0);
+
+        self.sessions = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTPresenceSession) capacity:1024];
+        self.anchorSessions = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTPresenceAnchorSessions) capacity:256];
+        self.partitions = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTPresencePartition) capacity:256];
+        self.idleKeys = [NSMutableData data];
+
+        _firstPartition = INT64_MAX;
+        _lastPartition = INT64_MIN;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self.partitions enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+        free(((ESTPresencePartition *)value)->intervals);
+    }];
+
+    [self.anchorSessions enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+        free(((ESTPresenceAnchorSessions *)value)->keys);
+    }];
+}
+
+- (NSUInteger)openSessionCount
+{
+    return self.sessions.count;
+}
+
+#pragma mark - Ingestion
+
+- (void)addObservationOfDevice:(uint64_t)device anchor:(uint64_t)anchor rssi:(NSInteger)rssi timestamp:(NSTimeInterval)timestamp
+{
+    self.observationCount++;
+
+    if (timestamp - _lastSweep > self.mergeTolerance)
+    {
+        [self closeSessionsIdleAtTime:timestamp];
+        _lastSweep = timestamp;
+    }
+
+    uint64_t key = ESTSketchHashCombine(device, anchor);
+    ESTPresenceSession *session = [self.sessions valueForKey:key];
+
+    if (session && timestamp - session->interval.end > self.mergeTolerance)
+    {
+        [self closeSession:session];
+        [self removeSessionForKey:key];
+        session = NULL;
+    }
+
+    int8_t value = ESTPresenceClampRSSI(rssi);
+
+    if (!session)
+    {
+        session = [self.sessions insertValueForKey:key created:NULL];
+        session->interval.device = device;
+        session->interval.anchor = anchor;
+        session->interval.start = timestamp;
+        session->interval.minRSSI = value;
+        session->interval.maxRSSI = value;
+
+        [self attachSession:session key:key];
+    }
+
+    session->interval.end = MAX(session->interval.end, timestamp);
+    session->interval.minRSSI = MIN(session->interval.minRSSI, value);
+    session->interval.maxRSSI = MAX(session->interval.maxRSSI, value);
+    session->interval.observations++;
+    session->rssiSum += value;
+}
+
+- (void)closeSessionsIdleAtTime:(NSTimeInterval)time
+{
+    NSTimeInterval tolerance = self.mergeTolerance;
+    NSMutableData *idleKeys = self.idleKeys;
+
+    [idleKeys setLength:0];
+
+    [self.sessions enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+
+        ESTPresenceSession *session = value;
+
+        if (time - session->interval.end > tolerance)
+        {
+            [self closeSession:session];
+            [idleKeys appendBytes:&key length:sizeof(key)];
+        }
+    }];
+
+    const uint64_t *keys = idleKeys.bytes;
+
+    for (NSUInteger i = 0; i < idleKeys.length / sizeof(uint64_t); i++)
+    {
+        [self removeSessionForKey:keys[i]];
+    }
+}
+
+- (void)attachSession:(ESTPresenceSession *)session key:(uint64_t)key
+{
+    ESTPresenceAnchorSessions *list = [self.anchorSessions insertValueForKey:session->interval.anchor created:NULL];
+
+    if (list->count == list->capacity)
+    {
+        list->capacity = MAX(list->capacity * 2, (uint32_t)8);
+        list->keys = realloc(list->keys, list->capacity * sizeof(uint64_t));
+    }
+
+    session->anchorSlot = list->count;
+    list->keys[list->count++] = key;
+}
+
+- (void)removeSessionForKey:(uint64_t)key
+{
+    ESTPresenceSession *session = [self.sessions valueForKey:key];
+    uint64_t anchor = session->interval.anchor;
+    uint32_t slot = session->anchorSlot;
+
+    ESTPresenceAnchorSessions *list = [self.anchorSessions valueForKey:anchor];
+    uint64_t last = list->keys[--list->count];
+
+    // Swap remove, the moved session learns its new slot.
+    if (slot != list->count)
+    {
+        list->keys[slot] = last;
+        ((ESTPresenceSession *)[self.sessions valueForKey:last])->anchorSlot = slot;
+    }
+
+    if (list->count == 0)
+    {
+        free(list->keys);
+        [self.anchorSessions removeValueForKey:anchor];
+    }
+
+    [self.sessions removeValueForKey:key];
+}
+
+- (void)closeSession:(ESTPresenceSession *)session
+{
+    ESTPresenceInterval interval = session->interval;
+    interval.meanRSSI = (float)(session->rssiSum / MAX(interval.observations, (uint32_t)1));
+
+    int64_t first = (int64_t)floor(interval.start / self.partitionDuration);
+    int64_t last = (int64_t)floor(interval.end / self.partitionDuration);
+
+    // Filed in every partition it overlaps, so queries need not look before their range.
+    for (int64_t index = first; index <= last; index++)
+    {
+        [self appendInterval:&interval toPartition:index];
+    }
+
+    self.intervalCount++;
+}
+
+- (void)appendInterval:(const ESTPresenceInterval *)interval toPartition:(int64_t)index
+{
+    BOOL created;
+    ESTPresencePartition *partition = [self.partitions insertValueForKey:(uint64_t)index created:&created];
+
+    if (created)
+    {
+        partition->index = index;
+        _firstPartition = MIN(_firstPartition, index);
+        _lastPartition = MAX(_lastPartition, index);
+    }
+
+    if (partition->count == partition->capacity)
+    {
+        partition->capacity = MAX(partition->capacity * 2, (uint32_t)EST_PRESENCE_PARTITION_CAPACITY);
+        partition->intervals = realloc(partition->intervals, partition->capacity * sizeof(ESTPresenceInterval));
+    }
+
+    partition->intervals[partition->count++] = *interval;
+    partition->sorted = NO;
+}
+
+#pragma mark - Queries
+
+- (void)enumerateIntervalsNearAnchor:(uint64_t)anchor
+                                from:(NSTimeInterval)from
+                                  to:(NSTimeInterval)to
+                          usingBlock:(void (^)(const ESTPresenceInterval *interval, BOOL *stop))block
+{
+    BOOL stop = NO;
+
+    NSTimeInterval partitionDuration = self.partitionDuration;
+    int64_t fromPartition = (int64_t)floor(from / partitionDuration);
+    int64_t last = MIN((int64_t)floor(to / partitionDuration), _lastPartition);
+
+    for (int64_t index = MAX(fromPartition, _firstPartition); index <= last && !stop; index++)
+    {
+        ESTPresencePartition *partition = [self.partitions valueForKey:(uint64_t)index];
+
+        if (!partition)
+        {
+            continue;
+        }
+
+        if (!partition->sorted)
+        {
+            qsort(partition->intervals, partition->count, sizeof(ESTPresenceInterval), ESTComparePresenceIntervals);
+            partition->sorted = YES;
+        }
+
+        for (uint32_t i = ESTPresenceLowerBound(partition, anchor); i < partition->count && !stop; i++)
+        {
+            const ESTPresenceInterval *interval = &partition->intervals[i];
+
+            // Sorted by start within the anchor, nothing later can overlap.
+            if (interval->anchor != anchor || interval->start > to)
+            {
+                break;
+            }
+
+            // Copies in partitions after the one of its start are reported only where the range begins.
+            BOOL copy = (int64_t)floor(interval->start / partitionDuration) < index;
+
+            if (interval->end >= from && (!copy || index == fromPartition))
+            {
+                block(interval, &stop);
+            }
+        }
+    }
+
+    if (stop)
+    {
+        return;
+    }
+
+    ESTPresenceAnchorSessions *list = [self.anchorSessions valueForKey:anchor];
+
+    for (uint32_t i = 0; list && i < list->count && !stop; i++)
+    {
+        ESTPresenceSession *session = [self.sessions valueForKey:list->keys[i]];
+        ESTPresenceInterval interval = session->interval;
+
+        if (interval.start <= to && interval.end >= from)
+        {
+            interval.meanRSSI = (float)(session->rssiSum / MAX(interval.observations, (uint32_t)1));
+            block(&interval, &stop);
+        }
+    }
+}
+
+- (NSArray *)devicesNearAnchor:(uint64_t)anchor from:(NSTimeInterval)from to:(NSTimeInterval)to
+{
+    NSMutableSet *devices = [NSMutableSet set];
+
+    [self enumerateIntervalsNearAnchor:anchor from:from to:to usingBlock:^(const ESTPresenceInterval *interval, BOOL *stop) {
+        [devices addObject:@(interval->device)];
+    }];
+
+    return [devices allObjects];
+}
+
+- (NSTimeInterval)durationOfDevice:(uint64_t)device nearAnchor:(uint64_t)anchor from:(NSTimeInterval)from to:(NSTimeInterval)to
+{
+    __block NSTimeInterval duration = 0;
+
+    // Sessions of a pair never overlap, so clipped lengths simply add up.
+    [self enumerateIntervalsNearAnchor:anchor from:from to:to usingBlock:^(const ESTPresenceInterval *interval, BOOL *stop) {
+        if (interval->device == device)
+        {
+            duration += MAX(MIN(interval->end, to) - MAX(interval->start, from), 0.0);
+        }
+    }];
+
+    return duration;
+}
+
+@end
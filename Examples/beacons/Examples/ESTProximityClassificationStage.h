@@ -0,0 +1,59 @@
+//
+//  ESTProximityClassificationStage.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTProximityClassifier.h"
+#import "ESTHDRHistogram.h"
+
+/*
+ * Zone classification of all visible devices with a pluggable classifier, replacing
+ * ESTNearableZone / ESTEddystoneProximity derived from fixed RSSI thresholds.
+ *
+ * Readings are appended to per-device windows in a flat table. classifyAtTime:
+ * extracts window features of every device into one buffer and runs the classifier
+ * once for the whole batch. Devices without readings in the window are dropped.
+ */
+@interface ESTProximityClassificationStage : NSObject
+
+/*
+ * Defaults to ESTThresholdProximityClassifier.
+ */
+@property (nonatomic, strong) id <ESTProximityClassifier> classifier;
+
+/*
+ * Feature window, default 2 s.
+ */
+@property (nonatomic, assign) NSTimeInterval windowDuration;
+
+@property (nonatomic, assign, readonly) NSUInteger deviceCount;
+
+/*
+ * Wall time of classifyAtTime: calls and its share per device, both in ns.
+ */
+@property (nonatomic, strong, readonly) ESTHDRHistogram *batchTime;
+@property (nonatomic, strong, readonly) ESTHDRHistogram *deviceTime;
+
+- (void)addRSSI:(NSInteger)rssi forDevice:(uint64_t)deviceHash timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * ESTNearable objects hashed by identifier, CLBeacon objects hashed with ESTBeaconIdentity.
+ */
+- (void)addNearables:(NSArray *)nearables timestamp:(NSTimeInterval)timestamp;
+- (void)addBeacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * Returns number of classified devices.
+ */
+- (NSUInteger)classifyAtTime:(NSTimeInterval)now;
+
+/*
+ * Zone from the last classifyAtTime:, ESTNearableZoneUnknown for unknown devices.
+ */
+- (ESTNearableZone)zoneForDevice:(uint64_t)deviceHash;
+
+@end
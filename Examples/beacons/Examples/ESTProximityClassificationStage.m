@@ -0,0 +1,180 @@
+//
+//  ESTProximityClassificationStage.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTProximityClassificationStage.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+#import <mach/mach_time.h>
+
+typedef struct
+{
+    ESTRSSIWindow window;
+    ESTNearableZone zone;
+} ESTProximityDevice;
+
+@interface ESTProximityClassificationStage ()
+
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *batchTime;
+@property (nonatomic, strong, readwrite) ESTHDRHistogram *deviceTime;
+
+@property (nonatomic, strong) ESTStructTable *devices;
+
+@end
+
+@implementation ESTProximityClassificationStage
+{
+    // Batch buffers, grown only when the device count exceeds capacity.
+    NSUInteger _capacity;
+    float *_features;
+    ESTNearableZone *_zones;
+    ESTProximityDevice **_batchDevices;
+    uint64_t *_staleKeys;
+
+    mach_timebase_info_data_t _timebase;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.classifier = [[ESTThresholdProximityClassifier alloc] init];
+        self.windowDuration = 2.0;
+        self.devices = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTProximityDevice) capacity:64];
+
+        // 1 ns ... 10 s.
+        self.batchTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:10000000000ULL significantBits:7];
+        self.deviceTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:10000000000ULL significantBits:7];
+
+        mach_timebase_info(&_timebase);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_features);
+    free(_zones);
+    free(_batchDevices);
+    free(_staleKeys);
+}
+
+- (NSUInteger)deviceCount
+{
+    return self.devices.count;
+}
+
+#pragma mark - Readings
+
+- (void)addRSSI:(NSInteger)rssi forDevice:(uint64_t)deviceHash timestamp:(NSTimeInterval)timestamp
+{
+    if (rssi >= 0)
+    {
+        return;
+    }
+
+    ESTProximityDevice *device = [self.devices insertValueForKey:deviceHash created:NULL];
+    ESTRSSIWindowAdd(&device->window, timestamp, (float)rssi);
+}
+
+- (void)addNearables:(NSArray *)nearables timestamp:(NSTimeInterval)timestamp
+{
+    for (ESTNearable *nearable in nearables)
+    {
+        [self addRSSI:nearable.rssi forDevice:ESTSketchHashString(nearable.identifier) timestamp:timestamp];
+    }
+}
+
+- (void)addBeacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp
+{
+    for (CLBeacon *beacon in beacons)
+    {
+        [self addRSSI:beacon.rssi forDevice:ESTBeaconIdentityHashCLBeacon(beacon) timestamp:timestamp];
+    }
+}
+
+#pragma mark - Classification
+
+- (void)reserveCapacity:(NSUInteger)capacity
+{
+    if (capacity <= _capacity)
+    {
+        return;
+    }
+
+    _capacity = MAX(capacity, 2 * _capacity);
+    _features = realloc(_features, _capacity * EST_PROXIMITY_FEATURE_COUNT * sizeof(float));
+    _zones = realloc(_zones, _capacity * sizeof(ESTNearableZone));
+    _batchDevices = realloc(_batchDevices, _capacity * sizeof(ESTProximityDevice *));
+    _staleKeys = realloc(_staleKeys, _capacity * sizeof(uint64_t));
+}
+
+- (NSUInteger)classifyAtTime:(NSTimeInterval)now
+{
+    uint64_t start = mach_absolute_time();
+
+    [self reserveCapacity:self.devices.count];
+
+    float *features = _features;
+    ESTProximityDevice **batchDevices = _batchDevices;
+    uint64_t *staleKeys = _staleKeys;
+    NSTimeInterval duration = self.windowDuration;
+
+    __block NSUInteger count = 0;
+    __block NSUInteger staleCount = 0;
+
+    // Value pointers stay valid, nothing is inserted until the batch is written back.
+    [self.devices enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+
+        ESTProximityDevice *device = value;
+
+        if (ESTRSSIWindowFeatures(&device->window, now, duration, features + count * EST_PROXIMITY_FEATURE_COUNT))
+        {
+            batchDevices[count++] = device;
+        }
+        else
+        {
+            staleKeys[staleCount++] = key;
+        }
+    }];
+
+    if (count > 0)
+    {
+        [self.classifier classifyFeatures:features count:count zones:_zones];
+    }
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        batchDevices[i]->zone = _zones[i];
+    }
+
+    for (NSUInteger i = 0; i < staleCount; i++)
+    {
+        [self.devices removeValueForKey:staleKeys[i]];
+    }
+
+    uint64_t elapsed = (mach_absolute_time() - start) * _timebase.numer / _timebase.denom;
+
+    [self.batchTime recordValue:elapsed];
+
+    if (count > 0)
+    {
+        [self.deviceTime recordValue:elapsed / count count:count];
+    }
+
+    return count;
+}
+
+- (ESTNearableZone)zoneForDevice:(uint64_t)deviceHash
+{
+    ESTProximityDevice *device = [self.devices valueForKey:deviceHash];
+
+    return device ? device->zone : ESTNearableZoneUnknown;
+}
+
+@end
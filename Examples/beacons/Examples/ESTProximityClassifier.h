@@ -0,0 +1,83 @@
+//
+//  ESTProximityClassifier.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+#define EST_PROXIMITY_FEATURE_COUNT   8
+#define EST_PROXIMITY_CLASS_COUNT     3
+#define EST_RSSI_WINDOW_CAPACITY      32
+
+/*
+ * Last RSSI readings of a single device, oldest are overwritten.
+ */
+typedef struct
+{
+    double timestamps[EST_RSSI_WINDOW_CAPACITY];
+    float rssi[EST_RSSI_WINDOW_CAPACITY];
+    uint8_t head;
+    uint8_t count;
+} ESTRSSIWindow;
+
+void ESTRSSIWindowAdd(ESTRSSIWindow *window, NSTimeInterval timestamp, float rssi);
+
+/*
+ * Features of readings in the last `duration` seconds: last, mean, max, min, standard
+ * deviation, slope (dBm/s), rate (readings/s) and exponential mean. Returns NO when
+ * there are no readings in the window.
+ */
+BOOL ESTRSSIWindowFeatures(const ESTRSSIWindow *window, NSTimeInterval now, NSTimeInterval duration, float *features);
+
+/*
+ * Classifier stage of ESTProximityClassificationStage. Features hold
+ * EST_PROXIMITY_FEATURE_COUNT values per device, zones receive Immediate, Near or Far.
+ */
+@protocol ESTProximityClassifier <NSObject>
+
+- (void)classifyFeatures:(const float *)features count:(NSUInteger)count zones:(ESTNearableZone *)zones;
+
+@end
+
+/*
+ * Fixed thresholds on mean RSSI, the behaviour the SDK zones are compared against.
+ */
+@interface ESTThresholdProximityClassifier : NSObject <ESTProximityClassifier>
+
+/*
+ * Defaults -60 dBm and -80 dBm.
+ */
+@property (nonatomic, assign) float immediateRSSI;
+@property (nonatomic, assign) float nearRSSI;
+
+@end
+
+/*
+ * Multinomial logistic regression with int8 weights and inputs.
+ *
+ * Features are standardized and quantized to int8, each class score is an int32 dot
+ * product scaled back with the per class weight scale. Devices are quantized and scored
+ * in batches, the dot products use NEON widening multiplies on arm64.
+ *
+ * Model files are ESTMappedRecordFile with standardization in metadata and one
+ * record per class.
+ */
+@interface ESTQuantizedProximityClassifier : NSObject <ESTProximityClassifier>
+
+/*
+ * Weights hold EST_PROXIMITY_CLASS_COUNT rows of EST_PROXIMITY_FEATURE_COUNT float values
+ * for standardized features (feature - mean) * scale, classes are Immediate, Near and Far.
+ */
+- (instancetype)initWithFeatureMeans:(const float *)means
+                       featureScales:(const float *)scales
+                             weights:(const float *)weights
+                              biases:(const float *)biases;
+
++ (instancetype)classifierWithContentsOfFile:(NSString *)path;
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error;
+
+@end
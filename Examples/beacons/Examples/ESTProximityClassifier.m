@@ -0,0 +1,315 @@
+//
+//  ESTProximityClassifier.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTProximityClassifier.h"
+#import "ESTMappedRecordFile.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#import <arm_neon.h>
+#define EST_PROXIMITY_NEON 1
+#endif
+
+#define EST_PROXIMITY_MODEL_TAG     0x314D5850 // "PXM1"
+#define EST_PROXIMITY_INPUT_RANGE   4.0f
+#define EST_PROXIMITY_BATCH         256
+#define EST_PROXIMITY_EMA_ALPHA     0.3f
+
+typedef struct
+{
+    int8_t weights[EST_PROXIMITY_FEATURE_COUNT];
+    float weightScale;
+    float bias;
+} ESTProximityClassWeights;
+
+typedef struct
+{
+    uint32_t featureCount;
+    uint32_t classCount;
+    float means[EST_PROXIMITY_FEATURE_COUNT];
+    float scales[EST_PROXIMITY_FEATURE_COUNT];
+} ESTProximityModelHeader;
+
+#pragma mark - Window
+
+void ESTRSSIWindowAdd(ESTRSSIWindow *window, NSTimeInterval timestamp, float rssi)
+{
+    window->timestamps[window->head] = timestamp;
+    window->rssi[window->head] = rssi;
+    window->head = (uint8_t)((window->head + 1) % EST_RSSI_WINDOW_CAPACITY);
+    window->count = (uint8_t)MIN(window->count + 1, EST_RSSI_WINDOW_CAPACITY);
+}
+
+BOOL ESTRSSIWindowFeatures(const ESTRSSIWindow *window, NSTimeInterval now, NSTimeInterval duration, float *features)
+{
+    double sum = 0, sumSquares = 0, sumT = 0, sumTT = 0, sumTR = 0;
+    float minimum = INFINITY, maximum = -INFINITY, last = 0, ema = 0;
+    NSUInteger n = 0;
+
+    // Oldest first, so the exponential mean and last value follow arrival order.
+    for (NSUInteger i = 0; i < window->count; i++)
+    {
+        NSUInteger index = (window->head + EST_RSSI_WINDOW_CAPACITY - window->count + i) % EST_RSSI_WINDOW_CAPACITY;
+        double t = window->timestamps[index] - now;
+
+        if (t < -duration || t > 0)
+        {
+            continue;
+        }
+
+        float rssi = window->rssi[index];
+
+        sum += rssi;
+        sumSquares += rssi * rssi;
+        sumT += t;
+        sumTT += t * t;
+        sumTR += t * rssi;
+        minimum = MIN(minimum, rssi);
+        maximum = MAX(maximum, rssi);
+        ema = n == 0 ? rssi : ema + EST_PROXIMITY_EMA_ALPHA * (rssi - ema);
+        last = rssi;
+        n++;
+    }
+
+    if (n == 0)
+    {
+        return NO;
+    }
+
+    double mean = sum / n;
+    double variance = MAX(sumSquares / n - mean * mean, 0.0);
+    double timeVariance = sumTT / n - (sumT / n) * (sumT / n);
+    double slope = timeVariance > 1e-9 ? (sumTR / n - (sumT / n) * mean) / timeVariance : 0;
+
+    features[0] = last;
+    features[1] = (float)mean;
+    features[2] = maximum;
+    features[3] = minimum;
+    features[4] = (float)sqrt(variance);
+    features[5] = (float)slope;
+    features[6] = (float)(n / MAX(duration, 1e-3));
+    features[7] = ema;
+
+    return YES;
+}
+
+#pragma mark - Threshold classifier
+
+@implementation ESTThresholdProximityClassifier
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.immediateRSSI = -60;
+        self.nearRSSI = -80;
+    }
+    return self;
+}
+
+- (void)classifyFeatures:(const float *)features count:(NSUInteger)count zones:(ESTNearableZone *)zones
+{
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        float mean = features[i * EST_PROXIMITY_FEATURE_COUNT + 1];
+
+        if (mean >= self.immediateRSSI)
+        {
+            zones[i] = ESTNearableZoneImmediate;
+        }
+        else if (mean >= self.nearRSSI)
+        {
+            zones[i] = ESTNearableZoneNear;
+        }
+        else
+        {
+            zones[i] = ESTNearableZoneFar;
+        }
+    }
+}
+
+@end
+
+#pragma mark - Quantized classifier
+
+@implementation ESTQuantizedProximityClassifier
+{
+    float _means[EST_PROXIMITY_FEATURE_COUNT];
+    float _scales[EST_PROXIMITY_FEATURE_COUNT];
+    float _inputMultipliers[EST_PROXIMITY_FEATURE_COUNT];
+    float _outputScales[EST_PROXIMITY_CLASS_COUNT];
+    ESTProximityClassWeights _classes[EST_PROXIMITY_CLASS_COUNT];
+
+    int8_t _quantized[EST_PROXIMITY_BATCH * EST_PROXIMITY_FEATURE_COUNT];
+}
+
+- (instancetype)initWithFeatureMeans:(const float *)means
+                       featureScales:(const float *)scales
+                             weights:(const float *)weights
+                              biases:(const float *)biases
+{
+    self = [super init];
+    if (self)
+    {
+        memcpy(_means, means, sizeof(_means));
+        memcpy(_scales, scales, sizeof(_scales));
+
+        // Symmetric per class quantization, zero stays exactly zero.
+        for (NSUInteger c = 0; c < EST_PROXIMITY_CLASS_COUNT; c++)
+        {
+            const float *row = weights + c * EST_PROXIMITY_FEATURE_COUNT;
+            float maximum = 0;
+
+            for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+            {
+                maximum = MAX(maximum, fabsf(row[f]));
+            }
+
+            float scale = maximum > 0 ? maximum / 127.0f : 1.0f;
+
+            for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+            {
+                _classes[c].weights[f] = (int8_t)lrintf(row[f] / scale);
+            }
+
+            _classes[c].weightScale = scale;
+            _classes[c].bias = biases[c];
+        }
+
+        [self prepare];
+    }
+    return self;
+}
+
+- (instancetype)initWithHeader:(const ESTProximityModelHeader *)header classes:(const ESTProximityClassWeights *)classes
+{
+    self = [super init];
+    if (self)
+    {
+        memcpy(_means, header->means, sizeof(_means));
+        memcpy(_scales, header->scales, sizeof(_scales));
+        memcpy(_classes, classes, sizeof(_classes));
+
+        [self prepare];
+    }
+    return self;
+}
+
+- (void)prepare
+{
+    float inputScale = EST_PROXIMITY_INPUT_RANGE / 127.0f;
+
+    for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+    {
+        _inputMultipliers[f] = _scales[f] / inputScale;
+    }
+
+    for (NSUInteger c = 0; c < EST_PROXIMITY_CLASS_COUNT; c++)
+    {
+        _outputScales[c] = inputScale * _classes[c].weightScale;
+    }
+}
+
+#pragma mark - Inference
+
+- (void)classifyFeatures:(const float *)features count:(NSUInteger)count zones:(ESTNearableZone *)zones
+{
+    for (NSUInteger start = 0; start < count; start += EST_PROXIMITY_BATCH)
+    {
+        NSUInteger batch = MIN(count - start, (NSUInteger)EST_PROXIMITY_BATCH);
+        const float *input = features + start * EST_PROXIMITY_FEATURE_COUNT;
+
+        // Standardize and quantize the whole batch first, the loop has no branches and vectorizes.
+        for (NSUInteger i = 0; i < batch; i++)
+        {
+            for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+            {
+                float value = (input[i * EST_PROXIMITY_FEATURE_COUNT + f] - _means[f]) * _inputMultipliers[f];
+                value = MIN(MAX(value, -127.0f), 127.0f);
+                _quantized[i * EST_PROXIMITY_FEATURE_COUNT + f] = (int8_t)lrintf(value);
+            }
+        }
+
+        for (NSUInteger i = 0; i < batch; i++)
+        {
+            const int8_t *row = _quantized + i * EST_PROXIMITY_FEATURE_COUNT;
+            float best = -INFINITY;
+            NSUInteger bestClass = 0;
+
+#if EST_PROXIMITY_NEON
+            int8x8_t x = vld1_s8(row);
+#endif
+
+            for (NSUInteger c = 0; c < EST_PROXIMITY_CLASS_COUNT; c++)
+            {
+#if EST_PROXIMITY_NEON
+                int32_t accumulator = vaddlvq_s16(vmull_s8(x, vld1_s8(_classes[c].weights)));
+#else
+                int32_t accumulator = 0;
+
+                for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+                {
+                    accumulator += (int32_t)row[f] * _classes[c].weights[f];
+                }
+#endif
+                float score = accumulator * _outputScales[c] + _classes[c].bias;
+
+                if (score > best)
+                {
+                    best = score;
+                    bestClass = c;
+                }
+            }
+
+            zones[start + i] = (ESTNearableZone)(ESTNearableZoneImmediate + bestClass);
+        }
+    }
+}
+
+#pragma mark - File
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error
+{
+    ESTProximityModelHeader header;
+    header.featureCount = EST_PROXIMITY_FEATURE_COUNT;
+    header.classCount = EST_PROXIMITY_CLASS_COUNT;
+    memcpy(header.means, _means, sizeof(header.means));
+    memcpy(header.scales, _scales, sizeof(header.scales));
+
+    return [ESTMappedRecordFile writeRecords:_classes
+                                       count:EST_PROXIMITY_CLASS_COUNT
+                                  recordSize:sizeof(ESTProximityClassWeights)
+                                   formatTag:EST_PROXIMITY_MODEL_TAG
+                                    metadata:[NSData dataWithBytes:&header length:sizeof(header)]
+                                      toPath:path
+                                       error:error];
+}
+
++ (instancetype)classifierWithContentsOfFile:(NSString *)path
+{
+    ESTMappedRecordFile *file = [ESTMappedRecordFile fileWithPath:path
+                                                        formatTag:EST_PROXIMITY_MODEL_TAG
+                                                       recordSize:sizeof(ESTProximityClassWeights)];
+
+    if (!file || file.recordCount != EST_PROXIMITY_CLASS_COUNT || file.metadata.length != sizeof(ESTProximityModelHeader))
+    {
+        return nil;
+    }
+
+    ESTProximityModelHeader header;
+    [file.metadata getBytes:&header length:sizeof(header)];
+
+    if (header.featureCount != EST_PROXIMITY_FEATURE_COUNT || header.classCount != EST_PROXIMITY_CLASS_COUNT)
+    {
+        return nil;
+    }
+
+    return [[self alloc] initWithHeader:&header classes:file.records];
+}
+
+@end
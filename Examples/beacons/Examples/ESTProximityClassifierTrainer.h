@@ -0,0 +1,84 @@
+//
+//  ESTProximityClassifierTrainer.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTProximityClassifier.h"
+
+/*
+ * Single reading of a labeled trace, zone is Immediate, Near or Far.
+ */
+typedef struct
+{
+    NSTimeInterval timestamp;
+    float rssi;
+    int32_t zone;
+} ESTLabeledRSSISample;
+
+@interface ESTProximityEvaluation : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger windowCount;
+@property (nonatomic, assign, readonly) double accuracy;
+
+/*
+ * Mean time from a zone change (or trace start) to the first correct classification.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval meanSettlingTime;
+
+/*
+ * Mean classifier time per window in ns, traces are classified as one batch each.
+ */
+@property (nonatomic, assign, readonly) double classificationTime;
+
+@end
+
+/*
+ * Offline training of ESTQuantizedProximityClassifier from labeled traces.
+ *
+ * Every reading of a trace produces a feature window labeled with the zone of that
+ * reading. Features are standardized, weights are fitted with batch gradient descent
+ * on softmax cross entropy with L2 regularization, then quantized to int8. Export the
+ * result with writeToFile:error: and ship the file with the app.
+ *
+ * evaluateClassifier: replays the same windows through any classifier, e.g. to compare
+ * the trained model with ESTThresholdProximityClassifier.
+ */
+@interface ESTProximityClassifierTrainer : NSObject
+
+/*
+ * Must match ESTProximityClassificationStage. Default 2 s.
+ */
+@property (nonatomic, assign) NSTimeInterval windowDuration;
+
+/*
+ * Defaults 300 epochs, learning rate 0.5 and regularization 1e-3.
+ */
+@property (nonatomic, assign) NSUInteger epochs;
+@property (nonatomic, assign) double learningRate;
+@property (nonatomic, assign) double regularization;
+
+@property (nonatomic, assign, readonly) NSUInteger windowCount;
+
+/*
+ * CSV lines "timestamp,rssi,zone" with zone 1 (immediate), 2 (near) or 3 (far).
+ * Malformed lines are skipped.
+ */
++ (NSData *)traceWithCSVString:(NSString *)string;
+
+/*
+ * ESTLabeledRSSISample values of a single device ordered by time.
+ */
+- (void)addTrace:(NSData *)samples;
+
+/*
+ * Returns nil without windows.
+ */
+- (ESTQuantizedProximityClassifier *)train;
+
+- (ESTProximityEvaluation *)evaluateClassifier:(id <ESTProximityClassifier>)classifier;
+
+@end
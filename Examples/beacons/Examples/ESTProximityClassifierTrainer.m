@@ -0,0 +1,371 @@
+//
+//  ESTProximityClassifierTrainer.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTProximityClassifierTrainer.h"
+#import <mach/mach_time.h>
+
+@interface ESTProximityEvaluation ()
+
+@property (nonatomic, assign, readwrite) NSUInteger windowCount;
+@property (nonatomic, assign, readwrite) double accuracy;
+@property (nonatomic, assign, readwrite) NSTimeInterval meanSettlingTime;
+@property (nonatomic, assign, readwrite) double classificationTime;
+
+@end
+
+@implementation ESTProximityEvaluation
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"accuracy %.1f %%, settling %.2f s, %.0f ns per window (%lu windows)",
+            100 * self.accuracy, self.meanSettlingTime, self.classificationTime, (unsigned long)self.windowCount];
+}
+
+@end
+
+@interface ESTProximityClassifierTrainer ()
+
+@property (nonatomic, strong) NSMutableArray *traces;
+
+@end
+
+@implementation ESTProximityClassifierTrainer
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.windowDuration = 2.0;
+        self.epochs = 300;
+        self.learningRate = 0.5;
+        self.regularization = 1e-3;
+        self.traces = [NSMutableArray array];
+    }
+    return self;
+}
+
++ (NSData *)traceWithCSVString:(NSString *)string
+{
+    NSMutableData *data = [NSMutableData data];
+
+    for (NSString *line in [string componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]])
+    {
+        NSArray *fields = [line componentsSeparatedByString:@","];
+
+        if (fields.count < 3)
+        {
+            continue;
+        }
+
+        NSScanner *timestampScanner = [NSScanner scannerWithString:fields[0]];
+        NSScanner *rssiScanner = [NSScanner scannerWithString:fields[1]];
+        NSScanner *zoneScanner = [NSScanner scannerWithString:fields[2]];
+
+        double timestamp;
+        float rssi;
+        int zone;
+
+        if ([timestampScanner scanDouble:&timestamp] && [rssiScanner scanFloat:&rssi] && [zoneScanner scanInt:&zone])
+        {
+            ESTLabeledRSSISample sample = { timestamp, rssi, zone };
+            [data appendBytes:&sample length:sizeof(sample)];
+        }
+    }
+
+    return data;
+}
+
+- (void)addTrace:(NSData *)samples
+{
+    [self.traces addObject:[samples copy]];
+}
+
+- (NSUInteger)windowCount
+{
+    NSUInteger count = 0;
+
+    for (NSData *trace in self.traces)
+    {
+        count += [self windowsOfTrace:trace features:NULL labels:NULL timestamps:NULL];
+    }
+
+    return count;
+}
+
+#pragma mark - Windows
+
+/*
+ * Buffers hold at least one entry per trace sample, NULL buffers only count windows.
+ */
+- (NSUInteger)windowsOfTrace:(NSData *)trace features:(float *)features labels:(uint8_t *)labels timestamps:(double *)timestamps
+{
+    const ESTLabeledRSSISample *samples = trace.bytes;
+    NSUInteger sampleCount = trace.length / sizeof(ESTLabeledRSSISample);
+    NSUInteger count = 0;
+
+    ESTRSSIWindow window;
+    memset(&window, 0, sizeof(window));
+
+    float scratch[EST_PROXIMITY_FEATURE_COUNT];
+
+    for (NSUInteger i = 0; i < sampleCount; i++)
+    {
+        ESTRSSIWindowAdd(&window, samples[i].timestamp, samples[i].rssi);
+
+        if (samples[i].zone < ESTNearableZoneImmediate || samples[i].zone > ESTNearableZoneFar)
+        {
+            continue;
+        }
+
+        float *output = features ? features + count * EST_PROXIMITY_FEATURE_COUNT : scratch;
+
+        if (!ESTRSSIWindowFeatures(&window, samples[i].timestamp, self.windowDuration, output))
+        {
+            continue;
+        }
+
+        if (labels)
+        {
+            labels[count] = (uint8_t)(samples[i].zone - ESTNearableZoneImmediate);
+        }
+
+        if (timestamps)
+        {
+            timestamps[count] = samples[i].timestamp;
+        }
+
+        count++;
+    }
+
+    return count;
+}
+
+#pragma mark - Training
+
+- (ESTQuantizedProximityClassifier *)train
+{
+    NSUInteger capacity = 0;
+
+    for (NSData *trace in self.traces)
+    {
+        capacity += trace.length / sizeof(ESTLabeledRSSISample);
+    }
+
+    float *features = malloc(MAX(capacity, (NSUInteger)1) * EST_PROXIMITY_FEATURE_COUNT * sizeof(float));
+    uint8_t *labels = malloc(MAX(capacity, (NSUInteger)1));
+    NSUInteger n = 0;
+
+    for (NSData *trace in self.traces)
+    {
+        n += [self windowsOfTrace:trace features:features + n * EST_PROXIMITY_FEATURE_COUNT labels:labels + n timestamps:NULL];
+    }
+
+    if (n == 0)
+    {
+        free(features);
+        free(labels);
+        return nil;
+    }
+
+    // Standardization.
+    float means[EST_PROXIMITY_FEATURE_COUNT];
+    float scales[EST_PROXIMITY_FEATURE_COUNT];
+
+    for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+    {
+        double sum = 0, sumSquares = 0;
+
+        for (NSUInteger i = 0; i < n; i++)
+        {
+            sum += features[i * EST_PROXIMITY_FEATURE_COUNT + f];
+            sumSquares += features[i * EST_PROXIMITY_FEATURE_COUNT + f] * features[i * EST_PROXIMITY_FEATURE_COUNT + f];
+        }
+
+        double mean = sum / n;
+        double deviation = sqrt(MAX(sumSquares / n - mean * mean, 0.0));
+
+        means[f] = (float)mean;
+        scales[f] = deviation > 1e-6 ? (float)(1.0 / deviation) : 1.0f;
+    }
+
+    for (NSUInteger i = 0; i < n; i++)
+    {
+        for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+        {
+            features[i * EST_PROXIMITY_FEATURE_COUNT + f] = (features[i * EST_PROXIMITY_FEATURE_COUNT + f] - means[f]) * scales[f];
+        }
+    }
+
+    // Batch gradient descent on softmax cross entropy.
+    double weights[EST_PROXIMITY_CLASS_COUNT][EST_PROXIMITY_FEATURE_COUNT];
+    double biases[EST_PROXIMITY_CLASS_COUNT];
+
+    memset(weights, 0, sizeof(weights));
+    memset(biases, 0, sizeof(biases));
+
+    for (NSUInteger epoch = 0; epoch < self.epochs; epoch++)
+    {
+        double weightGradient[EST_PROXIMITY_CLASS_COUNT][EST_PROXIMITY_FEATURE_COUNT];
+        double biasGradient[EST_PROXIMITY_CLASS_COUNT];
+
+        memset(weightGradient, 0, sizeof(weightGradient));
+        memset(biasGradient, 0, sizeof(biasGradient));
+
+        for (NSUInteger i = 0; i < n; i++)
+        {
+            const float *x = features + i * EST_PROXIMITY_FEATURE_COUNT;
+            double logits[EST_PROXIMITY_CLASS_COUNT];
+            double maximum = -INFINITY;
+
+            for (NSUInteger c = 0; c < EST_PROXIMITY_CLASS_COUNT; c++)
+            {
+                logits[c] = biases[c];
+
+                for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+                {
+                    logits[c] += weights[c][f] * x[f];
+                }
+
+                maximum = MAX(maximum, logits[c]);
+            }
+
+            double total = 0;
+
+            for (NSUInteger c = 0; c < EST_PROXIMITY_CLASS_COUNT; c++)
+            {
+                logits[c] = exp(logits[c] - maximum);
+                total += logits[c];
+            }
+
+            for (NSUInteger c = 0; c < EST_PROXIMITY_CLASS_COUNT; c++)
+            {
+                double delta = logits[c] / total - (labels[i] == c ? 1.0 : 0.0);
+
+                biasGradient[c] += delta;
+
+                for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+                {
+                    weightGradient[c][f] += delta * x[f];
+                }
+            }
+        }
+
+        for (NSUInteger c = 0; c < EST_PROXIMITY_CLASS_COUNT; c++)
+        {
+            biases[c] -= self.learningRate * biasGradient[c] / n;
+
+            for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+            {
+                weights[c][f] -= self.learningRate * (weightGradient[c][f] / n + self.regularization * weights[c][f]);
+            }
+        }
+    }
+
+    free(features);
+    free(labels);
+
+    float floatWeights[EST_PROXIMITY_CLASS_COUNT * EST_PROXIMITY_FEATURE_COUNT];
+    float floatBiases[EST_PROXIMITY_CLASS_COUNT];
+
+    for (NSUInteger c = 0; c < EST_PROXIMITY_CLASS_COUNT; c++)
+    {
+        floatBiases[c] = (float)biases[c];
+
+        for (NSUInteger f = 0; f < EST_PROXIMITY_FEATURE_COUNT; f++)
+        {
+            floatWeights[c * EST_PROXIMITY_FEATURE_COUNT + f] = (float)weights[c][f];
+        }
+    }
+
+    return [[ESTQuantizedProximityClassifier alloc] initWithFeatureMeans:means
+                                                           featureScales:scales
+                                                                 weights:floatWeights
+                                                                  biases:floatBiases];
+}
+
+#pragma mark - Evaluation
+
+- (ESTProximityEvaluation *)evaluateClassifier:(id <ESTProximityClassifier>)classifier
+{
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+
+    NSUInteger windows = 0;
+    NSUInteger correct = 0;
+    NSUInteger segments = 0;
+    double settling = 0;
+    uint64_t ticks = 0;
+
+    for (NSData *trace in self.traces)
+    {
+        NSUInteger capacity = MAX(trace.length / sizeof(ESTLabeledRSSISample), (NSUInteger)1);
+
+        float *features = malloc(capacity * EST_PROXIMITY_FEATURE_COUNT * sizeof(float));
+        uint8_t *labels = malloc(capacity);
+        double *timestamps = malloc(capacity * sizeof(double));
+        ESTNearableZone *zones = malloc(capacity * sizeof(ESTNearableZone));
+
+        NSUInteger count = [self windowsOfTrace:trace features:features labels:labels timestamps:timestamps];
+
+        uint64_t start = mach_absolute_time();
+        [classifier classifyFeatures:features count:count zones:zones];
+        ticks += mach_absolute_time() - start;
+
+        NSTimeInterval segmentStart = 0;
+        BOOL settled = NO;
+
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            BOOL match = zones[i] == (ESTNearableZone)(labels[i] + ESTNearableZoneImmediate);
+
+            if (i == 0 || labels[i] != labels[i - 1])
+            {
+                // Segment that never settled counts with its full length.
+                if (i > 0 && !settled)
+                {
+                    settling += timestamps[i - 1] - segmentStart;
+                }
+
+                segmentStart = timestamps[i];
+                settled = NO;
+                segments++;
+            }
+
+            if (match && !settled)
+            {
+                settling += timestamps[i] - segmentStart;
+                settled = YES;
+            }
+
+            correct += match ? 1 : 0;
+        }
+
+        if (count > 0 && !settled)
+        {
+            settling += timestamps[count - 1] - segmentStart;
+        }
+
+        windows += count;
+
+        free(features);
+        free(labels);
+        free(timestamps);
+        free(zones);
+    }
+
+    ESTProximityEvaluation *evaluation = [[ESTProximityEvaluation alloc] init];
+    evaluation.windowCount = windows;
+    evaluation.accuracy = windows ? (double)correct / windows : 0;
+    evaluation.meanSettlingTime = segments ? settling / segments : 0;
+    evaluation.classificationTime = windows ? (double)ticks * timebase.numer / timebase.denom / windows : 0;
+
+    return evaluation;
+}
+
+@end
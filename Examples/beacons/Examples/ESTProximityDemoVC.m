@@ -7,6 +7,7 @@
 //
 
 #import "ESTProximityDemoVC.h"
+#import "ESTLaunchCoordinator.h"
 
 @interface ESTProximityDemoVC () <ESTBeaconManagerDelegate>
 
@@ -59,7 +60,7 @@
     /*
      * BeaconManager setup.
      */
-    self.beaconManager = [[ESTBeaconManager alloc] init];
+    self.beaconManager = [ESTLaunchCoordinator sharedCoordinator].beaconManager;
     self.beaconManager.delegate = self;
     
     self.beaconRegion = [[CLBeaconRegion alloc] initWithProximityUUID:self.beacon.proximityUUID
@@ -81,6 +82,11 @@
 
 - (void)beaconManager:(id)manager didRangeBeacons:(NSArray *)beacons inRegion:(CLBeaconRegion *)region
 {
+    if (![region.identifier isEqualToString:self.beaconRegion.identifier])
+    {
+        return;
+    }
+    
     if (beacons.count > 0)
     {
         CLBeacon *firstBeacon = [beacons firstObject];
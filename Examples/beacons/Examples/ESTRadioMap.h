@@ -0,0 +1,92 @@
+//
+//  ESTRadioMap.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#define EST_RADIO_MAP_MAX_NEIGHBORS     256
+
+/*
+ * Reference point of a radio map returned by nearest neighbor search.
+ */
+@interface ESTRadioMapNeighbor : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger index;
+@property (nonatomic, assign, readonly) double x;
+@property (nonatomic, assign, readonly) double y;
+@property (nonatomic, assign, readonly) NSInteger floor;
+
+/*
+ * Euclidean distance in dBm.
+ */
+@property (nonatomic, assign, readonly) double distance;
+
+@end
+
+/*
+ * Fingerprint radio map: RSSI vectors over a fixed set of fleet beacons
+ * measured at known positions.
+ *
+ * Beacons are identified by identity hashes (see ESTBeaconIdentity.h), their order
+ * defines vector dimensions. Missing beacons are stored and queried as missingRSSI,
+ * so all vectors are dense and distances are computed with vDSP matrix kernels.
+ *
+ * buildIndex clusters reference points with k-means into about sqrt(N) lists
+ * (inverted file index). Queries scan only the probeCount lists with nearest centroids,
+ * which keeps latency low for maps with 100k+ points. Small maps are scanned fully.
+ *
+ * Maps are saved in ESTMappedRecordFile format and used in place after loading.
+ * Queries use internal scratch buffers, one map must not be queried from several threads at once.
+ */
+@interface ESTRadioMap : NSObject
+
+@property (nonatomic, strong, readonly) NSArray *beaconIdentityHashes;
+@property (nonatomic, assign, readonly) NSUInteger dimension;
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/*
+ * RSSI used for beacons not heard. Default -100 dBm.
+ */
+@property (nonatomic, assign, readonly) float missingRSSI;
+
+/*
+ * Number of lists scanned per query when index is built. Default 8.
+ */
+@property (nonatomic, assign) NSUInteger probeCount;
+
+@property (nonatomic, assign, readonly) NSUInteger listCount;
+
+/*
+ * beaconIdentityHashes is an array of NSNumber with uint64 identity hashes.
+ */
+- (instancetype)initWithBeaconIdentityHashes:(NSArray *)beaconIdentityHashes missingRSSI:(float)missingRSSI;
+
++ (instancetype)radioMapWithContentsOfFile:(NSString *)path;
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error;
+
+/*
+ * Dimension for identity hash, NSNotFound for beacons outside of the map.
+ */
+- (NSUInteger)dimensionForIdentityHash:(uint64_t)identityHash;
+
+/*
+ * rssi holds `dimension` values, values >= 0 or below missingRSSI are treated as missing.
+ * Adding points invalidates the index.
+ */
+- (void)addReferencePointWithRSSI:(const float *)rssi x:(double)x y:(double)y floor:(NSInteger)floor;
+
+/*
+ * Clusters points into lists. Maps below 4096 points are always scanned fully.
+ */
+- (void)buildIndex;
+
+/*
+ * At most EST_RADIO_MAP_MAX_NEIGHBORS neighbors, nearest first.
+ */
+- (NSArray *)nearestNeighborsOfRSSI:(const float *)rssi count:(NSUInteger)count;
+
+@end
@@ -0,0 +1,568 @@
+//
+//  ESTRadioMap.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTRadioMap.h"
+#import "ESTMappedRecordFile.h"
+#import "ESTStructTable.h"
+#import <Accelerate/Accelerate.h>
+
+#define EST_RADIO_MAP_TAG               0x31504D52 // "RMP1"
+#define EST_RADIO_MAP_INDEX_MINIMUM     4096
+#define EST_RADIO_MAP_MAX_LISTS         1024
+#define EST_RADIO_MAP_KMEANS_ITERATIONS 10
+#define EST_RADIO_MAP_KMEANS_SAMPLE     64
+#define EST_RADIO_MAP_BLOCK             1024
+
+/*
+ * Row layout: paddedDimension RSSI values followed by x, y, floor and squared norm.
+ * Queries and centroids keep these four tail values zero, so dot products with
+ * whole rows ignore them and rows can be fed to vDSP without gathering.
+ */
+#define EST_RADIO_MAP_TAIL              4
+#define EST_RADIO_MAP_TAIL_X            0
+#define EST_RADIO_MAP_TAIL_Y            1
+#define EST_RADIO_MAP_TAIL_FLOOR        2
+#define EST_RADIO_MAP_TAIL_NORM         3
+
+typedef struct
+{
+    uint32_t dimension;
+    uint32_t listCount;
+    float missingRSSI;
+    uint32_t reserved;
+} ESTRadioMapHeader;
+
+#pragma mark - Neighbor
+
+@interface ESTRadioMapNeighbor ()
+
+@property (nonatomic, assign, readwrite) NSUInteger index;
+@property (nonatomic, assign, readwrite) double x;
+@property (nonatomic, assign, readwrite) double y;
+@property (nonatomic, assign, readwrite) NSInteger floor;
+@property (nonatomic, assign, readwrite) double distance;
+
+@end
+
+@implementation ESTRadioMapNeighbor
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: #%lu (%.2f, %.2f) floor %ld distance %.2f>",
+            NSStringFromClass([self class]), (unsigned long)self.index, self.x, self.y, (long)self.floor, self.distance];
+}
+
+@end
+
+#pragma mark - Radio map
+
+@interface ESTRadioMap ()
+
+@property (nonatomic, strong, readwrite) NSArray *beaconIdentityHashes;
+@property (nonatomic, assign, readwrite) NSUInteger dimension;
+@property (nonatomic, assign, readwrite) NSUInteger count;
+@property (nonatomic, assign, readwrite) float missingRSSI;
+@property (nonatomic, assign, readwrite) NSUInteger listCount;
+
+@property (nonatomic, strong) ESTStructTable *dimensions;
+@property (nonatomic, strong) NSMutableData *mutableRows;
+@property (nonatomic, strong) ESTMappedRecordFile *file;
+
+@end
+
+@implementation ESTRadioMap
+{
+    NSUInteger _paddedDimension;
+    NSUInteger _stride;
+    const float *_rows;
+
+    uint32_t *_listOffsets;
+    float *_centroids;
+    float *_centroidNorms;
+
+    float *_query;
+    float *_dots;
+    float *_centroidDistances;
+}
+
+- (instancetype)initWithBeaconIdentityHashes:(NSArray *)beaconIdentityHashes missingRSSI:(float)missingRSSI
+{
+    self = [super init];
+    if (self)
+    {
+        self.beaconIdentityHashes = [beaconIdentityHashes copy];
+        self.dimension = beaconIdentityHashes.count;
+        self.missingRSSI = missingRSSI;
+        self.probeCount = 8;
+
+        _paddedDimension = (self.dimension + 3) & ~(NSUInteger)3;
+        _stride = _paddedDimension + EST_RADIO_MAP_TAIL;
+
+        self.dimensions = [[ESTStructTable alloc] initWithValueSize:sizeof(uint32_t) capacity:self.dimension];
+
+        [self.beaconIdentityHashes enumerateObjectsUsingBlock:^(NSNumber *hash, NSUInteger idx, BOOL *stop) {
+            uint32_t *dimension = [self.dimensions insertValueForKey:[hash unsignedLongLongValue] created:NULL];
+            *dimension = (uint32_t)idx;
+        }];
+
+        self.mutableRows = [NSMutableData data];
+        _rows = self.mutableRows.bytes;
+
+        _query = calloc(_stride, sizeof(float));
+        _dots = malloc(EST_RADIO_MAP_BLOCK * sizeof(float));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_listOffsets);
+    free(_centroids);
+    free(_centroidNorms);
+    free(_query);
+    free(_dots);
+    free(_centroidDistances);
+}
+
+- (NSUInteger)dimensionForIdentityHash:(uint64_t)identityHash
+{
+    uint32_t *dimension = [self.dimensions valueForKey:identityHash];
+
+    return dimension ? *dimension : NSNotFound;
+}
+
+#pragma mark - Points
+
+- (void)copyRSSI:(const float *)rssi toRow:(float *)row
+{
+    for (NSUInteger d = 0; d < self.dimension; d++)
+    {
+        float value = rssi[d];
+        row[d] = (value >= 0 || value < self.missingRSSI || isnan(value)) ? self.missingRSSI : value;
+    }
+
+    for (NSUInteger d = self.dimension; d < _stride; d++)
+    {
+        row[d] = 0;
+    }
+}
+
+- (void)addReferencePointWithRSSI:(const float *)rssi x:(double)x y:(double)y floor:(NSInteger)floor
+{
+    // Loaded maps are read only mappings, copy on first write.
+    if (self.file)
+    {
+        self.mutableRows = [NSMutableData dataWithBytes:_rows length:self.count * _stride * sizeof(float)];
+        self.file = nil;
+    }
+
+    [self.mutableRows increaseLengthBy:_stride * sizeof(float)];
+    _rows = self.mutableRows.bytes;
+
+    float *row = (float *)self.mutableRows.mutableBytes + self.count * _stride;
+    [self copyRSSI:rssi toRow:row];
+
+    float *tail = row + _paddedDimension;
+    tail[EST_RADIO_MAP_TAIL_X] = (float)x;
+    tail[EST_RADIO_MAP_TAIL_Y] = (float)y;
+    tail[EST_RADIO_MAP_TAIL_FLOOR] = (float)floor;
+    vDSP_svesq(row, 1, &tail[EST_RADIO_MAP_TAIL_NORM], _paddedDimension);
+
+    self.count++;
+    self.listCount = 0;
+}
+
+#pragma mark - Index
+
+- (void)allocateListsWithCount:(NSUInteger)listCount
+{
+    free(_listOffsets);
+    free(_centroids);
+    free(_centroidNorms);
+    free(_centroidDistances);
+
+    self.listCount = listCount;
+
+    _listOffsets = calloc(listCount + 1, sizeof(uint32_t));
+    _centroids = calloc(MAX(listCount, (NSUInteger)1) * _stride, sizeof(float));
+    _centroidNorms = calloc(MAX(listCount, (NSUInteger)1), sizeof(float));
+    _centroidDistances = malloc(MAX(listCount, (NSUInteger)1) * sizeof(float));
+}
+
+- (void)updateCentroidNorms
+{
+    for (NSUInteger c = 0; c < self.listCount; c++)
+    {
+        vDSP_svesq(_centroids + c * _stride, 1, &_centroidNorms[c], _paddedDimension);
+    }
+}
+
+/*
+ * Nearest centroid for `count` contiguous rows, scores are |c|^2 - 2 r.c
+ * (row norm is the same for all centroids).
+ */
+- (void)assignRows:(const float *)rows
+             count:(NSUInteger)count
+ transposedCentroids:(const float *)transposed
+            scores:(float *)scores
+       assignments:(uint32_t *)assignments
+{
+    NSUInteger lists = self.listCount;
+
+    vDSP_mmul(rows, 1, transposed, 1, scores, 1, count, lists, _stride);
+
+    for (NSUInteger r = 0; r < count; r++)
+    {
+        const float *rowScores = scores + r * lists;
+        float best = INFINITY;
+        uint32_t bestList = 0;
+
+        for (NSUInteger c = 0; c < lists; c++)
+        {
+            float score = _centroidNorms[c] - 2 * rowScores[c];
+
+            if (score < best)
+            {
+                best = score;
+                bestList = (uint32_t)c;
+            }
+        }
+
+        assignments[r] = bestList;
+    }
+}
+
+- (void)buildIndex
+{
+    NSUInteger count = self.count;
+
+    if (count < EST_RADIO_MAP_INDEX_MINIMUM)
+    {
+        [self allocateListsWithCount:0];
+        return;
+    }
+
+    NSUInteger lists = MIN((NSUInteger)EST_RADIO_MAP_MAX_LISTS, (NSUInteger)sqrt((double)count));
+    [self allocateListsWithCount:lists];
+
+    // Evenly spaced rows as initial centroids, tails stay zero.
+    for (NSUInteger c = 0; c < lists; c++)
+    {
+        memcpy(_centroids + c * _stride, _rows + (c * count / lists) * _stride, _paddedDimension * sizeof(float));
+    }
+
+    [self updateCentroidNorms];
+
+    NSUInteger sampleCount = MIN(count, lists * EST_RADIO_MAP_KMEANS_SAMPLE);
+    NSUInteger block = MIN(sampleCount, (NSUInteger)256);
+
+    float *transposed = malloc(_stride * lists * sizeof(float));
+    float *scores = malloc(block * lists * sizeof(float));
+    float *sampleBlock = malloc(block * _stride * sizeof(float));
+    uint32_t *assignments = malloc(MAX(count, block) * sizeof(uint32_t));
+    float *sums = malloc(lists * _paddedDimension * sizeof(float));
+    uint32_t *sizes = malloc(lists * sizeof(uint32_t));
+
+    for (NSUInteger iteration = 0; iteration < EST_RADIO_MAP_KMEANS_ITERATIONS; iteration++)
+    {
+        vDSP_mtrans(_centroids, 1, transposed, 1, _stride, lists);
+        memset(sums, 0, lists * _paddedDimension * sizeof(float));
+        memset(sizes, 0, lists * sizeof(uint32_t));
+
+        for (NSUInteger start = 0; start < sampleCount; start += block)
+        {
+            NSUInteger n = MIN(block, sampleCount - start);
+
+            // Training sample is spread over the whole map, gather it into a contiguous block.
+            for (NSUInteger i = 0; i < n; i++)
+            {
+                memcpy(sampleBlock + i * _stride, _rows + ((start + i) * count / sampleCount) * _stride, _stride * sizeof(float));
+            }
+
+            [self assignRows:sampleBlock count:n transposedCentroids:transposed scores:scores assignments:assignments];
+
+            for (NSUInteger i = 0; i < n; i++)
+            {
+                vDSP_vadd(sums + assignments[i] * _paddedDimension, 1, sampleBlock + i * _stride, 1,
+                          sums + assignments[i] * _paddedDimension, 1, _paddedDimension);
+                sizes[assignments[i]]++;
+            }
+        }
+
+        for (NSUInteger c = 0; c < lists; c++)
+        {
+            // Empty clusters keep their previous centroid.
+            if (sizes[c] > 0)
+            {
+                float scale = 1.0f / sizes[c];
+                vDSP_vsmul(sums + c * _paddedDimension, 1, &scale, _centroids + c * _stride, 1, _paddedDimension);
+            }
+        }
+
+        [self updateCentroidNorms];
+    }
+
+    // Assign all rows and reorder them so that every list is contiguous.
+    vDSP_mtrans(_centroids, 1, transposed, 1, _stride, lists);
+
+    for (NSUInteger start = 0; start < count; start += block)
+    {
+        NSUInteger n = MIN(block, count - start);
+        [self assignRows:_rows + start * _stride count:n transposedCentroids:transposed scores:scores assignments:assignments + start];
+    }
+
+    memset(_listOffsets, 0, (lists + 1) * sizeof(uint32_t));
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        _listOffsets[assignments[i] + 1]++;
+    }
+
+    for (NSUInteger c = 0; c < lists; c++)
+    {
+        _listOffsets[c + 1] += _listOffsets[c];
+    }
+
+    NSMutableData *ordered = [NSMutableData dataWithLength:count * _stride * sizeof(float)];
+    float *orderedRows = ordered.mutableBytes;
+    memcpy(sizes, _listOffsets, lists * sizeof(uint32_t));
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        memcpy(orderedRows + (sizes[assignments[i]]++) * _stride, _rows + i * _stride, _stride * sizeof(float));
+    }
+
+    self.mutableRows = ordered;
+    self.file = nil;
+    _rows = ordered.bytes;
+
+    free(transposed);
+    free(scores);
+    free(sampleBlock);
+    free(assignments);
+    free(sums);
+    free(sizes);
+}
+
+#pragma mark - Search
+
+typedef struct
+{
+    NSUInteger count;
+    NSUInteger capacity;
+    float *distances;
+    NSUInteger *indexes;
+} ESTTopK;
+
+static void ESTTopKInsert(ESTTopK *top, float distance, NSUInteger index)
+{
+    if (top->count == top->capacity && distance >= top->distances[top->count - 1])
+    {
+        return;
+    }
+
+    NSUInteger position = top->count < top->capacity ? top->count++ : top->count - 1;
+
+    while (position > 0 && top->distances[position - 1] > distance)
+    {
+        top->distances[position] = top->distances[position - 1];
+        top->indexes[position] = top->indexes[position - 1];
+        position--;
+    }
+
+    top->distances[position] = distance;
+    top->indexes[position] = index;
+}
+
+- (void)scanRowsFrom:(NSUInteger)start to:(NSUInteger)end queryNorm:(float)queryNorm top:(ESTTopK *)top
+{
+    for (NSUInteger blockStart = start; blockStart < end; blockStart += EST_RADIO_MAP_BLOCK)
+    {
+        NSUInteger n = MIN((NSUInteger)EST_RADIO_MAP_BLOCK, end - blockStart);
+        const float *rows = _rows + blockStart * _stride;
+
+        vDSP_mmul(rows, 1, _query, 1, _dots, 1, n, 1, _stride);
+
+        for (NSUInteger i = 0; i < n; i++)
+        {
+            float norm = rows[i * _stride + _paddedDimension + EST_RADIO_MAP_TAIL_NORM];
+            ESTTopKInsert(top, MAX(norm + queryNorm - 2 * _dots[i], 0.0f), blockStart + i);
+        }
+    }
+}
+
+- (NSArray *)nearestNeighborsOfRSSI:(const float *)rssi count:(NSUInteger)count
+{
+    if (self.count == 0 || count == 0)
+    {
+        return @[];
+    }
+
+    // Scratch below lives on the stack, bounded by the neighbor and list limits.
+    count = MIN(count, (NSUInteger)EST_RADIO_MAP_MAX_NEIGHBORS);
+
+    [self copyRSSI:rssi toRow:_query];
+
+    float queryNorm;
+    vDSP_svesq(_query, 1, &queryNorm, _paddedDimension);
+
+    float topDistances[count];
+    NSUInteger topIndexes[count];
+    ESTTopK top = { 0, count, topDistances, topIndexes };
+
+    if (self.listCount > 0)
+    {
+        NSUInteger lists = self.listCount;
+        NSUInteger probes = MIN(MAX(self.probeCount, (NSUInteger)1), lists);
+
+        vDSP_mmul(_centroids, 1, _query, 1, _centroidDistances, 1, lists, 1, _stride);
+
+        float probeDistances[probes];
+        NSUInteger probeLists[probes];
+        ESTTopK probe = { 0, probes, probeDistances, probeLists };
+
+        for (NSUInteger c = 0; c < lists; c++)
+        {
+            ESTTopKInsert(&probe, _centroidNorms[c] - 2 * _centroidDistances[c], c);
+        }
+
+        for (NSUInteger p = 0; p < probe.count; p++)
+        {
+            [self scanRowsFrom:_listOffsets[probeLists[p]] to:_listOffsets[probeLists[p] + 1] queryNorm:queryNorm top:&top];
+        }
+    }
+    else
+    {
+        [self scanRowsFrom:0 to:self.count queryNorm:queryNorm top:&top];
+    }
+
+    NSMutableArray *neighbors = [NSMutableArray arrayWithCapacity:top.count];
+
+    for (NSUInteger i = 0; i < top.count; i++)
+    {
+        const float *tail = _rows + topIndexes[i] * _stride + _paddedDimension;
+
+        ESTRadioMapNeighbor *neighbor = [ESTRadioMapNeighbor new];
+        neighbor.index = topIndexes[i];
+        neighbor.x = tail[EST_RADIO_MAP_TAIL_X];
+        neighbor.y = tail[EST_RADIO_MAP_TAIL_Y];
+        neighbor.floor = (NSInteger)tail[EST_RADIO_MAP_TAIL_FLOOR];
+        neighbor.distance = sqrt(topDistances[i]);
+
+        [neighbors addObject:neighbor];
+    }
+
+    return neighbors;
+}
+
+#pragma mark - File
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error
+{
+    ESTRadioMapHeader header = { (uint32_t)self.dimension, (uint32_t)self.listCount, self.missingRSSI, 0 };
+
+    NSMutableData *metadata = [NSMutableData dataWithBytes:&header length:sizeof(header)];
+
+    for (NSNumber *hash in self.beaconIdentityHashes)
+    {
+        uint64_t value = [hash unsignedLongLongValue];
+        [metadata appendBytes:&value length:sizeof(value)];
+    }
+
+    if (self.listCount > 0)
+    {
+        [metadata appendBytes:_listOffsets length:(self.listCount + 1) * sizeof(uint32_t)];
+        [metadata appendBytes:_centroids length:self.listCount * _stride * sizeof(float)];
+    }
+
+    return [ESTMappedRecordFile writeRecords:_rows
+                                       count:self.count
+                                  recordSize:_stride * sizeof(float)
+                                   formatTag:EST_RADIO_MAP_TAG
+                                    metadata:metadata
+                                      toPath:path
+                                       error:error];
+}
+
+/*
+ * Metadata is small and decoded, rows are used directly from the mapping.
+ * Files are written in host (little endian) byte order.
+ */
++ (instancetype)radioMapWithContentsOfFile:(NSString *)path
+{
+    ESTMappedRecordFile *file = [ESTMappedRecordFile fileWithPath:path formatTag:EST_RADIO_MAP_TAG recordSize:0];
+    NSData *metadata = file.metadata;
+
+    if (metadata.length < sizeof(ESTRadioMapHeader))
+    {
+        return nil;
+    }
+
+    ESTRadioMapHeader header;
+    [metadata getBytes:&header length:sizeof(header)];
+
+    NSUInteger stride = ((header.dimension + 3) & ~(NSUInteger)3) + EST_RADIO_MAP_TAIL;
+    NSUInteger listsLength = header.listCount ? (header.listCount + 1) * sizeof(uint32_t) + header.listCount * stride * sizeof(float) : 0;
+
+    if (file.recordSize != stride * sizeof(float)
+        || header.listCount > EST_RADIO_MAP_MAX_LISTS
+        || metadata.length < sizeof(header) + header.dimension * sizeof(uint64_t) + listsLength)
+    {
+        return nil;
+    }
+
+    const uint8_t *bytes = metadata.bytes;
+    const uint8_t *cursor = bytes + sizeof(header);
+
+    NSMutableArray *hashes = [NSMutableArray arrayWithCapacity:header.dimension];
+
+    for (NSUInteger d = 0; d < header.dimension; d++)
+    {
+        uint64_t value;
+        memcpy(&value, cursor, sizeof(value));
+        [hashes addObject:@(value)];
+        cursor += sizeof(value);
+    }
+
+    ESTRadioMap *map = [[self alloc] initWithBeaconIdentityHashes:hashes missingRSSI:header.missingRSSI];
+    map.file = file;
+    map.mutableRows = nil;
+    map.count = file.recordCount;
+    map->_rows = file.records;
+
+    if (header.listCount > 0)
+    {
+        [map allocateListsWithCount:header.listCount];
+
+        memcpy(map->_listOffsets, cursor, (header.listCount + 1) * sizeof(uint32_t));
+        cursor += (header.listCount + 1) * sizeof(uint32_t);
+
+        // Offsets index straight into the mapped rows, so lists must start at 0,
+        // never go backwards and end at the row count.
+        if (map->_listOffsets[0] != 0 || map->_listOffsets[header.listCount] != map.count)
+        {
+            return nil;
+        }
+
+        for (NSUInteger l = 0; l < header.listCount; l++)
+        {
+            if (map->_listOffsets[l] > map->_listOffsets[l + 1])
+            {
+                return nil;
+            }
+        }
+
+        memcpy(map->_centroids, cursor, header.listCount * stride * sizeof(float));
+
+        [map updateCentroidNorms];
+    }
+
+    return map;
+}
+
+@end
@@ -0,0 +1,95 @@
+//
+//  ESTRadioMapBuilder.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTRadioMap.h"
+
+/*
+ * Single beacon observation of a survey trace at a ground truth position.
+ */
+typedef struct
+{
+    double x;
+    double y;
+    int32_t floor;
+
+    /*
+     * dBm, 0 means not heard and is ignored.
+     */
+    int32_t rssi;
+
+    uint64_t identityHash;
+} ESTSurveySample;
+
+/*
+ * Survey ingestion pipeline building ESTRadioMap fingerprint databases.
+ *
+ * Traces are NSData buffers of ESTSurveySample structs, e.g. ranging output logged
+ * while walking a venue with positions from a survey tool. Samples are binned into
+ * grid cells, every (cell, beacon) pair keeps a fixed 2 dBm RSSI histogram from which
+ * median and percentiles are read. The radio map gets one reference point per cell
+ * at the mean sample position with median RSSI of beacons heard often enough.
+ *
+ * Aggregation runs on all cores: samples are partitioned once by a hash of their cell,
+ * each worker owns its shard tables, so no locking or merging is needed.
+ */
+@interface ESTRadioMapBuilder : NSObject
+
+@property (nonatomic, assign, readonly) double cellSize;
+
+/*
+ * Cells with fewer samples are dropped. Default 10.
+ */
+@property (nonatomic, assign) NSUInteger minimumSamplesPerCell;
+
+/*
+ * Beacon is considered heard in a cell when its sample count is at least this
+ * fraction of the most frequently heard beacon in that cell. Default 0.3.
+ */
+@property (nonatomic, assign) double minimumDetectionRatio;
+
+/*
+ * Default -100 dBm.
+ */
+@property (nonatomic, assign) float missingRSSI;
+
+@property (nonatomic, assign, readonly) NSUInteger sampleCount;
+@property (nonatomic, assign, readonly) NSUInteger cellCount;
+
+- (instancetype)initWithCellSize:(double)cellSize;
+
+/*
+ * Converts one ranging callback (CLBeacon objects) into samples.
+ */
++ (NSData *)samplesWithBeacons:(NSArray *)beacons x:(double)x y:(double)y floor:(NSInteger)floor;
+
+/*
+ * Trace data is kept until processTraces.
+ */
+- (void)addTrace:(NSData *)samples;
+
+/*
+ * Aggregates all added traces in parallel, can be called repeatedly as traces are added.
+ */
+- (void)processTraces;
+
+/*
+ * Radio map over all beacons seen, with index built.
+ */
+- (ESTRadioMap *)buildRadioMap;
+
+/*
+ * RSSI percentile (0-100) of beacon in the cell containing given position, NAN if unknown.
+ */
+- (float)rssiAtPercentile:(double)percentile
+                        x:(double)x
+                        y:(double)y
+                    floor:(NSInteger)floor
+             identityHash:(uint64_t)identityHash;
+
+@end
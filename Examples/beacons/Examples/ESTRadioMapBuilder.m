@@ -0,0 +1,395 @@
+//
+//  ESTRadioMapBuilder.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTRadioMapBuilder.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+
+#define EST_SURVEY_RSSI_MIN      -120
+#define EST_SURVEY_BIN_WIDTH     2
+#define EST_SURVEY_BINS          50
+
+typedef struct
+{
+    double sumX;
+    double sumY;
+    uint32_t samples;
+    uint32_t maximumBeaconCount;
+    uint32_t row;
+} ESTSurveyCell;
+
+typedef struct
+{
+    uint64_t cellKey;
+    uint64_t identityHash;
+    uint32_t count;
+    uint16_t bins[EST_SURVEY_BINS];
+} ESTSurveyStat;
+
+typedef struct
+{
+    uint64_t cellKey;
+    const ESTSurveySample *sample;
+} ESTSurveyShardSample;
+
+static uint64_t ESTSurveyCellKey(double x, double y, int32_t level, double cellSize)
+{
+    int64_t cellX = (int64_t)floor(x / cellSize);
+    int64_t cellY = (int64_t)floor(y / cellSize);
+
+    return ((uint64_t)(uint16_t)level << 48) | ((uint64_t)(cellX & 0xFFFFFF) << 24) | (uint64_t)(cellY & 0xFFFFFF);
+}
+
+/*
+ * Shard from the high hash bits. ESTStructTable places keys by the low bits of the same
+ * hash, with a shard picked from them each shard table would use a fraction of its slots.
+ */
+static inline NSUInteger ESTSurveyShard(uint64_t cellKey, NSUInteger shardCount)
+{
+    return (NSUInteger)(((ESTSketchMix64(cellKey) >> 32) * shardCount) >> 32);
+}
+
+static float ESTSurveyPercentile(const ESTSurveyStat *stat, double percentile)
+{
+    if (stat->count == 0)
+    {
+        return NAN;
+    }
+
+    // Bin counts saturate, so the total is recomputed from the bins.
+    uint32_t total = 0;
+    for (NSUInteger b = 0; b < EST_SURVEY_BINS; b++)
+    {
+        total += stat->bins[b];
+    }
+
+    double target = MIN(MAX(percentile, 0.0), 100.0) / 100.0 * total;
+    double cumulative = 0;
+
+    for (NSUInteger b = 0; b < EST_SURVEY_BINS; b++)
+    {
+        if (stat->bins[b] > 0 && cumulative + stat->bins[b] >= target)
+        {
+            // Linear interpolation inside the bin.
+            double fraction = (target - cumulative) / stat->bins[b];
+            return (float)(EST_SURVEY_RSSI_MIN + (b + fraction) * EST_SURVEY_BIN_WIDTH);
+        }
+
+        cumulative += stat->bins[b];
+    }
+
+    return (float)(EST_SURVEY_RSSI_MIN + EST_SURVEY_BINS * EST_SURVEY_BIN_WIDTH);
+}
+
+@interface ESTRadioMapBuilder ()
+
+@property (nonatomic, assign, readwrite) double cellSize;
+
+@property (nonatomic, strong) NSMutableArray *pendingTraces;
+@property (nonatomic, strong) NSArray *cellShards;
+@property (nonatomic, strong) NSArray *statShards;
+
+@end
+
+@implementation ESTRadioMapBuilder
+{
+    NSUInteger _shardCount;
+    NSUInteger *_shardSamples;
+}
+
+- (instancetype)init
+{
+    return [self initWithCellSize:2.0];
+}
+
+- (instancetype)initWithCellSize:(double)cellSize
+{
+    self = [super init];
+    if (self)
+    {
+        self.cellSize = MAX(cellSize, 0.1);
+        self.minimumSamplesPerCell = 10;
+        self.minimumDetectionRatio = 0.3;
+        self.missingRSSI = -100;
+
+        self.pendingTraces = [NSMutableArray array];
+
+        _shardCount = MAX([[NSProcessInfo processInfo] activeProcessorCount], (NSUInteger)1);
+        _shardSamples = calloc(_shardCount, sizeof(NSUInteger));
+
+        NSMutableArray *cellShards = [NSMutableArray arrayWithCapacity:_shardCount];
+        NSMutableArray *statShards = [NSMutableArray arrayWithCapacity:_shardCount];
+
+        for (NSUInteger i = 0; i < _shardCount; i++)
+        {
+            [cellShards addObject:[[ESTStructTable alloc] initWithValueSize:sizeof(ESTSurveyCell) capacity:1024]];
+            [statShards addObject:[[ESTStructTable alloc] initWithValueSize:sizeof(ESTSurveyStat) capacity:16384]];
+        }
+
+        self.cellShards = cellShards;
+        self.statShards = statShards;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_shardSamples);
+}
+
+- (NSUInteger)sampleCount
+{
+    NSUInteger count = 0;
+
+    for (NSUInteger i = 0; i < _shardCount; i++)
+    {
+        count += _shardSamples[i];
+    }
+
+    return count;
+}
+
+- (NSUInteger)cellCount
+{
+    NSUInteger count = 0;
+
+    for (ESTStructTable *cells in self.cellShards)
+    {
+        count += cells.count;
+    }
+
+    return count;
+}
+
+#pragma mark - Ingestion
+
++ (NSData *)samplesWithBeacons:(NSArray *)beacons x:(double)x y:(double)y floor:(NSInteger)floor
+{
+    NSMutableData *data = [NSMutableData dataWithCapacity:beacons.count * sizeof(ESTSurveySample)];
+
+    for (CLBeacon *beacon in beacons)
+    {
+        if (beacon.rssi >= 0)
+        {
+            continue;
+        }
+
+        ESTSurveySample sample = { x, y, (int32_t)floor, (int32_t)beacon.rssi, ESTBeaconIdentityHashCLBeacon(beacon) };
+        [data appendBytes:&sample length:sizeof(sample)];
+    }
+
+    return data;
+}
+
+- (void)addTrace:(NSData *)samples
+{
+    [self.pendingTraces addObject:[samples copy]];
+}
+
+/*
+ * Samples are partitioned by shard in one counting pass, then every worker aggregates
+ * only its bucket, so the total work stays O(samples) whatever the core count.
+ */
+- (void)processTraces
+{
+    NSArray *traces = [self.pendingTraces copy];
+    [self.pendingTraces removeAllObjects];
+
+    if (traces.count == 0)
+    {
+        return;
+    }
+
+    NSUInteger shardCount = _shardCount;
+    NSUInteger *shardSamples = _shardSamples;
+    double cellSize = self.cellSize;
+    NSArray *cellShards = self.cellShards;
+    NSArray *statShards = self.statShards;
+
+    NSUInteger total = 0;
+    for (NSData *trace in traces)
+    {
+        total += trace.length / sizeof(ESTSurveySample);
+    }
+
+    ESTSurveyShardSample *partitioned = malloc(MAX(total, (NSUInteger)1) * sizeof(ESTSurveyShardSample));
+    NSUInteger *offsets = calloc(shardCount + 1, sizeof(NSUInteger));
+    NSUInteger partitionedCount = 0;
+
+    // Cell keys are computed once, the shard of each sample is counted first.
+    for (NSData *trace in traces)
+    {
+        const ESTSurveySample *samples = trace.bytes;
+        NSUInteger count = trace.length / sizeof(ESTSurveySample);
+
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            if (samples[i].rssi >= 0)
+            {
+                continue;
+            }
+
+            uint64_t cellKey = ESTSurveyCellKey(samples[i].x, samples[i].y, samples[i].floor, cellSize);
+
+            partitioned[partitionedCount].cellKey = cellKey;
+            partitioned[partitionedCount].sample = &samples[i];
+            partitionedCount++;
+
+            offsets[ESTSurveyShard(cellKey, shardCount) + 1]++;
+        }
+    }
+
+    for (NSUInteger shard = 0; shard < shardCount; shard++)
+    {
+        offsets[shard + 1] += offsets[shard];
+    }
+
+    ESTSurveyShardSample *buckets = malloc(MAX(partitionedCount, (NSUInteger)1) * sizeof(ESTSurveyShardSample));
+    NSUInteger *cursors = malloc(shardCount * sizeof(NSUInteger));
+    memcpy(cursors, offsets, shardCount * sizeof(NSUInteger));
+
+    for (NSUInteger i = 0; i < partitionedCount; i++)
+    {
+        buckets[cursors[ESTSurveyShard(partitioned[i].cellKey, shardCount)]++] = partitioned[i];
+    }
+
+    free(cursors);
+    free(partitioned);
+
+    dispatch_apply(shardCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t shard) {
+
+        ESTStructTable *cells = cellShards[shard];
+        ESTStructTable *stats = statShards[shard];
+
+        for (NSUInteger i = offsets[shard]; i < offsets[shard + 1]; i++)
+        {
+            uint64_t cellKey = buckets[i].cellKey;
+            const ESTSurveySample *sample = buckets[i].sample;
+
+            BOOL created;
+            ESTSurveyStat *stat = [stats insertValueForKey:ESTSketchHashCombine(cellKey, sample->identityHash) created:&created];
+
+            if (created)
+            {
+                stat->cellKey = cellKey;
+                stat->identityHash = sample->identityHash;
+            }
+
+            NSInteger bin = (sample->rssi - EST_SURVEY_RSSI_MIN) / EST_SURVEY_BIN_WIDTH;
+            bin = MIN(MAX(bin, 0), EST_SURVEY_BINS - 1);
+
+            if (stat->bins[bin] < UINT16_MAX)
+            {
+                stat->bins[bin]++;
+            }
+
+            stat->count++;
+
+            ESTSurveyCell *cell = [cells insertValueForKey:cellKey created:NULL];
+            cell->sumX += sample->x;
+            cell->sumY += sample->y;
+            cell->samples++;
+            cell->maximumBeaconCount = MAX(cell->maximumBeaconCount, stat->count);
+        }
+
+        shardSamples[shard] += offsets[shard + 1] - offsets[shard];
+    });
+
+    free(buckets);
+    free(offsets);
+}
+
+#pragma mark - Output
+
+- (ESTRadioMap *)buildRadioMap
+{
+    [self processTraces];
+
+    // Sorted beacon hashes give a deterministic dimension order.
+    NSMutableSet *hashSet = [NSMutableSet set];
+
+    for (ESTStructTable *stats in self.statShards)
+    {
+        [stats enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+            [hashSet addObject:@(((ESTSurveyStat *)value)->identityHash)];
+        }];
+    }
+
+    NSArray *hashes = [[hashSet allObjects] sortedArrayUsingSelector:@selector(compare:)];
+    ESTRadioMap *map = [[ESTRadioMap alloc] initWithBeaconIdentityHashes:hashes missingRSSI:self.missingRSSI];
+
+    NSUInteger dimension = map.dimension;
+    NSUInteger minimumSamples = self.minimumSamplesPerCell;
+    double detectionRatio = self.minimumDetectionRatio;
+
+    for (NSUInteger shard = 0; shard < _shardCount; shard++)
+    {
+        ESTStructTable *cells = self.cellShards[shard];
+        ESTStructTable *stats = self.statShards[shard];
+
+        __block uint32_t rowCount = 0;
+
+        [cells enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+            ESTSurveyCell *cell = value;
+            cell->row = cell->samples >= minimumSamples ? rowCount++ : UINT32_MAX;
+        }];
+
+        float *rows = malloc(MAX(rowCount * dimension, (NSUInteger)1) * sizeof(float));
+        for (NSUInteger i = 0; i < rowCount * dimension; i++)
+        {
+            rows[i] = self.missingRSSI;
+        }
+
+        [stats enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+
+            ESTSurveyStat *stat = value;
+            ESTSurveyCell *cell = [cells valueForKey:stat->cellKey];
+
+            if (cell->row == UINT32_MAX || stat->count < detectionRatio * cell->maximumBeaconCount)
+            {
+                return;
+            }
+
+            rows[cell->row * dimension + [map dimensionForIdentityHash:stat->identityHash]] = ESTSurveyPercentile(stat, 50);
+        }];
+
+        [cells enumerateValuesUsingBlock:^(uint64_t key, void *value, BOOL *stop) {
+
+            ESTSurveyCell *cell = value;
+
+            if (cell->row != UINT32_MAX)
+            {
+                [map addReferencePointWithRSSI:rows + cell->row * dimension
+                                             x:cell->sumX / cell->samples
+                                             y:cell->sumY / cell->samples
+                                         floor:(int16_t)(key >> 48)];
+            }
+        }];
+
+        free(rows);
+    }
+
+    [map buildIndex];
+
+    return map;
+}
+
+- (float)rssiAtPercentile:(double)percentile
+                        x:(double)x
+                        y:(double)y
+                    floor:(NSInteger)floor
+             identityHash:(uint64_t)identityHash
+{
+    uint64_t cellKey = ESTSurveyCellKey(x, y, (int32_t)floor, self.cellSize);
+    ESTStructTable *stats = self.statShards[ESTSurveyShard(cellKey, _shardCount)];
+    ESTSurveyStat *stat = [stats valueForKey:ESTSketchHashCombine(cellKey, identityHash)];
+
+    return stat ? ESTSurveyPercentile(stat, percentile) : NAN;
+}
+
+@end
@@ -0,0 +1,86 @@
+//
+//  ESTRegionRegistry.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+/*
+ * Region API shared by ESTBeaconManager and ESTSecureBeaconManager.
+ */
+@protocol ESTRegionManaging <NSObject>
+
+- (void)startMonitoringForRegion:(CLBeaconRegion *)region;
+- (void)stopMonitoringForRegion:(CLBeaconRegion *)region;
+- (void)startRangingBeaconsInRegion:(CLBeaconRegion *)region;
+- (void)stopRangingBeaconsInRegion:(CLBeaconRegion *)region;
+
+@end
+
+@interface ESTBeaconManager (ESTRegionManaging) <ESTRegionManaging>
+@end
+
+@interface ESTSecureBeaconManager (ESTRegionManaging) <ESTRegionManaging>
+@end
+
+/*
+ * Immutable, versioned view of the registry. Never changes after publication,
+ * so it can be used on any thread without synchronization.
+ */
+@interface ESTRegionSnapshot : NSObject
+
+@property (nonatomic, assign, readonly) uint64_t version;
+
+@property (nonatomic, strong, readonly) NSSet *monitoredRegions;
+@property (nonatomic, strong, readonly) NSSet *rangedRegions;
+@property (nonatomic, strong, readonly) NSArray *eddystoneFilters;
+
+- (CLBeaconRegion *)monitoredRegionWithIdentifier:(NSString *)identifier;
+- (CLBeaconRegion *)rangedRegionWithIdentifier:(NSString *)identifier;
+
+@end
+
+/*
+ * Read-copy-update registry of monitored / ranged regions and Eddystone filters.
+ *
+ * Writers (start / stop calls) are serialized, build a new snapshot and publish it with
+ * a single atomic pointer store. Readers take the current snapshot without locks or
+ * copies: they announce the global epoch in a per-thread slot, load and retain the
+ * pointer and leave. Replaced snapshots are released only after every reader that
+ * could have loaded them has left (epoch based reclamation).
+ *
+ * When a region manager is attached, start / stop calls are forwarded to it after
+ * the snapshot is published.
+ */
+@interface ESTRegionRegistry : NSObject
+
+@property (nonatomic, strong, readonly) id <ESTRegionManaging> regionManager;
+
+- (instancetype)initWithRegionManager:(id <ESTRegionManaging>)regionManager;
+
+/*
+ * Lock free, callable from any thread.
+ */
+- (ESTRegionSnapshot *)snapshot;
+
+- (NSSet *)monitoredRegions;
+- (NSSet *)rangedRegions;
+
+- (void)startMonitoringForRegion:(CLBeaconRegion *)region;
+- (void)stopMonitoringForRegion:(CLBeaconRegion *)region;
+- (void)startRangingBeaconsInRegion:(CLBeaconRegion *)region;
+- (void)stopRangingBeaconsInRegion:(CLBeaconRegion *)region;
+
+- (void)addEddystoneFilter:(ESTEddystoneFilter *)filter;
+- (void)removeEddystoneFilter:(ESTEddystoneFilter *)filter;
+
+/*
+ * Number of replaced snapshots still waiting for readers to leave.
+ */
+- (NSUInteger)pendingReclamationCount;
+
+@end
@@ -0,0 +1,403 @@
+//
+//  ESTRegionRegistry.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTRegionRegistry.h"
+#import <pthread.h>
+#import <stdatomic.h>
+
+#define EST_RCU_READER_SLOTS  64
+#define EST_RCU_INACTIVE      0
+
+/*
+ * One reader slot per thread, padded to a cache line so readers on different
+ * threads never write to the same line.
+ */
+typedef struct
+{
+    _Atomic(uint64_t) epoch;
+    _Atomic(int) claimed;
+} __attribute__((aligned(64))) ESTReaderSlot;
+
+static void ESTReleaseReaderSlot(void *slot)
+{
+    atomic_store(&((ESTReaderSlot *)slot)->claimed, 0);
+}
+
+#pragma mark - Snapshot
+
+@interface ESTRegionSnapshot ()
+
+@property (nonatomic, assign, readwrite) uint64_t version;
+@property (nonatomic, strong, readwrite) NSSet *monitoredRegions;
+@property (nonatomic, strong, readwrite) NSSet *rangedRegions;
+@property (nonatomic, strong, readwrite) NSArray *eddystoneFilters;
+
+@property (nonatomic, strong) NSDictionary *monitoredByIdentifier;
+@property (nonatomic, strong) NSDictionary *rangedByIdentifier;
+
+@end
+
+@implementation ESTRegionSnapshot
+
+- (instancetype)initWithVersion:(uint64_t)version
+               monitoredRegions:(NSSet *)monitoredRegions
+                  rangedRegions:(NSSet *)rangedRegions
+               eddystoneFilters:(NSArray *)eddystoneFilters
+{
+    self = [super init];
+    if (self)
+    {
+        self.version = version;
+        self.monitoredRegions = [monitoredRegions copy];
+        self.rangedRegions = [rangedRegions copy];
+        self.eddystoneFilters = [eddystoneFilters copy];
+
+        self.monitoredByIdentifier = [self indexRegions:self.monitoredRegions];
+        self.rangedByIdentifier = [self indexRegions:self.rangedRegions];
+    }
+    return self;
+}
+
+- (NSDictionary *)indexRegions:(NSSet *)regions
+{
+    NSMutableDictionary *index = [NSMutableDictionary dictionaryWithCapacity:regions.count];
+
+    for (CLBeaconRegion *region in regions)
+    {
+        index[region.identifier] = region;
+    }
+
+    return [index copy];
+}
+
+- (CLBeaconRegion *)monitoredRegionWithIdentifier:(NSString *)identifier
+{
+    return self.monitoredByIdentifier[identifier];
+}
+
+- (CLBeaconRegion *)rangedRegionWithIdentifier:(NSString *)identifier
+{
+    return self.rangedByIdentifier[identifier];
+}
+
+@end
+
+#pragma mark - Registry
+
+@interface ESTRegionRegistry ()
+
+@property (nonatomic, strong, readwrite) id <ESTRegionManaging> regionManager;
+
+@end
+
+@implementation ESTRegionRegistry
+{
+    // Retained ESTRegionSnapshot.
+    _Atomic(void *) _current;
+    _Atomic(uint64_t) _epoch;
+
+    ESTReaderSlot _slots[EST_RCU_READER_SLOTS];
+    pthread_key_t _slotKey;
+
+    // Writers only.
+    pthread_mutex_t _writeLock;
+    void **_retired;
+    uint64_t *_retiredEpochs;
+    NSUInteger _retiredCount;
+    NSUInteger _retiredCapacity;
+}
+
+- (instancetype)init
+{
+    return [self initWithRegionManager:nil];
+}
+
+- (instancetype)initWithRegionManager:(id <ESTRegionManaging>)regionManager
+{
+    self = [super init];
+    if (self)
+    {
+        self.regionManager = regionManager;
+
+        ESTRegionSnapshot *empty = [[ESTRegionSnapshot alloc] initWithVersion:0
+                                                             monitoredRegions:[NSSet set]
+                                                                rangedRegions:[NSSet set]
+                                                             eddystoneFilters:@[]];
+        atomic_init(&_current, (void *)CFBridgingRetain(empty));
+        atomic_init(&_epoch, 1);
+
+        for (NSUInteger i = 0; i < EST_RCU_READER_SLOTS; i++)
+        {
+            atomic_init(&_slots[i].epoch, EST_RCU_INACTIVE);
+            atomic_init(&_slots[i].claimed, 0);
+        }
+
+        pthread_key_create(&_slotKey, ESTReleaseReaderSlot);
+        pthread_mutex_init(&_writeLock, NULL);
+
+        _retiredCapacity = 8;
+        _retired = malloc(_retiredCapacity * sizeof(void *));
+        _retiredEpochs = malloc(_retiredCapacity * sizeof(uint64_t));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    CFRelease(atomic_load(&_current));
+
+    for (NSUInteger i = 0; i < _retiredCount; i++)
+    {
+        CFRelease(_retired[i]);
+    }
+
+    free(_retired);
+    free(_retiredEpochs);
+
+    pthread_key_delete(_slotKey);
+    pthread_mutex_destroy(&_writeLock);
+}
+
+#pragma mark - Readers
+
+- (ESTReaderSlot *)readerSlot
+{
+    ESTReaderSlot *slot = pthread_getspecific(_slotKey);
+
+    if (!slot)
+    {
+        for (NSUInteger i = 0; i < EST_RCU_READER_SLOTS; i++)
+        {
+            int expected = 0;
+
+            if (atomic_compare_exchange_strong(&_slots[i].claimed, &expected, 1))
+            {
+                slot = &_slots[i];
+                pthread_setspecific(_slotKey, slot);
+                break;
+            }
+        }
+    }
+
+    return slot;
+}
+
+- (ESTRegionSnapshot *)snapshot
+{
+    ESTReaderSlot *slot = [self readerSlot];
+    const void *current;
+
+    if (slot)
+    {
+        atomic_store(&slot->epoch, atomic_load(&_epoch));
+
+        // Explicit retain, ARC would be free to move its retain past the slot release.
+        current = CFRetain(atomic_load(&_current));
+
+        atomic_store_explicit(&slot->epoch, EST_RCU_INACTIVE, memory_order_release);
+    }
+    else
+    {
+        // More reader threads than slots, fall back to the writer lock.
+        pthread_mutex_lock(&_writeLock);
+        current = CFRetain(atomic_load(&_current));
+        pthread_mutex_unlock(&_writeLock);
+    }
+
+    return (__bridge_transfer ESTRegionSnapshot *)current;
+}
+
+- (NSSet *)monitoredRegions
+{
+    return [self snapshot].monitoredRegions;
+}
+
+- (NSSet *)rangedRegions
+{
+    return [self snapshot].rangedRegions;
+}
+
+#pragma mark - Writers
+
+/*
+ * Called with write lock held.
+ */
+- (ESTRegionSnapshot *)writerSnapshot
+{
+    return (__bridge ESTRegionSnapshot *)atomic_load(&_current);
+}
+
+/*
+ * Called with write lock held.
+ */
+- (void)publishMonitoredRegions:(NSSet *)monitoredRegions
+                  rangedRegions:(NSSet *)rangedRegions
+               eddystoneFilters:(NSArray *)eddystoneFilters
+{
+    ESTRegionSnapshot *next = [[ESTRegionSnapshot alloc] initWithVersion:[self writerSnapshot].version + 1
+                                                        monitoredRegions:monitoredRegions
+                                                           rangedRegions:rangedRegions
+                                                        eddystoneFilters:eddystoneFilters];
+
+    void *old = atomic_exchange(&_current, (void *)CFBridgingRetain(next));
+    uint64_t epoch = atomic_fetch_add(&_epoch, 1) + 1;
+
+    if (_retiredCount == _retiredCapacity)
+    {
+        _retiredCapacity *= 2;
+        _retired = realloc(_retired, _retiredCapacity * sizeof(void *));
+        _retiredEpochs = realloc(_retiredEpochs, _retiredCapacity * sizeof(uint64_t));
+    }
+
+    // Readers announcing this epoch or later have loaded the new snapshot.
+    _retired[_retiredCount] = old;
+    _retiredEpochs[_retiredCount] = epoch;
+    _retiredCount++;
+
+    [self reclaim];
+}
+
+/*
+ * Called with write lock held.
+ */
+- (void)reclaim
+{
+    uint64_t oldestReader = UINT64_MAX;
+
+    for (NSUInteger i = 0; i < EST_RCU_READER_SLOTS; i++)
+    {
+        uint64_t epoch = atomic_load(&_slots[i].epoch);
+
+        if (epoch != EST_RCU_INACTIVE)
+        {
+            oldestReader = MIN(oldestReader, epoch);
+        }
+    }
+
+    NSUInteger kept = 0;
+
+    for (NSUInteger i = 0; i < _retiredCount; i++)
+    {
+        if (_retiredEpochs[i] <= oldestReader)
+        {
+            CFRelease(_retired[i]);
+        }
+        else
+        {
+            _retired[kept] = _retired[i];
+            _retiredEpochs[kept] = _retiredEpochs[i];
+            kept++;
+        }
+    }
+
+    _retiredCount = kept;
+}
+
+- (NSUInteger)pendingReclamationCount
+{
+    pthread_mutex_lock(&_writeLock);
+    [self reclaim];
+    NSUInteger count = _retiredCount;
+    pthread_mutex_unlock(&_writeLock);
+
+    return count;
+}
+
+- (NSSet *)regions:(NSSet *)regions replacingRegion:(CLBeaconRegion *)region add:(BOOL)add
+{
+    NSMutableSet *result = [NSMutableSet setWithCapacity:regions.count + 1];
+
+    for (CLBeaconRegion *existing in regions)
+    {
+        if (![existing.identifier isEqualToString:region.identifier])
+        {
+            [result addObject:existing];
+        }
+    }
+
+    if (add)
+    {
+        [result addObject:region];
+    }
+
+    return result;
+}
+
+- (void)updateMonitored:(BOOL)monitored region:(CLBeaconRegion *)region add:(BOOL)add
+{
+    pthread_mutex_lock(&_writeLock);
+
+    ESTRegionSnapshot *current = [self writerSnapshot];
+
+    [self publishMonitoredRegions:monitored ? [self regions:current.monitoredRegions replacingRegion:region add:add] : current.monitoredRegions
+                    rangedRegions:monitored ? current.rangedRegions : [self regions:current.rangedRegions replacingRegion:region add:add]
+                 eddystoneFilters:current.eddystoneFilters];
+
+    pthread_mutex_unlock(&_writeLock);
+}
+
+- (void)startMonitoringForRegion:(CLBeaconRegion *)region
+{
+    [self updateMonitored:YES region:region add:YES];
+    [self.regionManager startMonitoringForRegion:region];
+}
+
+- (void)stopMonitoringForRegion:(CLBeaconRegion *)region
+{
+    [self updateMonitored:YES region:region add:NO];
+    [self.regionManager stopMonitoringForRegion:region];
+}
+
+- (void)startRangingBeaconsInRegion:(CLBeaconRegion *)region
+{
+    [self updateMonitored:NO region:region add:YES];
+    [self.regionManager startRangingBeaconsInRegion:region];
+}
+
+- (void)stopRangingBeaconsInRegion:(CLBeaconRegion *)region
+{
+    [self updateMonitored:NO region:region add:NO];
+    [self.regionManager stopRangingBeaconsInRegion:region];
+}
+
+- (void)addEddystoneFilter:(ESTEddystoneFilter *)filter
+{
+    pthread_mutex_lock(&_writeLock);
+
+    ESTRegionSnapshot *current = [self writerSnapshot];
+
+    if (![current.eddystoneFilters containsObject:filter])
+    {
+        [self publishMonitoredRegions:current.monitoredRegions
+                        rangedRegions:current.rangedRegions
+                     eddystoneFilters:[current.eddystoneFilters arrayByAddingObject:filter]];
+    }
+
+    pthread_mutex_unlock(&_writeLock);
+}
+
+- (void)removeEddystoneFilter:(ESTEddystoneFilter *)filter
+{
+    pthread_mutex_lock(&_writeLock);
+
+    ESTRegionSnapshot *current = [self writerSnapshot];
+
+    if ([current.eddystoneFilters containsObject:filter])
+    {
+        NSMutableArray *filters = [current.eddystoneFilters mutableCopy];
+        [filters removeObject:filter];
+
+        [self publishMonitoredRegions:current.monitoredRegions
+                        rangedRegions:current.rangedRegions
+                     eddystoneFilters:filters];
+    }
+
+    pthread_mutex_unlock(&_writeLock);
+}
+
+@end
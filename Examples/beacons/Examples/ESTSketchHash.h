@@ -0,0 +1,58 @@
+//
+//  ESTSketchHash.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * 64-bit hashing shared by the streaming sketches.
+ *
+ * Identifiers are hashed once with FNV-1a and finished with the splitmix64
+ * mixer, so every bit of the result is usable for register / column selection.
+ * The hash is stable across devices and app launches, which is what makes
+ * sketches built on different phones or gateways mergeable.
+ */
+
+static inline uint64_t ESTSketchMix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static inline uint64_t ESTSketchHashBytes(const void *bytes, size_t length)
+{
+    const uint8_t *p = (const uint8_t *)bytes;
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+
+    return ESTSketchMix64(h);
+}
+
+static inline uint64_t ESTSketchHashString(NSString *string)
+{
+    if (!string)
+    {
+        return 0;
+    }
+
+    const char *utf8 = [string UTF8String];
+    return ESTSketchHashBytes(utf8, strlen(utf8));
+}
+
+static inline uint64_t ESTSketchHashCombine(uint64_t a, uint64_t b)
+{
+    return ESTSketchMix64(a ^ (b + 0x9e3779b97f4a7c15ULL + (a << 6) + (a >> 2)));
+}
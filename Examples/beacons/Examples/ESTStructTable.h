@@ -0,0 +1,40 @@
+//
+//  ESTStructTable.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * Hash table of fixed size C structs keyed by 64-bit hashes.
+ *
+ * Values live inline in one contiguous buffer (open addressing, linear probing),
+ * so lookups and updates do not allocate and per-device state stays compact.
+ * Pointers returned by the table are valid only until the next insert or remove.
+ */
+@interface ESTStructTable : NSObject
+
+@property (nonatomic, assign, readonly) size_t valueSize;
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+- (instancetype)initWithValueSize:(size_t)valueSize capacity:(NSUInteger)capacity;
+
+/*
+ * Returns pointer to the value or NULL when key is not present.
+ */
+- (void *)valueForKey:(uint64_t)key;
+
+/*
+ * Returns pointer to the value, creating zero filled one when key is not present.
+ */
+- (void *)insertValueForKey:(uint64_t)key created:(BOOL *)created;
+
+- (BOOL)removeValueForKey:(uint64_t)key;
+- (void)removeAllValues;
+
+- (void)enumerateValuesUsingBlock:(void (^)(uint64_t key, void *value, BOOL *stop))block;
+
+@end
@@ -0,0 +1,211 @@
+//
+//  ESTStructTable.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTStructTable.h"
+#import "ESTSketchHash.h"
+
+@interface ESTStructTable ()
+
+@property (nonatomic, assign, readwrite) size_t valueSize;
+@property (nonatomic, assign, readwrite) NSUInteger count;
+
+@end
+
+@implementation ESTStructTable
+{
+    uint64_t *_keys;
+    uint8_t *_values;
+    NSUInteger _capacity;
+}
+
+/*
+ * Key 0 marks an empty slot, so it is remapped to a fixed non-zero value.
+ */
+static inline uint64_t ESTStructTableKey(uint64_t key)
+{
+    return key ? key : 0x9e3779b97f4a7c15ULL;
+}
+
+static inline NSUInteger ESTStructTableHome(uint64_t key, NSUInteger mask)
+{
+    return (NSUInteger)ESTSketchMix64(key) & mask;
+}
+
+- (instancetype)init
+{
+    return [self initWithValueSize:sizeof(uint64_t) capacity:64];
+}
+
+- (instancetype)initWithValueSize:(size_t)valueSize capacity:(NSUInteger)capacity
+{
+    self = [super init];
+    if (self)
+    {
+        self.valueSize = MAX(valueSize, (size_t)1);
+        [self allocateCapacity:capacity];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_keys);
+    free(_values);
+}
+
+- (void)allocateCapacity:(NSUInteger)capacity
+{
+    // Keep load factor below 0.7.
+    NSUInteger slots = 16;
+    while (slots * 7 < capacity * 10)
+    {
+        slots <<= 1;
+    }
+
+    _capacity = slots;
+    _keys = calloc(slots, sizeof(uint64_t));
+    _values = calloc(slots, self.valueSize);
+}
+
+#pragma mark - Lookup
+
+- (NSUInteger)slotForKey:(uint64_t)key
+{
+    NSUInteger mask = _capacity - 1;
+    NSUInteger slot = ESTStructTableHome(key, mask);
+
+    while (_keys[slot] != 0 && _keys[slot] != key)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+- (void *)valueForKey:(uint64_t)key
+{
+    key = ESTStructTableKey(key);
+    NSUInteger slot = [self slotForKey:key];
+
+    return _keys[slot] == key ? _values + slot * self.valueSize : NULL;
+}
+
+- (void *)insertValueForKey:(uint64_t)key created:(BOOL *)created
+{
+    key = ESTStructTableKey(key);
+
+    if ((self.count + 1) * 10 > _capacity * 7)
+    {
+        [self grow];
+    }
+
+    NSUInteger slot = [self slotForKey:key];
+    BOOL isNew = (_keys[slot] == 0);
+
+    if (isNew)
+    {
+        _keys[slot] = key;
+        memset(_values + slot * self.valueSize, 0, self.valueSize);
+        self.count++;
+    }
+
+    if (created)
+    {
+        *created = isNew;
+    }
+
+    return _values + slot * self.valueSize;
+}
+
+- (void)grow
+{
+    uint64_t *oldKeys = _keys;
+    uint8_t *oldValues = _values;
+    NSUInteger oldCapacity = _capacity;
+
+    [self allocateCapacity:oldCapacity * 2];
+
+    for (NSUInteger i = 0; i < oldCapacity; i++)
+    {
+        if (oldKeys[i])
+        {
+            NSUInteger slot = [self slotForKey:oldKeys[i]];
+            _keys[slot] = oldKeys[i];
+            memcpy(_values + slot * self.valueSize, oldValues + i * self.valueSize, self.valueSize);
+        }
+    }
+
+    free(oldKeys);
+    free(oldValues);
+}
+
+#pragma mark - Removal
+
+/*
+ * Backward shift deletion keeps probe sequences intact without tombstones.
+ */
+- (BOOL)removeValueForKey:(uint64_t)key
+{
+    key = ESTStructTableKey(key);
+    NSUInteger mask = _capacity - 1;
+    NSUInteger hole = [self slotForKey:key];
+
+    if (_keys[hole] != key)
+    {
+        return NO;
+    }
+
+    NSUInteger next = hole;
+    while (YES)
+    {
+        next = (next + 1) & mask;
+
+        if (_keys[next] == 0)
+        {
+            break;
+        }
+
+        NSUInteger home = ESTStructTableHome(_keys[next], mask);
+        BOOL canMove = (hole <= next) ? (home <= hole || home > next) : (home <= hole && home > next);
+
+        if (canMove)
+        {
+            _keys[hole] = _keys[next];
+            memcpy(_values + hole * self.valueSize, _values + next * self.valueSize, self.valueSize);
+            hole = next;
+        }
+    }
+
+    _keys[hole] = 0;
+    self.count--;
+
+    return YES;
+}
+
+- (void)removeAllValues
+{
+    memset(_keys, 0, _capacity * sizeof(uint64_t));
+    self.count = 0;
+}
+
+#pragma mark - Enumeration
+
+- (void)enumerateValuesUsingBlock:(void (^)(uint64_t key, void *value, BOOL *stop))block
+{
+    BOOL stop = NO;
+
+    for (NSUInteger i = 0; i < _capacity && !stop; i++)
+    {
+        if (_keys[i])
+        {
+            block(_keys[i], _values + i * self.valueSize, &stop);
+        }
+    }
+}
+
+@end
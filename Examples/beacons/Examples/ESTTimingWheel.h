@@ -0,0 +1,40 @@
+//
+//  ESTTimingWheel.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * Hierarchical timing wheel for very large numbers of timeouts.
+ *
+ * Four levels of 64 slots cover 2^24 ticks (~194 days at 1 s resolution).
+ * Scheduling and cancelling are O(1), advancing costs O(1) per elapsed tick
+ * plus the work for timers that actually expire, independent of the number
+ * of pending timers. Deadlines further than the covered range are clamped
+ * and transparently re-armed.
+ *
+ * Timers are identified by 64-bit keys, scheduling an existing key moves it.
+ */
+@interface ESTTimingWheel : NSObject
+
+@property (nonatomic, assign, readonly) NSTimeInterval resolution;
+@property (nonatomic, assign, readonly) NSTimeInterval currentTime;
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+- (instancetype)initWithResolution:(NSTimeInterval)resolution startTime:(NSTimeInterval)startTime;
+
+- (void)scheduleKey:(uint64_t)key atTime:(NSTimeInterval)time;
+- (BOOL)cancelKey:(uint64_t)key;
+- (BOOL)isScheduledKey:(uint64_t)key;
+
+/*
+ * Moves wheel time forward and calls expired for every timer with deadline <= time.
+ * Block is called after internal state is updated, so it may schedule or cancel timers.
+ */
+- (void)advanceToTime:(NSTimeInterval)time expired:(void (^)(uint64_t key, NSTimeInterval deadline))expired;
+
+@end
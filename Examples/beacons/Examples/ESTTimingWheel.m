@@ -0,0 +1,330 @@
+//
+//  ESTTimingWheel.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTTimingWheel.h"
+#import "ESTStructTable.h"
+
+#define EST_WHEEL_LEVELS      4
+#define EST_WHEEL_SLOT_BITS   6
+#define EST_WHEEL_SLOTS       (1 << EST_WHEEL_SLOT_BITS)
+#define EST_WHEEL_SLOT_MASK   (EST_WHEEL_SLOTS - 1)
+#define EST_WHEEL_SPAN        ((uint64_t)1 << (EST_WHEEL_LEVELS * EST_WHEEL_SLOT_BITS))
+#define EST_WHEEL_NONE        UINT32_MAX
+
+typedef struct
+{
+    uint64_t key;
+    uint64_t tick;
+    NSTimeInterval deadline;
+    uint32_t next;
+    uint32_t prev;
+    uint32_t bucket;
+} ESTWheelTimer;
+
+typedef struct
+{
+    uint64_t key;
+    NSTimeInterval deadline;
+} ESTWheelExpired;
+
+@interface ESTTimingWheel ()
+
+@property (nonatomic, assign, readwrite) NSTimeInterval resolution;
+@property (nonatomic, strong) ESTStructTable *index;
+
+@end
+
+@implementation ESTTimingWheel
+{
+    NSTimeInterval _startTime;
+    uint64_t _currentTick;
+
+    uint32_t _buckets[EST_WHEEL_LEVELS * EST_WHEEL_SLOTS];
+
+    ESTWheelTimer *_timers;
+    uint32_t _timerCapacity;
+    uint32_t _freeList;
+
+    ESTWheelExpired *_expired;
+    NSUInteger _expiredCapacity;
+}
+
+- (instancetype)init
+{
+    return [self initWithResolution:1.0 startTime:CFAbsoluteTimeGetCurrent()];
+}
+
+- (instancetype)initWithResolution:(NSTimeInterval)resolution startTime:(NSTimeInterval)startTime
+{
+    self = [super init];
+    if (self)
+    {
+        self.resolution = MAX(resolution, 1e-3);
+        self.index = [[ESTStructTable alloc] initWithValueSize:sizeof(uint32_t) capacity:1024];
+
+        _startTime = startTime;
+
+        for (NSUInteger i = 0; i < EST_WHEEL_LEVELS * EST_WHEEL_SLOTS; i++)
+        {
+            _buckets[i] = EST_WHEEL_NONE;
+        }
+
+        _freeList = EST_WHEEL_NONE;
+        _expiredCapacity = 64;
+        _expired = malloc(_expiredCapacity * sizeof(ESTWheelExpired));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_timers);
+    free(_expired);
+}
+
+- (NSTimeInterval)currentTime
+{
+    return _startTime + _currentTick * self.resolution;
+}
+
+- (NSUInteger)count
+{
+    return self.index.count;
+}
+
+#pragma mark - Timer pool
+
+- (uint32_t)allocateTimer
+{
+    if (_freeList == EST_WHEEL_NONE)
+    {
+        uint32_t oldCapacity = _timerCapacity;
+        _timerCapacity = oldCapacity ? oldCapacity * 2 : 1024;
+        _timers = realloc(_timers, _timerCapacity * sizeof(ESTWheelTimer));
+
+        for (uint32_t i = _timerCapacity; i > oldCapacity; i--)
+        {
+            _timers[i - 1].next = _freeList;
+            _freeList = i - 1;
+        }
+    }
+
+    uint32_t timer = _freeList;
+    _freeList = _timers[timer].next;
+
+    return timer;
+}
+
+- (void)releaseTimer:(uint32_t)timer
+{
+    _timers[timer].next = _freeList;
+    _freeList = timer;
+}
+
+#pragma mark - Linking
+
+/*
+ * Timer goes to the lowest level whose higher bits it shares with current tick,
+ * so cascading a slot always moves its timers at least one level down.
+ */
+- (void)linkTimer:(uint32_t)timer
+{
+    ESTWheelTimer *t = &_timers[timer];
+
+    uint64_t tick = MAX(t->tick, _currentTick + 1);
+    // Clamp so that top level slot never aliases the current one.
+    tick = MIN(tick, _currentTick + EST_WHEEL_SPAN - ((uint64_t)1 << ((EST_WHEEL_LEVELS - 1) * EST_WHEEL_SLOT_BITS)));
+
+    NSUInteger level = 0;
+    while (level < EST_WHEEL_LEVELS - 1
+           && (tick >> ((level + 1) * EST_WHEEL_SLOT_BITS)) != (_currentTick >> ((level + 1) * EST_WHEEL_SLOT_BITS)))
+    {
+        level++;
+    }
+
+    uint32_t bucket = (uint32_t)(level * EST_WHEEL_SLOTS + ((tick >> (level * EST_WHEEL_SLOT_BITS)) & EST_WHEEL_SLOT_MASK));
+
+    t->bucket = bucket;
+    t->prev = EST_WHEEL_NONE;
+    t->next = _buckets[bucket];
+
+    if (t->next != EST_WHEEL_NONE)
+    {
+        _timers[t->next].prev = timer;
+    }
+
+    _buckets[bucket] = timer;
+}
+
+- (void)unlinkTimer:(uint32_t)timer
+{
+    ESTWheelTimer *t = &_timers[timer];
+
+    if (t->prev != EST_WHEEL_NONE)
+    {
+        _timers[t->prev].next = t->next;
+    }
+    else
+    {
+        _buckets[t->bucket] = t->next;
+    }
+
+    if (t->next != EST_WHEEL_NONE)
+    {
+        _timers[t->next].prev = t->prev;
+    }
+}
+
+#pragma mark - Scheduling
+
+- (uint64_t)tickForTime:(NSTimeInterval)time
+{
+    if (time <= _startTime)
+    {
+        return 0;
+    }
+
+    return (uint64_t)ceil((time - _startTime) / self.resolution);
+}
+
+- (void)scheduleKey:(uint64_t)key atTime:(NSTimeInterval)time
+{
+    BOOL created;
+    uint32_t *slot = [self.index insertValueForKey:key created:&created];
+    uint32_t timer;
+
+    if (created)
+    {
+        timer = [self allocateTimer];
+        *slot = timer;
+    }
+    else
+    {
+        timer = *slot;
+        [self unlinkTimer:timer];
+    }
+
+    _timers[timer].key = key;
+    _timers[timer].tick = [self tickForTime:time];
+    _timers[timer].deadline = time;
+
+    [self linkTimer:timer];
+}
+
+- (BOOL)cancelKey:(uint64_t)key
+{
+    uint32_t *slot = [self.index valueForKey:key];
+
+    if (!slot)
+    {
+        return NO;
+    }
+
+    uint32_t timer = *slot;
+    [self.index removeValueForKey:key];
+
+    [self unlinkTimer:timer];
+    [self releaseTimer:timer];
+
+    return YES;
+}
+
+- (BOOL)isScheduledKey:(uint64_t)key
+{
+    return [self.index valueForKey:key] != NULL;
+}
+
+#pragma mark - Advancing
+
+- (void)cascadeBucket:(uint32_t)bucket
+{
+    uint32_t timer = _buckets[bucket];
+    _buckets[bucket] = EST_WHEEL_NONE;
+
+    while (timer != EST_WHEEL_NONE)
+    {
+        uint32_t next = _timers[timer].next;
+        [self linkTimer:timer];
+        timer = next;
+    }
+}
+
+- (void)collectExpiredInBucket:(uint32_t)bucket count:(NSUInteger *)count
+{
+    uint32_t timer = _buckets[bucket];
+    _buckets[bucket] = EST_WHEEL_NONE;
+
+    while (timer != EST_WHEEL_NONE)
+    {
+        uint32_t next = _timers[timer].next;
+
+        if (_timers[timer].tick > _currentTick)
+        {
+            // Clamped timer, deadline is still ahead.
+            [self linkTimer:timer];
+        }
+        else
+        {
+            if (*count == _expiredCapacity)
+            {
+                _expiredCapacity *= 2;
+                _expired = realloc(_expired, _expiredCapacity * sizeof(ESTWheelExpired));
+            }
+
+            _expired[*count].key = _timers[timer].key;
+            _expired[*count].deadline = _timers[timer].deadline;
+            (*count)++;
+
+            [self.index removeValueForKey:_timers[timer].key];
+            [self releaseTimer:timer];
+        }
+
+        timer = next;
+    }
+}
+
+- (void)advanceToTime:(NSTimeInterval)time expired:(void (^)(uint64_t key, NSTimeInterval deadline))expired
+{
+    uint64_t target = (time <= _startTime) ? 0 : (uint64_t)floor((time - _startTime) / self.resolution);
+    NSUInteger count = 0;
+
+    while (_currentTick < target)
+    {
+        // Nothing pending, jump straight to the target tick.
+        if (self.index.count == 0)
+        {
+            _currentTick = target;
+            break;
+        }
+
+        _currentTick++;
+
+        for (NSInteger level = EST_WHEEL_LEVELS - 1; level > 0; level--)
+        {
+            uint64_t mask = ((uint64_t)1 << (level * EST_WHEEL_SLOT_BITS)) - 1;
+
+            if ((_currentTick & mask) == 0)
+            {
+                uint64_t slot = (_currentTick >> (level * EST_WHEEL_SLOT_BITS)) & EST_WHEEL_SLOT_MASK;
+                [self cascadeBucket:(uint32_t)(level * EST_WHEEL_SLOTS + slot)];
+            }
+        }
+
+        [self collectExpiredInBucket:(uint32_t)(_currentTick & EST_WHEEL_SLOT_MASK) count:&count];
+    }
+
+    if (expired)
+    {
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            expired(_expired[i].key, _expired[i].deadline);
+        }
+    }
+}
+
+@end
@@ -0,0 +1,106 @@
+//
+//  ESTVenueGeofenceGate.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+#import <EstimoteSDK/EstimoteSDK.h>
+
+@class ESTVenueGeofenceGate;
+
+@protocol ESTVenueGeofenceGateDelegate <NSObject>
+
+@optional
+
+- (void)venueGeofenceGate:(ESTVenueGeofenceGate *)gate didChangeScanning:(BOOL)scanning;
+
+@end
+
+/*
+ * Hybrid scanning mode gating beacon ranging and Eddystone discovery with coarse geofences.
+ *
+ * Fleet beacon coordinates (`ESTBeaconVO` latitude / longitude from `ESTCloudManager`)
+ * are clustered into venues. Venue geofences are monitored with `CLLocationManager`
+ * (cell / Wi-Fi based, no GPS) and ranging runs only while the device is inside at least one.
+ *
+ * iOS allows 20 monitored regions per app, shared with beacon regions. When there are more
+ * venues than free slots, geofences for the nearest venues are monitored together with
+ * a refresh geofence around the current location; leaving it selects the next nearest set.
+ *
+ * Location can also be fed manually with processLocation: (simulated location, trace replay).
+ * Radio on time is accumulated in scanningDuration between event times: location fix
+ * timestamps and, for region state and stopMonitoring, the time of the call. Replayed
+ * fixes therefore measure replay time and should not be mixed with live monitoring.
+ */
+@interface ESTVenueGeofenceGate : NSObject <CLLocationManagerDelegate>
+
+@property (nonatomic, weak) id <ESTVenueGeofenceGateDelegate> delegate;
+
+@property (nonatomic, strong, readonly) ESTBeaconManager *beaconManager;
+@property (nonatomic, strong, readonly) ESTEddystoneManager *eddystoneManager;
+
+/*
+ * Beacons closer than this are merged into one venue. Default 150 m.
+ */
+@property (nonatomic, assign) CLLocationDistance clusterDistance;
+
+/*
+ * Venue geofence radius is the venue extent plus radiusMargin, but at least minimumRadius.
+ * Defaults 100 m and 50 m, smaller geofences are not reliable with coarse location.
+ */
+@property (nonatomic, assign) CLLocationDistance minimumRadius;
+@property (nonatomic, assign) CLLocationDistance radiusMargin;
+
+/*
+ * Upper limit of geofences used by the gate. Default 20, lowered automatically
+ * by the number of beacon regions monitored by beaconManager.
+ */
+@property (nonatomic, assign) NSUInteger maximumGeofenceCount;
+
+/*
+ * Currently monitored geofences (CLCircularRegion), including the refresh geofence.
+ */
+@property (nonatomic, strong, readonly) NSArray *geofences;
+@property (nonatomic, assign, readonly) NSUInteger venueCount;
+
+@property (nonatomic, assign, readonly, getter = isScanning) BOOL scanning;
+
+/*
+ * Total time ranging / discovery was enabled and number of times it was switched on.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval scanningDuration;
+@property (nonatomic, assign, readonly) NSUInteger activationCount;
+
+- (instancetype)initWithBeaconManager:(ESTBeaconManager *)beaconManager
+                     eddystoneManager:(ESTEddystoneManager *)eddystoneManager;
+
+/*
+ * Beacons without coordinates are ignored.
+ */
+- (void)loadFleetBeacons:(NSArray *)beacons;
+
+/*
+ * Regions and filters started / stopped by the gate.
+ */
+- (void)addRangedRegion:(CLBeaconRegion *)region;
+- (void)removeRangedRegion:(CLBeaconRegion *)region;
+- (void)addEddystoneFilter:(ESTEddystoneFilter *)filter;
+- (void)removeEddystoneFilter:(ESTEddystoneFilter *)filter;
+
+/*
+ * Starts / stops geofence monitoring with CLLocationManager.
+ * Requires always authorization, see ESTBeaconManager requestAlwaysAuthorization.
+ */
+- (void)startMonitoring;
+- (void)stopMonitoring;
+
+/*
+ * Evaluates geofences against given location without CLLocationManager.
+ */
+- (void)processLocation:(CLLocation *)location;
+
+@end
@@ -0,0 +1,560 @@
+//
+//  ESTVenueGeofenceGate.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTVenueGeofenceGate.h"
+
+#define EST_GEOFENCE_PLATFORM_LIMIT   20
+#define EST_GEOFENCE_METERS_PER_DEG   111320.0
+
+static NSString * const ESTVenueGeofencePrefix = @"ESTVenueGeofence-";
+static NSString * const ESTVenueRefreshIdentifier = @"ESTVenueGeofenceRefresh";
+
+#pragma mark - Venue
+
+@interface ESTVenueCluster : NSObject
+
+@property (nonatomic, assign) double sumLatitude;
+@property (nonatomic, assign) double sumLongitude;
+@property (nonatomic, strong) NSMutableArray *members;
+@property (nonatomic, assign) CLLocationDistance radius;
+
+- (CLLocationCoordinate2D)center;
+
+@end
+
+@implementation ESTVenueCluster
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.members = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (CLLocationCoordinate2D)center
+{
+    return CLLocationCoordinate2DMake(self.sumLatitude / self.members.count, self.sumLongitude / self.members.count);
+}
+
+@end
+
+/*
+ * Equirectangular approximation, accurate enough at venue scale.
+ */
+static CLLocationDistance ESTVenueDistance(CLLocationCoordinate2D a, CLLocationCoordinate2D b)
+{
+    double dy = (a.latitude - b.latitude) * EST_GEOFENCE_METERS_PER_DEG;
+    double dx = (a.longitude - b.longitude) * EST_GEOFENCE_METERS_PER_DEG * cos((a.latitude + b.latitude) * M_PI / 360.0);
+
+    return sqrt(dx * dx + dy * dy);
+}
+
+#pragma mark - Gate
+
+@interface ESTVenueGeofenceGate ()
+
+@property (nonatomic, strong, readwrite) ESTBeaconManager *beaconManager;
+@property (nonatomic, strong, readwrite) ESTEddystoneManager *eddystoneManager;
+@property (nonatomic, strong, readwrite) NSArray *geofences;
+@property (nonatomic, assign, readwrite) BOOL scanning;
+@property (nonatomic, assign, readwrite) NSUInteger activationCount;
+
+@property (nonatomic, strong) CLLocationManager *locationManager;
+@property (nonatomic, strong) NSArray *venues;
+@property (nonatomic, strong) NSMutableSet *rangedRegions;
+@property (nonatomic, strong) NSMutableSet *eddystoneFilters;
+@property (nonatomic, strong) NSMutableSet *insideGeofences;
+@property (nonatomic, strong) CLLocation *lastLocation;
+@property (nonatomic, assign) BOOL monitoring;
+
+@end
+
+@implementation ESTVenueGeofenceGate
+{
+    NSTimeInterval _accumulatedDuration;
+    NSTimeInterval _scanningSince;
+    NSTimeInterval _lastEventTime;
+}
+
+- (instancetype)initWithBeaconManager:(ESTBeaconManager *)beaconManager
+                     eddystoneManager:(ESTEddystoneManager *)eddystoneManager
+{
+    self = [super init];
+    if (self)
+    {
+        self.beaconManager = beaconManager;
+        self.eddystoneManager = eddystoneManager;
+
+        self.clusterDistance = 150;
+        self.minimumRadius = 100;
+        self.radiusMargin = 50;
+        self.maximumGeofenceCount = EST_GEOFENCE_PLATFORM_LIMIT;
+
+        self.venues = @[];
+        self.geofences = @[];
+        self.rangedRegions = [NSMutableSet set];
+        self.eddystoneFilters = [NSMutableSet set];
+        self.insideGeofences = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (NSUInteger)venueCount
+{
+    return self.venues.count;
+}
+
+- (NSTimeInterval)scanningDuration
+{
+    return _accumulatedDuration + (self.scanning ? MAX(_lastEventTime - _scanningSince, 0.0) : 0);
+}
+
+#pragma mark - Venues
+
+/*
+ * Leader clustering on a grid with cells clusterDistance high and as many degrees
+ * wide, so each beacon is compared only with venues in the neighbouring cells.
+ */
+- (void)loadFleetBeacons:(NSArray *)beacons
+{
+    NSMutableArray *venues = [NSMutableArray array];
+    NSMutableDictionary *grid = [NSMutableDictionary dictionary];
+    double cellDegrees = MAX(self.clusterDistance, 1) / EST_GEOFENCE_METERS_PER_DEG;
+
+    for (ESTBeaconVO *beacon in beacons)
+    {
+        if (!beacon.latitude || !beacon.longitude)
+        {
+            continue;
+        }
+
+        CLLocationCoordinate2D coordinate = CLLocationCoordinate2DMake([beacon.latitude doubleValue], [beacon.longitude doubleValue]);
+
+        if (!CLLocationCoordinate2DIsValid(coordinate) || (coordinate.latitude == 0 && coordinate.longitude == 0))
+        {
+            continue;
+        }
+
+        // Cells have the same width in degrees everywhere, so away from the equator they are
+        // narrower than clusterDistance and the search reaches 1 / cos(latitude) cells sideways.
+        int32_t cellX = (int32_t)floor(coordinate.longitude / cellDegrees);
+        int32_t cellY = (int32_t)floor(coordinate.latitude / cellDegrees);
+        int32_t reachX = (int32_t)MIN(ceil(1.0 / MAX(cos(coordinate.latitude * M_PI / 180.0), 1e-3)), 180.0 / cellDegrees);
+
+        ESTVenueCluster *venue = nil;
+        CLLocationDistance best = self.clusterDistance;
+
+        for (int32_t y = cellY - 1; y <= cellY + 1; y++)
+        {
+            for (int32_t x = cellX - reachX; x <= cellX + reachX; x++)
+            {
+                for (ESTVenueCluster *candidate in grid[@(((int64_t)x << 32) | (uint32_t)y)])
+                {
+                    CLLocationDistance distance = ESTVenueDistance(candidate.center, coordinate);
+
+                    if (distance <= best)
+                    {
+                        best = distance;
+                        venue = candidate;
+                    }
+                }
+            }
+        }
+
+        if (!venue)
+        {
+            venue = [ESTVenueCluster new];
+            [venues addObject:venue];
+
+            NSNumber *cell = @(((int64_t)cellX << 32) | (uint32_t)cellY);
+            NSMutableArray *cellVenues = grid[cell];
+
+            if (!cellVenues)
+            {
+                cellVenues = [NSMutableArray array];
+                grid[cell] = cellVenues;
+            }
+
+            [cellVenues addObject:venue];
+        }
+
+        venue.sumLatitude += coordinate.latitude;
+        venue.sumLongitude += coordinate.longitude;
+        [venue.members addObject:[[CLLocation alloc] initWithLatitude:coordinate.latitude longitude:coordinate.longitude]];
+    }
+
+    for (ESTVenueCluster *venue in venues)
+    {
+        CLLocationDistance extent = 0;
+
+        for (CLLocation *member in venue.members)
+        {
+            extent = MAX(extent, ESTVenueDistance(venue.center, member.coordinate));
+        }
+
+        venue.radius = MAX(extent + self.radiusMargin, self.minimumRadius);
+    }
+
+    self.venues = venues;
+
+    [self selectGeofences];
+}
+
+- (NSUInteger)availableGeofenceCount
+{
+    // Monitored regions are shared by all location managers of the app, the gate's own do not count.
+    NSUInteger used = 0;
+
+    for (CLRegion *region in self.beaconManager.monitoredRegions)
+    {
+        used += [self ownsRegion:region] ? 0 : 1;
+    }
+
+    NSUInteger free = used < EST_GEOFENCE_PLATFORM_LIMIT ? EST_GEOFENCE_PLATFORM_LIMIT - used : 0;
+
+    return MIN(self.maximumGeofenceCount, free);
+}
+
+- (void)selectGeofences
+{
+    NSUInteger available = [self availableGeofenceCount];
+    NSArray *selected = self.venues;
+    CLCircularRegion *refresh = nil;
+
+    if (selected.count > available)
+    {
+        // The refresh geofence slot is reserved before venues are assigned, it needs
+        // a location to be centered on and room for at least one venue besides it.
+        BOOL reserveRefresh = self.lastLocation && available > 1;
+        NSUInteger count = reserveRefresh ? available - 1 : available;
+
+        if (reserveRefresh)
+        {
+            CLLocationCoordinate2D origin = self.lastLocation.coordinate;
+
+            selected = [self.venues sortedArrayUsingComparator:^NSComparisonResult(ESTVenueCluster *a, ESTVenueCluster *b) {
+                CLLocationDistance da = ESTVenueDistance(origin, a.center) - a.radius;
+                CLLocationDistance db = ESTVenueDistance(origin, b.center) - b.radius;
+                return da < db ? NSOrderedAscending : (da > db ? NSOrderedDescending : NSOrderedSame);
+            }];
+            selected = [selected subarrayWithRange:NSMakeRange(0, count)];
+
+            // Leaving the refresh geofence means one of the unselected venues may be closer now.
+            ESTVenueCluster *farthest = [selected lastObject];
+            CLLocationDistance radius = farthest ? ESTVenueDistance(origin, farthest.center) - farthest.radius : self.minimumRadius;
+
+            if (self.locationManager)
+            {
+                radius = MIN(radius, self.locationManager.maximumRegionMonitoringDistance);
+            }
+
+            refresh = [[CLCircularRegion alloc] initWithCenter:origin
+                                                        radius:MAX(radius, self.minimumRadius)
+                                                    identifier:ESTVenueRefreshIdentifier];
+        }
+        else
+        {
+            // No location yet or no room for the refresh geofence, prefer venues with most beacons.
+            selected = [self.venues sortedArrayUsingComparator:^NSComparisonResult(ESTVenueCluster *a, ESTVenueCluster *b) {
+                return a.members.count > b.members.count ? NSOrderedAscending : (a.members.count < b.members.count ? NSOrderedDescending : NSOrderedSame);
+            }];
+            selected = [selected subarrayWithRange:NSMakeRange(0, count)];
+        }
+    }
+
+    NSMutableArray *geofences = [NSMutableArray arrayWithCapacity:selected.count + 1];
+
+    [selected enumerateObjectsUsingBlock:^(ESTVenueCluster *venue, NSUInteger idx, BOOL *stop) {
+
+        CLLocationDistance radius = venue.radius;
+
+        if (self.locationManager)
+        {
+            radius = MIN(radius, self.locationManager.maximumRegionMonitoringDistance);
+        }
+
+        NSString *identifier = [NSString stringWithFormat:@"%@%lu", ESTVenueGeofencePrefix, (unsigned long)[self.venues indexOfObjectIdenticalTo:venue]];
+        [geofences addObject:[[CLCircularRegion alloc] initWithCenter:venue.center radius:radius identifier:identifier]];
+    }];
+
+    if (refresh)
+    {
+        [geofences addObject:refresh];
+    }
+
+    [self replaceGeofences:geofences];
+}
+
+- (void)replaceGeofences:(NSArray *)geofences
+{
+    NSSet *identifiers = [NSSet setWithArray:[geofences valueForKey:@"identifier"]];
+
+    if (self.monitoring)
+    {
+        for (CLCircularRegion *geofence in self.geofences)
+        {
+            [self.locationManager stopMonitoringForRegion:geofence];
+        }
+    }
+
+    [self.insideGeofences intersectSet:identifiers];
+    self.geofences = geofences;
+
+    if (self.monitoring)
+    {
+        for (CLCircularRegion *geofence in self.geofences)
+        {
+            [self.locationManager startMonitoringForRegion:geofence];
+            [self.locationManager requestStateForRegion:geofence];
+        }
+    }
+
+    if (self.lastLocation)
+    {
+        [self evaluateLocation:self.lastLocation];
+    }
+    else
+    {
+        // Not an event of its own, the change happens at the time of the last one.
+        [self updateScanningAtTime:_lastEventTime];
+    }
+}
+
+#pragma mark - Scan targets
+
+- (void)addRangedRegion:(CLBeaconRegion *)region
+{
+    [self.rangedRegions addObject:region];
+
+    if (self.scanning)
+    {
+        [self.beaconManager startRangingBeaconsInRegion:region];
+    }
+}
+
+- (void)removeRangedRegion:(CLBeaconRegion *)region
+{
+    if (self.scanning)
+    {
+        [self.beaconManager stopRangingBeaconsInRegion:region];
+    }
+
+    [self.rangedRegions removeObject:region];
+}
+
+- (void)addEddystoneFilter:(ESTEddystoneFilter *)filter
+{
+    [self.eddystoneFilters addObject:filter];
+
+    if (self.scanning)
+    {
+        [self.eddystoneManager startEddystoneDiscoveryWithFilter:filter];
+    }
+}
+
+- (void)removeEddystoneFilter:(ESTEddystoneFilter *)filter
+{
+    if (self.scanning)
+    {
+        [self.eddystoneManager stopEddystoneDiscoveryWithFilter:filter];
+    }
+
+    [self.eddystoneFilters removeObject:filter];
+}
+
+#pragma mark - Gating
+
+- (void)updateScanningAtTime:(NSTimeInterval)time
+{
+    NSMutableSet *venues = [self.insideGeofences mutableCopy];
+    [venues removeObject:ESTVenueRefreshIdentifier];
+
+    BOOL scanning = venues.count > 0;
+    _lastEventTime = time;
+
+    if (scanning == self.scanning)
+    {
+        return;
+    }
+
+    if (scanning)
+    {
+        _scanningSince = time;
+        self.activationCount++;
+
+        for (CLBeaconRegion *region in self.rangedRegions)
+        {
+            [self.beaconManager startRangingBeaconsInRegion:region];
+        }
+
+        for (ESTEddystoneFilter *filter in self.eddystoneFilters)
+        {
+            [self.eddystoneManager startEddystoneDiscoveryWithFilter:filter];
+        }
+    }
+    else
+    {
+        // Cached fixes can be older than the previous event, time never runs backwards here.
+        _accumulatedDuration += MAX(time - _scanningSince, 0.0);
+
+        for (CLBeaconRegion *region in self.rangedRegions)
+        {
+            [self.beaconManager stopRangingBeaconsInRegion:region];
+        }
+
+        for (ESTEddystoneFilter *filter in self.eddystoneFilters)
+        {
+            [self.eddystoneManager stopEddystoneDiscoveryWithFilter:filter];
+        }
+    }
+
+    self.scanning = scanning;
+
+    if ([self.delegate respondsToSelector:@selector(venueGeofenceGate:didChangeScanning:)])
+    {
+        [self.delegate venueGeofenceGate:self didChangeScanning:scanning];
+    }
+}
+
+- (void)evaluateLocation:(CLLocation *)location
+{
+    [self.insideGeofences removeAllObjects];
+
+    for (CLCircularRegion *geofence in self.geofences)
+    {
+        if ([geofence containsCoordinate:location.coordinate])
+        {
+            [self.insideGeofences addObject:geofence.identifier];
+        }
+    }
+
+    [self updateScanningAtTime:[location.timestamp timeIntervalSinceReferenceDate]];
+}
+
+- (void)processLocation:(CLLocation *)location
+{
+    BOOL leftRefresh = NO;
+
+    for (CLCircularRegion *geofence in self.geofences)
+    {
+        if ([geofence.identifier isEqualToString:ESTVenueRefreshIdentifier])
+        {
+            leftRefresh = ![geofence containsCoordinate:location.coordinate];
+        }
+    }
+
+    BOOL firstFix = (self.lastLocation == nil && self.venues.count > [self availableGeofenceCount]);
+    self.lastLocation = location;
+
+    if (leftRefresh || firstFix)
+    {
+        [self selectGeofences];
+    }
+    else
+    {
+        [self evaluateLocation:location];
+    }
+}
+
+#pragma mark - Location manager
+
+- (void)startMonitoring
+{
+    if (self.monitoring)
+    {
+        return;
+    }
+
+    if (!self.locationManager)
+    {
+        self.locationManager = [CLLocationManager new];
+        self.locationManager.delegate = self;
+    }
+
+    self.monitoring = YES;
+
+    // Significant changes provide the first fix and keep the refresh geofence honest.
+    [self.locationManager startMonitoringSignificantLocationChanges];
+    [self selectGeofences];
+}
+
+- (void)stopMonitoring
+{
+    if (!self.monitoring)
+    {
+        return;
+    }
+
+    for (CLCircularRegion *geofence in self.geofences)
+    {
+        [self.locationManager stopMonitoringForRegion:geofence];
+    }
+
+    [self.locationManager stopMonitoringSignificantLocationChanges];
+    self.monitoring = NO;
+
+    [self.insideGeofences removeAllObjects];
+    [self updateScanningAtTime:CFAbsoluteTimeGetCurrent()];
+}
+
+- (BOOL)ownsRegion:(CLRegion *)region
+{
+    return [region.identifier hasPrefix:ESTVenueGeofencePrefix] || [region.identifier isEqualToString:ESTVenueRefreshIdentifier];
+}
+
+- (void)locationManager:(CLLocationManager *)manager didUpdateLocations:(NSArray *)locations
+{
+    CLLocation *location = [locations lastObject];
+
+    if (location)
+    {
+        [self processLocation:location];
+    }
+}
+
+- (void)locationManager:(CLLocationManager *)manager didDetermineState:(CLRegionState)state forRegion:(CLRegion *)region
+{
+    if (![self ownsRegion:region])
+    {
+        return;
+    }
+
+    if (state == CLRegionStateInside)
+    {
+        [self.insideGeofences addObject:region.identifier];
+    }
+    else
+    {
+        [self.insideGeofences removeObject:region.identifier];
+
+        if (state == CLRegionStateOutside && [region.identifier isEqualToString:ESTVenueRefreshIdentifier] && manager.location)
+        {
+            // Nearest venue set is stale, select a new one around the latest fix.
+            [self processLocation:manager.location];
+            return;
+        }
+    }
+
+    // Region state carries no timestamp, it is delivered live.
+    [self updateScanningAtTime:CFAbsoluteTimeGetCurrent()];
+}
+
+- (void)locationManager:(CLLocationManager *)manager monitoringDidFailForRegion:(CLRegion *)region withError:(NSError *)error
+{
+    NSLog(@"Geofence monitoring failed for %@: %@", region.identifier, error);
+}
+
+- (void)locationManager:(CLLocationManager *)manager didFailWithError:(NSError *)error
+{
+    NSLog(@"Location manager failed: %@", error);
+}
+
+@end
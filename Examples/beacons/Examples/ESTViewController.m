@@ -22,6 +22,7 @@
 #import "ESTSendGPSDemoVC.h"
 #import "ESTEddystoneTableVC.h"
 #import "ESTVirtualBeaconDemoVC.h"
+#import "ESTLaunchCoordinator.h"
 #import <EstimoteSDK/ESTEddystone.h>
 
 @interface ESTDemoTableViewCell : UITableViewCell
@@ -64,6 +65,13 @@
                              ];
 }
 
+- (void)viewDidAppear:(BOOL)animated
+{
+    [super viewDidAppear:animated];
+    
+    [[ESTLaunchCoordinator sharedCoordinator] markFirstFrame];
+}
+
 #pragma mark - Table view data source
 
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView
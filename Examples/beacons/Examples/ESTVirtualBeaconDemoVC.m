@@ -8,6 +8,7 @@
 
 #import "ESTVirtualBeaconDemoVC.h"
 #import <EstimoteSDK/EstimoteSDK.h>
+#import "ESTLaunchCoordinator.h"
 
 @interface ESTVirtualBeaconDemoVC () <ESTBeaconManagerDelegate>
 
@@ -24,7 +25,7 @@
     self.title = @"Vritual Beacon";
     
     // Create beacon manager
-    self.beaconManager = [ESTBeaconManager new];
+    self.beaconManager = [ESTLaunchCoordinator sharedCoordinator].beaconManager;
     self.beaconManager.delegate = self;
 }
 
@@ -0,0 +1,104 @@
+//
+//  ESTVisitorAnalytics.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+#import "ESTHDRHistogram.h"
+
+/*
+ * Keys of dictionaries returned by topTransitions.
+ */
+extern NSString * const ESTVisitorTransitionFromKey;
+extern NSString * const ESTVisitorTransitionToKey;
+extern NSString * const ESTVisitorTransitionCountKey;
+
+/*
+ * On-device streaming visitor analytics computed from enter / exit events
+ * (`beaconManager:didEnterRegion:`, `nearableManager:didEnterIdentifierRegion:` etc.).
+ *
+ * Per zone (region or nearable identifier) it keeps footfall, unique visitors
+ * (HyperLogLog) and dwell time distribution in milliseconds (HDR histogram).
+ * Zone to zone transitions are counted in a shared Count-Min sketch with a small
+ * list of the most frequent ones.
+ *
+ * Memory is bounded by the configuration: ~24 KB per zone, a fixed table of active visits
+ * and fixed size sketches. Snapshots are archivable and snapshots collected on different
+ * devices or gateways can be merged. Active (not yet exited) visits are device local and are
+ * not part of a snapshot.
+ *
+ * Instance is not thread safe, feed it from a single queue (e.g. delegate callbacks on main queue).
+ */
+@interface ESTVisitorAnalytics : NSObject <NSCoding>
+
+@property (nonatomic, assign, readonly) NSUInteger maximumZoneCount;
+@property (nonatomic, assign, readonly) NSUInteger activeVisitCapacity;
+@property (nonatomic, assign, readonly) NSUInteger topTransitionCount;
+
+/*
+ * Zones of merged instances left out because maximumZoneCount was reached.
+ */
+@property (nonatomic, assign, readonly) uint64_t droppedZoneCount;
+
+/*
+ * Active visits evicted from a full probe window. Their exit was missed, so their
+ * dwell is unknown and they are counted here only, never in dwellTime.
+ */
+@property (nonatomic, assign, readonly) uint64_t evictedVisitCount;
+
+- (instancetype)initWithMaximumZoneCount:(NSUInteger)maximumZoneCount
+                     activeVisitCapacity:(NSUInteger)activeVisitCapacity
+                      topTransitionCount:(NSUInteger)topTransitionCount;
+
+#pragma mark - Events
+
+/*
+ * Timestamps are in seconds and only have to be consistent between calls.
+ * Methods return NO when zone limit is reached or exit has no matching enter.
+ */
+- (BOOL)recordEnterZone:(NSString *)zone visitor:(NSString *)visitor timestamp:(NSTimeInterval)timestamp;
+- (BOOL)recordExitZone:(NSString *)zone visitor:(NSString *)visitor timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * Convenience for monitoring callbacks, zone is the region identifier and timestamp is current time.
+ */
+- (BOOL)recordEnterRegion:(CLRegion *)region visitor:(NSString *)visitor;
+- (BOOL)recordExitRegion:(CLRegion *)region visitor:(NSString *)visitor;
+
+#pragma mark - Queries
+
+- (NSArray *)zoneIdentifiers;
+
+- (uint64_t)footfallForZone:(NSString *)zone;
+- (double)uniqueVisitorsForZone:(NSString *)zone;
+- (double)uniqueVisitors;
+
+/*
+ * Copy of dwell time histogram (milliseconds) or nil for unknown zone.
+ */
+- (ESTHDRHistogram *)dwellHistogramForZone:(NSString *)zone;
+
+- (uint64_t)estimatedTransitionsFromZone:(NSString *)fromZone toZone:(NSString *)toZone;
+
+/*
+ * Most frequent transitions sorted by count, as dictionaries with ESTVisitorTransition* keys.
+ */
+- (NSArray *)topTransitions;
+
+#pragma mark - Snapshots
+
+- (NSData *)snapshot;
++ (instancetype)analyticsWithSnapshot:(NSData *)snapshot;
+
+/*
+ * Adds counts collected by other instance (e.g. decoded from another device snapshot).
+ * Returns NO if sketches are not compatible. Zones that do not fit are counted in
+ * droppedZoneCount.
+ */
+- (BOOL)mergeWith:(ESTVisitorAnalytics *)other;
+
+@end
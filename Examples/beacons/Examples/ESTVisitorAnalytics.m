@@ -0,0 +1,586 @@
+//
+//  ESTVisitorAnalytics.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTVisitorAnalytics.h"
+#import "ESTHyperLogLog.h"
+#import "ESTCountMinSketch.h"
+#import "ESTSketchHash.h"
+
+NSString * const ESTVisitorTransitionFromKey  = @"from";
+NSString * const ESTVisitorTransitionToKey    = @"to";
+NSString * const ESTVisitorTransitionCountKey = @"count";
+
+#define EST_ZONE_HLL_PRECISION      12
+#define EST_GLOBAL_HLL_PRECISION    14
+#define EST_DWELL_HIGHEST_VALUE     (7ULL * 24 * 3600 * 1000)
+#define EST_DWELL_SIGNIFICANT_BITS  7
+#define EST_VISIT_PROBE_LENGTH      8
+
+/*
+ * Open addressing slot used for active visits and last visited zone per visitor.
+ * Key 0 marks an empty slot.
+ */
+typedef struct
+{
+    uint64_t key;
+    uint32_t zone;
+    NSTimeInterval time;
+} ESTVisitSlot;
+
+typedef struct
+{
+    uint64_t hash;
+    uint32_t from;
+    uint32_t to;
+    uint64_t estimate;
+} ESTTransitionCandidate;
+
+#pragma mark - Zone statistics
+
+@interface ESTVisitorZoneStats : NSObject <NSCoding>
+
+@property (nonatomic, strong) NSString *identifier;
+@property (nonatomic, assign) uint64_t identifierHash;
+@property (nonatomic, assign) uint32_t index;
+@property (nonatomic, assign) uint64_t footfall;
+@property (nonatomic, strong) ESTHyperLogLog *uniqueVisitors;
+@property (nonatomic, strong) ESTHDRHistogram *dwellTime;
+
+@end
+
+@implementation ESTVisitorZoneStats
+
+- (instancetype)initWithIdentifier:(NSString *)identifier
+{
+    self = [super init];
+    if (self)
+    {
+        self.identifier = identifier;
+        self.identifierHash = ESTSketchHashString(identifier);
+        self.uniqueVisitors = [[ESTHyperLogLog alloc] initWithPrecision:EST_ZONE_HLL_PRECISION];
+        self.dwellTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:EST_DWELL_HIGHEST_VALUE
+                                                                significantBits:EST_DWELL_SIGNIFICANT_BITS];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+    [coder encodeObject:self.identifier forKey:@"identifier"];
+    [coder encodeInt64:(int64_t)self.footfall forKey:@"footfall"];
+    [coder encodeObject:self.uniqueVisitors forKey:@"uniqueVisitors"];
+    [coder encodeObject:self.dwellTime forKey:@"dwellTime"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    self = [self initWithIdentifier:[decoder decodeObjectForKey:@"identifier"]];
+    if (self)
+    {
+        ESTHyperLogLog *uniqueVisitors = [decoder decodeObjectForKey:@"uniqueVisitors"];
+        ESTHDRHistogram *dwellTime = [decoder decodeObjectForKey:@"dwellTime"];
+
+        if (!self.identifier || ![self.uniqueVisitors mergeWith:uniqueVisitors] || ![self.dwellTime mergeWith:dwellTime])
+        {
+            return nil;
+        }
+
+        self.footfall = (uint64_t)[decoder decodeInt64ForKey:@"footfall"];
+    }
+    return self;
+}
+
+@end
+
+#pragma mark - Visit table
+
+static inline uint64_t ESTVisitKey(uint64_t hash)
+{
+    return hash ? hash : 1;
+}
+
+static ESTVisitSlot *ESTVisitTableFind(ESTVisitSlot *table, NSUInteger capacity, uint64_t key)
+{
+    key = ESTVisitKey(key);
+    NSUInteger mask = capacity - 1;
+
+    for (NSUInteger i = 0; i < EST_VISIT_PROBE_LENGTH; i++)
+    {
+        ESTVisitSlot *slot = &table[(NSUInteger)(key + i) & mask];
+        if (slot->key == key)
+        {
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns slot for the key. When the probe window is full the oldest entry is evicted,
+ * which keeps memory bounded at the cost of forgetting stale visits. The evicted entry
+ * is copied to evicted when given, its key is 0 when nothing was evicted.
+ */
+static ESTVisitSlot *ESTVisitTableInsert(ESTVisitSlot *table, NSUInteger capacity, uint64_t key, BOOL *existing,
+                                         ESTVisitSlot *evicted)
+{
+    key = ESTVisitKey(key);
+    NSUInteger mask = capacity - 1;
+    ESTVisitSlot *candidate = NULL;
+
+    for (NSUInteger i = 0; i < EST_VISIT_PROBE_LENGTH; i++)
+    {
+        ESTVisitSlot *slot = &table[(NSUInteger)(key + i) & mask];
+
+        if (slot->key == key)
+        {
+            *existing = YES;
+            return slot;
+        }
+
+        if (slot->key == 0)
+        {
+            if (!candidate || candidate->key != 0)
+            {
+                candidate = slot;
+            }
+        }
+        else if (!candidate || (candidate->key != 0 && slot->time < candidate->time))
+        {
+            candidate = slot;
+        }
+    }
+
+    *existing = NO;
+
+    if (evicted)
+    {
+        *evicted = *candidate;
+    }
+
+    candidate->key = key;
+
+    return candidate;
+}
+
+#pragma mark - Analytics
+
+@interface ESTVisitorAnalytics ()
+
+@property (nonatomic, assign, readwrite) NSUInteger maximumZoneCount;
+@property (nonatomic, assign, readwrite) NSUInteger activeVisitCapacity;
+@property (nonatomic, assign, readwrite) NSUInteger topTransitionCount;
+@property (nonatomic, assign, readwrite) uint64_t droppedZoneCount;
+@property (nonatomic, assign, readwrite) uint64_t evictedVisitCount;
+
+@property (nonatomic, strong) NSMutableDictionary *zones;
+@property (nonatomic, strong) NSMutableArray *zonesByIndex;
+@property (nonatomic, strong) ESTHyperLogLog *allVisitors;
+@property (nonatomic, strong) ESTCountMinSketch *transitions;
+
+@end
+
+@implementation ESTVisitorAnalytics
+{
+    ESTVisitSlot *_activeVisits;
+    ESTVisitSlot *_lastZones;
+
+    ESTTransitionCandidate *_candidates;
+    NSUInteger _candidateCount;
+}
+
+- (instancetype)init
+{
+    return [self initWithMaximumZoneCount:256 activeVisitCapacity:4096 topTransitionCount:32];
+}
+
+- (instancetype)initWithMaximumZoneCount:(NSUInteger)maximumZoneCount
+                     activeVisitCapacity:(NSUInteger)activeVisitCapacity
+                      topTransitionCount:(NSUInteger)topTransitionCount
+{
+    self = [super init];
+    if (self)
+    {
+        NSUInteger capacity = EST_VISIT_PROBE_LENGTH;
+        while (capacity < activeVisitCapacity)
+        {
+            capacity <<= 1;
+        }
+
+        self.maximumZoneCount = MAX((NSUInteger)1, maximumZoneCount);
+        self.activeVisitCapacity = capacity;
+        self.topTransitionCount = MAX((NSUInteger)1, topTransitionCount);
+
+        self.zones = [NSMutableDictionary dictionary];
+        self.zonesByIndex = [NSMutableArray array];
+        self.allVisitors = [[ESTHyperLogLog alloc] initWithPrecision:EST_GLOBAL_HLL_PRECISION];
+        self.transitions = [[ESTCountMinSketch alloc] initWithWidth:2048 depth:4];
+
+        _activeVisits = calloc(capacity, sizeof(ESTVisitSlot));
+        _lastZones = calloc(capacity, sizeof(ESTVisitSlot));
+        _candidates = calloc(self.topTransitionCount, sizeof(ESTTransitionCandidate));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_activeVisits);
+    free(_lastZones);
+    free(_candidates);
+}
+
+#pragma mark - Zones
+
+- (ESTVisitorZoneStats *)statsForZone:(NSString *)zone create:(BOOL)create
+{
+    if (!zone)
+    {
+        return nil;
+    }
+
+    ESTVisitorZoneStats *stats = self.zones[zone];
+
+    if (!stats && create && self.zonesByIndex.count < self.maximumZoneCount)
+    {
+        stats = [[ESTVisitorZoneStats alloc] initWithIdentifier:zone];
+        [self addZoneStats:stats];
+    }
+
+    return stats;
+}
+
+- (void)addZoneStats:(ESTVisitorZoneStats *)stats
+{
+    stats.index = (uint32_t)self.zonesByIndex.count;
+
+    self.zones[stats.identifier] = stats;
+    [self.zonesByIndex addObject:stats];
+}
+
+#pragma mark - Events
+
+- (BOOL)recordEnterZone:(NSString *)zone visitor:(NSString *)visitor timestamp:(NSTimeInterval)timestamp
+{
+    ESTVisitorZoneStats *stats = [self statsForZone:zone create:YES];
+
+    if (!stats || !visitor)
+    {
+        return NO;
+    }
+
+    uint64_t visitorHash = ESTSketchHashString(visitor);
+
+    stats.footfall++;
+    [stats.uniqueVisitors addHash:visitorHash];
+    [self.allVisitors addHash:visitorHash];
+
+    BOOL existing;
+    ESTVisitSlot evicted;
+    ESTVisitSlot *visit = ESTVisitTableInsert(_activeVisits, self.activeVisitCapacity,
+                                              ESTSketchHashCombine(visitorHash, stats.identifierHash), &existing, &evicted);
+
+    // Evicted visit missed its exit, dwell up to now would include the whole stale period.
+    if (!existing && evicted.key)
+    {
+        self.evictedVisitCount++;
+    }
+
+    // Repeated enter without exit keeps the original enter time.
+    if (!existing)
+    {
+        visit->zone = stats.index;
+        visit->time = timestamp;
+    }
+
+    ESTVisitSlot *last = ESTVisitTableInsert(_lastZones, self.activeVisitCapacity, visitorHash, &existing, NULL);
+
+    if (existing && last->zone != stats.index)
+    {
+        [self recordTransitionFrom:self.zonesByIndex[last->zone] to:stats];
+    }
+
+    last->zone = stats.index;
+    last->time = timestamp;
+
+    return YES;
+}
+
+- (BOOL)recordExitZone:(NSString *)zone visitor:(NSString *)visitor timestamp:(NSTimeInterval)timestamp
+{
+    ESTVisitorZoneStats *stats = [self statsForZone:zone create:NO];
+
+    if (!stats || !visitor)
+    {
+        return NO;
+    }
+
+    uint64_t key = ESTSketchHashCombine(ESTSketchHashString(visitor), stats.identifierHash);
+    ESTVisitSlot *visit = ESTVisitTableFind(_activeVisits, self.activeVisitCapacity, key);
+
+    if (!visit)
+    {
+        return NO;
+    }
+
+    NSTimeInterval dwell = MAX(0, timestamp - visit->time);
+    [stats.dwellTime recordValue:(uint64_t)llround(dwell * 1000.0)];
+
+    visit->key = 0;
+
+    return YES;
+}
+
+- (BOOL)recordEnterRegion:(CLRegion *)region visitor:(NSString *)visitor
+{
+    return [self recordEnterZone:region.identifier visitor:visitor timestamp:CFAbsoluteTimeGetCurrent()];
+}
+
+- (BOOL)recordExitRegion:(CLRegion *)region visitor:(NSString *)visitor
+{
+    return [self recordExitZone:region.identifier visitor:visitor timestamp:CFAbsoluteTimeGetCurrent()];
+}
+
+#pragma mark - Transitions
+
+- (void)recordTransitionFrom:(ESTVisitorZoneStats *)from to:(ESTVisitorZoneStats *)to
+{
+    uint64_t hash = ESTSketchHashCombine(from.identifierHash, to.identifierHash);
+
+    [self.transitions addHash:hash count:1];
+
+    [self offerTransitionHash:hash from:from.index to:to.index estimate:[self.transitions estimateForHash:hash]];
+}
+
+/*
+ * Keeps the topTransitionCount most frequent transitions seen so far.
+ * Candidate list is small, linear scan is cheaper than maintaining a heap.
+ */
+- (void)offerTransitionHash:(uint64_t)hash from:(uint32_t)from to:(uint32_t)to estimate:(uint64_t)estimate
+{
+    NSUInteger minimum = 0;
+
+    for (NSUInteger i = 0; i < _candidateCount; i++)
+    {
+        if (_candidates[i].hash == hash)
+        {
+            _candidates[i].estimate = estimate;
+            return;
+        }
+
+        if (_candidates[i].estimate < _candidates[minimum].estimate)
+        {
+            minimum = i;
+        }
+    }
+
+    ESTTransitionCandidate candidate = { hash, from, to, estimate };
+
+    if (_candidateCount < self.topTransitionCount)
+    {
+        _candidates[_candidateCount++] = candidate;
+    }
+    else if (estimate > _candidates[minimum].estimate)
+    {
+        _candidates[minimum] = candidate;
+    }
+}
+
+#pragma mark - Queries
+
+- (NSArray *)zoneIdentifiers
+{
+    return [self.zonesByIndex valueForKey:@"identifier"];
+}
+
+- (uint64_t)footfallForZone:(NSString *)zone
+{
+    return [self statsForZone:zone create:NO].footfall;
+}
+
+- (double)uniqueVisitorsForZone:(NSString *)zone
+{
+    return [[self statsForZone:zone create:NO].uniqueVisitors estimatedCardinality];
+}
+
+- (double)uniqueVisitors
+{
+    return [self.allVisitors estimatedCardinality];
+}
+
+- (ESTHDRHistogram *)dwellHistogramForZone:(NSString *)zone
+{
+    return [[self statsForZone:zone create:NO].dwellTime copy];
+}
+
+- (uint64_t)estimatedTransitionsFromZone:(NSString *)fromZone toZone:(NSString *)toZone
+{
+    return [self.transitions estimateForHash:ESTSketchHashCombine(ESTSketchHashString(fromZone),
+                                                                  ESTSketchHashString(toZone))];
+}
+
+- (NSArray *)topTransitions
+{
+    NSMutableArray *transitions = [NSMutableArray arrayWithCapacity:_candidateCount];
+
+    for (NSUInteger i = 0; i < _candidateCount; i++)
+    {
+        ESTVisitorZoneStats *from = self.zonesByIndex[_candidates[i].from];
+        ESTVisitorZoneStats *to = self.zonesByIndex[_candidates[i].to];
+
+        [transitions addObject:@{ ESTVisitorTransitionFromKey  : from.identifier,
+                                  ESTVisitorTransitionToKey    : to.identifier,
+                                  ESTVisitorTransitionCountKey : @(_candidates[i].estimate) }];
+    }
+
+    [transitions sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:ESTVisitorTransitionCountKey
+                                                                       ascending:NO]]];
+
+    return transitions;
+}
+
+#pragma mark - Merging
+
+- (BOOL)mergeWith:(ESTVisitorAnalytics *)other
+{
+    if (!other
+        || other.transitions.width != self.transitions.width
+        || other.transitions.depth != self.transitions.depth
+        || other.allVisitors.precision != self.allVisitors.precision)
+    {
+        return NO;
+    }
+
+    for (ESTVisitorZoneStats *otherStats in other.zonesByIndex)
+    {
+        ESTVisitorZoneStats *stats = [self statsForZone:otherStats.identifier create:YES];
+
+        if (stats)
+        {
+            stats.footfall += otherStats.footfall;
+            [stats.uniqueVisitors mergeWith:otherStats.uniqueVisitors];
+            [stats.dwellTime mergeWith:otherStats.dwellTime];
+        }
+        else
+        {
+            self.droppedZoneCount++;
+        }
+    }
+
+    [self.allVisitors mergeWith:other.allVisitors];
+    [self.transitions mergeWith:other.transitions];
+
+    for (NSUInteger i = 0; i < _candidateCount; i++)
+    {
+        _candidates[i].estimate = [self.transitions estimateForHash:_candidates[i].hash];
+    }
+
+    for (NSUInteger i = 0; i < other->_candidateCount; i++)
+    {
+        ESTTransitionCandidate candidate = other->_candidates[i];
+        ESTVisitorZoneStats *from = [self statsForZone:[other.zonesByIndex[candidate.from] identifier] create:NO];
+        ESTVisitorZoneStats *to = [self statsForZone:[other.zonesByIndex[candidate.to] identifier] create:NO];
+
+        if (from && to)
+        {
+            [self offerTransitionHash:candidate.hash
+                                 from:from.index
+                                   to:to.index
+                             estimate:[self.transitions estimateForHash:candidate.hash]];
+        }
+    }
+
+    return YES;
+}
+
+#pragma mark - Snapshots
+
+- (NSData *)snapshot
+{
+    return [NSKeyedArchiver archivedDataWithRootObject:self];
+}
+
++ (instancetype)analyticsWithSnapshot:(NSData *)snapshot
+{
+    id analytics = nil;
+
+    @try
+    {
+        analytics = [NSKeyedUnarchiver unarchiveObjectWithData:snapshot];
+    }
+    @catch (NSException *exception)
+    {
+        return nil;
+    }
+
+    return [analytics isKindOfClass:[ESTVisitorAnalytics class]] ? analytics : nil;
+}
+
+#pragma mark - NSCoding
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+    NSMutableArray *candidates = [NSMutableArray arrayWithCapacity:_candidateCount];
+    for (NSUInteger i = 0; i < _candidateCount; i++)
+    {
+        [candidates addObject:@[@(_candidates[i].from), @(_candidates[i].to)]];
+    }
+
+    [coder encodeInteger:(NSInteger)self.maximumZoneCount forKey:@"maximumZoneCount"];
+    [coder encodeInteger:(NSInteger)self.activeVisitCapacity forKey:@"activeVisitCapacity"];
+    [coder encodeInteger:(NSInteger)self.topTransitionCount forKey:@"topTransitionCount"];
+    [coder encodeObject:self.zonesByIndex forKey:@"zones"];
+    [coder encodeObject:self.allVisitors forKey:@"allVisitors"];
+    [coder encodeObject:self.transitions forKey:@"transitions"];
+    [coder encodeObject:candidates forKey:@"candidates"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    self = [self initWithMaximumZoneCount:(NSUInteger)[decoder decodeIntegerForKey:@"maximumZoneCount"]
+                      activeVisitCapacity:(NSUInteger)[decoder decodeIntegerForKey:@"activeVisitCapacity"]
+                       topTransitionCount:(NSUInteger)[decoder decodeIntegerForKey:@"topTransitionCount"]];
+    if (self)
+    {
+        NSArray *zones = [decoder decodeObjectForKey:@"zones"];
+        ESTHyperLogLog *allVisitors = [decoder decodeObjectForKey:@"allVisitors"];
+        ESTCountMinSketch *transitions = [decoder decodeObjectForKey:@"transitions"];
+
+        if (!allVisitors || !transitions || zones.count > self.maximumZoneCount)
+        {
+            return nil;
+        }
+
+        for (ESTVisitorZoneStats *stats in zones)
+        {
+            [self addZoneStats:stats];
+        }
+
+        self.allVisitors = allVisitors;
+        self.transitions = transitions;
+
+        for (NSArray *candidate in [decoder decodeObjectForKey:@"candidates"])
+        {
+            NSUInteger from = [candidate[0] unsignedIntegerValue];
+            NSUInteger to = [candidate[1] unsignedIntegerValue];
+
+            if (from < zones.count && to < zones.count)
+            {
+                uint64_t hash = ESTSketchHashCombine([zones[from] identifierHash], [zones[to] identifierHash]);
+
+                [self offerTransitionHash:hash
+                                     from:(uint32_t)from
+                                       to:(uint32_t)to
+                                 estimate:[transitions estimateForHash:hash]];
+            }
+        }
+    }
+    return self;
+}
+
+@end
@@ -0,0 +1,58 @@
+//
+//  ESTZoneGraph.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * Venue model for ESTZoneTracker: zones (rooms, aisles, ...), beacons heard in each zone
+ * with their expected RSSI, and allowed transitions between zones (doors, corridors).
+ *
+ * Graph is mutable until compile, which packs zones, transitions and beacons into
+ * flat arrays (compressed sparse rows) used by the tracker.
+ */
+@interface ESTZoneGraph : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger zoneCount;
+@property (nonatomic, assign, readonly, getter = isCompiled) BOOL compiled;
+
+/*
+ * Returns zone index.
+ */
+- (NSUInteger)addZoneWithIdentifier:(NSString *)identifier;
+
+- (NSString *)identifierForZone:(NSUInteger)zone;
+- (NSUInteger)zoneWithIdentifier:(NSString *)identifier;
+
+/*
+ * Same beacon can belong to several zones with different expected RSSI.
+ */
+- (void)addBeaconWithIdentityHash:(uint64_t)identityHash expectedRSSI:(float)expectedRSSI toZone:(NSUInteger)zone;
+
+/*
+ * Transitions are bidirectional, staying in a zone is always allowed.
+ */
+- (void)connectZone:(NSUInteger)zone toZone:(NSUInteger)otherZone;
+
+- (void)compile;
+
+@end
+
+/*
+ * Compiled graph access for ESTZoneTracker.
+ */
+@interface ESTZoneGraph (Compiled)
+
+- (const uint32_t *)neighborsOfZone:(NSUInteger)zone count:(NSUInteger *)count;
+
+- (const uint64_t *)beaconHashesOfZone:(NSUInteger)zone
+                          expectedRSSI:(const float **)expectedRSSI
+                                 count:(NSUInteger *)count;
+
+- (const uint32_t *)zonesOfBeacon:(uint64_t)identityHash count:(NSUInteger *)count;
+
+@end
@@ -0,0 +1,318 @@
+//
+//  ESTZoneGraph.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTZoneGraph.h"
+#import "ESTStructTable.h"
+
+typedef struct
+{
+    uint32_t zone;
+    float expectedRSSI;
+    uint64_t identityHash;
+} ESTZoneBeacon;
+
+typedef struct
+{
+    uint32_t offset;
+    uint32_t count;
+} ESTZoneRange;
+
+static int ESTCompareZoneBeaconsByHash(const void *a, const void *b)
+{
+    const ESTZoneBeacon *left = a;
+    const ESTZoneBeacon *right = b;
+
+    if (left->identityHash != right->identityHash)
+    {
+        return left->identityHash < right->identityHash ? -1 : 1;
+    }
+
+    return (int)left->zone - (int)right->zone;
+}
+
+@interface ESTZoneGraph ()
+
+@property (nonatomic, assign, readwrite) BOOL compiled;
+
+@property (nonatomic, strong) NSMutableArray *identifiers;
+@property (nonatomic, strong) NSMutableDictionary *zonesByIdentifier;
+@property (nonatomic, strong) NSMutableData *beaconEntries;
+@property (nonatomic, strong) NSMutableData *edges;
+@property (nonatomic, strong) ESTStructTable *beaconRanges;
+
+@end
+
+@implementation ESTZoneGraph
+{
+    // Compressed sparse rows, offsets have zoneCount + 1 entries.
+    uint32_t *_neighborOffsets;
+    uint32_t *_neighbors;
+
+    uint32_t *_beaconOffsets;
+    uint64_t *_beaconHashes;
+    float *_beaconRSSI;
+
+    uint32_t *_beaconZones;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.identifiers = [NSMutableArray array];
+        self.zonesByIdentifier = [NSMutableDictionary dictionary];
+        self.beaconEntries = [NSMutableData data];
+        self.edges = [NSMutableData data];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self freeCompiled];
+}
+
+- (void)freeCompiled
+{
+    free(_neighborOffsets);
+    free(_neighbors);
+    free(_beaconOffsets);
+    free(_beaconHashes);
+    free(_beaconRSSI);
+    free(_beaconZones);
+
+    _neighborOffsets = NULL;
+    _neighbors = NULL;
+    _beaconOffsets = NULL;
+    _beaconHashes = NULL;
+    _beaconRSSI = NULL;
+    _beaconZones = NULL;
+}
+
+- (NSUInteger)zoneCount
+{
+    return self.identifiers.count;
+}
+
+#pragma mark - Building
+
+- (NSUInteger)addZoneWithIdentifier:(NSString *)identifier
+{
+    NSNumber *existing = self.zonesByIdentifier[identifier];
+
+    if (existing)
+    {
+        return [existing unsignedIntegerValue];
+    }
+
+    NSUInteger zone = self.identifiers.count;
+
+    [self.identifiers addObject:[identifier copy]];
+    self.zonesByIdentifier[identifier] = @(zone);
+    self.compiled = NO;
+
+    return zone;
+}
+
+- (NSString *)identifierForZone:(NSUInteger)zone
+{
+    return zone < self.identifiers.count ? self.identifiers[zone] : nil;
+}
+
+- (NSUInteger)zoneWithIdentifier:(NSString *)identifier
+{
+    NSNumber *zone = self.zonesByIdentifier[identifier];
+
+    return zone ? [zone unsignedIntegerValue] : NSNotFound;
+}
+
+- (void)addBeaconWithIdentityHash:(uint64_t)identityHash expectedRSSI:(float)expectedRSSI toZone:(NSUInteger)zone
+{
+    NSAssert(zone < self.zoneCount, @"Unknown zone");
+
+    ESTZoneBeacon entry = { (uint32_t)zone, expectedRSSI, identityHash };
+    [self.beaconEntries appendBytes:&entry length:sizeof(entry)];
+    self.compiled = NO;
+}
+
+- (void)connectZone:(NSUInteger)zone toZone:(NSUInteger)otherZone
+{
+    NSAssert(zone < self.zoneCount && otherZone < self.zoneCount, @"Unknown zone");
+
+    if (zone == otherZone)
+    {
+        return;
+    }
+
+    uint32_t edge[4] = { (uint32_t)zone, (uint32_t)otherZone, (uint32_t)otherZone, (uint32_t)zone };
+    [self.edges appendBytes:edge length:sizeof(edge)];
+    self.compiled = NO;
+}
+
+#pragma mark - Compiling
+
+- (void)compile
+{
+    if (self.compiled)
+    {
+        return;
+    }
+
+    [self freeCompiled];
+
+    NSUInteger zones = self.zoneCount;
+
+    // Transitions, duplicates are harmless but removed to keep per-update work minimal.
+    const uint32_t *edges = self.edges.bytes;
+    NSUInteger edgeCount = self.edges.length / (2 * sizeof(uint32_t));
+
+    _neighborOffsets = calloc(zones + 1, sizeof(uint32_t));
+    _neighbors = malloc(MAX(edgeCount, (NSUInteger)1) * sizeof(uint32_t));
+
+    for (NSUInteger e = 0; e < edgeCount; e++)
+    {
+        _neighborOffsets[edges[2 * e] + 1]++;
+    }
+
+    for (NSUInteger z = 0; z < zones; z++)
+    {
+        _neighborOffsets[z + 1] += _neighborOffsets[z];
+    }
+
+    uint32_t *fill = calloc(MAX(zones, (NSUInteger)1), sizeof(uint32_t));
+
+    for (NSUInteger e = 0; e < edgeCount; e++)
+    {
+        uint32_t from = edges[2 * e];
+        uint32_t to = edges[2 * e + 1];
+        BOOL duplicate = NO;
+
+        for (uint32_t i = _neighborOffsets[from]; i < _neighborOffsets[from] + fill[from]; i++)
+        {
+            duplicate = duplicate || _neighbors[i] == to;
+        }
+
+        if (!duplicate)
+        {
+            _neighbors[_neighborOffsets[from] + fill[from]++] = to;
+        }
+    }
+
+    // Compact rows after duplicate removal.
+    uint32_t written = 0;
+
+    for (NSUInteger z = 0; z < zones; z++)
+    {
+        uint32_t start = _neighborOffsets[z];
+        _neighborOffsets[z] = written;
+        memmove(_neighbors + written, _neighbors + start, fill[z] * sizeof(uint32_t));
+        written += fill[z];
+    }
+
+    _neighborOffsets[zones] = written;
+    free(fill);
+
+    // Zone beacons grouped by zone.
+    const ESTZoneBeacon *entries = self.beaconEntries.bytes;
+    NSUInteger entryCount = self.beaconEntries.length / sizeof(ESTZoneBeacon);
+
+    _beaconOffsets = calloc(zones + 1, sizeof(uint32_t));
+    _beaconHashes = malloc(MAX(entryCount, (NSUInteger)1) * sizeof(uint64_t));
+    _beaconRSSI = malloc(MAX(entryCount, (NSUInteger)1) * sizeof(float));
+
+    for (NSUInteger i = 0; i < entryCount; i++)
+    {
+        _beaconOffsets[entries[i].zone + 1]++;
+    }
+
+    for (NSUInteger z = 0; z < zones; z++)
+    {
+        _beaconOffsets[z + 1] += _beaconOffsets[z];
+    }
+
+    fill = calloc(MAX(zones, (NSUInteger)1), sizeof(uint32_t));
+
+    for (NSUInteger i = 0; i < entryCount; i++)
+    {
+        uint32_t slot = _beaconOffsets[entries[i].zone] + fill[entries[i].zone]++;
+        _beaconHashes[slot] = entries[i].identityHash;
+        _beaconRSSI[slot] = entries[i].expectedRSSI;
+    }
+
+    free(fill);
+
+    // Zones grouped by beacon for candidate lookup, a beacon added twice to a zone is listed once.
+    ESTZoneBeacon *sorted = malloc(MAX(entryCount, (NSUInteger)1) * sizeof(ESTZoneBeacon));
+    memcpy(sorted, entries, entryCount * sizeof(ESTZoneBeacon));
+    qsort(sorted, entryCount, sizeof(ESTZoneBeacon), ESTCompareZoneBeaconsByHash);
+
+    _beaconZones = malloc(MAX(entryCount, (NSUInteger)1) * sizeof(uint32_t));
+    self.beaconRanges = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTZoneRange) capacity:entryCount];
+
+    uint32_t zoneCount = 0;
+
+    for (NSUInteger i = 0; i < entryCount; i++)
+    {
+        if (i > 0 && sorted[i].identityHash == sorted[i - 1].identityHash && sorted[i].zone == sorted[i - 1].zone)
+        {
+            continue;
+        }
+
+        BOOL created;
+        ESTZoneRange *range = [self.beaconRanges insertValueForKey:sorted[i].identityHash created:&created];
+
+        if (created)
+        {
+            range->offset = zoneCount;
+        }
+
+        _beaconZones[zoneCount++] = sorted[i].zone;
+        range->count++;
+    }
+
+    free(sorted);
+
+    self.compiled = YES;
+}
+
+#pragma mark - Compiled access
+
+- (const uint32_t *)neighborsOfZone:(NSUInteger)zone count:(NSUInteger *)count
+{
+    *count = _neighborOffsets[zone + 1] - _neighborOffsets[zone];
+
+    return _neighbors + _neighborOffsets[zone];
+}
+
+- (const uint64_t *)beaconHashesOfZone:(NSUInteger)zone
+                          expectedRSSI:(const float **)expectedRSSI
+                                 count:(NSUInteger *)count
+{
+    *count = _beaconOffsets[zone + 1] - _beaconOffsets[zone];
+    *expectedRSSI = _beaconRSSI + _beaconOffsets[zone];
+
+    return _beaconHashes + _beaconOffsets[zone];
+}
+
+- (const uint32_t *)zonesOfBeacon:(uint64_t)identityHash count:(NSUInteger *)count
+{
+    ESTZoneRange *range = [self.beaconRanges valueForKey:identityHash];
+
+    if (!range)
+    {
+        *count = 0;
+        return NULL;
+    }
+
+    *count = range->count;
+
+    return _beaconZones + range->offset;
+}
+
+@end
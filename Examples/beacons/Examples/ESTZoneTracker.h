@@ -0,0 +1,94 @@
+//
+//  ESTZoneTracker.h
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTZoneGraph.h"
+
+typedef struct
+{
+    uint64_t identityHash;
+    float rssi;
+} ESTZoneObservation;
+
+/*
+ * Room level location of many devices over an ESTZoneGraph, replacing flickering
+ * per-beacon proximity / ESTNearableZone readings.
+ *
+ * Each device runs an online Viterbi decoder (hidden Markov model over zones):
+ * transitions are allowed only along graph edges, emissions compare observed RSSI
+ * with expected RSSI of zone beacons. Only a beam of the best zones is kept, so an
+ * update touches the beam, its graph neighbors and zones of observed beacons,
+ * independent of venue size. Per-device state is a fixed size struct in a flat table.
+ *
+ * currentZone is the best path end (lag 0), smoothedZone is the decision `lag`
+ * updates back on the best path, which removes most short excursions.
+ */
+@interface ESTZoneTracker : NSObject
+
+@property (nonatomic, strong, readonly) ESTZoneGraph *graph;
+
+/*
+ * Probability of staying in a zone between updates. Default 0.9.
+ */
+@property (nonatomic, assign) double stayProbability;
+
+/*
+ * Probability of a jump between unconnected zones, allows recovery after
+ * missed updates. Default 1e-6.
+ */
+@property (nonatomic, assign) double teleportProbability;
+
+/*
+ * RSSI noise in dBm, default 6. Beacons heard outside of their zones are expected
+ * at farRSSI (default -95 dBm), zone beacons not heard cost missProbability (default 0.3).
+ */
+@property (nonatomic, assign) double rssiSigma;
+@property (nonatomic, assign) double farRSSI;
+@property (nonatomic, assign) double missProbability;
+
+/*
+ * Number of best zones kept per device, 1-8. Default 6.
+ */
+@property (nonatomic, assign) NSUInteger beamWidth;
+
+/*
+ * Smoothing lag in updates, 0-6. Default 2.
+ */
+@property (nonatomic, assign) NSUInteger lag;
+
+/*
+ * Device state older than this is discarded on next update. Default 60 s.
+ */
+@property (nonatomic, assign) NSTimeInterval resetInterval;
+
+@property (nonatomic, assign, readonly) NSUInteger deviceCount;
+
+/*
+ * Graph is compiled if needed.
+ */
+- (instancetype)initWithGraph:(ESTZoneGraph *)graph;
+
+/*
+ * Returns current zone or NSNotFound.
+ */
+- (NSUInteger)updateDevice:(uint64_t)deviceHash
+              observations:(const ESTZoneObservation *)observations
+                     count:(NSUInteger)count
+                 timestamp:(NSTimeInterval)timestamp;
+
+/*
+ * CLBeacon objects from ranging or ESTNearable objects (hashed by identifier).
+ */
+- (NSUInteger)updateDevice:(uint64_t)deviceHash beacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp;
+
+- (NSUInteger)currentZoneForDevice:(uint64_t)deviceHash;
+- (NSUInteger)smoothedZoneForDevice:(uint64_t)deviceHash;
+
+- (void)removeDevice:(uint64_t)deviceHash;
+
+@end
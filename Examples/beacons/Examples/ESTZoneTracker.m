@@ -0,0 +1,350 @@
+//
+//  ESTZoneTracker.m
+//  Examples
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTZoneTracker.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTStructTable.h"
+
+#define EST_ZONE_BEAM_MAX          8
+#define EST_ZONE_LAG_MAX           6
+#define EST_ZONE_HISTORY           (EST_ZONE_LAG_MAX + 1)
+#define EST_ZONE_CANDIDATES_MAX    256
+#define EST_ZONE_OBSERVATIONS_MAX  32
+#define EST_ZONE_NO_BACK           UINT8_MAX
+
+typedef struct
+{
+    uint32_t zone;
+    float score;
+    uint8_t back;
+} ESTZoneBeamEntry;
+
+/*
+ * Ring of the last beams, each entry points to its predecessor in the previous beam.
+ */
+typedef struct
+{
+    NSTimeInterval lastUpdate;
+    uint8_t head;
+    uint8_t steps;
+    uint8_t sizes[EST_ZONE_HISTORY];
+    ESTZoneBeamEntry beams[EST_ZONE_HISTORY][EST_ZONE_BEAM_MAX];
+} ESTZoneDeviceState;
+
+typedef struct
+{
+    NSUInteger count;
+    uint32_t zones[EST_ZONE_CANDIDATES_MAX];
+    float scores[EST_ZONE_CANDIDATES_MAX];
+    uint8_t backs[EST_ZONE_CANDIDATES_MAX];
+} ESTZoneCandidates;
+
+static void ESTZoneCandidatesAdd(ESTZoneCandidates *candidates, uint32_t zone, float score, uint8_t back)
+{
+    for (NSUInteger i = 0; i < candidates->count; i++)
+    {
+        if (candidates->zones[i] == zone)
+        {
+            if (score > candidates->scores[i])
+            {
+                candidates->scores[i] = score;
+                candidates->backs[i] = back;
+            }
+
+            return;
+        }
+    }
+
+    if (candidates->count < EST_ZONE_CANDIDATES_MAX)
+    {
+        candidates->zones[candidates->count] = zone;
+        candidates->scores[candidates->count] = score;
+        candidates->backs[candidates->count] = back;
+        candidates->count++;
+    }
+}
+
+@interface ESTZoneTracker ()
+
+@property (nonatomic, strong, readwrite) ESTZoneGraph *graph;
+@property (nonatomic, strong) ESTStructTable *devices;
+
+@end
+
+@implementation ESTZoneTracker
+{
+    ESTZoneCandidates _candidates;
+    ESTZoneObservation _observations[EST_ZONE_OBSERVATIONS_MAX];
+}
+
+- (instancetype)initWithGraph:(ESTZoneGraph *)graph
+{
+    self = [super init];
+    if (self)
+    {
+        [graph compile];
+
+        self.graph = graph;
+        self.devices = [[ESTStructTable alloc] initWithValueSize:sizeof(ESTZoneDeviceState) capacity:64];
+
+        self.stayProbability = 0.9;
+        self.teleportProbability = 1e-6;
+        self.rssiSigma = 6;
+        self.farRSSI = -95;
+        self.missProbability = 0.3;
+        self.beamWidth = 6;
+        self.lag = 2;
+        self.resetInterval = 60;
+    }
+    return self;
+}
+
+- (NSUInteger)deviceCount
+{
+    return self.devices.count;
+}
+
+#pragma mark - Updates
+
+- (NSUInteger)updateDevice:(uint64_t)deviceHash beacons:(NSArray *)beacons timestamp:(NSTimeInterval)timestamp
+{
+    NSUInteger count = 0;
+
+    for (id beacon in beacons)
+    {
+        if (count == EST_ZONE_OBSERVATIONS_MAX)
+        {
+            break;
+        }
+
+        if ([beacon isKindOfClass:[CLBeacon class]] && [(CLBeacon *)beacon rssi] < 0)
+        {
+            _observations[count].identityHash = ESTBeaconIdentityHashCLBeacon(beacon);
+            _observations[count].rssi = [(CLBeacon *)beacon rssi];
+            count++;
+        }
+        else if ([beacon isKindOfClass:[ESTNearable class]] && [(ESTNearable *)beacon rssi] < 0)
+        {
+            _observations[count].identityHash = ESTSketchHashString([(ESTNearable *)beacon identifier]);
+            _observations[count].rssi = [(ESTNearable *)beacon rssi];
+            count++;
+        }
+    }
+
+    return [self updateDevice:deviceHash observations:_observations count:count timestamp:timestamp];
+}
+
+- (float)emissionForZone:(uint32_t)zone observations:(const ESTZoneObservation *)observations count:(NSUInteger)count
+{
+    NSUInteger beaconCount;
+    const float *expectedRSSI;
+    const uint64_t *beacons = [self.graph beaconHashesOfZone:zone expectedRSSI:&expectedRSSI count:&beaconCount];
+
+    double scale = -0.5 / (self.rssiSigma * self.rssiSigma);
+    double score = 0;
+    NSUInteger matched = 0;
+
+    for (NSUInteger o = 0; o < count; o++)
+    {
+        double expected = self.farRSSI;
+
+        for (NSUInteger b = 0; b < beaconCount; b++)
+        {
+            if (beacons[b] == observations[o].identityHash)
+            {
+                expected = expectedRSSI[b];
+                matched++;
+                break;
+            }
+        }
+
+        double delta = observations[o].rssi - expected;
+        score += scale * delta * delta;
+    }
+
+    score += (double)(beaconCount > matched ? beaconCount - matched : 0) * log(self.missProbability);
+
+    return (float)score;
+}
+
+- (NSUInteger)updateDevice:(uint64_t)deviceHash
+              observations:(const ESTZoneObservation *)observations
+                     count:(NSUInteger)count
+                 timestamp:(NSTimeInterval)timestamp
+{
+    if (count == 0)
+    {
+        return [self currentZoneForDevice:deviceHash];
+    }
+
+    count = MIN(count, (NSUInteger)EST_ZONE_OBSERVATIONS_MAX);
+
+    // Devices are only inserted once they have a candidate, unknown beacons do not grow the table.
+    ESTZoneDeviceState *device = [self.devices valueForKey:deviceHash];
+    uint8_t steps = device ? device->steps : 0;
+
+    if (device && timestamp - device->lastUpdate > self.resetInterval)
+    {
+        steps = 0;
+    }
+
+    ESTZoneCandidates *candidates = &_candidates;
+    candidates->count = 0;
+
+    float teleportScore = 0;
+    uint8_t teleportBack = EST_ZONE_NO_BACK;
+
+    // Transitions from the previous beam, its best entry is first.
+    if (steps > 0)
+    {
+        const ESTZoneBeamEntry *previous = device->beams[device->head];
+        uint8_t previousCount = device->sizes[device->head];
+        float logStay = (float)log(self.stayProbability);
+
+        for (uint8_t j = 0; j < previousCount; j++)
+        {
+            ESTZoneCandidatesAdd(candidates, previous[j].zone, previous[j].score + logStay, j);
+
+            NSUInteger neighborCount;
+            const uint32_t *neighbors = [self.graph neighborsOfZone:previous[j].zone count:&neighborCount];
+
+            if (neighborCount > 0)
+            {
+                float logMove = (float)log((1.0 - self.stayProbability) / neighborCount);
+
+                for (NSUInteger n = 0; n < neighborCount; n++)
+                {
+                    ESTZoneCandidatesAdd(candidates, neighbors[n], previous[j].score + logMove, j);
+                }
+            }
+        }
+
+        teleportScore = previous[0].score + (float)log(self.teleportProbability);
+        teleportBack = 0;
+    }
+
+    // Zones of observed beacons, reachable only by teleport unless already in the beam.
+    for (NSUInteger o = 0; o < count; o++)
+    {
+        NSUInteger zoneCount;
+        const uint32_t *zones = [self.graph zonesOfBeacon:observations[o].identityHash count:&zoneCount];
+
+        for (NSUInteger z = 0; z < zoneCount; z++)
+        {
+            ESTZoneCandidatesAdd(candidates, zones[z], teleportScore, teleportBack);
+        }
+    }
+
+    if (candidates->count == 0)
+    {
+        if (device)
+        {
+            device->steps = steps;
+        }
+
+        return [self currentZoneForDevice:deviceHash];
+    }
+
+    if (!device)
+    {
+        BOOL created;
+        device = [self.devices insertValueForKey:deviceHash created:&created];
+    }
+
+    device->steps = steps;
+
+    for (NSUInteger i = 0; i < candidates->count; i++)
+    {
+        candidates->scores[i] += [self emissionForZone:candidates->zones[i] observations:observations count:count];
+    }
+
+    // Partial selection of the best candidates, beam is tiny.
+    NSUInteger beamWidth = MIN(MAX(self.beamWidth, (NSUInteger)1), (NSUInteger)EST_ZONE_BEAM_MAX);
+    NSUInteger beamCount = MIN(beamWidth, candidates->count);
+
+    uint8_t head = device->steps > 0 ? (uint8_t)((device->head + 1) % EST_ZONE_HISTORY) : 0;
+    ESTZoneBeamEntry *beam = device->beams[head];
+    float bestScore = 0;
+
+    for (NSUInteger k = 0; k < beamCount; k++)
+    {
+        NSUInteger best = k;
+
+        for (NSUInteger i = k + 1; i < candidates->count; i++)
+        {
+            if (candidates->scores[i] > candidates->scores[best])
+            {
+                best = i;
+            }
+        }
+
+        if (k == 0)
+        {
+            bestScore = candidates->scores[best];
+        }
+
+        // Scores are kept relative to the best entry so they never drift.
+        beam[k].zone = candidates->zones[best];
+        beam[k].score = candidates->scores[best] - bestScore;
+        beam[k].back = candidates->backs[best];
+
+        candidates->zones[best] = candidates->zones[k];
+        candidates->scores[best] = candidates->scores[k];
+        candidates->backs[best] = candidates->backs[k];
+    }
+
+    device->head = head;
+    device->sizes[head] = (uint8_t)beamCount;
+    device->steps = (uint8_t)MIN(device->steps + 1, EST_ZONE_HISTORY);
+    device->lastUpdate = timestamp;
+
+    return beam[0].zone;
+}
+
+#pragma mark - Queries
+
+- (NSUInteger)currentZoneForDevice:(uint64_t)deviceHash
+{
+    ESTZoneDeviceState *device = [self.devices valueForKey:deviceHash];
+
+    if (!device || device->steps == 0)
+    {
+        return NSNotFound;
+    }
+
+    return device->beams[device->head][0].zone;
+}
+
+- (NSUInteger)smoothedZoneForDevice:(uint64_t)deviceHash
+{
+    ESTZoneDeviceState *device = [self.devices valueForKey:deviceHash];
+
+    if (!device || device->steps == 0)
+    {
+        return NSNotFound;
+    }
+
+    NSUInteger lag = MIN(MIN(self.lag, (NSUInteger)EST_ZONE_LAG_MAX), (NSUInteger)device->steps - 1);
+    uint8_t index = device->head;
+    ESTZoneBeamEntry entry = device->beams[index][0];
+
+    for (NSUInteger step = 0; step < lag && entry.back != EST_ZONE_NO_BACK; step++)
+    {
+        index = (uint8_t)((index + EST_ZONE_HISTORY - 1) % EST_ZONE_HISTORY);
+        entry = device->beams[index][entry.back];
+    }
+
+    return entry.zone;
+}
+
+- (void)removeDevice:(uint64_t)deviceHash
+{
+    [self.devices removeValueForKey:deviceHash];
+}
+
+@end
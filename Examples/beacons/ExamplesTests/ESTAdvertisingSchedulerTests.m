@@ -0,0 +1,141 @@
+//
+//  ESTAdvertisingSchedulerTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTAdvertisingScheduler.h"
+#import "ESTRecordingAdvertiser.h"
+#import "ESTTestRandom.h"
+
+#define EST_SCHEDULER_TEST_CYCLES   50
+#define EST_SCHEDULER_TEST_JITTER   0.05
+
+@interface ESTAdvertisingSchedulerTests : XCTestCase
+
+@property (nonatomic, strong) ESTRecordingAdvertiser *advertiser;
+@property (nonatomic, strong) ESTAdvertisingScheduler *scheduler;
+
+@end
+
+@implementation ESTAdvertisingSchedulerTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    ESTAdvertisedIdentity *first = [ESTAdvertisedIdentity identityWithProximityUUID:[[NSUUID alloc] initWithUUIDString:@"B9407F30-F5F8-466E-AFF9-25556B57FE6D"]
+                                                                               major:1
+                                                                               minor:1
+                                                                       measuredPower:-74];
+    ESTAdvertisedIdentity *second = [ESTAdvertisedIdentity identityWithProximityUUID:[[NSUUID alloc] initWithUUIDString:@"B9407F30-F5F8-466E-AFF9-25556B57FE6D"]
+                                                                                major:1
+                                                                                minor:2
+                                                                        measuredPower:-74];
+    ESTAdvertisedIdentity *third = [ESTAdvertisedIdentity identityWithEddystoneNamespaceID:@"EDD1EBEAC04E5DEFA017"
+                                                                                instanceID:@"0BDB87539B67"
+                                                                             measuredPower:-33];
+    third.share = 2;
+
+    self.advertiser = [ESTRecordingAdvertiser new];
+    self.scheduler = [[ESTAdvertisingScheduler alloc] initWithAdvertiser:self.advertiser];
+    [self.scheduler setIdentities:@[ first, second, third ]];
+}
+
+/*
+ * Rotates for cycles on a simulated clock, every switch late by a pseudo random delay
+ * up to jitter.
+ */
+- (void)rotateForCycles:(NSUInteger)cycles jitter:(NSTimeInterval)jitter
+{
+    // Away from 0, which marks open records.
+    __block CFAbsoluteTime now = 1;
+    self.advertiser.clock = ^CFAbsoluteTime { return now; };
+
+    [self.scheduler startAtTime:now];
+
+    CFAbsoluteTime end = now + self.scheduler.cycleDuration * cycles;
+    uint64_t state = EST_TEST_SEED;
+
+    while (self.scheduler.running && now < end)
+    {
+        now = MIN(self.scheduler.nextSwitchTime + jitter * ESTTestRandom(&state), end);
+
+        [self.scheduler advanceToTime:now];
+    }
+
+    [self.scheduler stop];
+}
+
+/*
+ * Largest difference between an identity's fraction of recorded airtime and its
+ * fraction of the total share.
+ */
+- (double)maximumAirtimeError
+{
+    double totalShare = 0;
+    NSTimeInterval totalAirtime = 0;
+
+    for (ESTAdvertisedIdentity *identity in self.scheduler.identities)
+    {
+        totalShare += identity.share;
+        totalAirtime += [self.advertiser airtimeOfIdentity:identity];
+    }
+
+    double error = 0;
+
+    for (ESTAdvertisedIdentity *identity in self.scheduler.identities)
+    {
+        double airtime = totalAirtime > 0 ? [self.advertiser airtimeOfIdentity:identity] / totalAirtime : 0;
+        error = MAX(error, fabs(airtime - identity.share / totalShare));
+    }
+
+    return error;
+}
+
+- (void)testAirtimeFollowsSharesUnderJitter
+{
+    [self rotateForCycles:EST_SCHEDULER_TEST_CYCLES jitter:EST_SCHEDULER_TEST_JITTER];
+
+    double error = [self maximumAirtimeError];
+
+    NSLog(@"ESTAdvertisingSchedulerTests: airtime error %.4f with %.0f ms jitter", error, EST_SCHEDULER_TEST_JITTER * 1000);
+
+    // Shares split 20 slots exactly, what is left is timer jitter.
+    XCTAssertLessThan(error, 0.01);
+}
+
+/*
+ * Switch times come from the cycle start, so late timers do not push later switches.
+ */
+- (void)testLatenessDoesNotAccumulate
+{
+    [self rotateForCycles:EST_SCHEDULER_TEST_CYCLES jitter:EST_SCHEDULER_TEST_JITTER];
+
+    XCTAssertLessThanOrEqual(self.scheduler.maximumLateness, EST_SCHEDULER_TEST_JITTER + 1e-6);
+}
+
+- (void)testRecordsUsePrecomputedPayloads
+{
+    [self rotateForCycles:1 jitter:0];
+
+    XCTAssertGreaterThan(self.advertiser.records.count, (NSUInteger)0);
+
+    for (ESTAdvertisingRecord *record in self.advertiser.records)
+    {
+        XCTAssertEqual(record.payload, record.identity.payload);
+    }
+}
+
+- (void)testRotationPerformance
+{
+    [self measureBlock:^{
+        [self.advertiser removeAllRecords];
+        [self rotateForCycles:500 jitter:EST_SCHEDULER_TEST_JITTER];
+    }];
+}
+
+@end
@@ -0,0 +1,212 @@
+//
+//  ESTAssetLocationIndexTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTAssetLocationIndex.h"
+#import "ESTTestRandom.h"
+
+#define EST_ASSET_TEST_ASSETS       100000
+#define EST_ASSET_TEST_ROOMS        200
+#define EST_ASSET_TEST_INTERVAL     10.0
+
+static inline uint64_t ESTAssetTestRoom(NSUInteger room)
+{
+    return 0x524F4F4D00000000ULL + room + 1;
+}
+
+/*
+ * Two observers per room.
+ */
+static inline uint64_t ESTAssetTestObserver(NSUInteger room, NSUInteger observer)
+{
+    return 0x4F42530000000000ULL + room * 2 + observer + 1;
+}
+
+static inline uint64_t ESTAssetTestAsset(NSUInteger asset)
+{
+    return 0x4153534500000000ULL + asset + 1;
+}
+
+/*
+ * 100k assets spread evenly over 200 rooms. Every 10 s each asset is heard strongly by
+ * an observer of its room and weakly by one of the next room, through the wall.
+ */
+@interface ESTAssetLocationIndexTests : XCTestCase <ESTAssetLocationIndexDelegate>
+
+@property (nonatomic, strong) ESTAssetLocationIndex *index;
+@property (nonatomic, strong) NSMutableData *round;
+@property (nonatomic, assign) NSUInteger moveCount;
+@property (nonatomic, assign) uint64_t lastMoveTarget;
+
+@end
+
+@implementation ESTAssetLocationIndexTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.index = [ESTAssetLocationIndex new];
+    self.index.delegate = self;
+
+    for (NSUInteger room = 0; room < EST_ASSET_TEST_ROOMS; room++)
+    {
+        [self.index setRoom:ESTAssetTestRoom(room) forObserver:ESTAssetTestObserver(room, 0)];
+        [self.index setRoom:ESTAssetTestRoom(room) forObserver:ESTAssetTestObserver(room, 1)];
+    }
+
+    self.round = [NSMutableData dataWithLength:EST_ASSET_TEST_ASSETS * 2 * sizeof(ESTAssetObservation)];
+    ESTAssetObservation *observations = self.round.mutableBytes;
+    uint64_t state = EST_TEST_SEED;
+
+    for (NSUInteger a = 0; a < EST_ASSET_TEST_ASSETS; a++)
+    {
+        NSUInteger room = a % EST_ASSET_TEST_ROOMS;
+        NSUInteger observer = ESTTestRandom(&state) < 0.5 ? 0 : 1;
+
+        // Own room first, so the first sighting already assigns the right room.
+        observations[a * 2] = (ESTAssetObservation){
+            ESTAssetTestAsset(a), ESTAssetTestObserver(room, observer), 0, (int8_t)(-55 - ESTTestRandom(&state) * 15)
+        };
+        observations[a * 2 + 1] = (ESTAssetObservation){
+            ESTAssetTestAsset(a), ESTAssetTestObserver((room + 1) % EST_ASSET_TEST_ROOMS, observer), 0, (int8_t)(-80 - ESTTestRandom(&state) * 10)
+        };
+    }
+}
+
+- (void)assetIndex:(ESTAssetLocationIndex *)index didMoveAsset:(uint64_t)asset fromRoom:(uint64_t)fromRoom toRoom:(uint64_t)toRoom
+{
+    self.moveCount++;
+    self.lastMoveTarget = toRoom;
+}
+
+/*
+ * Feeds the round of observations stamped with time.
+ */
+- (void)addRoundAtTime:(NSTimeInterval)time
+{
+    ESTAssetObservation *observations = self.round.mutableBytes;
+    NSUInteger count = self.round.length / sizeof(ESTAssetObservation);
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        observations[i].timestamp = time;
+    }
+
+    [self.index addObservations:observations count:count];
+}
+
+- (void)testAssetsStayInTheirRooms
+{
+    for (NSUInteger r = 0; r < 3; r++)
+    {
+        [self addRoundAtTime:r * EST_ASSET_TEST_INTERVAL];
+    }
+
+    XCTAssertEqual(self.index.assetCount, (NSUInteger)EST_ASSET_TEST_ASSETS);
+    XCTAssertEqual(self.index.droppedObservationCount, (uint64_t)0);
+
+    // One move per asset, the first assignment, through-wall sightings never take one over.
+    XCTAssertEqual(self.moveCount, (NSUInteger)EST_ASSET_TEST_ASSETS);
+
+    NSUInteger misplaced = 0;
+
+    for (NSUInteger a = 0; a < EST_ASSET_TEST_ASSETS; a++)
+    {
+        misplaced += [self.index roomOfAsset:ESTAssetTestAsset(a) confidence:NULL] != ESTAssetTestRoom(a % EST_ASSET_TEST_ROOMS);
+    }
+
+    XCTAssertEqual(misplaced, (NSUInteger)0);
+
+    for (NSUInteger room = 0; room < EST_ASSET_TEST_ROOMS; room++)
+    {
+        XCTAssertEqual([self.index assetCountInRoom:ESTAssetTestRoom(room)], (NSUInteger)(EST_ASSET_TEST_ASSETS / EST_ASSET_TEST_ROOMS));
+    }
+}
+
+/*
+ * An asset carried into the next room moves only once the new room has led for dwellTime.
+ */
+- (void)testMoveWaitsForDwellTime
+{
+    for (NSUInteger r = 0; r < 3; r++)
+    {
+        [self addRoundAtTime:r * EST_ASSET_TEST_INTERVAL];
+    }
+
+    uint64_t asset = ESTAssetTestAsset(0);
+    uint64_t next = ESTAssetTestRoom(1);
+    NSTimeInterval carried = 3 * EST_ASSET_TEST_INTERVAL;
+    NSUInteger moves = self.moveCount;
+
+    for (NSUInteger s = 0; s < 30; s++)
+    {
+        ESTAssetObservation observation = { asset, ESTAssetTestObserver(1, 0), carried + s, -60 };
+        [self.index addObservation:observation];
+
+        if (s < self.index.dwellTime)
+        {
+            XCTAssertEqual([self.index roomOfAsset:asset confidence:NULL], ESTAssetTestRoom(0), @"Moved after %lu s", (unsigned long)s);
+        }
+    }
+
+    double confidence;
+
+    XCTAssertEqual([self.index roomOfAsset:asset confidence:&confidence], next);
+    XCTAssertGreaterThan(confidence, 0.5);
+    XCTAssertEqual(self.moveCount, moves + 1);
+    XCTAssertEqual(self.lastMoveTarget, next);
+}
+
+/*
+ * Steady state updates of 200k sightings per round.
+ */
+- (void)testUpdatePerformance
+{
+    [self addRoundAtTime:0];
+    [self.index.updateTime reset];
+
+    __block NSUInteger round = 1;
+
+    [self measureBlock:^{
+        [self addRoundAtTime:round++ * EST_ASSET_TEST_INTERVAL];
+    }];
+
+    ESTHDRHistogram *update = self.index.updateTime;
+
+    NSLog(@"ESTAssetLocationIndexTests: %.0f observations/s at %lu assets, mean %.0f ns",
+          1e9 / [update mean], (unsigned long)self.index.assetCount, [update mean]);
+}
+
+/*
+ * Listing every room, 500 assets each.
+ */
+- (void)testRoomQueryPerformance
+{
+    [self addRoundAtTime:0];
+
+    __block NSUInteger listed = 0;
+
+    [self measureBlock:^{
+        for (NSUInteger room = 0; room < EST_ASSET_TEST_ROOMS; room++)
+        {
+            [self.index enumerateAssetsInRoom:ESTAssetTestRoom(room) usingBlock:^(uint64_t asset, double confidence, BOOL *stop) {
+                listed++;
+            }];
+        }
+    }];
+
+    ESTHDRHistogram *query = self.index.queryTime;
+
+    NSLog(@"ESTAssetLocationIndexTests: room query p50 %llu ns, p99 %llu ns over %llu queries",
+          [query valueAtPercentile:50], [query valueAtPercentile:99], query.totalCount);
+
+    XCTAssertEqual(listed % EST_ASSET_TEST_ASSETS, (NSUInteger)0);
+}
+
+@end
@@ -0,0 +1,218 @@
+//
+//  ESTBeaconOperationPipelineTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTBeaconOperationPipeline.h"
+
+#define EST_PIPELINE_TEST_UUID      @"B9407F30-F5F8-466E-AFF9-25556B57FE6D"
+#define EST_PIPELINE_TEST_MAJOR     @(1201)
+#define EST_PIPELINE_TEST_MINOR     @(42)
+
+@interface ESTBeaconOperationPipelineTests : XCTestCase
+
+@property (nonatomic, strong) ESTMockBeaconBackend *backend;
+
+@end
+
+@implementation ESTBeaconOperationPipelineTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.backend = [ESTMockBeaconBackend new];
+}
+
+/*
+ * Ten operations configuring a beacon: identity first, major and minor after the
+ * UUID, the rest independent, then major read back once written.
+ */
+- (ESTFuture *)addRecipeToPipeline:(ESTBeaconOperationPipeline *)pipeline
+{
+    ESTFuture *uuid = [pipeline writeSetting:ESTBeaconSettingProximityUUID value:EST_PIPELINE_TEST_UUID];
+    ESTFuture *major = [pipeline writeSetting:ESTBeaconSettingMajor value:EST_PIPELINE_TEST_MAJOR after:@[ uuid ]];
+
+    [pipeline writeSetting:ESTBeaconSettingMinor value:EST_PIPELINE_TEST_MINOR after:@[ uuid ]];
+    [pipeline writeSetting:ESTBeaconSettingAdvInterval value:@(950)];
+    [pipeline writeSetting:ESTBeaconSettingPower value:@(-12)];
+    [pipeline writeSetting:ESTBeaconSettingName value:@"lobby"];
+    [pipeline writeSetting:ESTBeaconSettingEddystoneURL value:@"https://estimote.com"];
+    [pipeline writeSetting:ESTBeaconSettingSmartPowerMode value:@YES];
+    [pipeline writeSetting:ESTBeaconSettingMotionDetection value:@NO];
+
+    return [pipeline readSetting:ESTBeaconSettingMajor after:@[ major ]];
+}
+
+/*
+ * Runs the recipe to completion, returns seconds from the first issue.
+ */
+- (NSTimeInterval)runRecipeWithMaxInFlight:(NSUInteger)maxInFlight
+{
+    ESTBeaconOperationPipeline *pipeline = [[ESTBeaconOperationPipeline alloc] initWithBackend:self.backend];
+    pipeline.maxInFlight = maxInFlight;
+
+    XCTestExpectation *done = [self expectationWithDescription:@"recipe"];
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    __block CFAbsoluteTime end = 0;
+
+    [self addRecipeToPipeline:pipeline];
+
+    [[pipeline completion] whenComplete:^(id value, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual([value count], (NSUInteger)10);
+
+        end = CFAbsoluteTimeGetCurrent();
+        [done fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+
+    XCTAssertEqual(pipeline.inFlightCount, (NSUInteger)0);
+    XCTAssertEqual(pipeline.operationTime.totalCount, (uint64_t)10);
+
+    return end - start;
+}
+
+- (void)testRecipeAppliesEverySetting
+{
+    ESTBeaconOperationPipeline *pipeline = [[ESTBeaconOperationPipeline alloc] initWithBackend:self.backend];
+    XCTestExpectation *read = [self expectationWithDescription:@"read"];
+
+    [[self addRecipeToPipeline:pipeline] whenComplete:^(id value, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(value, EST_PIPELINE_TEST_MAJOR);
+        [read fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertEqualObjects(self.backend.settings[@(ESTBeaconSettingProximityUUID)], EST_PIPELINE_TEST_UUID);
+    XCTAssertEqualObjects(self.backend.settings[@(ESTBeaconSettingMinor)], EST_PIPELINE_TEST_MINOR);
+    XCTAssertEqual(self.backend.settings.count, (NSUInteger)9);
+}
+
+/*
+ * A failed write rejects its dependents without running them.
+ */
+- (void)testFailureRejectsDependents
+{
+    self.backend.failureRate = 1;
+
+    ESTBeaconOperationPipeline *pipeline = [[ESTBeaconOperationPipeline alloc] initWithBackend:self.backend];
+    ESTFuture *uuid = [pipeline writeSetting:ESTBeaconSettingProximityUUID value:EST_PIPELINE_TEST_UUID];
+    ESTFuture *major = [pipeline writeSetting:ESTBeaconSettingMajor value:EST_PIPELINE_TEST_MAJOR after:@[ uuid ]];
+
+    XCTestExpectation *rejected = [self expectationWithDescription:@"rejected"];
+
+    [major whenComplete:^(id value, NSError *error) {
+        XCTAssertEqualObjects(error.domain, ESTFutureErrorDomain);
+        XCTAssertEqual(error.code, (NSInteger)ESTFutureErrorDependencyFailed);
+        XCTAssertNotNil(error.userInfo[NSUnderlyingErrorKey]);
+        [rejected fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertEqual(pipeline.operationTime.totalCount, (uint64_t)1);
+    XCTAssertEqual(self.backend.settings.count, (NSUInteger)0);
+}
+
+/*
+ * A timed out operation is rejected at its timeout, and its dependents with it, but
+ * the request is still on the link: the slot stays taken until the backend answers,
+ * so the next operation starts only then.
+ */
+- (void)testTimeoutKeepsSlotUntilBackendCompletes
+{
+    self.backend.latency = 0.5;
+
+    ESTBeaconOperationPipeline *pipeline = [[ESTBeaconOperationPipeline alloc] initWithBackend:self.backend];
+    pipeline.maxInFlight = 1;
+
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    ESTFuture *slow = [pipeline writeSetting:ESTBeaconSettingName value:@"lobby" after:nil timeout:0.1];
+    ESTFuture *dependent = [pipeline writeSetting:ESTBeaconSettingMajor value:EST_PIPELINE_TEST_MAJOR after:@[ slow ]];
+    ESTFuture *next = [pipeline writeSetting:ESTBeaconSettingMinor value:EST_PIPELINE_TEST_MINOR];
+
+    XCTestExpectation *timedOut = [self expectationWithDescription:@"timed out"];
+
+    [slow whenComplete:^(id value, NSError *error) {
+        XCTAssertEqual(error.code, (NSInteger)ESTFutureErrorTimeout);
+        XCTAssertLessThan(CFAbsoluteTimeGetCurrent() - start, self.backend.latency);
+        [timedOut fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertEqual(dependent.error.code, (NSInteger)ESTFutureErrorDependencyFailed);
+    XCTAssertFalse(next.resolved);
+    XCTAssertEqual(pipeline.inFlightCount, (NSUInteger)1);
+    XCTAssertEqual(pipeline.pendingCount, (NSUInteger)1);
+
+    XCTestExpectation *written = [self expectationWithDescription:@"written"];
+
+    [next whenComplete:^(id value, NSError *error) {
+        XCTAssertNil(error);
+        [written fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    // Issued only after the slow write came back, so it paid two round trips.
+    XCTAssertGreaterThanOrEqual(CFAbsoluteTimeGetCurrent() - start, 2 * self.backend.latency);
+    XCTAssertEqual(pipeline.inFlightCount, (NSUInteger)0);
+    XCTAssertEqual(pipeline.operationTime.totalCount, (uint64_t)2);
+
+    // The late response still reached the beacon, the pipeline dropped it.
+    XCTAssertEqualObjects(self.backend.settings[@(ESTBeaconSettingName)], @"lobby");
+    XCTAssertNil(self.backend.settings[@(ESTBeaconSettingMajor)]);
+}
+
+- (void)testCancelDropsOperationsNotStarted
+{
+    ESTBeaconOperationPipeline *pipeline = [[ESTBeaconOperationPipeline alloc] initWithBackend:self.backend];
+    pipeline.maxInFlight = 1;
+
+    ESTFuture *first = [pipeline writeSetting:ESTBeaconSettingName value:@"lobby"];
+    ESTFuture *second = [pipeline writeSetting:ESTBeaconSettingPower value:@(-12)];
+
+    XCTAssertTrue([second cancel]);
+
+    XCTestExpectation *written = [self expectationWithDescription:@"written"];
+
+    [first whenComplete:^(id value, NSError *error) {
+        [written fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertEqual(second.error.code, (NSInteger)ESTFutureErrorCancelled);
+    XCTAssertEqual(pipeline.pendingCount, (NSUInteger)0);
+    XCTAssertNil(self.backend.settings[@(ESTBeaconSettingPower)]);
+}
+
+/*
+ * End-to-end time of the recipe on the default mock link, 7.5 ms per request and
+ * 100 ms round trip, against the same recipe serialized like nested completions.
+ */
+- (void)testRecipePerformance
+{
+    __block NSTimeInterval pipelined = 0;
+
+    [self measureBlock:^{
+        pipelined = [self runRecipeWithMaxInFlight:4];
+    }];
+
+    NSTimeInterval serialized = [self runRecipeWithMaxInFlight:1];
+
+    NSLog(@"ESTBeaconOperationPipelineTests: 10 operations in %.0f ms pipelined, %.0f ms serialized", pipelined * 1000, serialized * 1000);
+
+    XCTAssertLessThan(pipelined, serialized);
+}
+
+@end
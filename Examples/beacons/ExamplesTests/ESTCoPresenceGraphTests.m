@@ -0,0 +1,160 @@
+//
+//  ESTCoPresenceGraphTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTCoPresenceGraph.h"
+#import "ESTTestRandom.h"
+
+#define EST_COPRESENCE_TEST_INTERVAL    60.0
+
+static inline uint64_t ESTCoPresenceTestDevice(NSUInteger device)
+{
+    return 0xC0B5000000000000ULL + device + 1;
+}
+
+/*
+ * Devices travel in pairs (2k, 2k + 1): a window sees a random share of the pairs,
+ * both devices of each, plus unpaired strays.
+ */
+@interface ESTCoPresenceGraphTests : XCTestCase
+
+@end
+
+@implementation ESTCoPresenceGraphTests
+
+/*
+ * NSData of windowCount * windowSize identity hashes out of deviceCount devices.
+ */
+- (NSData *)windowsOfSize:(NSUInteger)windowSize count:(NSUInteger)windowCount devices:(NSUInteger)deviceCount
+{
+    NSMutableData *windows = [NSMutableData dataWithLength:windowSize * windowCount * sizeof(uint64_t)];
+    uint64_t *hashes = windows.mutableBytes;
+    uint64_t state = EST_TEST_SEED;
+
+    for (NSUInteger w = 0; w < windowCount; w++)
+    {
+        uint64_t *window = hashes + w * windowSize;
+
+        // Nine in ten slots are pairs, the rest single devices.
+        for (NSUInteger i = 0; i + 1 < windowSize * 9 / 10; i += 2)
+        {
+            NSUInteger pair = (NSUInteger)(ESTTestRandom(&state) * deviceCount / 2);
+            window[i] = ESTCoPresenceTestDevice(pair * 2);
+            window[i + 1] = ESTCoPresenceTestDevice(pair * 2 + 1);
+        }
+
+        for (NSUInteger i = windowSize * 9 / 10 & ~(NSUInteger)1; i < windowSize; i++)
+        {
+            window[i] = ESTCoPresenceTestDevice((NSUInteger)(ESTTestRandom(&state) * deviceCount));
+        }
+    }
+
+    return windows;
+}
+
+/*
+ * Windows one minute apart, continuing from window first.
+ */
+- (void)addWindows:(NSData *)windows size:(NSUInteger)windowSize toGraph:(ESTCoPresenceGraph *)graph first:(NSUInteger)first
+{
+    const uint64_t *hashes = windows.bytes;
+    NSUInteger windowCount = windows.length / sizeof(uint64_t) / windowSize;
+
+    for (NSUInteger w = 0; w < windowCount; w++)
+    {
+        [graph addScanWindowWithIdentityHashes:hashes + w * windowSize count:windowSize timestamp:(first + w) * EST_COPRESENCE_TEST_INTERVAL];
+    }
+}
+
+- (ESTCoPresenceGraph *)graphWithWindows:(NSData *)windows size:(NSUInteger)windowSize maxNeighbors:(NSUInteger)maxNeighbors
+{
+    ESTCoPresenceGraph *graph = [ESTCoPresenceGraph new];
+    graph.maxNeighbors = maxNeighbors;
+
+    [self addWindows:windows size:windowSize toGraph:graph first:0];
+
+    return graph;
+}
+
+/*
+ * Returns the share of seen devices whose strongest neighbor is their partner.
+ */
+- (double)partnerShareOfGraph:(ESTCoPresenceGraph *)graph devices:(NSUInteger)deviceCount
+{
+    NSUInteger seen = 0;
+    NSUInteger partnered = 0;
+
+    for (NSUInteger d = 0; d < deviceCount; d++)
+    {
+        ESTCoPresenceNeighbor *top = [[graph topNeighborsOfIdentityHash:ESTCoPresenceTestDevice(d) count:1] firstObject];
+
+        if (top)
+        {
+            seen++;
+            partnered += top.identityHash == ESTCoPresenceTestDevice(d ^ 1);
+        }
+    }
+
+    return seen ? (double)partnered / seen : 0;
+}
+
+- (void)testPartnersAreStrongestNeighbors
+{
+    NSData *windows = [self windowsOfSize:200 count:300 devices:2000];
+    ESTCoPresenceGraph *graph = [self graphWithWindows:windows size:200 maxNeighbors:256];
+
+    double share = [self partnerShareOfGraph:graph devices:2000];
+
+    NSLog(@"ESTCoPresenceGraphTests: %.3f of devices have their partner on top, %lu entries", share, (unsigned long)graph.entryCount);
+
+    XCTAssertGreaterThan(share, 0.99);
+}
+
+/*
+ * After a quiet period with small windows, dense windows overflow every row. Pruning
+ * keeps rows bounded and keeps the partners, whose weight has built up.
+ */
+- (void)testPruningKeepsPartners
+{
+    ESTCoPresenceGraph *graph = [self graphWithWindows:[self windowsOfSize:20 count:1000 devices:2000] size:20 maxNeighbors:16];
+
+    [self addWindows:[self windowsOfSize:500 count:100 devices:2000] size:500 toGraph:graph first:1000];
+
+    XCTAssertLessThanOrEqual(graph.entryCount, graph.deviceCount * 2 * 16);
+    XCTAssertGreaterThan([self partnerShareOfGraph:graph devices:2000], 0.99);
+
+    for (NSUInteger d = 0; d < 2000; d += 2)
+    {
+        uint64_t device = ESTCoPresenceTestDevice(d);
+        uint64_t partner = ESTCoPresenceTestDevice(d + 1);
+
+        XCTAssertEqual([graph weightBetweenIdentityHash:device andIdentityHash:partner],
+                       [graph weightBetweenIdentityHash:partner andIdentityHash:device]);
+    }
+}
+
+/*
+ * 20k devices, windows of 2000 of them, rows pruned at the default 256 neighbors.
+ */
+- (void)testDenseWindowPerformance
+{
+    NSData *windows = [self windowsOfSize:2000 count:50 devices:20000];
+    __block ESTCoPresenceGraph *graph;
+
+    [self measureBlock:^{
+        graph = [self graphWithWindows:windows size:2000 maxNeighbors:256];
+    }];
+
+    NSLog(@"ESTCoPresenceGraphTests: %lu devices, %lu entries after 50 windows of 2000",
+          (unsigned long)graph.deviceCount, (unsigned long)graph.entryCount);
+
+    // Pairs are drawn at random, a few are never seen.
+    XCTAssertGreaterThan(graph.deviceCount, (NSUInteger)19000);
+}
+
+@end
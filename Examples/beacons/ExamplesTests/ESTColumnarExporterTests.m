@@ -0,0 +1,161 @@
+//
+//  ESTColumnarExporterTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTColumnarExporter.h"
+#import "ESTTestRandom.h"
+
+#define EST_EXPORT_TEST_DEVICES     1000
+#define EST_EXPORT_TEST_SECONDS     600
+#define EST_EXPORT_TEST_VARIANTS    8
+
+/*
+ * CLBeacon with settable values, ranging results cannot be created otherwise.
+ */
+@interface ESTExportTestBeacon : CLBeacon
+
+@property (nonatomic, strong) NSUUID *proximityUUID;
+@property (nonatomic, strong) NSNumber *major;
+@property (nonatomic, strong) NSNumber *minor;
+@property (nonatomic, assign) CLProximity proximity;
+@property (nonatomic, assign) CLLocationAccuracy accuracy;
+@property (nonatomic, assign) NSInteger rssi;
+
+@end
+
+@implementation ESTExportTestBeacon
+
+@synthesize proximityUUID = _testProximityUUID;
+@synthesize major = _testMajor;
+@synthesize minor = _testMinor;
+@synthesize proximity = _testProximity;
+@synthesize accuracy = _testAccuracy;
+@synthesize rssi = _testRSSI;
+
+@end
+
+@interface ESTColumnarExporterTests : XCTestCase
+
+/*
+ * EST_EXPORT_TEST_VARIANTS arrays of one ranged beacon per device, differing in
+ * signal, so consecutive seconds do not repeat the same row.
+ */
+@property (nonatomic, strong) NSArray *rangingVariants;
+@property (nonatomic, copy) NSString *directory;
+
+@end
+
+@implementation ESTColumnarExporterTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    NSUUID *uuid = [[NSUUID alloc] initWithUUIDString:@"B9407F30-F5F8-466E-AFF9-25556B57FE6D"];
+    NSMutableArray *variants = [NSMutableArray arrayWithCapacity:EST_EXPORT_TEST_VARIANTS];
+    uint64_t state = EST_TEST_SEED;
+
+    for (NSUInteger v = 0; v < EST_EXPORT_TEST_VARIANTS; v++)
+    {
+        NSMutableArray *beacons = [NSMutableArray arrayWithCapacity:EST_EXPORT_TEST_DEVICES];
+
+        for (NSUInteger d = 0; d < EST_EXPORT_TEST_DEVICES; d++)
+        {
+            ESTExportTestBeacon *beacon = [ESTExportTestBeacon new];
+            beacon.proximityUUID = uuid;
+            beacon.major = @(d / 100 + 1);
+            beacon.minor = @(d % 100 + 1);
+            beacon.rssi = -50 - (NSInteger)(ESTTestRandom(&state) * 45);
+            beacon.accuracy = pow(10, (-59.0 - beacon.rssi) / 20);
+            beacon.proximity = beacon.accuracy < 1 ? CLProximityNear : CLProximityFar;
+
+            [beacons addObject:beacon];
+        }
+
+        [variants addObject:beacons];
+    }
+
+    self.rangingVariants = variants;
+    self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.directory error:NULL];
+
+    [super tearDown];
+}
+
+- (void)closeExporter:(ESTColumnarExporter *)exporter
+{
+    XCTestExpectation *closed = [self expectationWithDescription:@"closed"];
+
+    [exporter closeWithCompletion:^(NSError *error) {
+        XCTAssertNil(error);
+        [closed fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:60 handler:nil];
+}
+
+/*
+ * A full writer queue drops whole batches, every recorded row is either written or
+ * counted as dropped.
+ */
+- (void)testDroppedRowsAreCounted
+{
+    ESTColumnarExporter *exporter = [[ESTColumnarExporter alloc] initWithDirectory:self.directory
+                                                                      rowGroupSize:100
+                                                                 maxPendingBatches:1];
+
+    for (NSUInteger second = 0; second < 50; second++)
+    {
+        [exporter recordRangedBeacons:self.rangingVariants[second % EST_EXPORT_TEST_VARIANTS] timestamp:second];
+    }
+
+    [self closeExporter:exporter];
+
+    XCTAssertEqual(exporter.rowCount + exporter.droppedRowCount, (uint64_t)(50 * EST_EXPORT_TEST_DEVICES));
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:[self.directory stringByAppendingPathComponent:@"ranging.parquet"]]);
+}
+
+/*
+ * Ten minutes of 1 Hz ranging of 1000 devices. Reports writer throughput and the
+ * file size a day of the same data would take.
+ */
+- (void)testRangingExportPerformance
+{
+    __block ESTColumnarExporter *exporter;
+    __block NSUInteger run = 0;
+
+    [self measureBlock:^{
+        NSString *directory = [self.directory stringByAppendingPathComponent:[NSString stringWithFormat:@"%lu", (unsigned long)run++]];
+
+        // Enough pending batches for the whole run, so throughput is not hidden by drops.
+        exporter = [[ESTColumnarExporter alloc] initWithDirectory:directory rowGroupSize:16384 maxPendingBatches:64];
+
+        for (NSUInteger second = 0; second < EST_EXPORT_TEST_SECONDS; second++)
+        {
+            [exporter recordRangedBeacons:self.rangingVariants[second % EST_EXPORT_TEST_VARIANTS]
+                                timestamp:[NSDate timeIntervalSinceReferenceDate] + second];
+        }
+
+        [self closeExporter:exporter];
+    }];
+
+    uint64_t rows = (uint64_t)EST_EXPORT_TEST_SECONDS * EST_EXPORT_TEST_DEVICES;
+    double bytesPerRow = (double)exporter.bytesWritten / exporter.rowCount;
+
+    NSLog(@"ESTColumnarExporterTests: %.0f rows/s, %.2f bytes/row, %.1f MB per day of %d devices",
+          1e9 / [exporter.writeTime mean], bytesPerRow, bytesPerRow * 86400 * EST_EXPORT_TEST_DEVICES / 1e6, EST_EXPORT_TEST_DEVICES);
+
+    XCTAssertEqual(exporter.rowCount, rows);
+    XCTAssertEqual(exporter.droppedRowCount, (uint64_t)0);
+}
+
+@end
@@ -0,0 +1,288 @@
+//
+//  ESTConfigAuditorTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTConfigAuditor.h"
+#import "ESTTestRandom.h"
+
+#define EST_AUDIT_TEST_FLEET            3000
+#define EST_AUDIT_TEST_PACKETS          40
+#define EST_AUDIT_TEST_LOSS             0.2
+#define EST_AUDIT_TEST_DUPLICATES       0.1
+#define EST_AUDIT_TEST_MEASURED_POWER   -74
+
+// Eddystone frames carry power at 0 m, 41 dB above the iBeacon 1 m value.
+#define EST_AUDIT_TEST_EDDYSTONE_SHIFT  41
+
+typedef NS_ENUM(NSUInteger, ESTAuditTestDrift)
+{
+    ESTAuditTestDriftNone,
+    ESTAuditTestDriftScheme,
+    ESTAuditTestDriftIdentity,
+    ESTAuditTestDriftInterval,
+    ESTAuditTestDriftPower,
+    ESTAuditTestDriftFirmware,
+    ESTAuditTestDriftUnseen,
+    ESTAuditTestDriftCount
+};
+
+/*
+ * Packet as a beacon of the fleet would advertise it with the injected drift, an
+ * ESTBluetoothBeacon or an ESTEddystone.
+ */
+static id ESTAuditTestPacket(ESTBeaconVO *beacon, ESTAuditTestDrift drift, NSDate *date)
+{
+    BOOL eddystone = beacon.broadcastingScheme == ESTBroadcastingSchemeEddystoneUID
+                  || beacon.broadcastingScheme == ESTBroadcastingSchemeEddystoneURL;
+    NSInteger shift = drift == ESTAuditTestDriftPower ? 6 : 0;
+
+    // Scheme drift swaps iBeacon and Eddystone, bootloader advertises plain Bluetooth packets.
+    if (drift == ESTAuditTestDriftFirmware || eddystone == (drift == ESTAuditTestDriftScheme))
+    {
+        ESTBluetoothBeacon *packet = [ESTBluetoothBeacon new];
+        packet.macAddress = beacon.macAddress;
+        packet.major = beacon.major;
+        packet.minor = drift == ESTAuditTestDriftIdentity ? @([beacon.minor unsignedShortValue] ^ 1) : beacon.minor;
+        packet.measuredPower = @(EST_AUDIT_TEST_MEASURED_POWER + shift);
+        packet.discoveryDate = date;
+        packet.rssi = -70;
+        packet.firmwareState = drift == ESTAuditTestDriftFirmware ? ESTBeaconFirmwareStateBoot : ESTBeaconFirmwareStateApp;
+
+        return packet;
+    }
+
+    ESTEddystone *packet = [ESTEddystone new];
+    packet.macAddress = beacon.macAddress;
+    packet.measuredPower = @(EST_AUDIT_TEST_MEASURED_POWER + EST_AUDIT_TEST_EDDYSTONE_SHIFT + shift);
+    packet.discoveryDate = date;
+    packet.rssi = @(-70);
+
+    if (beacon.broadcastingScheme == ESTBroadcastingSchemeEddystoneURL && drift != ESTAuditTestDriftScheme)
+    {
+        packet.url = drift == ESTAuditTestDriftIdentity ? [beacon.eddystoneURL stringByAppendingString:@"x"] : beacon.eddystoneURL;
+    }
+    else
+    {
+        packet.namespaceID = beacon.eddystoneNamespaceID ?: @"EDD1EBEAC04E5DEFA017";
+        packet.instanceID = drift == ESTAuditTestDriftIdentity ? @"000000000000" : (beacon.eddystoneInstanceID ?: @"000000000001");
+    }
+
+    return packet;
+}
+
+/*
+ * Fields the auditor should report as drifted for the injected drift.
+ */
+static ESTConfigField ESTAuditTestExpectedDrift(ESTBeaconVO *beacon, ESTAuditTestDrift drift)
+{
+    switch (drift)
+    {
+        case ESTAuditTestDriftScheme:
+            return ESTConfigFieldBroadcastingScheme;
+
+        case ESTAuditTestDriftIdentity:
+            switch (beacon.broadcastingScheme)
+            {
+                case ESTBroadcastingSchemeEddystoneUID:
+                    return ESTConfigFieldEddystoneUID;
+
+                case ESTBroadcastingSchemeEddystoneURL:
+                    return ESTConfigFieldEddystoneURL;
+
+                default:
+                    return ESTConfigFieldMajorMinor;
+            }
+
+        case ESTAuditTestDriftInterval:
+            return ESTConfigFieldAdvInterval;
+
+        case ESTAuditTestDriftPower:
+            return ESTConfigFieldPower;
+
+        case ESTAuditTestDriftFirmware:
+            // Bootloader packets are plain Bluetooth ones, an Eddystone beacon also loses its scheme.
+            return ESTConfigFieldFirmwareState
+                 | (beacon.broadcastingScheme == ESTBroadcastingSchemeIBeacon ? ESTConfigFieldNone : ESTConfigFieldBroadcastingScheme);
+
+        default:
+            return ESTConfigFieldNone;
+    }
+}
+
+/*
+ * Simulated fleet of iBeacon, Eddystone-UID and Eddystone-URL beacons, about half of
+ * them with one injected drift or out of range. Packets come with advertising jitter,
+ * loss and duplicate deliveries, fed to the auditor in one second discovery callbacks.
+ */
+@interface ESTConfigAuditorTests : XCTestCase
+
+@property (nonatomic, strong) NSArray *fleet;
+@property (nonatomic, strong) NSData *drifts;
+@property (nonatomic, strong) NSArray *packets;
+
+@end
+
+@implementation ESTConfigAuditorTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    const ESTBroadcastingScheme schemes[3] = { ESTBroadcastingSchemeIBeacon, ESTBroadcastingSchemeEddystoneUID, ESTBroadcastingSchemeEddystoneURL };
+    const NSInteger intervals[3] = { 100, 300, 950 };
+
+    uint64_t state = EST_TEST_SEED;
+    NSMutableArray *fleet = [NSMutableArray arrayWithCapacity:EST_AUDIT_TEST_FLEET];
+    NSMutableData *driftData = [NSMutableData dataWithLength:EST_AUDIT_TEST_FLEET * sizeof(ESTAuditTestDrift)];
+    ESTAuditTestDrift *drifts = driftData.mutableBytes;
+
+    for (NSUInteger i = 0; i < EST_AUDIT_TEST_FLEET; i++)
+    {
+        ESTBeaconVO *beacon = [ESTBeaconVO new];
+        beacon.macAddress = [NSString stringWithFormat:@"%012llx", 0xD0A000000000ULL + i];
+        beacon.broadcastingScheme = schemes[i % 3];
+        beacon.proximityUUID = @"B9407F30-F5F8-466E-AFF9-25556B57FE6D";
+        beacon.major = @(i / 65536 + 1);
+        beacon.minor = @(i % 65536);
+        beacon.eddystoneNamespaceID = @"EDD1EBEAC04E5DEFA017";
+        beacon.eddystoneInstanceID = [NSString stringWithFormat:@"%012lx", (unsigned long)i + 1];
+        beacon.eddystoneURL = [NSString stringWithFormat:@"https://est.io/%lu", (unsigned long)i];
+        beacon.power = ESTBeaconPowerLevel4;
+        beacon.advInterval = intervals[(i / 3) % 3];
+        [fleet addObject:beacon];
+
+        // Half clean, the rest spread over the drift kinds.
+        drifts[i] = ESTTestRandom(&state) < 0.5 ? ESTAuditTestDriftNone
+                  : 1 + (ESTAuditTestDrift)(ESTTestRandom(&state) * (ESTAuditTestDriftCount - 1));
+    }
+
+    NSMutableArray *packets = [NSMutableArray array];
+    NSTimeInterval start = 500000000;
+
+    for (NSUInteger i = 0; i < EST_AUDIT_TEST_FLEET; i++)
+    {
+        ESTBeaconVO *beacon = fleet[i];
+
+        if (drifts[i] == ESTAuditTestDriftUnseen)
+        {
+            continue;
+        }
+
+        NSTimeInterval interval = beacon.advInterval / 1000.0 * (drifts[i] == ESTAuditTestDriftInterval ? 2 : 1);
+        NSTimeInterval offset = ESTTestRandom(&state);
+
+        for (NSUInteger k = 0; k < EST_AUDIT_TEST_PACKETS; k++)
+        {
+            if (ESTTestRandom(&state) < EST_AUDIT_TEST_LOSS)
+            {
+                continue;
+            }
+
+            // Advertising delay of up to 10 ms on top of the interval, as BLE adds it.
+            NSTimeInterval time = start + offset + k * interval + ESTTestRandom(&state) * 0.01;
+            [packets addObject:ESTAuditTestPacket(beacon, drifts[i], [NSDate dateWithTimeIntervalSinceReferenceDate:time])];
+
+            if (ESTTestRandom(&state) < EST_AUDIT_TEST_DUPLICATES)
+            {
+                [packets addObject:ESTAuditTestPacket(beacon, drifts[i], [NSDate dateWithTimeIntervalSinceReferenceDate:time + 0.001])];
+            }
+        }
+    }
+
+    [packets sortUsingComparator:^NSComparisonResult(id left, id right) {
+        return [[left discoveryDate] compare:[right discoveryDate]];
+    }];
+
+    self.fleet = fleet;
+    self.drifts = driftData;
+    self.packets = packets;
+}
+
+- (ESTConfigAuditor *)auditedFleet
+{
+    ESTConfigAuditor *auditor = [[ESTConfigAuditor alloc] initWithFleet:self.fleet];
+    [auditor setExpectedMeasuredPower:EST_AUDIT_TEST_MEASURED_POWER forPower:ESTBeaconPowerLevel4];
+
+    NSMutableArray *bluetoothBeacons = [NSMutableArray array];
+    NSMutableArray *eddystones = [NSMutableArray array];
+    NSTimeInterval windowEnd = floor([[self.packets.firstObject discoveryDate] timeIntervalSinceReferenceDate]) + 1;
+
+    for (NSUInteger p = 0; p <= self.packets.count; p++)
+    {
+        id packet = p < self.packets.count ? self.packets[p] : nil;
+
+        if (!packet || [[packet discoveryDate] timeIntervalSinceReferenceDate] >= windowEnd)
+        {
+            [auditor processBluetoothBeacons:bluetoothBeacons];
+            [auditor processEddystones:eddystones];
+            [bluetoothBeacons removeAllObjects];
+            [eddystones removeAllObjects];
+            windowEnd = floor([[packet discoveryDate] timeIntervalSinceReferenceDate]) + 1;
+        }
+
+        if ([packet isKindOfClass:[ESTBluetoothBeacon class]])
+        {
+            [bluetoothBeacons addObject:packet];
+        }
+        else if (packet)
+        {
+            [eddystones addObject:packet];
+        }
+    }
+
+    return auditor;
+}
+
+- (void)testReportsMatchInjectedDrift
+{
+    ESTConfigAuditor *auditor = [self auditedFleet];
+    const ESTAuditTestDrift *drifts = self.drifts.bytes;
+    NSArray *reports = [auditor reports];
+
+    for (NSUInteger i = 0; i < self.fleet.count; i++)
+    {
+        ESTConfigAuditReport *report = reports[i];
+        ESTConfigField expected = ESTAuditTestExpectedDrift(self.fleet[i], drifts[i]);
+
+        XCTAssertEqual(report.seen, (BOOL)(drifts[i] != ESTAuditTestDriftUnseen), @"Beacon %lu, drift %lu", (unsigned long)i, (unsigned long)drifts[i]);
+        XCTAssertEqual(report.driftedFields, expected, @"Beacon %lu, drift %lu: %@", (unsigned long)i, (unsigned long)drifts[i], report);
+    }
+}
+
+/*
+ * Every clean beacon is verified from its advertisements alone, every drifted one
+ * in range needs a connection.
+ */
+- (void)testConnectionsAvoided
+{
+    ESTConfigAuditor *auditor = [self auditedFleet];
+    const ESTAuditTestDrift *drifts = self.drifts.bytes;
+    NSUInteger clean = 0;
+    NSUInteger unseen = 0;
+
+    for (NSUInteger i = 0; i < self.fleet.count; i++)
+    {
+        clean += drifts[i] == ESTAuditTestDriftNone ? 1 : 0;
+        unseen += drifts[i] == ESTAuditTestDriftUnseen ? 1 : 0;
+    }
+
+    NSLog(@"ESTConfigAuditorTests: %lu of %lu connections avoided, %lu beacons need one",
+          (unsigned long)auditor.connectionsAvoided, (unsigned long)self.fleet.count, (unsigned long)[auditor beaconsNeedingConnection].count);
+
+    XCTAssertEqual(auditor.connectionsAvoided, clean);
+    XCTAssertEqual([auditor beaconsNeedingConnection].count, self.fleet.count - clean - unseen);
+}
+
+- (void)testAuditPerformance
+{
+    [self measureBlock:^{
+        [self auditedFleet];
+    }];
+}
+
+@end
@@ -0,0 +1,275 @@
+//
+//  ESTDeadReckoningFilterTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTDeadReckoningFilter.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTTestRandom.h"
+
+#define EST_WALK_TEST_WIDTH         20.0
+#define EST_WALK_TEST_HEIGHT        10.0
+#define EST_WALK_TEST_RATE          50.0
+#define EST_WALK_TEST_CADENCE       1.8
+#define EST_WALK_TEST_STEP          0.7
+#define EST_WALK_TEST_MIN_RANGE     0.1
+
+typedef NS_ENUM(uint32_t, ESTWalkEventType)
+{
+    ESTWalkEventTypeMotion,
+    ESTWalkEventTypeRange,
+    ESTWalkEventTypePositionFix,
+
+    /*
+     * Scored against the last reported position.
+     */
+    ESTWalkEventTypeGroundTruth
+};
+
+/*
+ * Trace event. Motion events use motion, ranges identityHash and value (m),
+ * position fixes x, y and value (accuracy) and ground truth x and y.
+ */
+typedef struct
+{
+    ESTWalkEventType type;
+    ESTMotionSample motion;
+    uint64_t identityHash;
+    double x;
+    double y;
+    double value;
+} ESTWalkEvent;
+
+/*
+ * Feeds a trace in order through the live entry points, ground truth goes to
+ * recordErrorWithTrueX:y:, so positionError and processingTime describe the replay.
+ */
+static void ESTWalkReplay(ESTDeadReckoningFilter *filter, NSData *trace)
+{
+    const ESTWalkEvent *events = trace.bytes;
+    NSUInteger count = trace.length / sizeof(ESTWalkEvent);
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        const ESTWalkEvent *event = &events[i];
+
+        switch (event->type)
+        {
+            case ESTWalkEventTypeMotion:
+                [filter processMotionSample:event->motion];
+                break;
+
+            case ESTWalkEventTypeRange:
+                [filter processRange:event->value toBeaconWithIdentityHash:event->identityHash];
+                break;
+
+            case ESTWalkEventTypePositionFix:
+                [filter processPositionFixWithX:event->x y:event->y accuracy:event->value];
+                break;
+
+            case ESTWalkEventTypeGroundTruth:
+                if (filter.initialized)
+                {
+                    [filter recordErrorWithTrueX:event->x y:event->y];
+                }
+                break;
+        }
+    }
+}
+
+static const double ESTWalkCorners[4][2] = { { 0, 0 }, { 0, EST_WALK_TEST_HEIGHT },
+                                              { EST_WALK_TEST_WIDTH, EST_WALK_TEST_HEIGHT }, { EST_WALK_TEST_WIDTH, 0 } };
+
+static inline uint64_t ESTWalkBeacon(NSUInteger corner)
+{
+    return ESTBeaconIdentityHashIBeacon(nil, 2, (uint16_t)corner);
+}
+
+/*
+ * Position and heading after walking distance along the rectangle, clockwise from (0, 0).
+ */
+static void ESTWalkPosition(double distance, double *x, double *y, double *heading)
+{
+    double perimeter = 2 * (EST_WALK_TEST_WIDTH + EST_WALK_TEST_HEIGHT);
+    double d = fmod(distance, perimeter);
+
+    if (d < EST_WALK_TEST_HEIGHT)
+    {
+        *x = 0; *y = d; *heading = 0;
+    }
+    else if ((d -= EST_WALK_TEST_HEIGHT) < EST_WALK_TEST_WIDTH)
+    {
+        *x = d; *y = EST_WALK_TEST_HEIGHT; *heading = M_PI_2;
+    }
+    else if ((d -= EST_WALK_TEST_WIDTH) < EST_WALK_TEST_HEIGHT)
+    {
+        *x = EST_WALK_TEST_WIDTH; *y = EST_WALK_TEST_HEIGHT - d; *heading = M_PI;
+    }
+    else
+    {
+        d -= EST_WALK_TEST_HEIGHT;
+        *x = EST_WALK_TEST_WIDTH - d; *y = 0; *heading = 3 * M_PI_2;
+    }
+}
+
+@interface ESTDeadReckoningFilterTests : XCTestCase
+
+@property (nonatomic, strong) ESTDeadReckoningFilter *filter;
+
+@end
+
+@implementation ESTDeadReckoningFilterTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.filter = [self filterWithCornerBeacons];
+}
+
+- (ESTDeadReckoningFilter *)filterWithCornerBeacons
+{
+    ESTDeadReckoningFilter *filter = [ESTDeadReckoningFilter new];
+
+    for (NSUInteger b = 0; b < 4; b++)
+    {
+        [filter addBeaconWithIdentityHash:ESTWalkBeacon(b) x:ESTWalkCorners[b][0] y:ESTWalkCorners[b][1] measuredPower:-59];
+    }
+
+    return filter;
+}
+
+- (NSTimeInterval)walkTimeForLaps:(NSUInteger)laps
+{
+    return laps * 2 * (EST_WALK_TEST_WIDTH + EST_WALK_TEST_HEIGHT) / (EST_WALK_TEST_CADENCE * EST_WALK_TEST_STEP);
+}
+
+/*
+ * Laps around a 20 x 10 m rectangle with beacons in its corners: 50 Hz motion with
+ * 1.8 Hz steps of ~0.7 m, a 0.1 rad heading offset and heading noise, ranges to every
+ * beacon each second with 20% noise and ground truth every 0.1 s. The walk starts
+ * after one second and ends with stillTime seconds of standing.
+ */
+- (NSData *)walkTraceWithLaps:(NSUInteger)laps stillTime:(NSTimeInterval)stillTime
+{
+    double speed = EST_WALK_TEST_CADENCE * EST_WALK_TEST_STEP;
+    NSTimeInterval walkTime = [self walkTimeForLaps:laps];
+    NSUInteger samples = (NSUInteger)((1.0 + walkTime + stillTime) * EST_WALK_TEST_RATE);
+
+    NSMutableData *trace = [NSMutableData data];
+    uint64_t state = EST_TEST_SEED;
+
+    ESTWalkEvent fix = { ESTWalkEventTypePositionFix, { 0 }, 0, 0, 0, 1.0 };
+    [trace appendBytes:&fix length:sizeof(fix)];
+
+    for (NSUInteger i = 0; i < samples; i++)
+    {
+        NSTimeInterval t = i / EST_WALK_TEST_RATE;
+        NSTimeInterval walked = MIN(MAX(t - 1.0, 0.0), walkTime);
+        BOOL walking = t >= 1.0 && t - 1.0 < walkTime;
+
+        double x, y, heading;
+        ESTWalkPosition(walked * speed, &x, &y, &heading);
+
+        // Vertical bounce of 0.25 g at the cadence while walking.
+        double acceleration = walking ? 0.25 * sin(2 * M_PI * EST_WALK_TEST_CADENCE * (t - 1.0)) : 0;
+        acceleration += (ESTTestRandom(&state) - 0.5) * 0.04;
+
+        ESTWalkEvent motion = { ESTWalkEventTypeMotion };
+        motion.motion.timestamp = t;
+        motion.motion.verticalAcceleration = (float)acceleration;
+        motion.motion.heading = (float)fmod(heading + 0.1 + (ESTTestRandom(&state) - 0.5) * 0.1 + 2 * M_PI, 2 * M_PI);
+        [trace appendBytes:&motion length:sizeof(motion)];
+
+        if (i % (NSUInteger)EST_WALK_TEST_RATE == 0)
+        {
+            for (NSUInteger b = 0; b < 4; b++)
+            {
+                double range = hypot(x - ESTWalkCorners[b][0], y - ESTWalkCorners[b][1]);
+
+                ESTWalkEvent event = { ESTWalkEventTypeRange, { 0 }, ESTWalkBeacon(b), 0, 0, 0 };
+                event.value = MAX(range * (1 + (ESTTestRandom(&state) - 0.5) * 0.4), EST_WALK_TEST_MIN_RANGE);
+                [trace appendBytes:&event length:sizeof(event)];
+            }
+        }
+
+        if (i % (NSUInteger)(EST_WALK_TEST_RATE / 10) == 0)
+        {
+            ESTWalkEvent truth = { ESTWalkEventTypeGroundTruth, { 0 }, 0, x, y, 0 };
+            [trace appendBytes:&truth length:sizeof(truth)];
+        }
+    }
+
+    return trace;
+}
+
+- (void)testStepsMatchCadence
+{
+    ESTWalkReplay(self.filter, [self walkTraceWithLaps:2 stillTime:5]);
+
+    double expected = [self walkTimeForLaps:2] * EST_WALK_TEST_CADENCE;
+
+    XCTAssertEqualWithAccuracy((double)self.filter.stepCount, expected, 2.0);
+}
+
+- (void)testWalkAccuracy
+{
+    ESTWalkReplay(self.filter, [self walkTraceWithLaps:3 stillTime:0]);
+
+    ESTHDRHistogram *error = self.filter.positionError;
+
+    NSLog(@"ESTDeadReckoningFilterTests: error p50 %.2f m, p95 %.2f m, max %.2f m, %lu corrections accepted, %lu rejected",
+          [error valueAtPercentile:50] / 100.0, [error valueAtPercentile:95] / 100.0, error.maxValue / 100.0,
+          (unsigned long)self.filter.acceptedCorrections, (unsigned long)self.filter.rejectedCorrections);
+
+    // Four beacons around a 20 x 10 m loop hold the drift from the heading offset.
+    XCTAssertLessThan([error valueAtPercentile:50], 150ULL);
+    XCTAssertLessThan([error valueAtPercentile:95], 300ULL);
+    XCTAssertGreaterThan(self.filter.acceptedCorrections, self.filter.rejectedCorrections);
+}
+
+/*
+ * Extrapolation stops at the expected next step, so standing still after the walk
+ * does not leave the position ahead of the stop.
+ */
+- (void)testStopDoesNotOvershoot
+{
+    ESTWalkReplay(self.filter, [self walkTraceWithLaps:1 stillTime:5]);
+
+    double x, y, heading;
+    ESTWalkPosition([self walkTimeForLaps:1] * EST_WALK_TEST_CADENCE * EST_WALK_TEST_STEP, &x, &y, &heading);
+
+    double error = [self.filter recordErrorWithTrueX:x y:y];
+
+    NSLog(@"ESTDeadReckoningFilterTests: %.2f m from the stop after standing 5 s", error);
+
+    XCTAssertLessThan(error, 1.5);
+}
+
+/*
+ * Motion samples run on the main queue at 50 Hz, processing one must stay far below
+ * the 20 ms between them.
+ */
+- (void)testMotionSampleLatency
+{
+    NSData *trace = [self walkTraceWithLaps:10 stillTime:0];
+    ESTHDRHistogram *latency = self.filter.processingTime;
+
+    // Every run replays from the start, so it needs a filter that has not seen the trace.
+    [self measureBlock:^{
+        ESTDeadReckoningFilter *filter = [self filterWithCornerBeacons];
+        ESTWalkReplay(filter, trace);
+        [latency mergeWith:filter.processingTime];
+    }];
+
+    NSLog(@"ESTDeadReckoningFilterTests: processMotionSample: p50 %llu ns, p99 %llu ns, max %llu ns over %llu samples",
+          [latency valueAtPercentile:50], [latency valueAtPercentile:99], latency.maxValue, latency.totalCount);
+
+    XCTAssertLessThan([latency valueAtPercentile:99], 100000ULL);
+}
+
+@end
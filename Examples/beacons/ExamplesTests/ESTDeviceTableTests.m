@@ -0,0 +1,355 @@
+//
+//  ESTDeviceTableTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTDeviceTable.h"
+#import "ESTHDRHistogram.h"
+#import "ESTMonotonicClock.h"
+#import "ESTTestRandom.h"
+
+#define EST_DEVICE_TEST_DEVICES     50000
+#define EST_DEVICE_TEST_ROUNDS      10
+#define EST_DEVICE_TEST_LOW_BATTERY 2700
+
+static inline uint64_t ESTDeviceTestDevice(NSUInteger device)
+{
+    return 0xDE71CE0000000000ULL + device + 1;
+}
+
+typedef struct
+{
+    uint32_t device;
+    int64_t values[ESTDeviceFieldCount];
+} ESTDeviceTestUpdate;
+
+/*
+ * Feeds the updates, one second per round of devices.
+ */
+static void ESTDeviceTestReplay(ESTDeviceTable *table, NSData *updates)
+{
+    const ESTDeviceTestUpdate *update = updates.bytes;
+    NSUInteger count = updates.length / sizeof(ESTDeviceTestUpdate);
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [table updateDevice:ESTDeviceTestDevice(update[i].device) values:update[i].values timestamp:1 + i / EST_DEVICE_TEST_DEVICES];
+    }
+}
+
+/*
+ * 50k devices reported once with every field, then ten rounds of ranging updates
+ * changing RSSI and proximity, with an occasional battery reading.
+ */
+@interface ESTDeviceTableTests : XCTestCase
+
+@property (nonatomic, strong) NSData *initial;
+@property (nonatomic, strong) NSData *updates;
+
+/*
+ * EST_DEVICE_TEST_DEVICES rows of ESTDeviceFieldCount values after all updates.
+ */
+@property (nonatomic, strong) NSMutableData *expected;
+
+@end
+
+@implementation ESTDeviceTableTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    NSMutableData *initial = [NSMutableData dataWithLength:EST_DEVICE_TEST_DEVICES * sizeof(ESTDeviceTestUpdate)];
+    NSMutableData *updates = [NSMutableData dataWithLength:EST_DEVICE_TEST_DEVICES * EST_DEVICE_TEST_ROUNDS * sizeof(ESTDeviceTestUpdate)];
+    ESTDeviceTestUpdate *first = initial.mutableBytes;
+    ESTDeviceTestUpdate *update = updates.mutableBytes;
+    uint64_t state = EST_TEST_SEED;
+
+    self.expected = [NSMutableData dataWithLength:EST_DEVICE_TEST_DEVICES * ESTDeviceFieldCount * sizeof(int64_t)];
+    int64_t *expected = self.expected.mutableBytes;
+
+    for (NSUInteger d = 0; d < EST_DEVICE_TEST_DEVICES; d++)
+    {
+        int64_t *values = first[d].values;
+        first[d].device = (uint32_t)d;
+
+        values[ESTDeviceFieldColor] = (int64_t)(ESTTestRandom(&state) * 8);
+        values[ESTDeviceFieldNearableType] = (int64_t)(ESTTestRandom(&state) * 10);
+        values[ESTDeviceFieldFirmwareVersion] = 1 + (int64_t)(ESTTestRandom(&state) * 4);
+        values[ESTDeviceFieldBatteryVoltage] = 2500 + (int64_t)(ESTTestRandom(&state) * 600);
+        values[ESTDeviceFieldProximity] = (int64_t)(ESTTestRandom(&state) * 4);
+        values[ESTDeviceFieldRegion] = 1 + (int64_t)(ESTTestRandom(&state) * 16);
+        values[ESTDeviceFieldRSSI] = -100 + (int64_t)(ESTTestRandom(&state) * 60);
+
+        memcpy(&expected[d * ESTDeviceFieldCount], values, sizeof(first[d].values));
+    }
+
+    for (NSUInteger i = 0; i < EST_DEVICE_TEST_DEVICES * EST_DEVICE_TEST_ROUNDS; i++, update++)
+    {
+        update->device = (uint32_t)(i % EST_DEVICE_TEST_DEVICES);
+
+        for (NSUInteger field = 0; field < ESTDeviceFieldCount; field++)
+        {
+            update->values[field] = ESTDeviceValueUnknown;
+        }
+
+        update->values[ESTDeviceFieldRSSI] = -100 + (int64_t)(ESTTestRandom(&state) * 60);
+        update->values[ESTDeviceFieldProximity] = update->values[ESTDeviceFieldRSSI] > -60 ? 1 : update->values[ESTDeviceFieldRSSI] > -80 ? 2 : 3;
+
+        // Batteries drain slowly, a reading now and then drops a few millivolts.
+        if (ESTTestRandom(&state) < 0.05)
+        {
+            int64_t *battery = &expected[update->device * ESTDeviceFieldCount + ESTDeviceFieldBatteryVoltage];
+            *battery -= (int64_t)(ESTTestRandom(&state) * 20);
+            update->values[ESTDeviceFieldBatteryVoltage] = *battery;
+        }
+
+        expected[update->device * ESTDeviceFieldCount + ESTDeviceFieldRSSI] = update->values[ESTDeviceFieldRSSI];
+        expected[update->device * ESTDeviceFieldCount + ESTDeviceFieldProximity] = update->values[ESTDeviceFieldProximity];
+    }
+
+    self.initial = initial;
+    self.updates = updates;
+}
+
+- (ESTDeviceTable *)loadedTable
+{
+    ESTDeviceTable *table = [ESTDeviceTable new];
+    const ESTDeviceTestUpdate *first = self.initial.bytes;
+
+    for (NSUInteger d = 0; d < EST_DEVICE_TEST_DEVICES; d++)
+    {
+        [table updateDevice:ESTDeviceTestDevice(d) values:first[d].values timestamp:0];
+    }
+
+    return table;
+}
+
+/*
+ * Queries the table is expected to answer, hash driven, range driven, conjunctions
+ * and a term on a field without an index.
+ */
+- (NSArray *)queries
+{
+    return @[
+        [ESTDeviceQuery queryWithField:ESTDeviceFieldColor equalTo:3],
+        [ESTDeviceQuery queryWithField:ESTDeviceFieldBatteryVoltage from:0 to:EST_DEVICE_TEST_LOW_BATTERY],
+        [[ESTDeviceQuery queryWithField:ESTDeviceFieldColor equalTo:3] queryAndField:ESTDeviceFieldBatteryVoltage from:0 to:EST_DEVICE_TEST_LOW_BATTERY],
+        [[ESTDeviceQuery queryWithField:ESTDeviceFieldProximity equalTo:1] queryAndField:ESTDeviceFieldRSSI from:-55 to:-40],
+        [[[ESTDeviceQuery queryWithField:ESTDeviceFieldRegion equalTo:5] queryAndField:ESTDeviceFieldNearableType equalTo:2]
+                                                                           queryAndField:ESTDeviceFieldFirmwareVersion equalTo:4],
+        [ESTDeviceQuery queryWithField:ESTDeviceFieldRSSI from:-41 to:-40]
+    ];
+}
+
+/*
+ * Identity hashes of the devices whose expected values satisfy every term, from a scan.
+ */
+- (NSSet *)expectedDevicesForTerms:(const int64_t (*)[3])terms count:(NSUInteger)count
+{
+    const int64_t *expected = self.expected.bytes;
+    NSMutableSet *devices = [NSMutableSet set];
+
+    for (NSUInteger d = 0; d < EST_DEVICE_TEST_DEVICES; d++)
+    {
+        BOOL matches = YES;
+
+        for (NSUInteger t = 0; t < count && matches; t++)
+        {
+            int64_t value = expected[d * ESTDeviceFieldCount + terms[t][0]];
+            matches = value >= terms[t][1] && value <= terms[t][2];
+        }
+
+        if (matches)
+        {
+            [devices addObject:@(ESTDeviceTestDevice(d))];
+        }
+    }
+
+    return devices;
+}
+
+- (void)testQueriesMatchScan
+{
+    ESTDeviceTable *table = [self loadedTable];
+    ESTDeviceTestReplay(table, self.updates);
+
+    XCTAssertEqual(table.deviceCount, (NSUInteger)EST_DEVICE_TEST_DEVICES);
+
+    // Same terms as -queries, in { field, minimum, maximum } form.
+    const int64_t terms[][3][3] = {
+        { { ESTDeviceFieldColor, 3, 3 } },
+        { { ESTDeviceFieldBatteryVoltage, 0, EST_DEVICE_TEST_LOW_BATTERY } },
+        { { ESTDeviceFieldColor, 3, 3 }, { ESTDeviceFieldBatteryVoltage, 0, EST_DEVICE_TEST_LOW_BATTERY } },
+        { { ESTDeviceFieldProximity, 1, 1 }, { ESTDeviceFieldRSSI, -55, -40 } },
+        { { ESTDeviceFieldRegion, 5, 5 }, { ESTDeviceFieldNearableType, 2, 2 }, { ESTDeviceFieldFirmwareVersion, 4, 4 } },
+        { { ESTDeviceFieldRSSI, -41, -40 } }
+    };
+
+    NSArray *queries = [self queries];
+
+    for (NSUInteger q = 0; q < queries.count; q++)
+    {
+        ESTDeviceQuery *query = queries[q];
+        NSArray *devices = [table devicesMatchingQuery:query];
+        NSSet *expected = [self expectedDevicesForTerms:terms[q] count:query.termCount];
+
+        XCTAssertEqual(devices.count, expected.count, @"Query %lu", (unsigned long)q);
+        XCTAssertEqualObjects([NSSet setWithArray:devices], expected, @"Query %lu", (unsigned long)q);
+        XCTAssertEqual([table countOfDevicesMatchingQuery:query], expected.count, @"Query %lu", (unsigned long)q);
+    }
+
+    // Dropping the firmware index makes the conjunction check the term per row instead.
+    [table setIndexKind:ESTDeviceIndexKindNone forField:ESTDeviceFieldFirmwareVersion];
+
+    XCTAssertEqualObjects([NSSet setWithArray:[table devicesMatchingQuery:queries[4]]], [self expectedDevicesForTerms:terms[4] count:3]);
+}
+
+/*
+ * A set kept from subscription deltas equals the query result after every round,
+ * including devices removed as idle.
+ */
+- (void)testSubscriptionFollowsQuery
+{
+    ESTDeviceTable *table = [self loadedTable];
+    ESTDeviceQuery *query = [[ESTDeviceQuery queryWithField:ESTDeviceFieldProximity equalTo:1] queryAndField:ESTDeviceFieldBatteryVoltage
+                                                                                                        from:0
+                                                                                                          to:EST_DEVICE_TEST_LOW_BATTERY];
+    NSMutableSet *matching = [NSMutableSet set];
+    __block NSUInteger deliveries = 0;
+
+    ESTDeviceSubscription *subscription = [table subscribeToQuery:query handler:^(NSArray *added, NSArray *removed) {
+        for (NSNumber *device in added)
+        {
+            XCTAssertFalse([matching containsObject:device]);
+        }
+
+        for (NSNumber *device in removed)
+        {
+            XCTAssertTrue([matching containsObject:device]);
+        }
+
+        [matching addObjectsFromArray:added];
+        [matching minusSet:[NSSet setWithArray:removed]];
+        deliveries++;
+    }];
+
+    XCTAssertEqualObjects(matching, [NSSet setWithArray:[table devicesMatchingQuery:query]]);
+
+    const ESTDeviceTestUpdate *updates = self.updates.bytes;
+
+    for (NSUInteger round = 0; round < EST_DEVICE_TEST_ROUNDS; round++)
+    {
+        NSData *slice = [NSData dataWithBytesNoCopy:(void *)&updates[round * EST_DEVICE_TEST_DEVICES]
+                                             length:EST_DEVICE_TEST_DEVICES * sizeof(ESTDeviceTestUpdate)
+                                       freeWhenDone:NO];
+        ESTDeviceTestReplay(table, slice);
+
+        XCTAssertEqualObjects(matching, [NSSet setWithArray:[table devicesMatchingQuery:query]], @"Round %lu", (unsigned long)round);
+    }
+
+    NSLog(@"ESTDeviceTableTests: %lu deliveries, %lu devices matching", (unsigned long)deliveries, (unsigned long)matching.count);
+
+    // Every other device refreshed past the timeout, the rest goes idle.
+    for (NSUInteger d = 0; d < EST_DEVICE_TEST_DEVICES; d += 2)
+    {
+        [table updateDevice:ESTDeviceTestDevice(d) field:ESTDeviceFieldRSSI value:-70 timestamp:100];
+    }
+
+    XCTAssertEqual([table removeDevicesIdleForTimeout:30 atTime:100], (NSUInteger)(EST_DEVICE_TEST_DEVICES / 2));
+    XCTAssertEqualObjects(matching, [NSSet setWithArray:[table devicesMatchingQuery:query]]);
+
+    [table unsubscribe:subscription];
+    deliveries = 0;
+
+    [table removeDevice:ESTDeviceTestDevice(0)];
+
+    XCTAssertEqual(deliveries, (NSUInteger)0);
+}
+
+/*
+ * 500k ranging updates over 50k devices with a standing query subscribed, a fresh
+ * table per run, loading is not measured.
+ */
+- (void)testUpdatePerformance
+{
+    __block ESTDeviceTable *table;
+    __block NSUInteger delivered = 0;
+    __block ESTMonotonicTime elapsed = 0;
+
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        table = [self loadedTable];
+
+        [table subscribeToQuery:[[ESTDeviceQuery queryWithField:ESTDeviceFieldProximity equalTo:1] queryAndField:ESTDeviceFieldColor equalTo:3]
+                        handler:^(NSArray *added, NSArray *removed) {
+            delivered += added.count + removed.count;
+        }];
+
+        ESTMonotonicTime start = ESTMonotonicNow();
+        [self startMeasuring];
+
+        ESTDeviceTestReplay(table, self.updates);
+
+        [self stopMeasuring];
+        elapsed = ESTMonotonicElapsed(start);
+    }];
+
+    NSUInteger count = self.updates.length / sizeof(ESTDeviceTestUpdate);
+
+    NSLog(@"ESTDeviceTableTests: %.0f updates/s at %lu devices, %.0f ns per update, %lu subscription changes",
+          count * 1e9 / elapsed, (unsigned long)table.deviceCount, (double)elapsed / count, (unsigned long)delivered);
+
+    XCTAssertEqual(table.deviceCount, (NSUInteger)EST_DEVICE_TEST_DEVICES);
+}
+
+/*
+ * Query latency per query, against NSPredicate filtering of an array of the same
+ * devices, what callbacks did before the table.
+ */
+- (void)testQueryPerformance
+{
+    ESTDeviceTable *table = [self loadedTable];
+    ESTDeviceTestReplay(table, self.updates);
+
+    NSArray *queries = [self queries];
+    ESTHDRHistogram *queryTime = [[ESTHDRHistogram alloc] initWithHighestTrackableValue:10000000000ULL significantBits:7];
+    __block NSUInteger matched = 0;
+
+    [self measureBlock:^{
+        for (NSUInteger repeat = 0; repeat < 100; repeat++)
+        {
+            for (ESTDeviceQuery *query in queries)
+            {
+                ESTMonotonicTime start = ESTMonotonicNow();
+                matched += [table countOfDevicesMatchingQuery:query];
+                [queryTime recordValue:ESTMonotonicElapsed(start)];
+            }
+        }
+    }];
+
+    const int64_t *expected = self.expected.bytes;
+    NSMutableArray *devices = [NSMutableArray arrayWithCapacity:EST_DEVICE_TEST_DEVICES];
+
+    for (NSUInteger d = 0; d < EST_DEVICE_TEST_DEVICES; d++)
+    {
+        [devices addObject:@{ @"color" : @(expected[d * ESTDeviceFieldCount + ESTDeviceFieldColor]),
+                              @"battery" : @(expected[d * ESTDeviceFieldCount + ESTDeviceFieldBatteryVoltage]) }];
+    }
+
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"color == 3 AND battery <= %d", EST_DEVICE_TEST_LOW_BATTERY];
+    ESTMonotonicTime start = ESTMonotonicNow();
+    NSUInteger filtered = [devices filteredArrayUsingPredicate:predicate].count;
+    uint64_t predicateTime = ESTMonotonicElapsed(start);
+
+    NSLog(@"ESTDeviceTableTests: query p50 %llu ns, p99 %llu ns over %llu queries, NSPredicate on the color and battery conjunction %llu ns",
+          [queryTime valueAtPercentile:50], [queryTime valueAtPercentile:99], queryTime.totalCount, predicateTime);
+
+    XCTAssertEqual([table countOfDevicesMatchingQuery:queries[2]], filtered);
+    XCTAssertGreaterThan(matched, (NSUInteger)0);
+}
+
+@end
@@ -0,0 +1,291 @@
+//
+//  ESTFastEnterDetectorTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <malloc/malloc.h>
+#import "ESTFastEnterDetector.h"
+#import "ESTFrameDecoder.h"
+
+#define EST_ENTER_TEST_BEACONS          1000
+#define EST_ENTER_TEST_OBSERVATIONS     10000
+#define EST_ENTER_TEST_FRAME_LENGTH     20
+
+static const uint8_t ESTEnterTestNamespace[10] = { 0xED, 0xD1, 0xEB, 0xEA, 0xC0, 0x4E, 0x5D, 0xEF, 0xA0, 0x17 };
+
+/*
+ * Heap blocks and bytes in use over all zones.
+ */
+static malloc_statistics_t ESTEnterTestHeap(void)
+{
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+
+    return statistics;
+}
+
+/*
+ * Watches 1000 Eddystone-UID beacons of one namespace. Observations of them arrive
+ * either as decoded frames stamped with a monotonic receipt time, or as ESTEddystone
+ * discovery results carrying an NSDate, as the SDK delivers them.
+ */
+@interface ESTFastEnterDetectorTests : XCTestCase
+
+/*
+ * EST_ENTER_TEST_BEACONS service data frames of EST_ENTER_TEST_FRAME_LENGTH bytes.
+ */
+@property (nonatomic, strong) NSData *frameBytes;
+
+@end
+
+@implementation ESTFastEnterDetectorTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    NSMutableData *frameBytes = [NSMutableData dataWithLength:EST_ENTER_TEST_BEACONS * EST_ENTER_TEST_FRAME_LENGTH];
+    uint8_t *bytes = frameBytes.mutableBytes;
+
+    for (NSUInteger b = 0; b < EST_ENTER_TEST_BEACONS; b++)
+    {
+        uint8_t *frame = bytes + b * EST_ENTER_TEST_FRAME_LENGTH;
+
+        // UID frame type, -18 dBm at 0 m, namespace, instance big endian, two reserved bytes.
+        frame[0] = 0x00;
+        frame[1] = (uint8_t)-18;
+        memcpy(frame + 2, ESTEnterTestNamespace, sizeof(ESTEnterTestNamespace));
+
+        for (NSUInteger i = 0; i < 6; i++)
+        {
+            frame[12 + i] = (uint8_t)((uint64_t)(b + 1) >> (8 * (5 - i)));
+        }
+    }
+
+    self.frameBytes = frameBytes;
+}
+
+- (NSString *)namespaceID
+{
+    NSMutableString *namespaceID = [NSMutableString string];
+
+    for (NSUInteger i = 0; i < sizeof(ESTEnterTestNamespace); i++)
+    {
+        [namespaceID appendFormat:@"%02X", ESTEnterTestNamespace[i]];
+    }
+
+    return namespaceID;
+}
+
+- (NSString *)instanceIDOfBeacon:(NSUInteger)beacon
+{
+    return [NSString stringWithFormat:@"%012llX", (unsigned long long)(beacon + 1)];
+}
+
+- (ESTFastEnterDetector *)watchingDetector
+{
+    ESTFastEnterDetector *detector = [ESTFastEnterDetector new];
+    NSString *namespaceID = [self namespaceID];
+
+    for (NSUInteger b = 0; b < EST_ENTER_TEST_BEACONS; b++)
+    {
+        [detector watchEddystoneWithNamespaceID:namespaceID instanceID:[self instanceIDOfBeacon:b] enterRSSI:-80];
+    }
+
+    return detector;
+}
+
+/*
+ * Raw frames of observations cycling through the beacons, receipt time left for the
+ * decoder to stamp.
+ */
+- (NSMutableData *)rawFramesOfCount:(NSUInteger)count
+{
+    NSMutableData *raw = [NSMutableData dataWithLength:count * sizeof(ESTRawFrame)];
+    ESTRawFrame *frames = raw.mutableBytes;
+    const uint8_t *bytes = self.frameBytes.bytes;
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        frames[i] = (ESTRawFrame){
+            ESTFrameSourceServiceData, EST_FRAME_SERVICE_EDDYSTONE, bytes + (i % EST_ENTER_TEST_BEACONS) * EST_ENTER_TEST_FRAME_LENGTH,
+            EST_ENTER_TEST_FRAME_LENGTH, (int8_t)(-60 - i % 10), 0
+        };
+    }
+
+    return raw;
+}
+
+/*
+ * Discovery results of the same observations as the SDK builds them, one object and
+ * one discovery date each.
+ */
+- (NSArray *)eddystonesOfCount:(NSUInteger)count namespaceID:(NSString *)namespaceID instanceIDs:(NSArray *)instanceIDs
+{
+    NSMutableArray *eddystones = [NSMutableArray arrayWithCapacity:count];
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        ESTEddystone *eddystone = [ESTEddystone new];
+        eddystone.namespaceID = namespaceID;
+        eddystone.instanceID = instanceIDs[i % EST_ENTER_TEST_BEACONS];
+        eddystone.rssi = @(-60 - (NSInteger)(i % 10));
+        eddystone.discoveryDate = [NSDate date];
+
+        [eddystones addObject:eddystone];
+    }
+
+    return eddystones;
+}
+
+/*
+ * Every provisional enter from decoded frames records its receipt to callback latency.
+ */
+- (void)testFrameEnterLatency
+{
+    ESTFastEnterDetector *detector = [self watchingDetector];
+    ESTFrameDecoder *decoder = [ESTFrameDecoder new];
+    NSMutableData *raw = [self rawFramesOfCount:EST_ENTER_TEST_BEACONS];
+    ESTFrame *frames = malloc(EST_ENTER_TEST_BEACONS * sizeof(ESTFrame));
+
+    NSUInteger count = [decoder decodeRawFrames:raw.bytes count:EST_ENTER_TEST_BEACONS into:frames];
+    [detector processFrames:frames count:count];
+
+    free(frames);
+
+    ESTHDRHistogram *latency = detector.enterLatency;
+
+    NSLog(@"ESTFastEnterDetectorTests: receipt to enter p50 %llu us, p99 %llu us", [latency valueAtPercentile:50], [latency valueAtPercentile:99]);
+
+    XCTAssertEqual(count, (NSUInteger)EST_ENTER_TEST_BEACONS);
+    XCTAssertEqual(detector.provisionalCount, (NSUInteger)EST_ENTER_TEST_BEACONS);
+    XCTAssertEqual(latency.totalCount, (uint64_t)EST_ENTER_TEST_BEACONS);
+}
+
+/*
+ * Discovery results without a date still enter, but have no receipt time to measure from.
+ */
+- (void)testUndatedDiscoveryRecordsNoLatency
+{
+    ESTFastEnterDetector *detector = [self watchingDetector];
+    ESTEddystone *eddystone = [ESTEddystone new];
+    eddystone.namespaceID = [self namespaceID];
+    eddystone.instanceID = [self instanceIDOfBeacon:0];
+    eddystone.rssi = @(-60);
+
+    [detector processEddystones:@[ eddystone ]];
+
+    XCTAssertEqual(detector.provisionalCount, (NSUInteger)1);
+    XCTAssertEqual(detector.enterLatency.totalCount, (uint64_t)0);
+}
+
+/*
+ * Heap blocks and bytes held per observation by each path, after a pass that enters
+ * every beacon so detector state is in place. Discovery results stay alive while
+ * their batch is processed, so the difference is what every observation allocates.
+ */
+- (void)testAllocationsPerObservation
+{
+    NSString *namespaceID = [self namespaceID];
+    NSMutableArray *instanceIDs = [NSMutableArray arrayWithCapacity:EST_ENTER_TEST_BEACONS];
+
+    for (NSUInteger b = 0; b < EST_ENTER_TEST_BEACONS; b++)
+    {
+        [instanceIDs addObject:[self instanceIDOfBeacon:b]];
+    }
+
+    ESTFastEnterDetector *objectDetector = [self watchingDetector];
+    ESTFastEnterDetector *frameDetector = [self watchingDetector];
+    ESTFrameDecoder *decoder = [ESTFrameDecoder new];
+    NSMutableData *raw = [self rawFramesOfCount:EST_ENTER_TEST_OBSERVATIONS];
+    ESTFrame *frames = malloc(EST_ENTER_TEST_OBSERVATIONS * sizeof(ESTFrame));
+
+    @autoreleasepool
+    {
+        [objectDetector processEddystones:[self eddystonesOfCount:EST_ENTER_TEST_BEACONS namespaceID:namespaceID instanceIDs:instanceIDs]];
+        [frameDetector processFrames:frames count:[decoder decodeRawFrames:raw.bytes count:EST_ENTER_TEST_BEACONS into:frames]];
+    }
+
+    malloc_statistics_t before;
+    malloc_statistics_t after;
+
+    @autoreleasepool
+    {
+        before = ESTEnterTestHeap();
+
+        NSArray *eddystones = [self eddystonesOfCount:EST_ENTER_TEST_OBSERVATIONS namespaceID:namespaceID instanceIDs:instanceIDs];
+        [objectDetector processEddystones:eddystones];
+
+        after = ESTEnterTestHeap();
+    }
+
+    double objectBlocks = ((double)after.blocks_in_use - before.blocks_in_use) / EST_ENTER_TEST_OBSERVATIONS;
+    double objectBytes = ((double)after.size_in_use - before.size_in_use) / EST_ENTER_TEST_OBSERVATIONS;
+
+    @autoreleasepool
+    {
+        before = ESTEnterTestHeap();
+
+        NSUInteger count = [decoder decodeRawFrames:raw.bytes count:EST_ENTER_TEST_OBSERVATIONS into:frames];
+        [frameDetector processFrames:frames count:count];
+
+        after = ESTEnterTestHeap();
+    }
+
+    double frameBlocks = ((double)after.blocks_in_use - before.blocks_in_use) / EST_ENTER_TEST_OBSERVATIONS;
+    double frameBytes = ((double)after.size_in_use - before.size_in_use) / EST_ENTER_TEST_OBSERVATIONS;
+
+    free(frames);
+
+    NSLog(@"ESTFastEnterDetectorTests: per observation %.2f blocks / %.0f bytes as discovery results, %.4f blocks / %.1f bytes as decoded frames (%lu bytes of caller buffer)",
+          objectBlocks, objectBytes, frameBlocks, frameBytes, (unsigned long)sizeof(ESTFrame));
+
+    XCTAssertGreaterThanOrEqual(objectBlocks, 1.0);
+    XCTAssertLessThan(frameBlocks, 0.01);
+}
+
+/*
+ * Decoding and processing 10k observations, against building and processing the same
+ * observations as discovery results.
+ */
+- (void)testObservationPerformance
+{
+    NSString *namespaceID = [self namespaceID];
+    NSMutableArray *instanceIDs = [NSMutableArray arrayWithCapacity:EST_ENTER_TEST_BEACONS];
+
+    for (NSUInteger b = 0; b < EST_ENTER_TEST_BEACONS; b++)
+    {
+        [instanceIDs addObject:[self instanceIDOfBeacon:b]];
+    }
+
+    ESTFastEnterDetector *detector = [self watchingDetector];
+    ESTFrameDecoder *decoder = [ESTFrameDecoder new];
+    NSMutableData *raw = [self rawFramesOfCount:EST_ENTER_TEST_OBSERVATIONS];
+    ESTFrame *frames = malloc(EST_ENTER_TEST_OBSERVATIONS * sizeof(ESTFrame));
+
+    [self measureBlock:^{
+        NSUInteger count = [decoder decodeRawFrames:raw.bytes count:EST_ENTER_TEST_OBSERVATIONS into:frames];
+        [detector processFrames:frames count:count];
+    }];
+
+    free(frames);
+
+    ESTFastEnterDetector *objectDetector = [self watchingDetector];
+    ESTMonotonicTime start = ESTMonotonicNow();
+
+    @autoreleasepool
+    {
+        [objectDetector processEddystones:[self eddystonesOfCount:EST_ENTER_TEST_OBSERVATIONS namespaceID:namespaceID instanceIDs:instanceIDs]];
+    }
+
+    NSLog(@"ESTFastEnterDetectorTests: %.0f ns per observation as discovery results",
+          (double)ESTMonotonicElapsed(start) / EST_ENTER_TEST_OBSERVATIONS);
+
+    XCTAssertEqual(objectDetector.provisionalCount, (NSUInteger)EST_ENTER_TEST_BEACONS);
+}
+
+@end
@@ -0,0 +1,290 @@
+//
+//  ESTLoadShedderTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTLoadShedder.h"
+#import "ESTTestRandom.h"
+
+#define EST_SHED_TEST_IDENTITIES        3000
+#define EST_SHED_TEST_STATIC            1000
+#define EST_SHED_TEST_WATCHED           20
+#define EST_SHED_TEST_BATCH             100
+#define EST_SHED_TEST_FRAME_COST        20000
+#define EST_SHED_TEST_CONTROL_INTERVAL  0.25
+#define EST_SHED_TEST_DURATION          4.0
+
+/*
+ * Static identities first, then watched ones, the rest moves.
+ */
+static inline uint64_t ESTShedTestIdentity(NSUInteger identity)
+{
+    return 0x5348454400000000ULL + identity + 1;
+}
+
+static inline BOOL ESTShedTestIsWatched(uint64_t identityHash)
+{
+    uint64_t identity = identityHash - ESTShedTestIdentity(0);
+
+    return identity >= EST_SHED_TEST_STATIC && identity < EST_SHED_TEST_STATIC + EST_SHED_TEST_WATCHED;
+}
+
+/*
+ * Stands in for the pipeline, EST_SHED_TEST_FRAME_COST ns of work per frame.
+ */
+static void ESTShedTestWork(NSUInteger count)
+{
+    ESTMonotonicTime until = ESTMonotonicNow() + (uint64_t)count * EST_SHED_TEST_FRAME_COST;
+
+    while (ESTMonotonicNow() < until)
+    {
+    }
+}
+
+/*
+ * Steady state of one run, measured over its second half.
+ */
+typedef struct
+{
+    ESTLoadShedLevel level;
+    uint64_t lagP50;
+    uint64_t lagP99;
+    double pipelineShare;
+    double admittedShare;
+    uint64_t watchedReceived;
+    uint64_t watchedAdmitted;
+} ESTShedTestResult;
+
+@interface ESTLoadShedderTests : XCTestCase
+
+@end
+
+@implementation ESTLoadShedderTests
+
+- (ESTLoadShedder *)shedderWithStaticAndWatchedIdentities
+{
+    ESTLoadShedder *shedder = [ESTLoadShedder new];
+
+    for (NSUInteger i = 0; i < EST_SHED_TEST_STATIC; i++)
+    {
+        [shedder addStaticIdentity:ESTShedTestIdentity(i)];
+    }
+
+    for (NSUInteger i = EST_SHED_TEST_STATIC; i < EST_SHED_TEST_STATIC + EST_SHED_TEST_WATCHED; i++)
+    {
+        [shedder watchIdentity:ESTShedTestIdentity(i)];
+    }
+
+    return shedder;
+}
+
+/*
+ * Synthetic load at multiple of the sustainable rate, the rate at which the pipeline
+ * takes cpuBudget of the time. Batches of 100 frames of random identities arrive on
+ * schedule, stamped with their arrival time. The loop processes the oldest batch
+ * that has arrived, so when the pipeline falls behind batches queue and lag grows.
+ *
+ * Without shedding every budget is lifted. Recovery is held off for the run, the
+ * second half measures the level the controller settled on.
+ */
+- (ESTShedTestResult)runLoadAtMultiple:(double)multiple shedding:(BOOL)shedding
+{
+    ESTLoadShedder *shedder = [self shedderWithStaticAndWatchedIdentities];
+    shedder.controlInterval = EST_SHED_TEST_CONTROL_INTERVAL;
+    shedder.recoveryIntervals = (NSUInteger)(EST_SHED_TEST_DURATION / EST_SHED_TEST_CONTROL_INTERVAL) + 1;
+
+    double rate = multiple * shedder.cpuBudget * 1e9 / EST_SHED_TEST_FRAME_COST;
+    uint64_t batchInterval = (uint64_t)(EST_SHED_TEST_BATCH * 1e9 / rate);
+    uint64_t duration = (uint64_t)(EST_SHED_TEST_DURATION * 1e9);
+
+    if (!shedding)
+    {
+        shedder.lagBudget = DBL_MAX;
+        shedder.cpuBudget = DBL_MAX;
+        shedder.queueDepthBudget = 0;
+    }
+
+    NSMutableData *batch = [NSMutableData dataWithLength:EST_SHED_TEST_BATCH * sizeof(ESTFrame)];
+    ESTFrame *frames = batch.mutableBytes;
+    uint64_t state = EST_TEST_SEED;
+
+    __block ESTShedTestResult result = { 0 };
+    __block uint64_t pipelineTime = 0;
+    uint64_t received = 0;
+    uint64_t admitted = 0;
+    ESTMonotonicTime measureStart = 0;
+
+    ESTMonotonicTime start = ESTMonotonicNow();
+    uint64_t next = 0;
+
+    for (ESTMonotonicTime now = start; now - start < duration; now = ESTMonotonicNow())
+    {
+        ESTMonotonicTime arrival = start + next * batchInterval;
+
+        if (arrival > now)
+        {
+            usleep((useconds_t)((arrival - now) / 1000));
+            continue;
+        }
+
+        if (!measureStart && now - start >= duration / 2)
+        {
+            measureStart = now;
+            [shedder.callbackLag reset];
+            pipelineTime = 0;
+            received = admitted = 0;
+            result.watchedReceived = result.watchedAdmitted = 0;
+        }
+
+        for (NSUInteger i = 0; i < EST_SHED_TEST_BATCH; i++)
+        {
+            frames[i].type = ESTFrameTypeEddystoneUID;
+            frames[i].identityHash = ESTShedTestIdentity((NSUInteger)(ESTTestRandom(&state) * EST_SHED_TEST_IDENTITIES));
+            frames[i].rssi = -70;
+            frames[i].receiptTime = arrival;
+
+            result.watchedReceived += ESTShedTestIsWatched(frames[i].identityHash);
+        }
+
+        uint64_t arrived = (now - start) / batchInterval + 1;
+
+        received += EST_SHED_TEST_BATCH;
+        admitted += [shedder processFrames:frames count:EST_SHED_TEST_BATCH queueDepth:(NSUInteger)(arrived - next - 1) usingBlock:^(const ESTFrame *passed, NSUInteger count) {
+
+            ESTMonotonicTime blockStart = ESTMonotonicNow();
+
+            for (NSUInteger i = 0; i < count; i++)
+            {
+                result.watchedAdmitted += ESTShedTestIsWatched(passed[i].identityHash);
+            }
+
+            ESTShedTestWork(count);
+            pipelineTime += ESTMonotonicElapsed(blockStart);
+        }];
+
+        next++;
+    }
+
+    result.level = shedder.level;
+    result.lagP50 = [shedder.callbackLag valueAtPercentile:50];
+    result.lagP99 = [shedder.callbackLag valueAtPercentile:99];
+    result.pipelineShare = (double)pipelineTime / ESTMonotonicElapsed(measureStart);
+    result.admittedShare = received ? (double)admitted / received : 0;
+
+    NSLog(@"ESTLoadShedderTests: %.0fx load (%.0f frames/s) %@, level %ld, lag p50 %.1f ms p99 %.1f ms, pipeline %.0f %% of the time, %.1f %% admitted, %llu batches behind",
+          multiple, rate, shedding ? @"shedding" : @"not shedding", (long)result.level, result.lagP50 / 1000.0, result.lagP99 / 1000.0,
+          result.pipelineShare * 100, result.admittedShare * 100, duration / batchInterval - next);
+
+    return result;
+}
+
+- (void)assertSheddingResult:(ESTShedTestResult)result atLeastLevel:(ESTLoadShedLevel)level
+{
+    ESTLoadShedder *defaults = [ESTLoadShedder new];
+
+    XCTAssertGreaterThanOrEqual(result.level, level);
+    XCTAssertLessThan(result.lagP99, (uint64_t)(defaults.lagBudget * 1e6));
+    XCTAssertLessThan(result.pipelineShare, defaults.cpuBudget);
+    XCTAssertGreaterThan(result.watchedReceived, (uint64_t)0);
+    XCTAssertEqual(result.watchedAdmitted, result.watchedReceived);
+}
+
+/*
+ * The pipeline alone keeps up, at twice its CPU budget. Sampling static identities
+ * is not enough, coalescing brings it back under budget.
+ */
+- (void)testTwiceSustainableRate
+{
+    ESTShedTestResult unshed = [self runLoadAtMultiple:2 shedding:NO];
+    ESTShedTestResult shed = [self runLoadAtMultiple:2 shedding:YES];
+
+    XCTAssertGreaterThan(unshed.pipelineShare, [ESTLoadShedder new].cpuBudget);
+    [self assertSheddingResult:shed atLeastLevel:ESTLoadShedLevelCoalesce];
+}
+
+/*
+ * The pipeline alone falls further behind every second, shedding keeps lag within budget.
+ */
+- (void)testFiveTimesSustainableRate
+{
+    ESTShedTestResult unshed = [self runLoadAtMultiple:5 shedding:NO];
+    ESTShedTestResult shed = [self runLoadAtMultiple:5 shedding:YES];
+
+    XCTAssertGreaterThan(unshed.lagP99, shed.lagP99);
+    [self assertSheddingResult:shed atLeastLevel:ESTLoadShedLevelCoalesce];
+}
+
+/*
+ * At the critical level repeated frames of one identity are coalesced, while
+ * telemetry frames, which carry no identity, and watched identities all pass.
+ */
+- (void)testCriticalLevelCoalescesIdentitiesOnly
+{
+    ESTLoadShedder *shedder = [self shedderWithStaticAndWatchedIdentities];
+    shedder.controlInterval = 0.001;
+    shedder.lagBudget = 0;
+
+    ESTFrame frame = { 0 };
+    frame.type = ESTFrameTypeEddystoneUID;
+    frame.identityHash = ESTShedTestIdentity(EST_SHED_TEST_IDENTITIES - 1);
+
+    // Frames received a second ago are over the zero lag budget, every interval raises the level.
+    for (NSUInteger i = 0; i < 100 && shedder.level < ESTLoadShedLevelCritical; i++)
+    {
+        frame.receiptTime = ESTMonotonicNow() - 1000000000ULL;
+        [shedder processFrames:&frame count:1 queueDepth:0 usingBlock:^(const ESTFrame *frames, NSUInteger count) {}];
+        usleep(2000);
+    }
+
+    XCTAssertEqual(shedder.level, ESTLoadShedLevelCritical);
+
+    ESTFrame frames[30];
+    ESTMonotonicTime now = ESTMonotonicNow();
+
+    for (NSUInteger i = 0; i < 30; i++)
+    {
+        frames[i] = (ESTFrame){ 0 };
+        frames[i].receiptTime = now;
+
+        switch (i % 3)
+        {
+            case 0:
+                frames[i].type = ESTFrameTypeEddystoneUID;
+                frames[i].identityHash = ESTShedTestIdentity(EST_SHED_TEST_IDENTITIES - 2);
+                break;
+
+            case 1:
+                frames[i].type = ESTFrameTypeEddystoneTLM;
+                break;
+
+            default:
+                frames[i].type = ESTFrameTypeEddystoneUID;
+                frames[i].identityHash = ESTShedTestIdentity(EST_SHED_TEST_STATIC);
+                break;
+        }
+    }
+
+    __block NSUInteger telemetry = 0;
+    __block NSUInteger watched = 0;
+    __block NSUInteger coalesced = 0;
+
+    NSUInteger count = [shedder processFrames:frames count:30 queueDepth:0 usingBlock:^(const ESTFrame *passed, NSUInteger passedCount) {
+        for (NSUInteger i = 0; i < passedCount; i++)
+        {
+            telemetry += passed[i].identityHash == 0;
+            watched += ESTShedTestIsWatched(passed[i].identityHash);
+            coalesced += passed[i].identityHash == ESTShedTestIdentity(EST_SHED_TEST_IDENTITIES - 2);
+        }
+    }];
+
+    XCTAssertEqual(telemetry, (NSUInteger)10);
+    XCTAssertEqual(watched, (NSUInteger)10);
+    XCTAssertEqual(coalesced, (NSUInteger)1);
+    XCTAssertEqual(count, (NSUInteger)21);
+}
+
+@end
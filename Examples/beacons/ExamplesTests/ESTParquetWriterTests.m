@@ -0,0 +1,357 @@
+//
+//  ESTParquetWriterTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTParquetWriter.h"
+#import "ESTTestRandom.h"
+
+// Thrift compact protocol types and parquet.thrift values the writer uses.
+#define EST_THRIFT_TEST_BOOL_TRUE       1
+#define EST_THRIFT_TEST_BOOL_FALSE      2
+#define EST_THRIFT_TEST_BYTE            3
+#define EST_THRIFT_TEST_I16             4
+#define EST_THRIFT_TEST_I32             5
+#define EST_THRIFT_TEST_I64             6
+#define EST_THRIFT_TEST_DOUBLE          7
+#define EST_THRIFT_TEST_BINARY          8
+#define EST_THRIFT_TEST_LIST            9
+#define EST_THRIFT_TEST_SET             10
+#define EST_THRIFT_TEST_STRUCT          12
+
+#define EST_PARQUET_TEST_DATA_PAGE          0
+#define EST_PARQUET_TEST_DICTIONARY_PAGE    2
+
+/*
+ * Thrift compact protocol reader for the footer and page headers. Structs decode
+ * into dictionaries keyed by field id, lists into arrays, integers into NSNumber and
+ * binary into NSData. Maps are not used by Parquet metadata and fail the read.
+ */
+typedef struct
+{
+    const uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger position;
+    BOOL failed;
+} ESTThriftReader;
+
+static uint8_t ESTThriftReadByte(ESTThriftReader *reader)
+{
+    if (reader->position >= reader->length)
+    {
+        reader->failed = YES;
+        return 0;
+    }
+
+    return reader->bytes[reader->position++];
+}
+
+static uint64_t ESTThriftReadVarint(ESTThriftReader *reader)
+{
+    uint64_t value = 0;
+
+    for (int shift = 0; shift < 64 && !reader->failed; shift += 7)
+    {
+        uint8_t byte = ESTThriftReadByte(reader);
+        value |= (uint64_t)(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80))
+        {
+            break;
+        }
+    }
+
+    return value;
+}
+
+static int64_t ESTThriftReadZigZag(ESTThriftReader *reader)
+{
+    uint64_t value = ESTThriftReadVarint(reader);
+
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static NSDictionary *ESTThriftReadStruct(ESTThriftReader *reader);
+
+static id ESTThriftReadValue(ESTThriftReader *reader, uint8_t type)
+{
+    switch (type)
+    {
+        case EST_THRIFT_TEST_BOOL_TRUE:
+        case EST_THRIFT_TEST_BOOL_FALSE:
+            return @(type == EST_THRIFT_TEST_BOOL_TRUE);
+
+        case EST_THRIFT_TEST_BYTE:
+            return @(ESTThriftReadByte(reader));
+
+        case EST_THRIFT_TEST_I16:
+        case EST_THRIFT_TEST_I32:
+        case EST_THRIFT_TEST_I64:
+            return @(ESTThriftReadZigZag(reader));
+
+        case EST_THRIFT_TEST_DOUBLE:
+        {
+            double value = 0;
+
+            if (reader->position + sizeof(value) > reader->length)
+            {
+                reader->failed = YES;
+                return nil;
+            }
+
+            memcpy(&value, reader->bytes + reader->position, sizeof(value));
+            reader->position += sizeof(value);
+
+            return @(value);
+        }
+
+        case EST_THRIFT_TEST_BINARY:
+        {
+            uint64_t length = ESTThriftReadVarint(reader);
+
+            if (reader->failed || length > reader->length - reader->position)
+            {
+                reader->failed = YES;
+                return nil;
+            }
+
+            NSData *value = [NSData dataWithBytes:reader->bytes + reader->position length:(NSUInteger)length];
+            reader->position += (NSUInteger)length;
+
+            return value;
+        }
+
+        case EST_THRIFT_TEST_LIST:
+        case EST_THRIFT_TEST_SET:
+        {
+            uint8_t header = ESTThriftReadByte(reader);
+            uint64_t count = header >> 4 == 15 ? ESTThriftReadVarint(reader) : header >> 4;
+            NSMutableArray *values = [NSMutableArray array];
+
+            for (uint64_t i = 0; i < count && !reader->failed; i++)
+            {
+                id value = ESTThriftReadValue(reader, header & 0x0F);
+
+                if (value)
+                {
+                    [values addObject:value];
+                }
+            }
+
+            return values;
+        }
+
+        case EST_THRIFT_TEST_STRUCT:
+            return ESTThriftReadStruct(reader);
+
+        default:
+            reader->failed = YES;
+            return nil;
+    }
+}
+
+static NSDictionary *ESTThriftReadStruct(ESTThriftReader *reader)
+{
+    NSMutableDictionary *fields = [NSMutableDictionary dictionary];
+    int64_t lastField = 0;
+
+    while (!reader->failed)
+    {
+        uint8_t header = ESTThriftReadByte(reader);
+
+        if (header == 0)
+        {
+            break;
+        }
+
+        int64_t field = header >> 4 ? lastField + (header >> 4) : ESTThriftReadZigZag(reader);
+        id value = ESTThriftReadValue(reader, header & 0x0F);
+
+        if (value)
+        {
+            fields[@(field)] = value;
+        }
+
+        lastField = field;
+    }
+
+    return reader->failed ? nil : fields;
+}
+
+static NSDictionary *ESTThriftStructAtOffset(NSData *data, NSUInteger offset, NSUInteger length)
+{
+    ESTThriftReader reader = { (const uint8_t *)data.bytes + offset, length, 0, NO };
+
+    return ESTThriftReadStruct(&reader);
+}
+
+@interface ESTParquetWriterTests : XCTestCase
+
+@property (nonatomic, copy) NSString *path;
+
+@end
+
+@implementation ESTParquetWriterTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:NULL];
+
+    [super tearDown];
+}
+
+/*
+ * One row group per entry of rowCounts over every column type, strings cycle
+ * through distinctStrings values.
+ */
+- (ESTParquetWriter *)writeRowGroups:(const NSUInteger *)rowCounts count:(NSUInteger)count distinctStrings:(NSUInteger)distinctStrings
+{
+    const ESTParquetType types[] = {
+        ESTParquetTypeTimestamp, ESTParquetTypeString, ESTParquetTypeInt32, ESTParquetTypeInt64, ESTParquetTypeDouble
+    };
+
+    NSError *error;
+    ESTParquetWriter *writer = [[ESTParquetWriter alloc] initWithPath:self.path
+                                                          columnNames:@[ @"timestamp", @"identifier", @"rssi", @"packet_count", @"accuracy" ]
+                                                                types:types
+                                                                error:&error];
+    XCTAssertNotNil(writer, @"%@", error);
+
+    uint64_t state = EST_TEST_SEED;
+
+    for (NSUInteger g = 0; g < count; g++)
+    {
+        ESTParquetBatch *batch = [writer batch];
+
+        for (NSUInteger r = 0; r < rowCounts[g]; r++)
+        {
+            [batch appendTimestamp:r column:0];
+            [batch appendString:[NSString stringWithFormat:@"device-%lu", (unsigned long)(r % distinctStrings)] column:1];
+            [batch appendInt32:-40 - (int32_t)(ESTTestRandom(&state) * 60) column:2];
+            [batch appendInt64:(int64_t)r column:3];
+            [batch appendDouble:ESTTestRandom(&state) * 10 column:4];
+            [batch endRow];
+        }
+
+        XCTAssertTrue([writer writeBatch:batch error:&error], @"%@", error);
+    }
+
+    XCTAssertTrue([writer closeWithError:&error], @"%@", error);
+
+    return writer;
+}
+
+/*
+ * Reads the footer back and checks that every column chunk starts where the previous
+ * one ended, its offsets point at page headers of the right kind and the row groups
+ * fill the file between the leading magic and the footer.
+ */
+- (void)testFooterDescribesRowGroups
+{
+    const NSUInteger rowCounts[] = { 1000, 2500, 10 };
+    ESTParquetWriter *writer = [self writeRowGroups:rowCounts count:3 distinctStrings:37];
+    NSData *file = [NSData dataWithContentsOfFile:self.path];
+
+    XCTAssertEqual((uint64_t)file.length, writer.bytesWritten);
+    XCTAssertEqual(writer.rowCount, (uint64_t)3510);
+    XCTAssertGreaterThan(file.length, (NSUInteger)12);
+    XCTAssertEqual(memcmp(file.bytes, "PAR1", 4), 0);
+    XCTAssertEqual(memcmp((const uint8_t *)file.bytes + file.length - 4, "PAR1", 4), 0);
+
+    uint32_t footerLength;
+    [file getBytes:&footerLength range:NSMakeRange(file.length - 8, 4)];
+    footerLength = CFSwapInt32LittleToHost(footerLength);
+
+    XCTAssertLessThan(footerLength, file.length - 12);
+
+    NSUInteger footerStart = file.length - 8 - footerLength;
+    NSDictionary *metadata = ESTThriftStructAtOffset(file, footerStart, footerLength);
+
+    XCTAssertNotNil(metadata);
+    XCTAssertEqualObjects(metadata[@3], @3510);
+
+    NSArray *schema = metadata[@2];
+    NSArray *rowGroups = metadata[@4];
+
+    XCTAssertEqual(schema.count, (NSUInteger)6);
+    XCTAssertEqual(rowGroups.count, (NSUInteger)3);
+
+    int64_t expectedStart = 4;
+
+    for (NSUInteger g = 0; g < rowGroups.count; g++)
+    {
+        NSDictionary *rowGroup = rowGroups[g];
+        NSArray *columns = rowGroup[@1];
+
+        XCTAssertEqualObjects(rowGroup[@3], @(rowCounts[g]));
+        XCTAssertEqual(columns.count, (NSUInteger)5);
+
+        for (NSUInteger c = 0; c < columns.count; c++)
+        {
+            NSDictionary *chunk = columns[c];
+            NSDictionary *column = chunk[@3];
+            BOOL dictionary = c == 1;
+
+            int64_t start = [chunk[@2] longLongValue];
+            int64_t dataOffset = [column[@9] longLongValue];
+            int64_t compressedSize = [column[@7] longLongValue];
+
+            XCTAssertEqual(start, expectedStart, @"Row group %lu column %lu", (unsigned long)g, (unsigned long)c);
+            XCTAssertEqualObjects(column[@5], @(rowCounts[g]));
+            XCTAssertEqual(column[@11] != nil, dictionary);
+
+            if (dictionary)
+            {
+                XCTAssertEqual([column[@11] longLongValue], start);
+
+                NSDictionary *page = ESTThriftStructAtOffset(file, (NSUInteger)start, (NSUInteger)(dataOffset - start));
+
+                XCTAssertEqualObjects(page[@1], @(EST_PARQUET_TEST_DICTIONARY_PAGE));
+                XCTAssertEqualObjects(page[@7][@1], @(MIN(rowCounts[g], (NSUInteger)37)));
+            }
+            else
+            {
+                XCTAssertEqual(dataOffset, start);
+            }
+
+            NSDictionary *page = ESTThriftStructAtOffset(file, (NSUInteger)dataOffset, (NSUInteger)(start + compressedSize - dataOffset));
+
+            XCTAssertEqualObjects(page[@1], @(EST_PARQUET_TEST_DATA_PAGE));
+            XCTAssertEqualObjects(page[@5][@1], @(rowCounts[g]));
+
+            expectedStart = start + compressedSize;
+        }
+    }
+
+    XCTAssertEqual(expectedStart, (int64_t)footerStart);
+}
+
+- (void)testEmptyBatchAddsNoRowGroup
+{
+    const NSUInteger rowCounts[] = { 0, 5 };
+    [self writeRowGroups:rowCounts count:2 distinctStrings:1];
+
+    NSData *file = [NSData dataWithContentsOfFile:self.path];
+
+    uint32_t footerLength;
+    [file getBytes:&footerLength range:NSMakeRange(file.length - 8, 4)];
+    footerLength = CFSwapInt32LittleToHost(footerLength);
+
+    NSDictionary *metadata = ESTThriftStructAtOffset(file, file.length - 8 - footerLength, footerLength);
+
+    XCTAssertEqual([metadata[@4] count], (NSUInteger)1);
+    XCTAssertEqualObjects(metadata[@3], @5);
+}
+
+@end
@@ -0,0 +1,211 @@
+//
+//  ESTRadioMapBuilderTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTRadioMapBuilder.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTTestRandom.h"
+
+#define EST_SURVEY_TEST_SIZE        80
+#define EST_SURVEY_TEST_SPACING     10
+#define EST_SURVEY_TEST_VISITS      10
+#define EST_SURVEY_TEST_AUDIBLE     -95
+
+/*
+ * RSSI at 1 m of -59 dBm and a path loss exponent of 3, so a beacon is heard up to ~15 m.
+ */
+static inline double ESTSurveyTestRSSI(double beaconX, double beaconY, double x, double y)
+{
+    double distance = MAX(hypot(beaconX - x, beaconY - y), 0.5);
+
+    return -59.0 - 30.0 * log10(distance);
+}
+
+/*
+ * Synthetic survey of an 80 x 80 m floor with beacons on a 10 m grid, walked in one
+ * trace per row of 1 m cells with 10 positions per cell and 8 dB of noise.
+ */
+@interface ESTRadioMapBuilderTests : XCTestCase
+
+@property (nonatomic, assign) NSUInteger perRow;
+@property (nonatomic, strong) NSData *beacons;
+@property (nonatomic, strong) NSArray *traces;
+@property (nonatomic, assign) NSUInteger sampleCount;
+@property (nonatomic, copy) NSString *path;
+
+@end
+
+@implementation ESTRadioMapBuilderTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.perRow = EST_SURVEY_TEST_SIZE / EST_SURVEY_TEST_SPACING + 1;
+
+    NSUInteger beaconCount = self.perRow * self.perRow;
+    NSMutableData *beaconData = [NSMutableData dataWithLength:beaconCount * sizeof(uint64_t)];
+    uint64_t *beacons = beaconData.mutableBytes;
+
+    for (NSUInteger b = 0; b < beaconCount; b++)
+    {
+        beacons[b] = ESTBeaconIdentityHashIBeacon(nil, 1, (uint16_t)b);
+    }
+
+    NSMutableArray *traces = [NSMutableArray arrayWithCapacity:EST_SURVEY_TEST_SIZE];
+    uint64_t state = EST_TEST_SEED;
+
+    for (NSUInteger cellY = 0; cellY < EST_SURVEY_TEST_SIZE; cellY++)
+    {
+        NSMutableData *trace = [NSMutableData data];
+
+        for (NSUInteger cellX = 0; cellX < EST_SURVEY_TEST_SIZE; cellX++)
+        {
+            for (NSUInteger visit = 0; visit < EST_SURVEY_TEST_VISITS; visit++)
+            {
+                double x = cellX + ESTTestRandom(&state);
+                double y = cellY + ESTTestRandom(&state);
+
+                for (NSUInteger b = 0; b < beaconCount; b++)
+                {
+                    double rssi = ESTSurveyTestRSSI((b % self.perRow) * EST_SURVEY_TEST_SPACING,
+                                                    (b / self.perRow) * EST_SURVEY_TEST_SPACING, x, y);
+                    rssi += (ESTTestRandom(&state) - 0.5) * 8.0;
+
+                    if (rssi >= EST_SURVEY_TEST_AUDIBLE)
+                    {
+                        ESTSurveySample sample = { x, y, 0, (int32_t)lround(rssi), beacons[b] };
+                        [trace appendBytes:&sample length:sizeof(sample)];
+                    }
+                }
+            }
+        }
+
+        self.sampleCount += trace.length / sizeof(ESTSurveySample);
+        [traces addObject:trace];
+    }
+
+    self.beacons = beaconData;
+    self.traces = traces;
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:NULL];
+
+    [super tearDown];
+}
+
+- (ESTRadioMapBuilder *)surveyedBuilder
+{
+    // 1 m cells, enough of them for the map to get an inverted file index.
+    ESTRadioMapBuilder *builder = [[ESTRadioMapBuilder alloc] initWithCellSize:1.0];
+
+    for (NSData *trace in self.traces)
+    {
+        [builder addTrace:trace];
+    }
+
+    [builder processTraces];
+
+    return builder;
+}
+
+/*
+ * Writes the built map, loads it back and compares beacons, points, lists and the
+ * nearest neighbors of a noiseless query at every cell.
+ */
+- (void)testRoundTrip
+{
+    ESTRadioMap *map = [[self surveyedBuilder] buildRadioMap];
+
+    XCTAssertEqual(map.count, (NSUInteger)(EST_SURVEY_TEST_SIZE * EST_SURVEY_TEST_SIZE));
+    XCTAssertGreaterThan(map.listCount, (NSUInteger)0);
+
+    NSError *error;
+    XCTAssertTrue([map writeToFile:self.path error:&error], @"%@", error);
+
+    ESTRadioMap *loaded = [ESTRadioMap radioMapWithContentsOfFile:self.path];
+
+    XCTAssertNotNil(loaded);
+    XCTAssertEqual(loaded.count, map.count);
+    XCTAssertEqual(loaded.listCount, map.listCount);
+    XCTAssertEqualObjects(loaded.beaconIdentityHashes, map.beaconIdentityHashes);
+
+    const uint64_t *beacons = self.beacons.bytes;
+    NSUInteger beaconCount = self.beacons.length / sizeof(uint64_t);
+    float *query = malloc(map.dimension * sizeof(float));
+
+    for (NSUInteger cell = 0; cell < map.count; cell++)
+    {
+        double x = cell % EST_SURVEY_TEST_SIZE + 0.5;
+        double y = cell / EST_SURVEY_TEST_SIZE + 0.5;
+
+        for (NSUInteger b = 0; b < beaconCount; b++)
+        {
+            NSUInteger d = [map dimensionForIdentityHash:beacons[b]];
+
+            if (d != NSNotFound)
+            {
+                double rssi = ESTSurveyTestRSSI((b % self.perRow) * EST_SURVEY_TEST_SPACING,
+                                                (b / self.perRow) * EST_SURVEY_TEST_SPACING, x, y);
+                query[d] = rssi >= EST_SURVEY_TEST_AUDIBLE ? (float)rssi : map.missingRSSI;
+            }
+        }
+
+        NSArray *expected = [map nearestNeighborsOfRSSI:query count:4];
+        NSArray *actual = [loaded nearestNeighborsOfRSSI:query count:4];
+
+        XCTAssertEqual(actual.count, expected.count);
+
+        for (NSUInteger i = 0; i < MIN(expected.count, actual.count); i++)
+        {
+            ESTRadioMapNeighbor *a = expected[i];
+            ESTRadioMapNeighbor *b = actual[i];
+
+            XCTAssertEqual(a.index, b.index, @"Neighbor %lu at (%.1f, %.1f)", (unsigned long)i, x, y);
+            XCTAssertEqual(a.x, b.x, @"Neighbor %lu at (%.1f, %.1f)", (unsigned long)i, x, y);
+            XCTAssertEqual(a.y, b.y, @"Neighbor %lu at (%.1f, %.1f)", (unsigned long)i, x, y);
+            XCTAssertEqual(a.floor, b.floor, @"Neighbor %lu at (%.1f, %.1f)", (unsigned long)i, x, y);
+            XCTAssertEqual(a.distance, b.distance, @"Neighbor %lu at (%.1f, %.1f)", (unsigned long)i, x, y);
+        }
+    }
+
+    free(query);
+}
+
+/*
+ * Median RSSI of a beacon next to a cell stays within the noise of the path loss model.
+ */
+- (void)testPercentilesFollowPathLoss
+{
+    ESTRadioMapBuilder *builder = [self surveyedBuilder];
+    const uint64_t *beacons = self.beacons.bytes;
+
+    // Beacon at (10, 10), cell (12, 10) is 2.5 m away from its center.
+    float median = [builder rssiAtPercentile:50 x:12.5 y:10.5 floor:0 identityHash:beacons[self.perRow + 1]];
+    float expected = (float)ESTSurveyTestRSSI(10, 10, 12.5, 10.5);
+
+    XCTAssertEqualWithAccuracy(median, expected, 4.0);
+    XCTAssertTrue(isnan([builder rssiAtPercentile:50 x:12.5 y:10.5 floor:1 identityHash:beacons[0]]));
+}
+
+/*
+ * Whole survey, 6400 cells and about half a million samples, on all cores.
+ */
+- (void)testSurveyProcessingPerformance
+{
+    NSLog(@"ESTRadioMapBuilderTests: %lu samples in %lu traces", (unsigned long)self.sampleCount, (unsigned long)self.traces.count);
+
+    [self measureBlock:^{
+        [[self surveyedBuilder] buildRadioMap];
+    }];
+}
+
+@end
@@ -0,0 +1,224 @@
+//
+//  ESTRadioMapTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTRadioMap.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTTestRandom.h"
+
+#define EST_VENUE_TEST_SIZE         100
+#define EST_VENUE_TEST_SPACING      10
+#define EST_VENUE_TEST_AUDIBLE      -95
+#define EST_VENUE_TEST_NOISE        3.0
+#define EST_VENUE_TEST_QUERIES      1000
+
+// Mapped record file header, then the radio map header (dimension, list count, missing RSSI, reserved).
+#define EST_VENUE_TEST_FILE_HEADER  24
+#define EST_VENUE_TEST_MAP_HEADER   16
+
+/*
+ * Synthetic 100 x 100 m venue with beacons on a 10 m grid, -59 dBm at 1 m and
+ * a path loss exponent of 3, measurements with 3 dB of gaussian noise.
+ */
+@interface ESTRadioMapTests : XCTestCase
+
+@property (nonatomic, assign) NSUInteger perRow;
+@property (nonatomic, strong) NSArray *beaconIdentityHashes;
+@property (nonatomic, copy) NSString *path;
+
+@end
+
+@implementation ESTRadioMapTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.perRow = EST_VENUE_TEST_SIZE / EST_VENUE_TEST_SPACING + 1;
+
+    NSMutableArray *hashes = [NSMutableArray arrayWithCapacity:self.perRow * self.perRow];
+
+    for (NSUInteger b = 0; b < self.perRow * self.perRow; b++)
+    {
+        [hashes addObject:@(ESTBeaconIdentityHashIBeacon(nil, 1, (uint16_t)b))];
+    }
+
+    self.beaconIdentityHashes = hashes;
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:NULL];
+
+    [super tearDown];
+}
+
+/*
+ * Fills one value per beacon, beacons below the audible level are left out as 0.
+ */
+- (void)measureRSSI:(float *)rssi x:(double)x y:(double)y noise:(double)noise state:(uint64_t *)state
+{
+    for (NSUInteger b = 0; b < self.beaconIdentityHashes.count; b++)
+    {
+        double distance = MAX(hypot((b % self.perRow) * EST_VENUE_TEST_SPACING - x,
+                                    (b / self.perRow) * EST_VENUE_TEST_SPACING - y), 0.5);
+        double value = -59.0 - 30.0 * log10(distance) + noise * ESTTestRandomGaussian(state);
+
+        rssi[b] = value >= EST_VENUE_TEST_AUDIBLE ? (float)value : 0;
+    }
+}
+
+/*
+ * Reference points at the centers of 1 m cells, `visits` fingerprints per cell.
+ */
+- (ESTRadioMap *)venueMapWithVisits:(NSUInteger)visits noise:(double)noise
+{
+    ESTRadioMap *map = [[ESTRadioMap alloc] initWithBeaconIdentityHashes:self.beaconIdentityHashes missingRSSI:-100];
+    float *rssi = malloc(self.beaconIdentityHashes.count * sizeof(float));
+    uint64_t state = EST_TEST_SEED;
+
+    for (NSUInteger cell = 0; cell < EST_VENUE_TEST_SIZE * EST_VENUE_TEST_SIZE; cell++)
+    {
+        double x = cell % EST_VENUE_TEST_SIZE + 0.5;
+        double y = cell / EST_VENUE_TEST_SIZE + 0.5;
+
+        for (NSUInteger visit = 0; visit < visits; visit++)
+        {
+            [self measureRSSI:rssi x:x y:y noise:noise state:&state];
+            [map addReferencePointWithRSSI:rssi x:x y:y floor:0];
+        }
+    }
+
+    free(rssi);
+
+    [map buildIndex];
+
+    return map;
+}
+
+/*
+ * Writes the map, overwrites list offset `list` in the file and loads it back.
+ */
+- (ESTRadioMap *)loadMap:(ESTRadioMap *)map withListOffset:(NSUInteger)list setTo:(uint32_t)offset
+{
+    NSError *error;
+    XCTAssertTrue([map writeToFile:self.path error:&error], @"%@", error);
+
+    NSMutableData *file = [NSMutableData dataWithContentsOfFile:self.path];
+    NSUInteger position = EST_VENUE_TEST_FILE_HEADER + EST_VENUE_TEST_MAP_HEADER
+                          + map.dimension * sizeof(uint64_t) + list * sizeof(uint32_t);
+
+    [file replaceBytesInRange:NSMakeRange(position, sizeof(offset)) withBytes:&offset];
+    XCTAssertTrue([file writeToFile:self.path options:NSDataWritingAtomic error:&error], @"%@", error);
+
+    return [ESTRadioMap radioMapWithContentsOfFile:self.path];
+}
+
+- (void)testLoaderRejectsCorruptListOffsets
+{
+    ESTRadioMap *map = [self venueMapWithVisits:1 noise:0];
+    NSUInteger lists = map.listCount;
+
+    XCTAssertGreaterThan(lists, (NSUInteger)1);
+
+    // Rewriting the first offset with its own value leaves a valid file.
+    XCTAssertNotNil([self loadMap:map withListOffset:0 setTo:0]);
+
+    XCTAssertNil([self loadMap:map withListOffset:0 setTo:1], @"Lists not starting at row 0");
+    XCTAssertNil([self loadMap:map withListOffset:lists setTo:(uint32_t)map.count + 1], @"Lists past the last row");
+    XCTAssertNil([self loadMap:map withListOffset:lists setTo:(uint32_t)map.count - 1], @"Lists short of the last row");
+    XCTAssertNil([self loadMap:map withListOffset:lists / 2 setTo:UINT32_MAX], @"List offsets going backwards");
+}
+
+/*
+ * Noisy fingerprints at random positions, located as the mean of the 4 nearest
+ * reference points. Also reports how many of those the index finds compared to
+ * scanning every list.
+ */
+- (void)testLocalizationAccuracy
+{
+    ESTRadioMap *map = [self venueMapWithVisits:1 noise:0];
+    float *rssi = malloc(map.dimension * sizeof(float));
+    uint64_t state = EST_TEST_SEED ^ 1;
+
+    double totalError = 0;
+    NSUInteger found = 0;
+
+    for (NSUInteger q = 0; q < EST_VENUE_TEST_QUERIES; q++)
+    {
+        double x = ESTTestRandom(&state) * EST_VENUE_TEST_SIZE;
+        double y = ESTTestRandom(&state) * EST_VENUE_TEST_SIZE;
+
+        [self measureRSSI:rssi x:x y:y noise:EST_VENUE_TEST_NOISE state:&state];
+
+        map.probeCount = 8;
+        NSArray *neighbors = [map nearestNeighborsOfRSSI:rssi count:4];
+
+        map.probeCount = map.listCount;
+        NSArray *exact = [map nearestNeighborsOfRSSI:rssi count:4];
+
+        XCTAssertEqual(neighbors.count, (NSUInteger)4);
+
+        double estimateX = 0;
+        double estimateY = 0;
+
+        for (ESTRadioMapNeighbor *neighbor in neighbors)
+        {
+            estimateX += neighbor.x / neighbors.count;
+            estimateY += neighbor.y / neighbors.count;
+
+            found += [[exact valueForKey:@"index"] containsObject:@(neighbor.index)];
+        }
+
+        totalError += hypot(estimateX - x, estimateY - y);
+    }
+
+    free(rssi);
+
+    double meanError = totalError / EST_VENUE_TEST_QUERIES;
+    double recall = (double)found / (EST_VENUE_TEST_QUERIES * 4);
+
+    NSLog(@"ESTRadioMapTests: mean error %.2f m, recall %.3f over %lu lists", meanError, recall, (unsigned long)map.listCount);
+
+    // Well inside the beacon spacing, and the index keeps most of the exact neighbors.
+    XCTAssertLessThan(meanError, 3.0);
+    XCTAssertGreaterThan(recall, 0.7);
+}
+
+/*
+ * 100k reference points (10 per cell), 8 of ~316 lists probed per query.
+ */
+- (void)testQueryPerformanceAt100kPoints
+{
+    ESTRadioMap *map = [self venueMapWithVisits:10 noise:EST_VENUE_TEST_NOISE];
+
+    XCTAssertEqual(map.count, (NSUInteger)100000);
+
+    float *queries = malloc(EST_VENUE_TEST_QUERIES * map.dimension * sizeof(float));
+    uint64_t state = EST_TEST_SEED ^ 2;
+
+    for (NSUInteger q = 0; q < EST_VENUE_TEST_QUERIES; q++)
+    {
+        double x = ESTTestRandom(&state) * EST_VENUE_TEST_SIZE;
+        double y = ESTTestRandom(&state) * EST_VENUE_TEST_SIZE;
+
+        [self measureRSSI:queries + q * map.dimension x:x y:y noise:EST_VENUE_TEST_NOISE state:&state];
+    }
+
+    [self measureBlock:^{
+        for (NSUInteger q = 0; q < EST_VENUE_TEST_QUERIES; q++)
+        {
+            [map nearestNeighborsOfRSSI:queries + q * map.dimension count:4];
+        }
+    }];
+
+    free(queries);
+}
+
+@end
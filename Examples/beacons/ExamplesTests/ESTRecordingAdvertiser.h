@@ -0,0 +1,53 @@
+//
+//  ESTRecordingAdvertiser.h
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ESTAdvertisingScheduler.h"
+
+/*
+ * Frame started by ESTRecordingAdvertiser. endTime is 0 while it is advertised.
+ */
+@interface ESTAdvertisingRecord : NSObject
+
+@property (nonatomic, strong, readonly) ESTAdvertisedIdentity *identity;
+@property (nonatomic, strong, readonly) NSData *payload;
+@property (nonatomic, assign, readonly) CFAbsoluteTime startTime;
+@property (nonatomic, assign, readonly) CFAbsoluteTime endTime;
+
+@end
+
+/*
+ * Stand-in radio recording every frame it is asked to advertise, with its payload and
+ * start and end time. It accepts Eddystone identities as well, so rotation schedules
+ * can be checked off device and against a simulated clock.
+ */
+@interface ESTRecordingAdvertiser : NSObject <ESTAdvertiser>
+
+/*
+ * Time source of the records, CFAbsoluteTimeGetCurrent when nil.
+ */
+@property (nonatomic, copy) CFAbsoluteTime (^clock)(void);
+
+/*
+ * Default YES, NO rejects them like ESTPeripheralAdvertiser.
+ */
+@property (nonatomic, assign) BOOL acceptsEddystone;
+
+/*
+ * ESTAdvertisingRecord objects in start order.
+ */
+@property (nonatomic, strong, readonly) NSArray *records;
+
+/*
+ * Total time of finished records of the identity.
+ */
+- (NSTimeInterval)airtimeOfIdentity:(ESTAdvertisedIdentity *)identity;
+
+- (void)removeAllRecords;
+
+@end
@@ -0,0 +1,107 @@
+//
+//  ESTRecordingAdvertiser.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import "ESTRecordingAdvertiser.h"
+
+@interface ESTAdvertisingRecord ()
+
+@property (nonatomic, strong, readwrite) ESTAdvertisedIdentity *identity;
+@property (nonatomic, strong, readwrite) NSData *payload;
+@property (nonatomic, assign, readwrite) CFAbsoluteTime startTime;
+@property (nonatomic, assign, readwrite) CFAbsoluteTime endTime;
+
+@end
+
+@implementation ESTAdvertisingRecord
+
+@end
+
+@interface ESTRecordingAdvertiser ()
+
+@property (nonatomic, strong) NSMutableArray *mutableRecords;
+
+@end
+
+@implementation ESTRecordingAdvertiser
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.acceptsEddystone = YES;
+        self.mutableRecords = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSArray *)records
+{
+    return [self.mutableRecords copy];
+}
+
+- (CFAbsoluteTime)now
+{
+    return self.clock ? self.clock() : CFAbsoluteTimeGetCurrent();
+}
+
+- (BOOL)canAdvertiseIdentity:(ESTAdvertisedIdentity *)identity
+{
+    return identity.payload && (self.acceptsEddystone || identity.frameType == ESTAdvertisedFrameTypeIBeacon);
+}
+
+- (void)startAdvertisingIdentity:(ESTAdvertisedIdentity *)identity
+{
+    CFAbsoluteTime now = [self now];
+
+    [self finishRecordAtTime:now];
+
+    ESTAdvertisingRecord *record = [ESTAdvertisingRecord new];
+    record.identity = identity;
+    record.payload = identity.payload;
+    record.startTime = now;
+
+    [self.mutableRecords addObject:record];
+}
+
+- (void)stopAdvertising
+{
+    [self finishRecordAtTime:[self now]];
+}
+
+- (void)finishRecordAtTime:(CFAbsoluteTime)time
+{
+    ESTAdvertisingRecord *record = [self.mutableRecords lastObject];
+
+    if (record && record.endTime == 0)
+    {
+        record.endTime = MAX(time, record.startTime);
+    }
+}
+
+- (NSTimeInterval)airtimeOfIdentity:(ESTAdvertisedIdentity *)identity
+{
+    NSTimeInterval airtime = 0;
+
+    for (ESTAdvertisingRecord *record in self.mutableRecords)
+    {
+        if (record.identity == identity && record.endTime > 0)
+        {
+            airtime += record.endTime - record.startTime;
+        }
+    }
+
+    return airtime;
+}
+
+- (void)removeAllRecords
+{
+    [self.mutableRecords removeAllObjects];
+}
+
+@end
@@ -0,0 +1,36 @@
+//
+//  ESTTestRandom.h
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/*
+ * Seeded generator for simulated traces, so every run sees the same input.
+ */
+
+#define EST_TEST_SEED   0x9E3779B97F4A7C15ULL
+
+/*
+ * Uniform in [0, 1).
+ */
+static inline double ESTTestRandom(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+    return (double)(*state >> 11) / 9007199254740992.0;
+}
+
+/*
+ * Standard normal, Box-Muller.
+ */
+static inline double ESTTestRandomGaussian(uint64_t *state)
+{
+    double u = MAX(ESTTestRandom(state), 1e-12);
+    double v = ESTTestRandom(state);
+
+    return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
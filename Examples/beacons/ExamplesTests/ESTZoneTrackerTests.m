@@ -0,0 +1,285 @@
+//
+//  ESTZoneTrackerTests.m
+//  ExamplesTests
+//
+//  Created by Estimote on 18.10.2026.
+//  Copyright (c) 2026 Estimote. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ESTZoneTracker.h"
+#import "ESTBeaconIdentity.h"
+#import "ESTTestRandom.h"
+
+#define EST_ZONE_TEST_SIDE          20
+#define EST_ZONE_TEST_OWN_RSSI      -65.0
+#define EST_ZONE_TEST_NEXT_RSSI     -80.0
+#define EST_ZONE_TEST_NOISE         6.0
+#define EST_ZONE_TEST_DEVICES       1000
+#define EST_ZONE_TEST_SECONDS       120
+
+static inline uint64_t ESTZoneTestBeacon(NSUInteger zone)
+{
+    return ESTBeaconIdentityHashIBeacon(nil, 3, (uint16_t)zone);
+}
+
+typedef struct
+{
+    uint64_t device;
+    uint32_t zone;
+    uint32_t count;
+    ESTZoneObservation observations[5];
+} ESTZoneTestUpdate;
+
+/*
+ * Feeds the updates in order, one second apart per round of devices.
+ */
+static void ESTZoneTestReplay(ESTZoneTracker *tracker, NSData *walk)
+{
+    const ESTZoneTestUpdate *updates = walk.bytes;
+    NSUInteger count = walk.length / sizeof(ESTZoneTestUpdate);
+
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [tracker updateDevice:updates[i].device
+                 observations:updates[i].observations
+                        count:updates[i].count
+                    timestamp:i / EST_ZONE_TEST_DEVICES];
+    }
+}
+
+/*
+ * 20 x 20 grid of rooms with doors to the rooms next to them. Every room has one
+ * beacon, expected at -65 dBm inside and -80 dBm in the rooms next door.
+ */
+@interface ESTZoneTrackerTests : XCTestCase
+
+@property (nonatomic, strong) ESTZoneGraph *graph;
+@property (nonatomic, strong) NSData *walk;
+
+@end
+
+@implementation ESTZoneTrackerTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.graph = [ESTZoneGraph new];
+
+    for (NSUInteger zone = 0; zone < EST_ZONE_TEST_SIDE * EST_ZONE_TEST_SIDE; zone++)
+    {
+        [self.graph addZoneWithIdentifier:[NSString stringWithFormat:@"room-%lu", (unsigned long)zone]];
+    }
+
+    for (NSUInteger zone = 0; zone < EST_ZONE_TEST_SIDE * EST_ZONE_TEST_SIDE; zone++)
+    {
+        [self.graph addBeaconWithIdentityHash:ESTZoneTestBeacon(zone) expectedRSSI:EST_ZONE_TEST_OWN_RSSI toZone:zone];
+
+        NSUInteger neighbors[4];
+        NSUInteger count = [self neighbors:neighbors ofZone:zone];
+
+        for (NSUInteger n = 0; n < count; n++)
+        {
+            [self.graph addBeaconWithIdentityHash:ESTZoneTestBeacon(neighbors[n]) expectedRSSI:EST_ZONE_TEST_NEXT_RSSI toZone:zone];
+
+            if (neighbors[n] > zone)
+            {
+                [self.graph connectZone:zone toZone:neighbors[n]];
+            }
+        }
+    }
+
+    self.walk = [self walkOfDevices];
+}
+
+- (NSUInteger)neighbors:(NSUInteger *)neighbors ofZone:(NSUInteger)zone
+{
+    NSUInteger x = zone % EST_ZONE_TEST_SIDE;
+    NSUInteger y = zone / EST_ZONE_TEST_SIDE;
+    NSUInteger count = 0;
+
+    if (x > 0) neighbors[count++] = zone - 1;
+    if (x + 1 < EST_ZONE_TEST_SIDE) neighbors[count++] = zone + 1;
+    if (y > 0) neighbors[count++] = zone - EST_ZONE_TEST_SIDE;
+    if (y + 1 < EST_ZONE_TEST_SIDE) neighbors[count++] = zone + EST_ZONE_TEST_SIDE;
+
+    return count;
+}
+
+/*
+ * One ranging callback in zone: the room beacon heard 90% of the time, beacons of
+ * the rooms next door half of the time, all with gaussian noise.
+ */
+- (void)fillUpdate:(ESTZoneTestUpdate *)update state:(uint64_t *)state
+{
+    update->count = 0;
+
+    if (ESTTestRandom(state) < 0.9)
+    {
+        update->observations[update->count++] = (ESTZoneObservation){
+            ESTZoneTestBeacon(update->zone), (float)(EST_ZONE_TEST_OWN_RSSI + EST_ZONE_TEST_NOISE * ESTTestRandomGaussian(state))
+        };
+    }
+
+    NSUInteger neighbors[4];
+    NSUInteger neighborCount = [self neighbors:neighbors ofZone:update->zone];
+
+    for (NSUInteger n = 0; n < neighborCount; n++)
+    {
+        if (ESTTestRandom(state) < 0.5)
+        {
+            update->observations[update->count++] = (ESTZoneObservation){
+                ESTZoneTestBeacon(neighbors[n]), (float)(EST_ZONE_TEST_NEXT_RSSI + EST_ZONE_TEST_NOISE * ESTTestRandomGaussian(state))
+            };
+        }
+    }
+}
+
+/*
+ * Devices walking the rooms, ranging at 1 Hz and staying put 90% of the time.
+ * Updates are ordered by second, then device.
+ */
+- (NSData *)walkOfDevices
+{
+    NSMutableData *walk = [NSMutableData dataWithLength:EST_ZONE_TEST_DEVICES * EST_ZONE_TEST_SECONDS * sizeof(ESTZoneTestUpdate)];
+    ESTZoneTestUpdate *updates = walk.mutableBytes;
+    uint64_t state = EST_TEST_SEED;
+
+    for (NSUInteger second = 0; second < EST_ZONE_TEST_SECONDS; second++)
+    {
+        for (NSUInteger d = 0; d < EST_ZONE_TEST_DEVICES; d++)
+        {
+            ESTZoneTestUpdate *update = &updates[second * EST_ZONE_TEST_DEVICES + d];
+            update->device = d + 1;
+
+            if (second == 0)
+            {
+                update->zone = (uint32_t)(ESTTestRandom(&state) * EST_ZONE_TEST_SIDE * EST_ZONE_TEST_SIDE);
+            }
+            else if (ESTTestRandom(&state) < 0.9)
+            {
+                update->zone = update[-EST_ZONE_TEST_DEVICES].zone;
+            }
+            else
+            {
+                NSUInteger neighbors[4];
+                NSUInteger count = [self neighbors:neighbors ofZone:update[-EST_ZONE_TEST_DEVICES].zone];
+                update->zone = (uint32_t)neighbors[(NSUInteger)(ESTTestRandom(&state) * count)];
+            }
+
+            [self fillUpdate:update state:&state];
+        }
+    }
+
+    return walk;
+}
+
+/*
+ * Share of updates where the tracker named the right zone, the strongest beacon rule
+ * is written to baseline. The first seconds fill the lag and let the decoder settle.
+ */
+- (double)accuracyOfTracker:(ESTZoneTracker *)tracker smoothed:(BOOL)smoothed baseline:(double *)baseline
+{
+    const ESTZoneTestUpdate *updates = self.walk.bytes;
+    NSUInteger lag = smoothed ? tracker.lag : 0;
+    NSUInteger correct = 0;
+    NSUInteger strongestCorrect = 0;
+    NSUInteger scored = 0;
+
+    for (NSUInteger second = 0; second < EST_ZONE_TEST_SECONDS; second++)
+    {
+        for (NSUInteger d = 0; d < EST_ZONE_TEST_DEVICES; d++)
+        {
+            const ESTZoneTestUpdate *update = &updates[second * EST_ZONE_TEST_DEVICES + d];
+
+            [tracker updateDevice:update->device observations:update->observations count:update->count timestamp:second];
+
+            if (second < 8)
+            {
+                continue;
+            }
+
+            NSUInteger truth = updates[(second - lag) * EST_ZONE_TEST_DEVICES + d].zone;
+            NSUInteger estimate = smoothed ? [tracker smoothedZoneForDevice:update->device] : [tracker currentZoneForDevice:update->device];
+
+            correct += estimate == truth;
+            scored++;
+
+            NSUInteger strongest = 0;
+
+            for (NSUInteger o = 1; o < update->count; o++)
+            {
+                strongest = update->observations[o].rssi > update->observations[strongest].rssi ? o : strongest;
+            }
+
+            strongestCorrect += update->count > 0 && update->observations[strongest].identityHash == ESTZoneTestBeacon(update->zone);
+        }
+    }
+
+    if (baseline)
+    {
+        *baseline = (double)strongestCorrect / scored;
+    }
+
+    return (double)correct / scored;
+}
+
+- (void)testTrackingBeatsStrongestBeacon
+{
+    double strongest;
+    double current = [self accuracyOfTracker:[[ESTZoneTracker alloc] initWithGraph:self.graph] smoothed:NO baseline:&strongest];
+    double smoothed = [self accuracyOfTracker:[[ESTZoneTracker alloc] initWithGraph:self.graph] smoothed:YES baseline:NULL];
+
+    NSLog(@"ESTZoneTrackerTests: accuracy current %.3f, smoothed %.3f, strongest beacon %.3f", current, smoothed, strongest);
+
+    XCTAssertGreaterThan(current, strongest);
+    XCTAssertGreaterThanOrEqual(smoothed, current);
+}
+
+/*
+ * Beacons outside of the graph give no candidate zone and must not create device state.
+ */
+- (void)testUnknownBeaconsDoNotAddDevices
+{
+    ESTZoneTracker *tracker = [[ESTZoneTracker alloc] initWithGraph:self.graph];
+    ESTZoneObservation unknown = { ESTBeaconIdentityHashIBeacon(nil, 4, 1), -60 };
+
+    for (uint64_t device = 1; device <= 100; device++)
+    {
+        XCTAssertEqual([tracker updateDevice:device observations:&unknown count:1 timestamp:0], (NSUInteger)NSNotFound);
+    }
+
+    XCTAssertEqual(tracker.deviceCount, (NSUInteger)0);
+}
+
+/*
+ * A beacon added to a zone twice is listed for it once.
+ */
+- (void)testDuplicateBeaconListedOnce
+{
+    ESTZoneGraph *graph = [ESTZoneGraph new];
+    NSUInteger zone = [graph addZoneWithIdentifier:@"lobby"];
+
+    [graph addBeaconWithIdentityHash:ESTZoneTestBeacon(0) expectedRSSI:-65 toZone:zone];
+    [graph addBeaconWithIdentityHash:ESTZoneTestBeacon(0) expectedRSSI:-70 toZone:zone];
+    [graph compile];
+
+    NSUInteger count;
+    [graph zonesOfBeacon:ESTZoneTestBeacon(0) count:&count];
+
+    XCTAssertEqual(count, (NSUInteger)1);
+}
+
+/*
+ * 120k updates of 1000 devices, a fresh tracker per run.
+ */
+- (void)testUpdatePerformance
+{
+    [self measureBlock:^{
+        ESTZoneTracker *tracker = [[ESTZoneTracker alloc] initWithGraph:self.graph];
+        ESTZoneTestReplay(tracker, self.walk);
+    }];
+}
+
+@end